@@ -0,0 +1,143 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replay the memory pool trace recorded with MS_DEV_MEMPOOL_TRACE_PATH against the dynamic memory pool on the host,
+// the device memory is faked by the address space which is never accessed, so the trace of any device can be replayed.
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "common/mem_reuse/mem_pool_trace.h"
+
+namespace device = mindspore::device;
+
+namespace {
+constexpr size_t kGBToByte = 1024 << 20;
+constexpr size_t kMBToByte = 1024 << 10;
+constexpr size_t kDefaultDeviceMemSizeGB = 32;
+constexpr size_t kDefaultUnitSizeMB = 1024;
+// The fake device address starts from a large base, so it never looks like a null pointer.
+constexpr uintptr_t kFakeDeviceAddrBase = 1ULL << 40;
+
+struct ReplayArgs {
+  std::string trace_path_;
+  size_t device_mem_size_{kDefaultDeviceMemSizeGB * kGBToByte};
+  size_t unit_size_{kDefaultUnitSizeMB * kMBToByte};
+  bool size_class_{false};
+  size_t repeat_{1};
+};
+
+// The memory pool whose device memory is the fake address space without any real memory.
+class FakeDeviceMemPool : public device::DynamicMemPoolBestFit {
+ public:
+  explicit FakeDeviceMemPool(size_t device_mem_size) : device_mem_size_(device_mem_size) {}
+  ~FakeDeviceMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, device::DeviceMemPtr *addr) override {
+    if (size > free_mem_size()) {
+      return 0;
+    }
+    *addr = reinterpret_cast<device::DeviceMemPtr>(next_addr_);
+    next_addr_ += size;
+    used_size_ += size;
+    block_size_map_[*addr] = size;
+    return size;
+  }
+  bool FreeDeviceMem(const device::DeviceMemPtr &addr) override {
+    auto iter = block_size_map_.find(addr);
+    if (iter == block_size_map_.end()) {
+      return false;
+    }
+    used_size_ -= iter->second;
+    (void)block_size_map_.erase(iter);
+    return true;
+  }
+  size_t free_mem_size() override { return device_mem_size_ - used_size_; }
+
+ private:
+  size_t device_mem_size_;
+  size_t used_size_{0};
+  uintptr_t next_addr_{kFakeDeviceAddrBase};
+  std::map<device::DeviceMemPtr, size_t> block_size_map_;
+};
+
+void PrintUsage() {
+  std::cout << "Usage: mem_pool_trace_replay --trace=<trace file> [--device_mem=<GB, default "
+            << kDefaultDeviceMemSizeGB << ">] [--unit_size=<MB, default " << kDefaultUnitSizeMB
+            << ">] [--size_class=<0|1, default 0>] [--repeat=<N, default 1>]" << std::endl;
+}
+
+bool ParseArgs(int argc, char **argv, ReplayArgs *args) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || pos == std::string::npos) {
+      std::cerr << "Invalid argument: " << arg << std::endl;
+      return false;
+    }
+    auto key = arg.substr(2, pos - 2);
+    auto value = arg.substr(pos + 1);
+    try {
+      if (key == "trace") {
+        args->trace_path_ = value;
+      } else if (key == "device_mem") {
+        args->device_mem_size_ = std::stoul(value) * kGBToByte;
+      } else if (key == "unit_size") {
+        args->unit_size_ = std::stoul(value) * kMBToByte;
+      } else if (key == "size_class") {
+        args->size_class_ = value == "1";
+      } else if (key == "repeat") {
+        args->repeat_ = std::stoul(value);
+      } else {
+        std::cerr << "Unknown argument: " << arg << std::endl;
+        return false;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "Invalid value of argument: " << arg << ", " << e.what() << std::endl;
+      return false;
+    }
+  }
+  return !args->trace_path_.empty() && args->unit_size_ != 0;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  ReplayArgs args;
+  if (!ParseArgs(argc, argv, &args)) {
+    PrintUsage();
+    return 1;
+  }
+  std::vector<device::MemTraceRecord> records;
+  if (!device::LoadMemTrace(args.trace_path_, &records)) {
+    std::cerr << "Load the memory pool trace file " << args.trace_path_ << " failed." << std::endl;
+    return 1;
+  }
+  std::cout << "Replay " << records.size() << " records of " << args.trace_path_
+            << ", device mem:" << args.device_mem_size_ / kGBToByte << "G, unit size:" << args.unit_size_ / kMBToByte
+            << "M, size class cache:" << args.size_class_ << std::endl;
+
+  FakeDeviceMemPool mem_pool(args.device_mem_size_);
+  mem_pool.SetMemAllocUintSize(args.unit_size_, args.unit_size_);
+  mem_pool.EnableSizeClassCache(args.size_class_);
+  device::MemTraceReplayer replayer(&mem_pool);
+  // The memory blocks are kept by the pool, so the later rounds show the steady state of a training loop.
+  for (size_t round = 0; round < args.repeat_; ++round) {
+    auto result = replayer.Replay(records);
+    std::cout << "Round " << round << ". " << device::MemTraceReplayer::ResultInfo(result) << std::endl;
+  }
+  return 0;
+}
@@ -43,12 +43,48 @@ static const std::map<AllocatorType, std::string> kAllocatorTypeString = {
   {AllocatorType::kOther, "other"},
 };
 
+// The external fragmentation is the part of idle memory which can not be served by the largest idle memory buf.
+static double CalIdleMemFragmentation(const MemStatusManagerPtr &mem_mng, size_t *max_idle_size) {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  size_t total_idle_size = mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_;
+  size_t max_idle_buf_size = mem_mng->idle_mem_buf_map_.empty() ? 0 : mem_mng->idle_mem_buf_map_.rbegin()->first;
+  if (max_idle_size != nullptr) {
+    *max_idle_size = max_idle_buf_size;
+  }
+  return total_idle_size == 0 ? 0 : (kPercent * (total_idle_size - max_idle_buf_size)) / total_idle_size;
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   persistent_mem_->clear();
   common_mem_->clear();
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
+  DeviceMemPtr device_addr = nullptr;
+  if (enable_size_class_cache_ && !from_persistent_mem) {
+    size_t align_size = AlignMemorySize(size);
+    if (SizeClassMemCache::IsSizeClass(align_size)) {
+      device_addr = size_class_cache_->Alloc(align_size, size);
+      if (device_addr != nullptr) {
+        MS_LOG(DEBUG) << "Alloc memory from size class cache, name:"
+                      << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_ << ", address:" << device_addr
+                      << ", size:" << size << "B.";
+      }
+    }
+  }
+  if (device_addr == nullptr) {
+    device_addr = AllocBestFitTensorMem(size, from_persistent_mem);
+  }
+  if (device_addr == nullptr && size_class_cache_ != nullptr && size_class_cache_->ReleaseIdleSlabs() > 0) {
+    // The idle slabs may be combined into a memory buf which is large enough.
+    device_addr = AllocBestFitTensorMem(size, from_persistent_mem);
+  }
+  trace_recorder_.RecordAlloc(device_addr, size, from_persistent_mem,
+                              static_cast<int>(DynamicMemAllocatorDebugInfo::GetDebugInfo().type_));
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocBestFitTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
@@ -73,9 +109,11 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
   size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false);
+  // Pre-alloc the one whole piece memory, which must be a memory buf of the best-fit pool.
+  auto device_addr = AllocBestFitTensorMem(total_size, false);
   if (!device_addr) {
+    trace_recorder_.RecordAllocContinuous(device_addr_list, size_list,
+                                          static_cast<int>(DynamicMemAllocatorDebugInfo::GetDebugInfo().type_));
     return device_addr_list;
   }
   std::lock_guard<std::mutex> locker(mutex_);
@@ -112,6 +150,8 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const
   }
   // Update the size of the last memory buf.
   continuous_mem_buf->size_ += rest_size;
+  trace_recorder_.RecordAllocContinuous(device_addr_list, size_list,
+                                        static_cast<int>(DynamicMemAllocatorDebugInfo::GetDebugInfo().type_));
   return device_addr_list;
 }
 
@@ -313,6 +353,16 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 }
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  MS_EXCEPTION_IF_NULL(device_addr);
+  // Record before the memory is given back, so the free is always ahead of the alloc which reuses the memory.
+  trace_recorder_.RecordFree(device_addr);
+  if (size_class_cache_ != nullptr && size_class_cache_->Free(device_addr)) {
+    return;
+  }
+  FreeBestFitTensorMem(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeBestFitTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
   std::lock_guard<std::mutex> locker(mutex_);
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
@@ -416,7 +466,45 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+void DynamicMemPoolBestFit::EnableSizeClassCache(bool enable) {
+  enable_size_class_cache_ = enable;
+  if (!enable) {
+    // The memory allocated before can still be freed to the cache, only the idle slabs are given back.
+    if (size_class_cache_ != nullptr) {
+      (void)size_class_cache_->ReleaseIdleSlabs();
+    }
+    return;
+  }
+  if (size_class_cache_ == nullptr) {
+    size_class_cache_ = std::make_unique<SizeClassMemCache>(
+      [this](size_t size) { return AllocBestFitTensorMem(size, false); },
+      [this](const DeviceMemPtr &device_addr) { FreeBestFitTensorMem(device_addr); });
+  }
+  MS_LOG(INFO) << "Enable the size class cache of dynamic memory pool.";
+}
+
+bool DynamicMemPoolBestFit::StartMemTrace(const std::string &path) { return trace_recorder_.Start(path); }
+
+void DynamicMemPoolBestFit::StartMemTraceFromEnv() {
+  static std::atomic<size_t> mem_pool_index{0};
+  auto trace_path = common::GetEnv("MS_DEV_MEMPOOL_TRACE_PATH");
+  if (trace_path.empty()) {
+    return;
+  }
+  (void)StartMemTrace(trace_path + "." + std::to_string(mem_pool_index++));
+}
+
+double DynamicMemPoolBestFit::IdleMemFragmentation(bool from_persistent_mem) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  const auto &mem_mng = from_persistent_mem ? persistent_mem_ : common_mem_;
+  return CalIdleMemFragmentation(mem_mng, nullptr);
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  // The slabs are released together with the memory blocks.
+  if (size_class_cache_ != nullptr) {
+    size_class_cache_->Clear();
+  }
   std::lock_guard<std::mutex> locker(mutex_);
   DumpDynamicMemPoolStateInfo();
 
@@ -445,6 +533,8 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
     }
 
     std::ostringstream buf;
+    size_t max_idle_size = 0;
+    double fragmentation = CalIdleMemFragmentation(mem_mng, &max_idle_size);
     for (size_t i = 0; i < mem_mng->mem_block_list_.size(); ++i) {
       size_t mem_block_used_size = 0;
       for (auto mb = mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.begin();
@@ -465,7 +555,9 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                  << "M, peak used mem:" << mem_mng->mps_.used_mem_peak_size_ / kMBToByte
                  << "M, in used mem:" << mem_mng->mps_.total_used_mem_size_ / kMBToByte << "M, total idle mem:"
                  << (mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_) / kMBToByte
-                 << "M. Block unit size:" << mem_mng->unit_size_ / kMBToByte
+                 << "M, idle mem buf counts:" << mem_mng->idle_mem_buf_map_.size()
+                 << ", max idle mem buf:" << max_idle_size / kMBToByte << "M, fragmentation:" << fragmentation
+                 << "%. Block unit size:" << mem_mng->unit_size_ / kMBToByte
                  << "M, block counts:" << mem_mng->mem_block_list_.size() << buf.str();
   };
 
@@ -482,6 +574,9 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                << total_used_size_list[static_cast<int>(AllocatorType::kKernelOutput)] / kMBToByte
                << "M, other used size:" << total_used_size_list[static_cast<int>(AllocatorType::kOther)] / kMBToByte
                << "M.";
+  if (size_class_cache_ != nullptr) {
+    MS_LOG(INFO) << size_class_cache_->StatisticsInfo();
+  }
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
@@ -26,6 +26,8 @@
 #include <mutex>
 #include <string>
 #include "utils/ms_utils.h"
+#include "common/mem_reuse/mem_size_class_cache.h"
+#include "common/mem_reuse/mem_pool_trace.h"
 
 namespace mindspore {
 namespace device {
@@ -148,7 +150,12 @@ using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 class DynamicMemPoolBestFit {
  public:
   DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {
+    if (common::GetEnv("MS_DEV_MEMPOOL_SIZE_CLASS") == "1") {
+      EnableSizeClassCache(true);
+    }
+    StartMemTraceFromEnv();
+  }
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -161,6 +168,15 @@ class DynamicMemPoolBestFit {
   // Release the real device memory.
   void ReleaseDeviceRes();
 
+  // Serve the small and medium common memory by the size class cache in front of the best-fit pool.
+  void EnableSizeClassCache(bool enable);
+  bool IsSizeClassCacheEnabled() const { return enable_size_class_cache_; }
+  SizeClassMemCache *size_class_cache() const { return size_class_cache_.get(); }
+
+  // Record all the alloc and free operations to the trace file, which can be replayed by the MemTraceReplayer.
+  bool StartMemTrace(const std::string &path);
+  void StopMemTrace() { trace_recorder_.Stop(); }
+
   // Get the minimum memory unit size using for dynamic extend.
   size_t MemAllocUnitSize(bool from_persistent_mem = false) const;
   // Set the minimum memory unit size using for dynamic extend.
@@ -176,8 +192,10 @@ class DynamicMemPoolBestFit {
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
+  // The external fragmentation of idle memory in percent, which is the part can not be served by the largest idle buf.
+  double IdleMemFragmentation(bool from_persistent_mem = false);
 
-  // Display the brief state information of memory block and memory buf.
+  // Display the brief state information of memory block and memory buf, and the fragmentation of idle memory.
   void DumpDynamicMemPoolStateInfo();
   // Display the detailed debug information of memory block and memory buf.
   void DumpDynamicMemPoolDebugInfo();
@@ -198,6 +216,12 @@ class DynamicMemPoolBestFit {
   virtual size_t CalMemBlockAllocSize(size_t size, bool from_persistent_mem);
 
  private:
+  // Alloc memory from the best-fit pool, bypassing the size class cache.
+  DeviceMemPtr AllocBestFitTensorMem(size_t size, bool from_persistent_mem);
+  // Free memory to the best-fit pool, bypassing the size class cache.
+  void FreeBestFitTensorMem(const DeviceMemPtr &device_addr);
+  // Start the trace if MS_DEV_MEMPOOL_TRACE_PATH is set, every memory pool records to the path suffixed by its index.
+  void StartMemTraceFromEnv();
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size, bool from_persistent_mem);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -223,6 +247,10 @@ class DynamicMemPoolBestFit {
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
   // needs to be changed back after that
   size_t config_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
+  // The size class front-end, whose slabs are allocated from the common memory of best-fit pool.
+  std::unique_ptr<SizeClassMemCache> size_class_cache_{nullptr};
+  bool enable_size_class_cache_{false};
+  MemTraceRecorder trace_recorder_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -0,0 +1,341 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/mem_reuse/mem_pool_trace.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "securec/include/securec.h"
+#include "utils/convert_utils_base.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kPercentileBase = 1000;
+constexpr size_t kP50 = 500;
+constexpr size_t kP99 = 990;
+constexpr size_t kP999 = 999;
+constexpr uint64_t kNsToMs = 1000000;
+
+uint64_t ElapsedNs(const std::chrono::steady_clock::time_point &start) {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+MemTraceLatency CalLatency(std::vector<uint64_t> *latency_list) {
+  MS_EXCEPTION_IF_NULL(latency_list);
+  MemTraceLatency latency;
+  if (latency_list->empty()) {
+    return latency;
+  }
+  std::sort(latency_list->begin(), latency_list->end());
+  auto percentile = [latency_list](size_t p) {
+    return (*latency_list)[(latency_list->size() - 1) * p / kPercentileBase];
+  };
+  latency.count_ = latency_list->size();
+  double total = 0;
+  for (auto ns : *latency_list) {
+    total += static_cast<double>(ns);
+  }
+  latency.avg_ns_ = total / latency_list->size();
+  latency.p50_ns_ = percentile(kP50);
+  latency.p99_ns_ = percentile(kP99);
+  latency.p999_ns_ = percentile(kP999);
+  latency.max_ns_ = latency_list->back();
+  return latency;
+}
+
+std::string LatencyInfo(const MemTraceLatency &latency) {
+  std::ostringstream buf;
+  buf << "counts:" << latency.count_ << ", avg:" << latency.avg_ns_ << "ns, p50:" << latency.p50_ns_
+      << "ns, p99:" << latency.p99_ns_ << "ns, p999:" << latency.p999_ns_ << "ns, max:" << latency.max_ns_ << "ns";
+  return buf.str();
+}
+}  // namespace
+
+bool MemTraceRecorder::Start(const std::string &path) {
+  Stop();
+  std::lock_guard<std::mutex> locker(mutex_);
+  ChangeFileMode(path, S_IWUSR);
+  ofs_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs_.is_open()) {
+    MS_LOG(ERROR) << "Open memory pool trace file [" << path << "] failed!";
+    return false;
+  }
+  MemTraceHeader header{};
+  auto ret = memcpy_s(header.magic_, sizeof(header.magic_), MEM_TRACE_MAGIC, sizeof(MEM_TRACE_MAGIC));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "Memcpy error, errorno(" << ret << ")";
+    ofs_.close();
+    return false;
+  }
+  header.version_ = MEM_TRACE_VERSION;
+  header.record_size_ = sizeof(MemTraceRecord);
+  (void)ofs_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  path_ = path;
+  start_time_ = std::chrono::steady_clock::now();
+  buffer_.reserve(MEM_TRACE_FLUSH_SIZE);
+  record_count_ = 0;
+  recording_.store(true, std::memory_order_relaxed);
+  MS_LOG(INFO) << "Start recording the memory pool trace to file: " << path;
+  return true;
+}
+
+void MemTraceRecorder::Stop() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!recording_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  recording_.store(false, std::memory_order_relaxed);
+  Flush();
+  ofs_.close();
+  MS_LOG(INFO) << "Stop recording the memory pool trace, record counts:" << record_count_ << ", file: " << path_;
+}
+
+MemTraceRecord MemTraceRecorder::MakeRecord(MemTraceOpType op_type, const DeviceMemPtr &device_addr, size_t size,
+                                            uint32_t count, bool from_persistent_mem, int allocator_type) const {
+  MemTraceRecord record{};
+  record.timestamp_ns_ = ElapsedNs(start_time_);
+  record.device_addr_ = reinterpret_cast<uint64_t>(device_addr);
+  record.size_ = size;
+  record.count_ = count;
+  record.op_type_ = static_cast<uint8_t>(op_type);
+  record.from_persistent_mem_ = static_cast<uint8_t>(from_persistent_mem);
+  record.allocator_type_ = static_cast<uint8_t>(allocator_type);
+  return record;
+}
+
+void MemTraceRecorder::AppendRecord(const MemTraceRecord &record) {
+  buffer_.push_back(record);
+  ++record_count_;
+  if (buffer_.size() >= MEM_TRACE_FLUSH_SIZE) {
+    Flush();
+  }
+}
+
+void MemTraceRecorder::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  (void)ofs_.write(reinterpret_cast<const char *>(buffer_.data()), buffer_.size() * sizeof(MemTraceRecord));
+  if (!ofs_.good()) {
+    MS_LOG(ERROR) << "Write memory pool trace file [" << path_ << "] failed, stop recording.";
+    recording_.store(false, std::memory_order_relaxed);
+  }
+  buffer_.clear();
+}
+
+void MemTraceRecorder::RecordAlloc(const DeviceMemPtr &device_addr, size_t size, bool from_persistent_mem,
+                                   int allocator_type) {
+  if (!IsRecording()) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!recording_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  AppendRecord(MakeRecord(MemTraceOpType::kAlloc, device_addr, size, 1, from_persistent_mem, allocator_type));
+}
+
+void MemTraceRecorder::RecordAllocContinuous(const std::vector<DeviceMemPtr> &device_addr_list,
+                                             const std::vector<size_t> &size_list, int allocator_type) {
+  if (!IsRecording() || size_list.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!recording_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // The failed continuous alloc is recorded with the null addresses.
+  bool success = device_addr_list.size() == size_list.size();
+  auto count = static_cast<uint32_t>(size_list.size());
+  for (size_t i = 0; i < size_list.size(); ++i) {
+    DeviceMemPtr device_addr = success ? device_addr_list[i] : nullptr;
+    AppendRecord(
+      MakeRecord(MemTraceOpType::kAllocContinuous, device_addr, size_list[i], count, false, allocator_type));
+  }
+}
+
+void MemTraceRecorder::RecordFree(const DeviceMemPtr &device_addr) {
+  if (!IsRecording()) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!recording_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  AppendRecord(MakeRecord(MemTraceOpType::kFree, device_addr, 0, 1, false, 0));
+}
+
+bool LoadMemTrace(const std::string &path, std::vector<MemTraceRecord> *records) {
+  MS_EXCEPTION_IF_NULL(records);
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open memory pool trace file [" << path << "] failed!";
+    return false;
+  }
+  MemTraceHeader header{};
+  if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      memcmp(header.magic_, MEM_TRACE_MAGIC, sizeof(MEM_TRACE_MAGIC)) != 0) {
+    MS_LOG(ERROR) << "The file [" << path << "] is not a memory pool trace file.";
+    return false;
+  }
+  if (header.version_ != MEM_TRACE_VERSION || header.record_size_ != sizeof(MemTraceRecord)) {
+    MS_LOG(ERROR) << "The version " << header.version_ << " and record size " << header.record_size_
+                  << " of memory pool trace file [" << path << "] are not supported, expect version "
+                  << MEM_TRACE_VERSION << " and record size " << sizeof(MemTraceRecord) << ".";
+    return false;
+  }
+  (void)ifs.seekg(0, std::ios::end);
+  auto data_size = static_cast<size_t>(ifs.tellg()) - sizeof(header);
+  (void)ifs.seekg(sizeof(header), std::ios::beg);
+  if (data_size % sizeof(MemTraceRecord) != 0) {
+    MS_LOG(WARNING) << "The memory pool trace file [" << path
+                    << "] is truncated, the last incomplete record is dropped.";
+  }
+  records->resize(data_size / sizeof(MemTraceRecord));
+  if (!ifs.read(reinterpret_cast<char *>(records->data()), records->size() * sizeof(MemTraceRecord))) {
+    MS_LOG(ERROR) << "Read memory pool trace file [" << path << "] failed.";
+    return false;
+  }
+  return true;
+}
+
+MemTraceReplayResult MemTraceReplayer::Replay(const std::vector<MemTraceRecord> &records) {
+  MS_EXCEPTION_IF_NULL(mem_pool_);
+  MemTraceReplayResult result;
+  // The device address in the trace to the device address allocated in the replay.
+  std::unordered_map<uint64_t, DeviceMemPtr> addr_map;
+  std::vector<uint64_t> alloc_latency_list;
+  std::vector<uint64_t> free_latency_list;
+  double total_fragmentation = 0;
+  size_t sample_count = 0;
+  auto set_debug_info = [](const MemTraceRecord &record) {
+    auto allocator_type = AllocatorType::kOther;
+    if (record.allocator_type_ < ALLOCATOR_TYPE_NUM) {
+      allocator_type = static_cast<AllocatorType>(record.allocator_type_);
+    }
+    DynamicMemAllocatorDebugInfo::SetDebugInfo("Replay", allocator_type);
+  };
+
+  size_t index = 0;
+  while (index < records.size()) {
+    const auto &record = records[index];
+    auto op_type = static_cast<MemTraceOpType>(record.op_type_);
+    if (op_type == MemTraceOpType::kAlloc) {
+      set_debug_info(record);
+      auto start = std::chrono::steady_clock::now();
+      auto device_addr = mem_pool_->AllocTensorMem(record.size_, record.from_persistent_mem_ != 0);
+      alloc_latency_list.push_back(ElapsedNs(start));
+      ++result.alloc_count_;
+      if (device_addr == nullptr) {
+        result.alloc_fail_count_ += record.device_addr_ == 0 ? 0 : 1;
+      } else if (record.device_addr_ == 0) {
+        // The alloc failed in the trace, so nobody holds the memory.
+        mem_pool_->FreeTensorMem(device_addr);
+      } else {
+        addr_map[record.device_addr_] = device_addr;
+      }
+      ++index;
+    } else if (op_type == MemTraceOpType::kAllocContinuous) {
+      size_t count = record.count_;
+      if (count == 0 || index + count > records.size()) {
+        MS_LOG(ERROR) << "The continuous alloc record " << index << " is incomplete, stop replaying.";
+        break;
+      }
+      set_debug_info(record);
+      std::vector<size_t> size_list;
+      for (size_t i = index; i < index + count; ++i) {
+        size_list.push_back(records[i].size_);
+      }
+      auto start = std::chrono::steady_clock::now();
+      auto device_addr_list = mem_pool_->AllocContinuousTensorMem(size_list);
+      alloc_latency_list.push_back(ElapsedNs(start));
+      ++result.alloc_count_;
+      if (device_addr_list.size() != count) {
+        result.alloc_fail_count_ += record.device_addr_ == 0 ? 0 : 1;
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          if (records[index + i].device_addr_ == 0) {
+            mem_pool_->FreeTensorMem(device_addr_list[i]);
+          } else {
+            addr_map[records[index + i].device_addr_] = device_addr_list[i];
+          }
+        }
+      }
+      index += count;
+    } else if (op_type == MemTraceOpType::kFree) {
+      auto iter = addr_map.find(record.device_addr_);
+      if (iter == addr_map.end()) {
+        ++result.unmatched_free_count_;
+      } else {
+        auto start = std::chrono::steady_clock::now();
+        mem_pool_->FreeTensorMem(iter->second);
+        free_latency_list.push_back(ElapsedNs(start));
+        ++result.free_count_;
+        (void)addr_map.erase(iter);
+      }
+      ++index;
+    } else {
+      MS_LOG(ERROR) << "Invalid operation type " << static_cast<int>(record.op_type_) << " of record " << index
+                    << ", stop replaying.";
+      break;
+    }
+
+    // Sample the memory state out of the latency measurement.
+    auto fragmentation = mem_pool_->IdleMemFragmentation();
+    auto used_mem_size = mem_pool_->TotalUsedMemStatistics();
+    result.peak_total_mem_size_ = std::max(result.peak_total_mem_size_, mem_pool_->TotalMemStatistics());
+    if (used_mem_size > result.peak_used_mem_size_) {
+      result.peak_used_mem_size_ = used_mem_size;
+      result.peak_fragmentation_ = fragmentation;
+    }
+    result.max_fragmentation_ = std::max(result.max_fragmentation_, fragmentation);
+    total_fragmentation += fragmentation;
+    ++sample_count;
+  }
+
+  // Give back the memory which is not freed in the trace, so the pool can be replayed again.
+  for (const auto &iter : addr_map) {
+    mem_pool_->FreeTensorMem(iter.second);
+  }
+  result.avg_fragmentation_ = sample_count == 0 ? 0 : total_fragmentation / sample_count;
+  if (!records.empty()) {
+    result.trace_duration_ns_ = records.back().timestamp_ns_ - records.front().timestamp_ns_;
+  }
+  result.alloc_latency_ = CalLatency(&alloc_latency_list);
+  result.free_latency_ = CalLatency(&free_latency_list);
+  return result;
+}
+
+std::string MemTraceReplayer::ResultInfo(const MemTraceReplayResult &result) {
+  std::ostringstream buf;
+  buf << "Memory pool trace replay result: trace duration:" << result.trace_duration_ns_ / kNsToMs
+      << "ms, alloc counts:" << result.alloc_count_ << ", free counts:" << result.free_count_
+      << ", alloc fail counts:" << result.alloc_fail_count_
+      << ", unmatched free counts:" << result.unmatched_free_count_
+      << ", peak total mem:" << result.peak_total_mem_size_ / kMBToByte
+      << "M, peak used mem:" << result.peak_used_mem_size_ / kMBToByte
+      << "M, fragmentation avg:" << result.avg_fragmentation_ << "%, max:" << result.max_fragmentation_
+      << "%, at peak used:" << result.peak_fragmentation_ << "%.\n  Alloc latency "
+      << LatencyInfo(result.alloc_latency_) << ".\n  Free latency " << LatencyInfo(result.free_latency_) << ".";
+  return buf.str();
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_POOL_TRACE_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_POOL_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+using DeviceMemPtr = void(*);
+class DynamicMemPoolBestFit;
+
+// The magic and version in the header of the memory pool trace file.
+static const char MEM_TRACE_MAGIC[] = "MSMEMTR";
+static const uint32_t MEM_TRACE_VERSION = 1;
+// The number of records buffered in memory before written to the trace file.
+static const size_t MEM_TRACE_FLUSH_SIZE = 4096;
+
+enum class MemTraceOpType : uint8_t { kAlloc, kAllocContinuous, kFree };
+
+struct MemTraceHeader {
+  char magic_[sizeof(MEM_TRACE_MAGIC)];
+  uint32_t version_;
+  uint32_t record_size_;
+};
+
+// One memory pool operation in the trace file, the continuous memory alloc is recorded as the consecutive records of
+// all its tensors, and the count is the number of tensors.
+struct MemTraceRecord {
+  // The nanoseconds since the trace started.
+  uint64_t timestamp_ns_;
+  // The device address returned by alloc or passed to free, null if the alloc failed.
+  uint64_t device_addr_;
+  // The requested size before aligned, zero for free.
+  uint64_t size_;
+  uint32_t count_;
+  uint8_t op_type_;
+  uint8_t from_persistent_mem_;
+  uint8_t allocator_type_;
+  uint8_t reserved_;
+};
+static_assert(sizeof(MemTraceRecord) == 32, "The memory trace record must be packed.");
+
+// Record the operations of the dynamic memory pool to the compact binary trace file, which can be replayed offline by
+// the MemTraceReplayer against any memory pool implementation.
+class MemTraceRecorder {
+ public:
+  MemTraceRecorder() = default;
+  ~MemTraceRecorder() { Stop(); }
+
+  bool Start(const std::string &path);
+  void Stop();
+  bool IsRecording() const { return recording_.load(std::memory_order_relaxed); }
+
+  void RecordAlloc(const DeviceMemPtr &device_addr, size_t size, bool from_persistent_mem, int allocator_type);
+  void RecordAllocContinuous(const std::vector<DeviceMemPtr> &device_addr_list, const std::vector<size_t> &size_list,
+                             int allocator_type);
+  void RecordFree(const DeviceMemPtr &device_addr);
+
+ private:
+  MemTraceRecord MakeRecord(MemTraceOpType op_type, const DeviceMemPtr &device_addr, size_t size, uint32_t count,
+                            bool from_persistent_mem, int allocator_type) const;
+  // Append the records to the buffer, and write them to the file when the buffer is full. Need the lock held.
+  void AppendRecord(const MemTraceRecord &record);
+  void Flush();
+
+  std::atomic<bool> recording_{false};
+  std::mutex mutex_;
+  std::ofstream ofs_;
+  std::string path_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::vector<MemTraceRecord> buffer_;
+  size_t record_count_{0};
+
+  DISABLE_COPY_AND_ASSIGN(MemTraceRecorder);
+};
+
+// Load all the records of the trace file, return false if the file is not a valid memory pool trace.
+bool LoadMemTrace(const std::string &path, std::vector<MemTraceRecord> *records);
+
+struct MemTraceLatency {
+  size_t count_{0};
+  double avg_ns_{0};
+  uint64_t p50_ns_{0};
+  uint64_t p99_ns_{0};
+  uint64_t p999_ns_{0};
+  uint64_t max_ns_{0};
+};
+
+struct MemTraceReplayResult {
+  size_t alloc_count_{0};
+  size_t free_count_{0};
+  // The allocations which succeeded in the trace but failed in the replay.
+  size_t alloc_fail_count_{0};
+  // The frees whose address is not allocated in the replay, because the alloc failed or happened before the trace.
+  size_t unmatched_free_count_{0};
+  // The peak device memory allocated from the device, and the peak memory in used by the tensors.
+  size_t peak_total_mem_size_{0};
+  size_t peak_used_mem_size_{0};
+  // The external fragmentation of the common memory in percent, sampled after every operation.
+  double avg_fragmentation_{0};
+  double max_fragmentation_{0};
+  // The fragmentation when the used memory reaches the peak.
+  double peak_fragmentation_{0};
+  // The duration between the first and the last record in the trace.
+  uint64_t trace_duration_ns_{0};
+  MemTraceLatency alloc_latency_;
+  MemTraceLatency free_latency_;
+};
+
+// Replay the records of trace on the memory pool in order, the device addresses in the trace are mapped to the
+// addresses allocated by the pool, the records of multiple threads are replayed by the current thread.
+class MemTraceReplayer {
+ public:
+  explicit MemTraceReplayer(DynamicMemPoolBestFit *mem_pool) : mem_pool_(mem_pool) {}
+  ~MemTraceReplayer() = default;
+
+  MemTraceReplayResult Replay(const std::vector<MemTraceRecord> &records);
+  static std::string ResultInfo(const MemTraceReplayResult &result);
+
+ private:
+  DynamicMemPoolBestFit *mem_pool_;
+
+  DISABLE_COPY_AND_ASSIGN(MemTraceReplayer);
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_POOL_TRACE_H_
@@ -0,0 +1,359 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/mem_reuse/mem_size_class_cache.h"
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The size classes are multiples of 512 bytes up to 4K, then four classes for each power of 2.
+constexpr size_t kLinearClassMaxSize = 4096;
+constexpr size_t kClassNumPerDouble = 4;
+
+std::atomic<uint64_t> g_cache_id{0};
+// The number of destroyed size class caches, for the threads to find out their stale thread caches.
+std::atomic<uint64_t> g_destroyed_cache_num{0};
+
+// The alive size class caches, for the exiting thread to find the owner of its cached memory.
+std::mutex &CacheRegistryMutex() {
+  static std::mutex registry_mutex;
+  return registry_mutex;
+}
+
+std::map<uint64_t, SizeClassMemCache *> &CacheRegistry() {
+  static std::map<uint64_t, SizeClassMemCache *> registry;
+  return registry;
+}
+}  // namespace
+
+struct SizeClassThreadCache {
+  SizeClassThreadCache(uint64_t cache_id, uint64_t epoch, size_t class_num) : cache_id_(cache_id), epoch_(epoch) {
+    free_lists_.resize(class_num);
+  }
+  ~SizeClassThreadCache() {
+    std::lock_guard<std::mutex> locker(CacheRegistryMutex());
+    auto iter = CacheRegistry().find(cache_id_);
+    if (iter != CacheRegistry().end()) {
+      iter->second->ReturnThreadFreeLists(epoch_, &free_lists_);
+    }
+  }
+  uint64_t cache_id_;
+  uint64_t epoch_;
+  std::vector<std::vector<DeviceMemPtr>> free_lists_;
+};
+
+namespace {
+// The thread local caches of all size class caches, the cache id is never reused so the cache of the destroyed
+// memory pool is never accessed again, and it is pruned on the next access of the thread.
+thread_local std::vector<std::unique_ptr<SizeClassThreadCache>> g_thread_caches;
+thread_local uint64_t g_pruned_destroyed_cache_num = 0;
+
+// Drop the thread caches of the destroyed size class caches, which only costs an atomic load if none is destroyed
+// since the last prune of the current thread.
+void PruneThreadCaches() {
+  auto destroyed_cache_num = g_destroyed_cache_num.load(std::memory_order_acquire);
+  if (destroyed_cache_num == g_pruned_destroyed_cache_num) {
+    return;
+  }
+  g_pruned_destroyed_cache_num = destroyed_cache_num;
+  // The stale thread caches are released out of the lock, because their destructors acquire it.
+  std::vector<std::unique_ptr<SizeClassThreadCache>> stale_caches;
+  {
+    std::lock_guard<std::mutex> locker(CacheRegistryMutex());
+    for (auto &thread_cache : g_thread_caches) {
+      if (CacheRegistry().count(thread_cache->cache_id_) == 0) {
+        (void)stale_caches.emplace_back(std::move(thread_cache));
+      }
+    }
+  }
+  (void)g_thread_caches.erase(std::remove(g_thread_caches.begin(), g_thread_caches.end(), nullptr),
+                              g_thread_caches.end());
+}
+}  // namespace
+
+SizeClassMemCache::SizeClassMemCache(const SlabAllocFunc &slab_alloc_func, const SlabFreeFunc &slab_free_func)
+    : cache_id_(++g_cache_id), slab_alloc_func_(slab_alloc_func), slab_free_func_(slab_free_func) {
+  for (size_t size = SIZE_CLASS_ALIGN_SIZE; size <= kLinearClassMaxSize; size += SIZE_CLASS_ALIGN_SIZE) {
+    class_size_list_.push_back(size);
+  }
+  for (size_t base = kLinearClassMaxSize; base < SIZE_CLASS_MAX_SIZE; base *= 2) {
+    size_t step = base / kClassNumPerDouble;
+    for (size_t i = 1; i <= kClassNumPerDouble; ++i) {
+      class_size_list_.push_back(base + i * step);
+    }
+  }
+  // Map every aligned size to the smallest size class which is not less than it.
+  class_index_table_.resize(SIZE_CLASS_MAX_SIZE / SIZE_CLASS_ALIGN_SIZE);
+  size_t class_index = 0;
+  for (size_t i = 0; i < class_index_table_.size(); ++i) {
+    size_t size = (i + 1) * SIZE_CLASS_ALIGN_SIZE;
+    while (class_size_list_[class_index] < size) {
+      ++class_index;
+    }
+    class_index_table_[i] = static_cast<uint8_t>(class_index);
+  }
+  for (size_t i = 0; i < class_size_list_.size(); ++i) {
+    (void)central_free_lists_.emplace_back(std::make_unique<SizeClassFreeList>());
+  }
+  std::lock_guard<std::mutex> locker(CacheRegistryMutex());
+  CacheRegistry()[cache_id_] = this;
+}
+
+SizeClassMemCache::~SizeClassMemCache() {
+  {
+    std::lock_guard<std::mutex> locker(CacheRegistryMutex());
+    (void)CacheRegistry().erase(cache_id_);
+  }
+  // The current thread drops its cache at once, and the other threads drop theirs when they access any cache.
+  (void)g_destroyed_cache_num.fetch_add(1, std::memory_order_release);
+  PruneThreadCaches();
+}
+
+std::vector<std::vector<DeviceMemPtr>> *SizeClassMemCache::ThreadFreeLists() {
+  PruneThreadCaches();
+  auto epoch = epoch_.load(std::memory_order_acquire);
+  for (auto &thread_cache : g_thread_caches) {
+    if (thread_cache->cache_id_ == cache_id_) {
+      if (thread_cache->epoch_ != epoch) {
+        // The slabs have been dropped, the cached memory is invalid.
+        for (auto &free_list : thread_cache->free_lists_) {
+          free_list.clear();
+        }
+        thread_cache->epoch_ = epoch;
+      }
+      return &thread_cache->free_lists_;
+    }
+  }
+  (void)g_thread_caches.emplace_back(std::make_unique<SizeClassThreadCache>(cache_id_, epoch, class_size_list_.size()));
+  return &g_thread_caches.back()->free_lists_;
+}
+
+void SizeClassMemCache::ReturnThreadFreeLists(uint64_t epoch,
+                                              std::vector<std::vector<DeviceMemPtr>> *thread_free_lists) {
+  MS_EXCEPTION_IF_NULL(thread_free_lists);
+  if (epoch != epoch_.load(std::memory_order_acquire)) {
+    return;
+  }
+  for (size_t class_index = 0; class_index < thread_free_lists->size(); ++class_index) {
+    auto &thread_free_list = (*thread_free_lists)[class_index];
+    if (thread_free_list.empty()) {
+      continue;
+    }
+    auto &central = central_free_lists_[class_index];
+    std::lock_guard<std::mutex> locker(central->mutex_);
+    (void)central->free_list_.insert(central->free_list_.end(), thread_free_list.begin(), thread_free_list.end());
+    thread_free_list.clear();
+  }
+}
+
+DeviceMemPtr SizeClassMemCache::Alloc(size_t size, size_t requested_size) {
+  if (!IsSizeClass(size)) {
+    return nullptr;
+  }
+  auto class_index = ClassIndex(size);
+  auto &thread_free_list = (*ThreadFreeLists())[class_index];
+  if (thread_free_list.empty()) {
+    if (!RefillThreadFreeList(class_index, &thread_free_list)) {
+      (void)stats_.alloc_fail_count_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+  } else {
+    (void)stats_.thread_cache_hit_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  auto device_addr = thread_free_list.back();
+  thread_free_list.pop_back();
+  auto class_size = class_size_list_[class_index];
+  (void)stats_.total_requested_size_.fetch_add(requested_size, std::memory_order_relaxed);
+  (void)stats_.total_class_size_.fetch_add(class_size, std::memory_order_relaxed);
+  (void)stats_.in_used_size_.fetch_add(class_size, std::memory_order_relaxed);
+  return device_addr;
+}
+
+bool SizeClassMemCache::RefillThreadFreeList(size_t class_index, std::vector<DeviceMemPtr> *thread_free_list) {
+  MS_EXCEPTION_IF_NULL(thread_free_list);
+  auto &central = central_free_lists_[class_index];
+  std::lock_guard<std::mutex> locker(central->mutex_);
+  if (central->free_list_.empty()) {
+    if (!AddSlab(class_index, central.get())) {
+      return false;
+    }
+    (void)stats_.slab_alloc_count_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    (void)stats_.central_hit_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  size_t transfer_size = std::min(SIZE_CLASS_TRANSFER_SIZE, central->free_list_.size());
+  auto begin = central->free_list_.end() - SizeToLong(transfer_size);
+  (void)thread_free_list->insert(thread_free_list->end(), begin, central->free_list_.end());
+  (void)central->free_list_.erase(begin, central->free_list_.end());
+  return true;
+}
+
+bool SizeClassMemCache::AddSlab(size_t class_index, SizeClassFreeList *central) {
+  MS_EXCEPTION_IF_NULL(central);
+  auto class_size = class_size_list_[class_index];
+  auto slab_size = std::max(SIZE_CLASS_SLAB_SIZE, class_size);
+  auto device_addr = slab_alloc_func_(slab_size);
+  if (device_addr == nullptr) {
+    MS_LOG(INFO) << "Alloc slab of size class " << class_size << " failed, slab size: " << slab_size;
+    return false;
+  }
+  auto object_count = slab_size / class_size;
+  auto slab = std::make_shared<SizeClassSlab>(device_addr, slab_size, class_index, object_count);
+  {
+    std::unique_lock<std::shared_mutex> locker(slab_mutex_);
+    (void)slab_map_.emplace(device_addr, slab);
+  }
+  // Push in reverse order so that the memory is allocated from the low address.
+  for (size_t i = object_count; i > 0; --i) {
+    central->free_list_.push_back(AddressOffset(device_addr, (i - 1) * class_size));
+  }
+  (void)stats_.slab_total_size_.fetch_add(slab_size, std::memory_order_relaxed);
+  return true;
+}
+
+SizeClassSlabPtr SizeClassMemCache::FindSlab(const DeviceMemPtr &device_addr) {
+  std::shared_lock<std::shared_mutex> locker(slab_mutex_);
+  auto iter = slab_map_.upper_bound(device_addr);
+  if (iter == slab_map_.begin()) {
+    return nullptr;
+  }
+  --iter;
+  const auto &slab = iter->second;
+  if (static_cast<uint8_t *>(device_addr) >= AddressOffset(slab->device_addr_, slab->size_)) {
+    return nullptr;
+  }
+  return slab;
+}
+
+bool SizeClassMemCache::Free(const DeviceMemPtr &device_addr) {
+  auto slab = FindSlab(device_addr);
+  if (slab == nullptr) {
+    return false;
+  }
+  auto class_index = slab->class_index_;
+  (void)stats_.free_count_.fetch_add(1, std::memory_order_relaxed);
+  (void)stats_.in_used_size_.fetch_sub(class_size_list_[class_index], std::memory_order_relaxed);
+  auto &thread_free_list = (*ThreadFreeLists())[class_index];
+  thread_free_list.push_back(device_addr);
+  if (thread_free_list.size() > SIZE_CLASS_THREAD_CACHE_SIZE) {
+    // Give back the earliest freed memory to the central free list for the other threads.
+    auto &central = central_free_lists_[class_index];
+    auto end = thread_free_list.begin() + SizeToLong(SIZE_CLASS_TRANSFER_SIZE);
+    std::lock_guard<std::mutex> locker(central->mutex_);
+    (void)central->free_list_.insert(central->free_list_.end(), thread_free_list.begin(), end);
+    (void)thread_free_list.erase(thread_free_list.begin(), end);
+  }
+  return true;
+}
+
+size_t SizeClassMemCache::ReleaseIdleSlabs() {
+  // The memory cached by the current thread can be released too.
+  auto thread_free_lists = ThreadFreeLists();
+  std::vector<SizeClassSlabPtr> idle_slabs;
+  for (size_t class_index = 0; class_index < central_free_lists_.size(); ++class_index) {
+    auto &central = central_free_lists_[class_index];
+    auto &thread_free_list = (*thread_free_lists)[class_index];
+    std::lock_guard<std::mutex> locker(central->mutex_);
+    (void)central->free_list_.insert(central->free_list_.end(), thread_free_list.begin(), thread_free_list.end());
+    thread_free_list.clear();
+    if (central->free_list_.empty()) {
+      continue;
+    }
+    // Count the idle memory of each slab.
+    std::unordered_map<SizeClassSlabPtr, size_t> idle_count;
+    for (const auto &device_addr : central->free_list_) {
+      auto slab = FindSlab(device_addr);
+      MS_EXCEPTION_IF_NULL(slab);
+      ++idle_count[slab];
+    }
+    std::vector<SizeClassSlabPtr> class_idle_slabs;
+    for (const auto &iter : idle_count) {
+      if (iter.second == iter.first->object_count_) {
+        class_idle_slabs.push_back(iter.first);
+      }
+    }
+    if (class_idle_slabs.empty()) {
+      continue;
+    }
+    auto is_in_idle_slab = [&class_idle_slabs](const DeviceMemPtr &device_addr) {
+      return std::any_of(class_idle_slabs.begin(), class_idle_slabs.end(), [&device_addr](const SizeClassSlabPtr &slab) {
+        return device_addr >= slab->device_addr_ && device_addr < AddressOffset(slab->device_addr_, slab->size_);
+      });
+    };
+    (void)central->free_list_.erase(
+      std::remove_if(central->free_list_.begin(), central->free_list_.end(), is_in_idle_slab),
+      central->free_list_.end());
+    (void)idle_slabs.insert(idle_slabs.end(), class_idle_slabs.begin(), class_idle_slabs.end());
+  }
+
+  size_t release_size = 0;
+  for (const auto &slab : idle_slabs) {
+    {
+      std::unique_lock<std::shared_mutex> locker(slab_mutex_);
+      (void)slab_map_.erase(slab->device_addr_);
+    }
+    slab_free_func_(slab->device_addr_);
+    release_size += slab->size_;
+  }
+  (void)stats_.slab_total_size_.fetch_sub(release_size, std::memory_order_relaxed);
+  MS_LOG(INFO) << "Release " << idle_slabs.size() << " idle slabs, size: " << release_size;
+  return release_size;
+}
+
+void SizeClassMemCache::Clear() {
+  for (auto &central : central_free_lists_) {
+    std::lock_guard<std::mutex> locker(central->mutex_);
+    central->free_list_.clear();
+  }
+  {
+    std::unique_lock<std::shared_mutex> locker(slab_mutex_);
+    slab_map_.clear();
+  }
+  (void)epoch_.fetch_add(1, std::memory_order_release);
+  stats_.in_used_size_ = 0;
+  stats_.slab_total_size_ = 0;
+}
+
+std::string SizeClassMemCache::StatisticsInfo() const {
+  size_t thread_cache_hit = stats_.thread_cache_hit_count_.load(std::memory_order_relaxed);
+  size_t central_hit = stats_.central_hit_count_.load(std::memory_order_relaxed);
+  size_t slab_alloc = stats_.slab_alloc_count_.load(std::memory_order_relaxed);
+  size_t alloc_fail = stats_.alloc_fail_count_.load(std::memory_order_relaxed);
+  size_t total_alloc = thread_cache_hit + central_hit + slab_alloc + alloc_fail;
+  size_t requested_size = stats_.total_requested_size_.load(std::memory_order_relaxed);
+  size_t class_size = stats_.total_class_size_.load(std::memory_order_relaxed);
+  size_t in_used_size = stats_.in_used_size_.load(std::memory_order_relaxed);
+  size_t slab_size = stats_.slab_total_size_.load(std::memory_order_relaxed);
+  auto percent = [](size_t numerator, size_t denominator) {
+    return denominator == 0 ? 0.0 : kPercent * numerator / denominator;
+  };
+  std::ostringstream buf;
+  buf << "Size class cache info: alloc counts:" << total_alloc
+      << ", thread cache hit rate:" << percent(thread_cache_hit, total_alloc)
+      << "%, central hit rate:" << percent(central_hit, total_alloc)
+      << "%, slab alloc counts:" << slab_alloc << ", alloc fail counts:" << alloc_fail
+      << ", free counts:" << stats_.free_count_.load(std::memory_order_relaxed) << ", slab mem:" << slab_size / kMBToByte
+      << "M, in used mem:" << in_used_size / kMBToByte
+      << "M, slab utilization:" << percent(in_used_size, slab_size)
+      << "%, internal fragmentation:" << percent(class_size - requested_size, class_size) << "%.";
+  return buf.str();
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_CACHE_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_CACHE_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+using DeviceMemPtr = void(*);
+
+// The size class is aligned according to 512 bytes, which is the same as the dynamic memory pool.
+static const size_t SIZE_CLASS_ALIGN_SIZE = 512;
+// The tensors larger than this size are allocated from the best-fit pool directly.
+static const size_t SIZE_CLASS_MAX_SIZE = 1 << 20;
+// The slab carved into the memory of one size class is allocated from the best-fit pool.
+static const size_t SIZE_CLASS_SLAB_SIZE = 4 << 20;
+// The max number of idle memory cached by one thread for each size class.
+static const size_t SIZE_CLASS_THREAD_CACHE_SIZE = 64;
+// The number of idle memory moved between the thread cache and the central free list at a time.
+static const size_t SIZE_CLASS_TRANSFER_SIZE = 16;
+// The multiplier of the ratios reported in percentage by the memory pool statistics.
+constexpr double kPercent = 100.0;
+
+// Slab is a piece of memory from the best-fit pool which is divided into the memory of the same size class.
+struct SizeClassSlab {
+  SizeClassSlab(DeviceMemPtr addr, size_t size, size_t class_index, size_t object_count)
+      : device_addr_(addr), size_(size), class_index_(class_index), object_count_(object_count) {}
+  DeviceMemPtr device_addr_;
+  size_t size_;
+  size_t class_index_;
+  size_t object_count_;
+};
+using SizeClassSlabPtr = std::shared_ptr<SizeClassSlab>;
+
+// The central free list of one size class, shared by all threads.
+struct SizeClassFreeList {
+  std::mutex mutex_;
+  std::vector<DeviceMemPtr> free_list_;
+};
+
+struct SizeClassStatistics {
+  // Allocations served by the thread cache without any lock.
+  std::atomic<size_t> thread_cache_hit_count_{0};
+  // Allocations which refill the thread cache from the central free list.
+  std::atomic<size_t> central_hit_count_{0};
+  // Allocations which need a new slab from the best-fit pool.
+  std::atomic<size_t> slab_alloc_count_{0};
+  std::atomic<size_t> alloc_fail_count_{0};
+  std::atomic<size_t> free_count_{0};
+  // The requested size and size class size of all allocations, for the internal fragmentation.
+  std::atomic<size_t> total_requested_size_{0};
+  std::atomic<size_t> total_class_size_{0};
+  std::atomic<size_t> in_used_size_{0};
+  std::atomic<size_t> slab_total_size_{0};
+};
+
+// The size class segregated front-end of the dynamic memory pool. The small and medium tensors are allocated from
+// the thread local cache first, then from the central free list of the size class, and the slabs of each size class
+// are allocated from the best-fit pool by SlabAllocFunc.
+class SizeClassMemCache {
+ public:
+  using SlabAllocFunc = std::function<DeviceMemPtr(size_t)>;
+  using SlabFreeFunc = std::function<void(const DeviceMemPtr &)>;
+
+  SizeClassMemCache(const SlabAllocFunc &slab_alloc_func, const SlabFreeFunc &slab_free_func);
+  ~SizeClassMemCache();
+
+  // Whether the aligned size is served by the size class cache.
+  static bool IsSizeClass(size_t size) { return size > 0 && size <= SIZE_CLASS_MAX_SIZE; }
+
+  // Alloc the memory of the size class which the aligned size belongs to, the requested size is used for statistics.
+  DeviceMemPtr Alloc(size_t size, size_t requested_size);
+  // Return false if the device address is not allocated by the size class cache.
+  bool Free(const DeviceMemPtr &device_addr);
+  // Return the slabs whose memory are all idle in the central free list to the best-fit pool, return the released size.
+  size_t ReleaseIdleSlabs();
+  // Drop all the slabs and thread caches without returning them, used when the device memory is released.
+  void Clear();
+
+  size_t SizeClassNum() const { return class_size_list_.size(); }
+  size_t ClassSize(size_t class_index) const { return class_size_list_[class_index]; }
+  const SizeClassStatistics &statistics() const { return stats_; }
+  std::string StatisticsInfo() const;
+
+ private:
+  friend struct SizeClassThreadCache;
+  // Give back the memory cached by the exiting thread to the central free lists.
+  void ReturnThreadFreeLists(uint64_t epoch, std::vector<std::vector<DeviceMemPtr>> *thread_free_lists);
+  // The index of size class which the aligned size belongs to.
+  size_t ClassIndex(size_t size) const { return class_index_table_[(size - 1) / SIZE_CLASS_ALIGN_SIZE]; }
+  // Get the free lists cached by the current thread for this cache.
+  std::vector<std::vector<DeviceMemPtr>> *ThreadFreeLists();
+  // Move the idle memory from the central free list to the thread free list, alloc new slab if the central is empty.
+  bool RefillThreadFreeList(size_t class_index, std::vector<DeviceMemPtr> *thread_free_list);
+  // Alloc a new slab for the size class and add all its memory to the central free list.
+  bool AddSlab(size_t class_index, SizeClassFreeList *central);
+  SizeClassSlabPtr FindSlab(const DeviceMemPtr &device_addr);
+
+  // The unique id of this cache which is used as the key of thread local cache.
+  uint64_t cache_id_;
+  // The thread caches are dropped when the epoch changes.
+  std::atomic<uint64_t> epoch_{0};
+  std::vector<size_t> class_size_list_;
+  std::vector<uint8_t> class_index_table_;
+  std::vector<std::unique_ptr<SizeClassFreeList>> central_free_lists_;
+
+  // The map of all slabs by device address, for finding the slab when memory free.
+  std::shared_mutex slab_mutex_;
+  std::map<DeviceMemPtr, SizeClassSlabPtr> slab_map_;
+
+  SlabAllocFunc slab_alloc_func_;
+  SlabFreeFunc slab_free_func_;
+  SizeClassStatistics stats_;
+
+  DISABLE_COPY_AND_ASSIGN(SizeClassMemCache);
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_CACHE_H_
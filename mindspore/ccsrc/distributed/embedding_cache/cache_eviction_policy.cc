@@ -0,0 +1,248 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/embedding_cache/cache_eviction_policy.h"
+#include <algorithm>
+#include <map>
+#include "distributed/embedding_cache/embedding_hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+const std::map<std::string, CacheEvictionPolicyType> kCacheEvictionPolicyTypes = {
+  {"clock", CacheEvictionPolicyType::kClock},
+  {"lru", CacheEvictionPolicyType::kLRU},
+  {"lfu", CacheEvictionPolicyType::kLFU},
+  {"arc", CacheEvictionPolicyType::kARC}};
+
+// Iterate the list from the least recently pushed index, return the first index which can be evicted.
+int SelectFromBack(const IndexLinkedList &list, const std::function<bool(int)> &can_evict) {
+  for (int index = list.Back(); index != INVALID_INDEX_VALUE; index = list.Prev(index)) {
+    if (can_evict(index)) {
+      return index;
+    }
+  }
+  return INVALID_INDEX_VALUE;
+}
+}  // namespace
+
+CacheEvictionPolicyType GetCacheEvictionPolicyType(const std::string &name) {
+  if (name.empty()) {
+    return CacheEvictionPolicyType::kClock;
+  }
+  std::string lower_name = name;
+  (void)std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), ::tolower);
+  auto iter = kCacheEvictionPolicyTypes.find(lower_name);
+  if (iter == kCacheEvictionPolicyTypes.end()) {
+    MS_LOG(WARNING) << "Unknown embedding cache eviction policy: " << name
+                    << ", the policy should be one of clock, lru, lfu and arc, use the default policy clock instead.";
+    return CacheEvictionPolicyType::kClock;
+  }
+  return iter->second;
+}
+
+std::string GetCacheEvictionPolicyName(CacheEvictionPolicyType type) {
+  for (const auto &item : kCacheEvictionPolicyTypes) {
+    if (item.second == type) {
+      return item.first;
+    }
+  }
+  return "unknown";
+}
+
+IndexLinkedList::IndexLinkedList(size_t capacity)
+    : prev_(capacity, INVALID_INDEX_VALUE),
+      next_(capacity, INVALID_INDEX_VALUE),
+      in_list_(capacity, false),
+      head_(INVALID_INDEX_VALUE),
+      tail_(INVALID_INDEX_VALUE) {}
+
+void IndexLinkedList::PushFront(int index) {
+  if (in_list_[index]) {
+    Remove(index);
+  }
+  prev_[index] = INVALID_INDEX_VALUE;
+  next_[index] = head_;
+  if (head_ != INVALID_INDEX_VALUE) {
+    prev_[head_] = index;
+  } else {
+    tail_ = index;
+  }
+  head_ = index;
+  in_list_[index] = true;
+  ++size_;
+}
+
+void IndexLinkedList::Remove(int index) {
+  if (!in_list_[index]) {
+    return;
+  }
+  if (prev_[index] != INVALID_INDEX_VALUE) {
+    next_[prev_[index]] = next_[index];
+  } else {
+    head_ = next_[index];
+  }
+  if (next_[index] != INVALID_INDEX_VALUE) {
+    prev_[next_[index]] = prev_[index];
+  } else {
+    tail_ = prev_[index];
+  }
+  prev_[index] = INVALID_INDEX_VALUE;
+  next_[index] = INVALID_INDEX_VALUE;
+  in_list_[index] = false;
+  --size_;
+}
+
+void LRUCacheEvictionPolicy::Insert(int, int index) { lru_list_.PushFront(index); }
+
+void LRUCacheEvictionPolicy::Access(int index) { lru_list_.PushFront(index); }
+
+void LRUCacheEvictionPolicy::Evict(int, int index) { lru_list_.Remove(index); }
+
+int LRUCacheEvictionPolicy::SelectVictim(int, const std::function<bool(int)> &can_evict) const {
+  return SelectFromBack(lru_list_, can_evict);
+}
+
+void LFUCacheEvictionPolicy::Insert(int, int index) {
+  auto i = IntToSize(index);
+  frequency_[i] = 1;
+  tick_[i] = ++current_tick_;
+  (void)lfu_nodes_.insert({frequency_[i], tick_[i], index});
+}
+
+void LFUCacheEvictionPolicy::Access(int index) {
+  auto i = IntToSize(index);
+  auto iter = lfu_nodes_.find({frequency_[i], tick_[i], index});
+  if (iter == lfu_nodes_.end()) {
+    return;
+  }
+  (void)lfu_nodes_.erase(iter);
+  ++frequency_[i];
+  tick_[i] = ++current_tick_;
+  (void)lfu_nodes_.insert({frequency_[i], tick_[i], index});
+}
+
+void LFUCacheEvictionPolicy::Evict(int, int index) {
+  auto i = IntToSize(index);
+  (void)lfu_nodes_.erase({frequency_[i], tick_[i], index});
+  frequency_[i] = 0;
+  tick_[i] = 0;
+}
+
+int LFUCacheEvictionPolicy::SelectVictim(int, const std::function<bool(int)> &can_evict) const {
+  for (const auto &node : lfu_nodes_) {
+    if (can_evict(node.index_)) {
+      return node.index_;
+    }
+  }
+  return INVALID_INDEX_VALUE;
+}
+
+void ARCCacheEvictionPolicy::GhostList::PushFront(int id) {
+  ids_.push_front(id);
+  id_to_iter_[id] = ids_.begin();
+}
+
+void ARCCacheEvictionPolicy::GhostList::Remove(int id) {
+  auto iter = id_to_iter_.find(id);
+  if (iter == id_to_iter_.end()) {
+    return;
+  }
+  (void)ids_.erase(iter->second);
+  (void)id_to_iter_.erase(iter);
+}
+
+void ARCCacheEvictionPolicy::GhostList::PopBack() {
+  if (ids_.empty()) {
+    return;
+  }
+  (void)id_to_iter_.erase(ids_.back());
+  ids_.pop_back();
+}
+
+void ARCCacheEvictionPolicy::Insert(int id, int index) {
+  // A hit on the ghost list means the list is too small, enlarge its target size.
+  if (recent_ghost_list_.Contains(id)) {
+    size_t delta = std::max(frequent_ghost_list_.size() / recent_ghost_list_.size(), static_cast<size_t>(1));
+    recent_target_size_ = std::min(recent_target_size_ + delta, capacity_);
+    recent_ghost_list_.Remove(id);
+    frequent_list_.PushFront(index);
+    return;
+  }
+  if (frequent_ghost_list_.Contains(id)) {
+    size_t delta = std::max(recent_ghost_list_.size() / frequent_ghost_list_.size(), static_cast<size_t>(1));
+    recent_target_size_ = recent_target_size_ > delta ? recent_target_size_ - delta : 0;
+    frequent_ghost_list_.Remove(id);
+    frequent_list_.PushFront(index);
+    return;
+  }
+  recent_list_.PushFront(index);
+}
+
+void ARCCacheEvictionPolicy::Access(int index) {
+  recent_list_.Remove(index);
+  frequent_list_.PushFront(index);
+}
+
+void ARCCacheEvictionPolicy::Evict(int id, int index) {
+  if (recent_list_.Contains(index)) {
+    recent_list_.Remove(index);
+    recent_ghost_list_.PushFront(id);
+  } else {
+    frequent_list_.Remove(index);
+    frequent_ghost_list_.PushFront(id);
+  }
+  // Keep the size of the recent list and its ghost list within the capacity, and the size of all lists within twice the
+  // capacity.
+  while (recent_ghost_list_.size() != 0 && recent_list_.size() + recent_ghost_list_.size() > capacity_) {
+    recent_ghost_list_.PopBack();
+  }
+  auto total_size = [this]() {
+    return recent_list_.size() + frequent_list_.size() + recent_ghost_list_.size() + frequent_ghost_list_.size();
+  };
+  while (frequent_ghost_list_.size() != 0 && total_size() > capacity_ * 2) {
+    frequent_ghost_list_.PopBack();
+  }
+}
+
+int ARCCacheEvictionPolicy::SelectVictim(int id, const std::function<bool(int)> &can_evict) const {
+  bool evict_recent =
+    !recent_list_.empty() && (recent_list_.size() > recent_target_size_ ||
+                              (frequent_ghost_list_.Contains(id) && recent_list_.size() == recent_target_size_));
+  const auto &first_list = evict_recent ? recent_list_ : frequent_list_;
+  const auto &second_list = evict_recent ? frequent_list_ : recent_list_;
+  auto index = SelectFromBack(first_list, can_evict);
+  if (index != INVALID_INDEX_VALUE) {
+    return index;
+  }
+  return SelectFromBack(second_list, can_evict);
+}
+
+CacheEvictionPolicyPtr CreateCacheEvictionPolicy(CacheEvictionPolicyType type, size_t capacity) {
+  switch (type) {
+    case CacheEvictionPolicyType::kLRU:
+      return std::make_unique<LRUCacheEvictionPolicy>(capacity);
+    case CacheEvictionPolicyType::kLFU:
+      return std::make_unique<LFUCacheEvictionPolicy>(capacity);
+    case CacheEvictionPolicyType::kARC:
+      return std::make_unique<ARCCacheEvictionPolicy>(capacity);
+    default:
+      return nullptr;
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
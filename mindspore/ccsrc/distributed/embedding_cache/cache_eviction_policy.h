@@ -0,0 +1,178 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_EVICTION_POLICY_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_EVICTION_POLICY_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace distributed {
+// The environment variable to choose the eviction policy of embedding cache, the value is one of 'clock', 'lru', 'lfu'
+// and 'arc', and the default policy is 'clock'.
+constexpr char kEnvEmbeddingCacheEvictionPolicy[] = "MS_DEV_EMBEDDING_CACHE_EVICTION_POLICY";
+
+enum class CacheEvictionPolicyType {
+  // Scan the cache indices circularly and evict the index whose step is expired, which is the origin policy.
+  kClock = 0,
+  kLRU,
+  kLFU,
+  kARC
+};
+
+// Get the eviction policy type by name, return kClock for the unknown name.
+CacheEvictionPolicyType GetCacheEvictionPolicyType(const std::string &name);
+std::string GetCacheEvictionPolicyName(CacheEvictionPolicyType type);
+
+// The doubly linked list of the cache indices, the links are stored in the arrays indexed by cache index, so the
+// insertion and removal need no memory allocation.
+class IndexLinkedList {
+ public:
+  explicit IndexLinkedList(size_t capacity);
+  ~IndexLinkedList() = default;
+
+  void PushFront(int index);
+  void Remove(int index);
+  bool Contains(int index) const { return in_list_[index]; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Iterate from the back (the least recently pushed) to the front, return INVALID_INDEX_VALUE at the end.
+  int Back() const { return tail_; }
+  int Prev(int index) const { return prev_[index]; }
+
+ private:
+  std::vector<int> prev_;
+  std::vector<int> next_;
+  std::vector<bool> in_list_;
+  int head_;
+  int tail_;
+  size_t size_{0};
+};
+
+// The eviction policy records the usage of the cache indices, and selects the victim index when there is no free index
+// in the cache. Whether an index can be evicted is still decided by the step of the element, so the embedding used by
+// the pending data steps is never swapped out. The hit and swap information is reported by EmbeddingHashMap, which is
+// accessed by a single thread.
+class CacheEvictionPolicy {
+ public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  // The new id is inserted into the cache index.
+  virtual void Insert(int id, int index) = 0;
+  // The id on the cache index is hit by a new data step.
+  virtual void Access(int index) = 0;
+  // The id on the cache index is swapped out.
+  virtual void Evict(int id, int index) = 0;
+  // Select the index to insert the new id from the indices which can be evicted, return INVALID_INDEX_VALUE if there is
+  // no such index.
+  virtual int SelectVictim(int id, const std::function<bool(int)> &can_evict) const = 0;
+};
+using CacheEvictionPolicyPtr = std::unique_ptr<CacheEvictionPolicy>;
+
+// Evict the least recently used index.
+class LRUCacheEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  explicit LRUCacheEvictionPolicy(size_t capacity) : lru_list_(capacity) {}
+  ~LRUCacheEvictionPolicy() override = default;
+
+  void Insert(int id, int index) override;
+  void Access(int index) override;
+  void Evict(int id, int index) override;
+  int SelectVictim(int id, const std::function<bool(int)> &can_evict) const override;
+
+ private:
+  IndexLinkedList lru_list_;
+};
+
+// Evict the least frequently used index, and the least recently used one if the frequencies are equal. The frequency
+// is the number of data steps which use the id.
+class LFUCacheEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  explicit LFUCacheEvictionPolicy(size_t capacity) : frequency_(capacity, 0), tick_(capacity, 0) {}
+  ~LFUCacheEvictionPolicy() override = default;
+
+  void Insert(int id, int index) override;
+  void Access(int index) override;
+  void Evict(int id, int index) override;
+  int SelectVictim(int id, const std::function<bool(int)> &can_evict) const override;
+
+ private:
+  struct LFUNode {
+    size_t frequency_;
+    size_t tick_;
+    int index_;
+    bool operator<(const LFUNode &other) const {
+      return frequency_ != other.frequency_ ? frequency_ < other.frequency_
+                                            : (tick_ != other.tick_ ? tick_ < other.tick_ : index_ < other.index_);
+    }
+  };
+
+  // The indices ordered by frequency and access time.
+  std::set<LFUNode> lfu_nodes_;
+  std::vector<size_t> frequency_;
+  std::vector<size_t> tick_;
+  size_t current_tick_{0};
+};
+
+// Adaptive replacement cache: the indices used once recently and the indices used at least twice recently are kept in
+// two LRU lists, and the ids evicted from them are remembered in two ghost lists. A hit on the ghost list adjusts the
+// target size of the first list, so the policy adapts between recency and frequency.
+class ARCCacheEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  explicit ARCCacheEvictionPolicy(size_t capacity)
+      : capacity_(capacity), recent_list_(capacity), frequent_list_(capacity) {}
+  ~ARCCacheEvictionPolicy() override = default;
+
+  void Insert(int id, int index) override;
+  void Access(int index) override;
+  void Evict(int id, int index) override;
+  int SelectVictim(int id, const std::function<bool(int)> &can_evict) const override;
+
+  size_t recent_target_size() const { return recent_target_size_; }
+
+ private:
+  // The ghost list of the evicted ids, the front is the latest evicted one.
+  struct GhostList {
+    std::list<int> ids_;
+    mindspore::HashMap<int, std::list<int>::iterator> id_to_iter_;
+
+    bool Contains(int id) const { return id_to_iter_.count(id) != 0; }
+    size_t size() const { return ids_.size(); }
+    void PushFront(int id);
+    void Remove(int id);
+    void PopBack();
+  };
+
+  size_t capacity_;
+  // The target size of recent_list_.
+  size_t recent_target_size_{0};
+  IndexLinkedList recent_list_;
+  IndexLinkedList frequent_list_;
+  GhostList recent_ghost_list_;
+  GhostList frequent_ghost_list_;
+};
+
+CacheEvictionPolicyPtr CreateCacheEvictionPolicy(CacheEvictionPolicyType type, size_t capacity);
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_EVICTION_POLICY_H_
@@ -30,7 +30,11 @@ EmbeddingCacheTableManager &EmbeddingCacheTableManager::GetInstance() {
   return instance;
 }
 
-void EmbeddingCacheTableManager::Initialize() { GetEmbeddingTableSliceBound(); }
+void EmbeddingCacheTableManager::Initialize() {
+  GetEmbeddingTableSliceBound();
+  eviction_policy_type_ = GetCacheEvictionPolicyType(common::GetEnv(kEnvEmbeddingCacheEvictionPolicy));
+  MS_LOG(INFO) << "The eviction policy of embedding cache: " << GetCacheEvictionPolicyName(eviction_policy_type_);
+}
 
 void EmbeddingCacheTableManager::Finalize() {
   hash_tables_.clear();
@@ -135,9 +139,10 @@ void EmbeddingCacheTableManager::AllocMemForEmbeddingCacheTable(const device::De
     max_embedding_size = (embedding_size > max_embedding_size) ? embedding_size : max_embedding_size;
   }
 
-  embedding_device_cache_ = std::make_shared<EmbeddingDeviceCache>(batch_ids_num_, device_cache_size_);
+  embedding_device_cache_ =
+    std::make_shared<EmbeddingDeviceCache>(batch_ids_num_, device_cache_size_, eviction_policy_type_);
   MS_EXCEPTION_IF_NULL(embedding_device_cache_);
-  embedding_host_cache_ = std::make_shared<EmbeddingHostCache>(batch_ids_num_, host_cache_size_);
+  embedding_host_cache_ = std::make_shared<EmbeddingHostCache>(batch_ids_num_, host_cache_size_, eviction_policy_type_);
   MS_EXCEPTION_IF_NULL(embedding_host_cache_);
 
   embedding_device_cache_->hash_swap_index_addr_ =
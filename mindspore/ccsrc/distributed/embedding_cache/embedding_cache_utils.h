@@ -58,13 +58,14 @@ struct HashTableInfo {
 // all embedding cache tables on the device side is same: hash mapping, and feature ids of feature vectors that need
 // to be swapped with the local host cache.
 struct EmbeddingDeviceCache {
-  EmbeddingDeviceCache(size_t batch_ids_num, size_t cache_vocab_size)
+  EmbeddingDeviceCache(size_t batch_ids_num, size_t cache_vocab_size,
+                       CacheEvictionPolicyType eviction_policy_type = CacheEvictionPolicyType::kClock)
       : hash_swap_index_addr_(nullptr), hash_swap_value_addr_(nullptr) {
     device_to_host_index = std::make_unique<int[]>(batch_ids_num);
     device_to_host_ids = std::make_unique<int[]>(batch_ids_num);
     host_to_device_index = std::make_unique<int[]>(batch_ids_num);
     host_to_device_ids = std::make_unique<int[]>(batch_ids_num);
-    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size);
+    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size, eviction_policy_type);
   }
 
   std::unique_ptr<int[]> device_to_host_index;
@@ -81,14 +82,15 @@ struct EmbeddingDeviceCache {
 // all embedding cache tables on the local host side is same: hash mapping, and feature ids of feature vectors that need
 // to be swapped with the remote cache and device cache.
 struct EmbeddingHostCache {
-  EmbeddingHostCache(size_t batch_ids_num, size_t host_cache_vocab_size) {
+  EmbeddingHostCache(size_t batch_ids_num, size_t host_cache_vocab_size,
+                     CacheEvictionPolicyType eviction_policy_type = CacheEvictionPolicyType::kClock) {
     host_to_server_index = std::make_unique<int[]>(batch_ids_num);
     host_to_server_ids = std::make_unique<int[]>(batch_ids_num);
     server_to_host_index = std::make_unique<int[]>(batch_ids_num);
     server_to_host_ids = std::make_unique<int[]>(batch_ids_num);
     host_to_device_index = std::make_unique<int[]>(batch_ids_num);
     device_to_host_index = std::make_unique<int[]>(batch_ids_num);
-    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size);
+    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size, eviction_policy_type);
   }
 
   std::unique_ptr<int[]> host_to_server_index;
@@ -111,6 +113,36 @@ struct EmbeddingCacheStatisticsInfo {
   size_t mem_cache_swap_out_size_{0};
   size_t mem_cache_swap_in_size_{0};
   size_t mem_cache_hit_count_{0};
+
+  // The cost time(us) of each stage of cache prefetching.
+  // Wait for the free swap buffer, which means the cache updating falls behind the ids parsing.
+  size_t wait_swap_buffer_cost_{0};
+  size_t parse_ids_cost_{0};
+  // Wait for the graph to finish the running step when the cache is full, which is included in parse_ids_cost_.
+  size_t wait_graph_cost_{0};
+  size_t host_to_server_cost_{0};
+  size_t device_to_host_cost_{0};
+  size_t server_to_host_cost_{0};
+  size_t host_to_device_cost_{0};
+};
+
+// The statistics accumulated over all steps, which are used to compare the eviction policies by the traffic between
+// the caches.
+struct EmbeddingCacheAccumulatedStatisticsInfo {
+  size_t step_count_{0};
+  size_t device_hit_count_{0};
+  size_t device_miss_count_{0};
+  size_t host_to_device_size_{0};
+  size_t device_to_host_size_{0};
+  size_t server_to_host_size_{0};
+  size_t host_to_server_size_{0};
+  size_t wait_swap_buffer_cost_{0};
+  size_t parse_ids_cost_{0};
+  size_t wait_graph_cost_{0};
+  size_t host_to_server_cost_{0};
+  size_t device_to_host_cost_{0};
+  size_t server_to_host_cost_{0};
+  size_t host_to_device_cost_{0};
 };
 
 // The EmbeddingCacheTableManager class is used to save all Parameter information for enabling cache, such as device
@@ -152,6 +184,9 @@ class BACKEND_EXPORT EmbeddingCacheTableManager {
   // Set ids number of a batchsize.
   void set_batch_ids_num(size_t batch_ids_num) { batch_ids_num_ = batch_ids_num; }
 
+  // Get the eviction policy of device cache and local host cache.
+  CacheEvictionPolicyType eviction_policy_type() const { return eviction_policy_type_; }
+
   //  Get the offset of the id range corresponding to the embedding cache table slice on each worker in a multi-worker
   //  automatic parallel scenario.
   int cache_indices_lower_bound() const;
@@ -194,6 +229,9 @@ class BACKEND_EXPORT EmbeddingCacheTableManager {
   size_t host_cache_size_{0};
   // Total ids number of a batchsize.
   size_t batch_ids_num_{0};
+  // The eviction policy of device cache and local host cache, which is set by the environment variable
+  // 'MS_DEV_EMBEDDING_CACHE_EVICTION_POLICY'.
+  CacheEvictionPolicyType eviction_policy_type_{CacheEvictionPolicyType::kClock};
 
   friend class mindspore::runtime::EmbeddingCachePrefetchActor;
 };
@@ -25,7 +25,9 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
   MS_EXCEPTION_IF_NULL(swap_out_ids);
   MS_EXCEPTION_IF_NULL(swap_out_size);
   bool need_swap = false;
-  auto hash_index = FindInsertionPos(data_step, graph_running_step, &need_swap, need_wait_graph);
+  auto hash_index = eviction_policy_ == nullptr
+                      ? FindInsertionPos(data_step, graph_running_step, &need_swap, need_wait_graph)
+                      : FindInsertionPosByPolicy(id, graph_running_step, &need_swap, need_wait_graph);
   if (hash_index == INVALID_INDEX_VALUE) {
     return hash_index;
   }
@@ -34,17 +36,25 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
     hash_count_++;
     (void)hash_id_to_index_.emplace(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
-    hash_map_elements_[hash_index].set_step(data_step);
+    UpdateStep(hash_index, data_step);
+    if (eviction_policy_ != nullptr) {
+      eviction_policy_->Insert(id, hash_index);
+    }
     return hash_index;
   }
 
+  if (eviction_policy_ != nullptr) {
+    eviction_policy_->Evict(hash_map_elements_[hash_index].id_, hash_index);
+    eviction_policy_->Insert(id, hash_index);
+  }
+
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
   (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
   (void)hash_id_to_index_.emplace(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
-  hash_map_elements_[hash_index].set_step(data_step);
+  UpdateStep(hash_index, data_step);
   return hash_index;
 }
 
@@ -81,6 +91,59 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
   return INVALID_INDEX_VALUE;
 }
 
+int EmbeddingHashMap::FindInsertionPosByPolicy(const int id, const size_t graph_running_step, bool *const need_swap,
+                                               bool *const need_wait_graph) {
+  MS_EXCEPTION_IF_NULL(need_swap);
+  MS_EXCEPTION_IF_NULL(need_wait_graph);
+  MS_EXCEPTION_IF_NULL(eviction_policy_);
+  if (!free_index_.empty()) {
+    auto hash_index = free_index_.back();
+    free_index_.pop_back();
+    return hash_index;
+  }
+
+  // Evict the index whose step is expired first, then the index used by the running graph step. The policy is only
+  // asked when such index exists, so it skips no more than the indices used by the running and pending data steps.
+  if (!step_index_num_.empty() && step_index_num_.begin()->first < graph_running_step) {
+    auto hash_index = eviction_policy_->SelectVictim(id, [this, graph_running_step](int index) {
+      return hash_map_elements_[IntToSize(index)].IsExpired(graph_running_step);
+    });
+    if (hash_index != INVALID_INDEX_VALUE) {
+      *need_swap = true;
+      return hash_index;
+    }
+  }
+  if (step_index_num_.count(graph_running_step) != 0) {
+    auto hash_index = eviction_policy_->SelectVictim(id, [this, graph_running_step](int index) {
+      return hash_map_elements_[IntToSize(index)].StepEqual(graph_running_step);
+    });
+    if (hash_index != INVALID_INDEX_VALUE) {
+      *need_swap = true;
+      *need_wait_graph = true;
+      return hash_index;
+    }
+  }
+  MS_LOG(INFO) << "Running step:" << graph_running_step
+               << " will be used, index swap will wait until the graph completed.";
+  return INVALID_INDEX_VALUE;
+}
+
+void EmbeddingHashMap::UpdateStep(const int hash_index, const size_t step) {
+  auto &element = hash_map_elements_[IntToSize(hash_index)];
+  if (eviction_policy_ != nullptr && element.step_ != step) {
+    if (!element.IsEmpty()) {
+      auto iter = step_index_num_.find(element.step_);
+      if (iter != step_index_num_.end() && --iter->second == 0) {
+        (void)step_index_num_.erase(iter);
+      }
+    }
+    if (step != INVALID_STEP_VALUE) {
+      ++step_index_num_[step];
+    }
+  }
+  element.set_step(step);
+}
+
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
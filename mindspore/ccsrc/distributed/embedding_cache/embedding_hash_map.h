@@ -19,10 +19,12 @@
 
 #include <cmath>
 #include <utility>
+#include <map>
 #include <memory>
 #include <vector>
 #include "utils/hash_map.h"
 #include "utils/convert_utils_base.h"
+#include "distributed/embedding_cache/cache_eviction_policy.h"
 
 namespace mindspore {
 namespace distributed {
@@ -44,10 +46,12 @@ struct HashMapElement {
 };
 
 // EmbeddingHashMap is used to manage the id -> index mapping of the embedding cache table on the host
-// side. The cache content can be stored on the device or host side.
+// side. The cache content can be stored on the device or host side. The victim index is selected by the clock scan of
+// steps by default, or by the eviction policy such as LRU, LFU and ARC.
 class EmbeddingHashMap {
  public:
-  EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
+  EmbeddingHashMap(size_t hash_count, size_t hash_capacity,
+                   CacheEvictionPolicyType eviction_policy_type = CacheEvictionPolicyType::kClock)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
         current_pos_(0),
@@ -62,6 +66,15 @@ class EmbeddingHashMap {
     hash_map_elements_.front().set_step(SIZE_MAX);
     hash_map_elements_.back().set_step(SIZE_MAX);
     graph_running_index_ = std::make_unique<int[]>(hash_capacity);
+    eviction_policy_ = CreateCacheEvictionPolicy(eviction_policy_type, hash_capacity);
+    if (eviction_policy_ != nullptr) {
+      // The free indices are popped from the back, so the small indices are used first like the clock scan.
+      for (size_t i = hash_capacity - 1; i > 0; --i) {
+        if (hash_map_elements_[i].IsEmpty()) {
+          free_index_.push_back(SizeToInt(i));
+        }
+      }
+    }
   }
 
   ~EmbeddingHashMap() = default;
@@ -74,8 +87,13 @@ class EmbeddingHashMap {
   // Get the global step of a element in hash map.
   size_t hash_step(const int hash_index) const { return hash_map_elements_[IntToSize(hash_index)].step_; }
   // Set the global step of a element in hash map.
-  void set_hash_step(const int hash_index, const size_t step) {
-    hash_map_elements_[IntToSize(hash_index)].set_step(step);
+  void set_hash_step(const int hash_index, const size_t step) { UpdateStep(hash_index, step); }
+
+  // Record the hit of the index by a new data step for the eviction policy, this method is not thread safe.
+  void AccessIndex(const int hash_index) {
+    if (eviction_policy_ != nullptr) {
+      eviction_policy_->Access(hash_index);
+    }
   }
 
   // Get the id -> index mapping.
@@ -93,6 +111,11 @@ class EmbeddingHashMap {
   // Find the insertion position (index) in the hash map for an id.
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  // Find the insertion position (index) in the hash map for an id by the eviction policy.
+  int FindInsertionPosByPolicy(const int id, const size_t graph_running_step, bool *const need_swap,
+                               bool *const need_wait_graph);
+  // Set the step of the element, and count the indices of each step for the eviction policy.
+  void UpdateStep(const int hash_index, const size_t step);
 
   // Statistics on the usage of hash map capacity.
   size_t hash_count_;
@@ -123,6 +146,14 @@ class EmbeddingHashMap {
 
   // The flag indicates hash map is full.
   bool expired_element_full_;
+
+  // The eviction policy, the clock scan is used if it is null.
+  CacheEvictionPolicyPtr eviction_policy_{nullptr};
+  // The indices which have never been used, only used with the eviction policy.
+  std::vector<int> free_index_;
+  // The number of the indices of each step, only used with the eviction policy. It tells whether there is any index
+  // which can be evicted before asking the eviction policy to select one.
+  std::map<size_t, size_t> step_index_num_;
 };
 }  // namespace distributed
 }  // namespace mindspore
@@ -25,6 +25,9 @@
 #include <utility>
 
 #include "distributed/persistent/storage/local_file.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include "distributed/persistent/storage/mmap_file.h"
+#endif
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -74,6 +77,9 @@ class PersistentData : public Data<T> {
   // Custom storage config, you can choose different configurations according to different storage forms,
   // such as using file storage by configuring the file storage path,
   // and config can be like this: std::map<std::string, std::string> config = {{kFileStoragePath, "real_path_of_dir"}};
+  // The memory mapped file storage, which persists the dirty rows incrementally, can be chosen by configuring
+  // {kStorageType, kMmapStorageType}. The block files can be compressed by configuring
+  // {kCompressType, kLZCompressType}, and written with O_DIRECT by configuring {kDirectIO, "true"}.
   void Initialize(const std::map<std::string, std::string> &storage_config);
 
   // In disaster recovery mode, memory of tensor need to be saved into disk file periodically.
@@ -93,6 +99,13 @@ class PersistentData : public Data<T> {
 
 template <typename T>
 void PersistentData<T>::Initialize(const std::map<std::string, std::string> &storage_config) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto storage_type_iter = storage_config.find(storage::kStorageType);
+  if (storage_type_iter != storage_config.end() && storage_type_iter->second == storage::kMmapStorageType) {
+    storage_ = std::make_shared<storage::MmapFile>(storage_config);
+    return;
+  }
+#endif
   storage_ = std::make_shared<storage::LocalFile>(storage_config);
 }
 
@@ -29,15 +29,34 @@ constexpr char kShardShape[] = "shard_shape";
 constexpr char kShardRangeLowerBound[] = "shard_range_lower_bound";
 constexpr char kShardRangeUpperBound[] = "shard_range_upper_bound";
 constexpr char kHashSeq[] = "hash_seq";
+constexpr char kCompressedLengths[] = "compressed_lengths";
 
 constexpr char kBlockFilePrefix[] = "block_";
 constexpr char kBlockMetaFilePrefix[] = "block_meta_";
 constexpr char kJsonSuffix[] = ".json";
 constexpr size_t JSON_SUFFIX_LENS = 5;
 
+// Memory mapped file related.
+constexpr char kMmapDataFileName[] = "mmap_data";
+constexpr char kMmapMetaFileName[] = "mmap_data_meta.json";
+constexpr char kChangeLogFileName[] = "change_log";
+constexpr char kRowNum[] = "row_num";
+constexpr char kRowLength[] = "row_length";
+constexpr char kInputNum[] = "input_num";
+
 // Storage config related.
 constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
+// The storage type is one of 'block'(default) and 'mmap'.
+constexpr char kStorageType[] = "storage_type";
+constexpr char kMmapStorageType[] = "mmap";
+constexpr char kCompactionThreshold[] = "compaction_threshold";
+// The compress type of block files is one of 'none'(default) and 'lz'.
+constexpr char kCompressType[] = "compress_type";
+constexpr char kNoneCompressType[] = "none";
+constexpr char kLZCompressType[] = "lz";
+// Write block files with O_DIRECT if the value is 'true'.
+constexpr char kDirectIO[] = "direct_io";
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
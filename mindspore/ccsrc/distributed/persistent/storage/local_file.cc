@@ -17,8 +17,17 @@
 #include "distributed/persistent/storage/local_file.h"
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <numeric>
 #include <tuple>
 #include <utility>
@@ -27,11 +36,108 @@
 #include "utils/file_utils.h"
 #include "utils/log_adapter.h"
 #include "include/common/utils/utils.h"
+#include "include/common/thread_pool.h"
 #include "distributed/persistent/storage/constants.h"
+#include "distributed/persistent/storage/lz_codec.h"
 
 namespace mindspore {
 namespace distributed {
 namespace storage {
+namespace {
+// The alignment of buffer address, file offset and length for O_DIRECT.
+constexpr size_t kDirectIOAlignment = 4096;
+
+// Run the task of every block in the thread pool, every thread handles the blocks in a round robin way.
+bool RunBlockTasksInParallel(const std::vector<size_t> &block_indices, const std::function<bool(size_t)> &block_task) {
+  size_t thread_num = std::min(block_indices.size(), common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  if (thread_num <= 1) {
+    return std::all_of(block_indices.begin(), block_indices.end(), block_task);
+  }
+
+  // The exception can not be thrown in the thread pool, so the failure is recorded and handled by the caller.
+  std::atomic<bool> success{true};
+  std::vector<common::Task> tasks;
+  tasks.reserve(thread_num);
+  for (size_t thread_index = 0; thread_index < thread_num; ++thread_index) {
+    (void)tasks.emplace_back([&, thread_index]() {
+      for (size_t i = thread_index; i < block_indices.size() && success.load(); i += thread_num) {
+        try {
+          if (!block_task(block_indices[i])) {
+            success = false;
+          }
+        } catch (const std::exception &e) {
+          MS_LOG(ERROR) << "Run the task of block " << block_indices[i] << " failed: " << e.what();
+          success = false;
+        }
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  return success.load();
+}
+
+// Write the inputs to file with O_DIRECT, the data is copied to an aligned buffer whose length is padded to the
+// alignment, and the file is truncated to the real length after writing. Fall back to the buffered writing if the file
+// system does not support O_DIRECT.
+bool WriteFileWithDirectIO(const std::string &file_name, const std::vector<std::pair<const void *, size_t>> &inputs) {
+#ifdef O_DIRECT
+  size_t total_size = 0;
+  for (const auto &item : inputs) {
+    total_size += item.second;
+  }
+  size_t aligned_size = (total_size + kDirectIOAlignment - 1) / kDirectIOAlignment * kDirectIOAlignment;
+
+  int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, S_IRUSR | S_IWUSR);
+  if (fd < 0 && errno == EINVAL) {
+    MS_LOG(WARNING) << "The file system does not support O_DIRECT, write file with buffered io, file name: "
+                    << file_name;
+    return FileIOUtils::Write(file_name, inputs);
+  }
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file failed, file name: " << file_name << ", errno: " << errno;
+    return false;
+  }
+
+  void *buffer = nullptr;
+  if (aligned_size != 0 && posix_memalign(&buffer, kDirectIOAlignment, aligned_size) != 0) {
+    MS_LOG(ERROR) << "Allocate aligned buffer failed, size: " << aligned_size;
+    (void)close(fd);
+    return false;
+  }
+  std::unique_ptr<void, decltype(&free)> buffer_holder(buffer, &free);
+  char *dst = reinterpret_cast<char *>(buffer);
+  for (const auto &item : inputs) {
+    MS_ERROR_IF_NULL(item.first);
+    (void)std::memcpy(dst, item.first, item.second);
+    dst += item.second;
+  }
+  if (aligned_size != total_size) {
+    (void)std::memset(dst, 0, aligned_size - total_size);
+  }
+
+  size_t written = 0;
+  while (written < aligned_size) {
+    auto ret = write(fd, reinterpret_cast<char *>(buffer) + written, aligned_size - written);
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Write file failed, file name: " << file_name << ", errno: " << errno;
+      (void)close(fd);
+      return false;
+    }
+    written += static_cast<size_t>(ret);
+  }
+  if (ftruncate(fd, static_cast<off_t>(total_size)) != 0) {
+    MS_LOG(ERROR) << "Truncate file failed, file name: " << file_name << ", errno: " << errno;
+    (void)close(fd);
+    return false;
+  }
+  return close(fd) == 0;
+#else
+  return FileIOUtils::Write(file_name, inputs);
+#endif
+}
+}  // namespace
+
 void LocalFile::Write(const InputData &input, const DirtyInfo &dirty_info) {
   std::vector<InputData> inputs = {input};
   Write(inputs, dirty_info);
@@ -47,9 +153,14 @@ void LocalFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dir
     std::vector<int> block_indices;
     TransformDirtyInfoToBlockIndices(dirty_info, &block_indices);
 
-    for (const auto &block_index : block_indices) {
-      WriteOneBlockFile(IntToSize(block_index), inputs);
-    }
+    std::vector<size_t> dirty_block_indices;
+    dirty_block_indices.reserve(block_indices.size());
+    (void)std::transform(block_indices.begin(), block_indices.end(), std::back_inserter(dirty_block_indices),
+                         [](int block_index) { return IntToSize(block_index); });
+    // The same block file can not be written by different threads.
+    dirty_block_indices.erase(std::unique(dirty_block_indices.begin(), dirty_block_indices.end()),
+                              dirty_block_indices.end());
+    WriteBlockFilesInParallel(dirty_block_indices, inputs);
     return;
   }
 
@@ -141,6 +252,7 @@ void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
     size_t field_length = (cur_upper_bound - cur_lower_bound) * non_first_dims_size;
     block_meta_ptr->Insert(kFieldsLength, field_length);
     block_meta_ptr->Insert(kOffset, offset);
+    block_meta_ptr->Insert(kCompressType, compress_type_);
     offset += field_length;
     block_meta_list_.push_back(block_meta_ptr);
 
@@ -153,14 +265,22 @@ void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
   finish_create_block_files_ = true;
 
   // Write inputs_data to block files and Gen Sha256 seq.
-  for (size_t block_index = 0; block_index < block_num; ++block_index) {
-    WriteOneBlockFile(block_index, inputs);
+  std::vector<size_t> block_indices(block_num);
+  std::iota(block_indices.begin(), block_indices.end(), 0);
+  WriteBlockFilesInParallel(block_indices, inputs);
+}
+
+void LocalFile::WriteBlockFilesInParallel(const std::vector<size_t> &block_indices,
+                                          const std::vector<InputData> &inputs) const {
+  auto write_task = [this, &inputs](size_t block_index) { return WriteOneBlockFile(block_index, inputs); };
+  if (!RunBlockTasksInParallel(block_indices, write_task)) {
+    MS_LOG(EXCEPTION) << "Write block files failed, file path [" << file_path_ << "]";
   }
 }
 
-void LocalFile::WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const {
+bool LocalFile::WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const {
   const auto &block_meta_ptr = block_meta_list_.at(block_index);
-  MS_EXCEPTION_IF_NULL(block_meta_ptr);
+  MS_ERROR_IF_NULL(block_meta_ptr);
   size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
   size_t offset = block_meta_ptr->Get<size_t>(kOffset);
   std::vector<std::pair<const void *, size_t>> block_inputs_data;
@@ -171,17 +291,34 @@ void LocalFile::WriteOneBlockFile(size_t block_index, const std::vector<InputDat
     (void)block_inputs_data.emplace_back(data_ptr, data_size);
   }
 
+  // Compress the data of every input to a frame, and record the frame lengths to decompress them separately.
+  std::vector<char> compressed_data;
+  if (compress_type_ == kLZCompressType) {
+    std::vector<size_t> compressed_lengths;
+    for (const auto &item : block_inputs_data) {
+      size_t frame_start = compressed_data.size();
+      LZCodec::Compress(item.first, item.second, &compressed_data);
+      (void)compressed_lengths.emplace_back(compressed_data.size() - frame_start);
+    }
+    block_meta_ptr->Insert(kCompressedLengths, compressed_lengths);
+    block_inputs_data = {{compressed_data.data(), compressed_data.size()}};
+  }
+
   const auto &block_ptr = block_list_.at(block_index);
-  MS_EXCEPTION_IF_NULL(block_ptr);
+  MS_ERROR_IF_NULL(block_ptr);
   // Rewrite the current block file.
-  if (!FileIOUtils::Write(block_ptr->block_file_name(), block_inputs_data)) {
-    MS_LOG(EXCEPTION) << "Write to block file[" << block_ptr->block_file_name() << "] failed.";
+  bool ret = direct_io_ ? WriteFileWithDirectIO(block_ptr->block_file_name(), block_inputs_data)
+                        : FileIOUtils::Write(block_ptr->block_file_name(), block_inputs_data);
+  if (!ret) {
+    MS_LOG(ERROR) << "Write to block file[" << block_ptr->block_file_name() << "] failed.";
+    return false;
   }
 
   ChangeFileMode(block_ptr->block_file_name(), S_IRWXU | S_IRWXG | S_IRWXO);
 
   // Generate sha256 hash sequence.
   block_ptr->GenSha256Seq();
+  return true;
 }
 
 void LocalFile::Read(const OutputData &output) {
@@ -198,29 +335,67 @@ void LocalFile::Read(const std::vector<OutputData> &outputs) {
   }
 
   // Read all block files.
-  for (size_t block_index = 0; block_index < block_list_.size(); ++block_index) {
-    std::vector<std::pair<void *, size_t>> block_output_data;
-    const auto &block_meta_ptr = block_meta_list_[block_index];
-    MS_EXCEPTION_IF_NULL(block_meta_ptr);
-    size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
-    size_t offset = block_meta_ptr->Get<size_t>(kOffset);
-
-    for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
-      void *data_ptr = reinterpret_cast<char *>(std::get<0>(outputs[output_index])) + offset;
-      size_t data_size = field_size;
-      (void)block_output_data.emplace_back(data_ptr, data_size);
-    }
+  std::vector<size_t> block_indices(block_list_.size());
+  std::iota(block_indices.begin(), block_indices.end(), 0);
+  auto read_task = [this, &outputs](size_t block_index) { return ReadOneBlockFile(block_index, outputs); };
+  if (!RunBlockTasksInParallel(block_indices, read_task)) {
+    MS_LOG(EXCEPTION) << "Read block files failed, file path [" << file_path_ << "]";
+  }
+}
 
-    const auto &block_ptr = block_list_[block_index];
-    MS_EXCEPTION_IF_NULL(block_ptr);
-    if (!block_ptr->CheckSha256Seq()) {
-      MS_LOG(EXCEPTION) << "CheckSha256 failed, file name [" << block_ptr->block_file_name() << "]";
-    }
+bool LocalFile::ReadOneBlockFile(size_t block_index, const std::vector<OutputData> &outputs) const {
+  std::vector<std::pair<void *, size_t>> block_output_data;
+  const auto &block_meta_ptr = block_meta_list_.at(block_index);
+  MS_ERROR_IF_NULL(block_meta_ptr);
+  size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
+  size_t offset = block_meta_ptr->Get<size_t>(kOffset);
+
+  for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
+    void *data_ptr = reinterpret_cast<char *>(std::get<0>(outputs[output_index])) + offset;
+    size_t data_size = field_size;
+    (void)block_output_data.emplace_back(data_ptr, data_size);
+  }
 
+  const auto &block_ptr = block_list_.at(block_index);
+  MS_ERROR_IF_NULL(block_ptr);
+  if (!block_ptr->CheckSha256Seq()) {
+    MS_LOG(ERROR) << "CheckSha256 failed, file name [" << block_ptr->block_file_name() << "]";
+    return false;
+  }
+
+  // The block files written before supporting compression have no compress type.
+  bool compressed =
+    block_meta_ptr->Exists(kCompressType) && block_meta_ptr->Get<std::string>(kCompressType) == kLZCompressType;
+  if (!compressed) {
     if (!FileIOUtils::Read(block_ptr->block_file_name(), block_output_data)) {
-      MS_LOG(EXCEPTION) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
+      MS_LOG(ERROR) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
+      return false;
+    }
+    return true;
+  }
+
+  // Read all the frames and decompress them to the outputs directly.
+  auto compressed_lengths = block_meta_ptr->Get<std::vector<size_t>>(kCompressedLengths);
+  if (compressed_lengths.size() != block_output_data.size()) {
+    MS_LOG(ERROR) << "The frame number " << compressed_lengths.size() << " is not equal to the output number "
+                  << block_output_data.size() << ", file name [" << block_ptr->block_file_name() << "]";
+    return false;
+  }
+  std::vector<char> compressed_data(std::accumulate(compressed_lengths.begin(), compressed_lengths.end(), size_t(0)));
+  if (!FileIOUtils::Read(block_ptr->block_file_name(), {{compressed_data.data(), compressed_data.size()}})) {
+    MS_LOG(ERROR) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
+    return false;
+  }
+  size_t frame_offset = 0;
+  for (size_t i = 0; i < block_output_data.size(); ++i) {
+    if (!LZCodec::Decompress(compressed_data.data() + frame_offset, compressed_lengths[i], block_output_data[i].first,
+                             block_output_data[i].second)) {
+      MS_LOG(ERROR) << "Decompress block file failed, file name [" << block_ptr->block_file_name() << "]";
+      return false;
     }
+    frame_offset += compressed_lengths[i];
   }
+  return true;
 }
 
 bool LocalFile::LoadBlocksInfo() {
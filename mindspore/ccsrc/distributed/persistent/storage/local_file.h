@@ -48,13 +48,24 @@ class LocalFile : public StorageBase {
     } else {
       max_block_length_ = DEFAULT_MAX_BLOCK_LENGTH;
     }
+
+    auto compress_type_iter = storage_config.find(kCompressType);
+    if (compress_type_iter != storage_config.end() && !(compress_type_iter->second).empty()) {
+      compress_type_ = compress_type_iter->second;
+    }
+
+    auto direct_io_iter = storage_config.find(kDirectIO);
+    if (direct_io_iter != storage_config.end()) {
+      direct_io_ = (direct_io_iter->second == "true");
+    }
   }
 
   ~LocalFile() override = default;
 
   // The following two methods are override version function for Write:
   // 1. Create blocks and block metas.
-  // 2. Write input data to block files and Generate sha256 sequence for every block file.
+  // 2. Write input data to block files and Generate sha256 sequence for every block file, the blocks are written in
+  // parallel by the thread pool.
   // Write the entire blob data of tensor to the block files on disk:
   void Write(const InputData &input, const DirtyInfo &dirty_info) override;
   // Write the entire blob data composed of multiple tensors to the block files on disk:
@@ -62,7 +73,7 @@ class LocalFile : public StorageBase {
 
   // The following two methods are override version function for Read:
   // 1.Tamper proof check.
-  // 2.Read all block files and merge them into contiguous memory.
+  // 2.Read all block files in parallel and merge them into contiguous memory.
   // Read data from all block files in file_path_(dir):
   void Read(const OutputData &output) override;
   // Read data from all block files in file_path_(dir) for multiple tensors.
@@ -72,8 +83,15 @@ class LocalFile : public StorageBase {
   // Create blocks and block metas and write input data to block files.
   void WriteBlockFiles(const std::vector<InputData> &inputs);
 
-  // Write shardding data to one specific block file by block index and generate sha256.
-  void WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
+  // Write shardding data to one specific block file by block index and generate sha256, the data of every input is
+  // compressed to a frame if the compress type is 'lz'.
+  bool WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
+
+  // Write the block files by block indices in parallel, and throw exception if any block file fails to be written.
+  void WriteBlockFilesInParallel(const std::vector<size_t> &block_indices, const std::vector<InputData> &inputs) const;
+
+  // Check sha256 and read one specific block file by block index to the outputs.
+  bool ReadOneBlockFile(size_t block_index, const std::vector<OutputData> &outputs) const;
 
   // Obtain the corresponding file block index according to dirty info, only need to rewrite these file blocks, and
   // dirty info needs to be sorted in ascending order.
@@ -95,6 +113,12 @@ class LocalFile : public StorageBase {
   // Maximum size of each block file.
   size_t max_block_length_;
 
+  // The compress type of the new block files: 'none' or 'lz'.
+  std::string compress_type_{kNoneCompressType};
+
+  // Whether to write block files with O_DIRECT, which bypasses the page cache.
+  bool direct_io_{false};
+
   // Indicates whether block files has been created.
   bool finish_create_block_files_{false};
 };
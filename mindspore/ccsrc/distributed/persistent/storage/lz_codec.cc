@@ -0,0 +1,237 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+constexpr uint8_t kRawFrame = 0;
+constexpr uint8_t kLZFrame = 1;
+constexpr size_t kMinMatchLength = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kHashLog = 16;
+constexpr size_t kTokenLengthMask = 15;
+constexpr size_t kTokenLiteralShift = 4;
+constexpr size_t kExtendedLengthByte = 255;
+constexpr size_t kOffsetBytes = 2;
+constexpr size_t kByteBits = 8;
+
+inline uint32_t Read32(const uint8_t *ptr) {
+  uint32_t value;
+  (void)std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+inline size_t Hash(uint32_t sequence) {
+  constexpr uint32_t kPrime = 2654435761U;
+  return static_cast<size_t>((sequence * kPrime) >> (sizeof(uint32_t) * kByteBits - kHashLog));
+}
+
+// Write the part of length exceeding the token, every byte holds at most 255.
+inline uint8_t *WriteExtendedLength(size_t length, uint8_t *op) {
+  for (; length >= kExtendedLengthByte; length -= kExtendedLengthByte) {
+    *op++ = static_cast<uint8_t>(kExtendedLengthByte);
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+inline bool ReadExtendedLength(const uint8_t **ip, const uint8_t *end, size_t *length) {
+  uint8_t byte;
+  do {
+    if (*ip >= end) {
+      return false;
+    }
+    byte = *(*ip)++;
+    *length += byte;
+  } while (byte == kExtendedLengthByte);
+  return true;
+}
+
+uint8_t *WriteSequence(const uint8_t *literal, size_t literal_length, size_t offset, size_t match_length,
+                       uint8_t *op) {
+  uint8_t *token = op++;
+  size_t literal_token = literal_length < kTokenLengthMask ? literal_length : kTokenLengthMask;
+  size_t match_token = 0;
+  if (match_length != 0) {
+    match_token = match_length - kMinMatchLength;
+    match_token = match_token < kTokenLengthMask ? match_token : kTokenLengthMask;
+  }
+  *token = static_cast<uint8_t>((literal_token << kTokenLiteralShift) | match_token);
+  if (literal_token == kTokenLengthMask) {
+    op = WriteExtendedLength(literal_length - kTokenLengthMask, op);
+  }
+  (void)std::memcpy(op, literal, literal_length);
+  op += literal_length;
+  if (match_length == 0) {
+    return op;
+  }
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> kByteBits);
+  if (match_token == kTokenLengthMask) {
+    op = WriteExtendedLength(match_length - kMinMatchLength - kTokenLengthMask, op);
+  }
+  return op;
+}
+}  // namespace
+
+void LZCodec::Compress(const void *data, size_t size, std::vector<char> *output) {
+  if (size != 0) {
+    MS_EXCEPTION_IF_NULL(data);
+  }
+  MS_EXCEPTION_IF_NULL(output);
+  const uint8_t *src = reinterpret_cast<const uint8_t *>(data);
+  size_t frame_start = output->size();
+  // The worst case: all the data are literals.
+  size_t max_frame_size = 1 + 1 + size + size / kExtendedLengthByte + 1;
+  output->resize(frame_start + max_frame_size);
+  uint8_t *frame = reinterpret_cast<uint8_t *>(output->data()) + frame_start;
+  uint8_t *op = frame + 1;
+  // The positions in hash table are 32 bits, the larger data is stored raw.
+  if (size >= UINT32_MAX) {
+    op = frame + max_frame_size;
+  }
+
+  // The hash table saves the position plus one of the latest sequence, zero means empty.
+  auto hash_table = std::make_unique<uint32_t[]>(static_cast<size_t>(1) << kHashLog);
+  size_t anchor = 0;
+  size_t pos = 0;
+  while (op != frame + max_frame_size && pos + kMinMatchLength <= size) {
+    auto sequence = Read32(src + pos);
+    auto &entry = hash_table[Hash(sequence)];
+    size_t candidate = entry;
+    entry = static_cast<uint32_t>(pos + 1);
+    if (candidate == 0 || pos + 1 - candidate > kMaxOffset || Read32(src + candidate - 1) != sequence) {
+      ++pos;
+      continue;
+    }
+    --candidate;
+    size_t match_length = kMinMatchLength;
+    while (pos + match_length < size && src[candidate + match_length] == src[pos + match_length]) {
+      ++match_length;
+    }
+    op = WriteSequence(src + anchor, pos - anchor, pos - candidate, match_length, op);
+    pos += match_length;
+    anchor = pos;
+  }
+  if (op != frame + max_frame_size) {
+    op = WriteSequence(src + anchor, size - anchor, 0, 0, op);
+  }
+
+  size_t frame_size = static_cast<size_t>(op - frame);
+  if (frame_size >= size + 1) {
+    // Store the raw data if it can not be compressed.
+    frame[0] = kRawFrame;
+    if (size != 0) {
+      (void)std::memcpy(frame + 1, src, size);
+    }
+    output->resize(frame_start + 1 + size);
+    return;
+  }
+  frame[0] = kLZFrame;
+  output->resize(frame_start + frame_size);
+}
+
+bool LZCodec::Decompress(const void *frame, size_t frame_size, void *output, size_t output_size) {
+  MS_ERROR_IF_NULL(frame);
+  if (output_size != 0) {
+    MS_ERROR_IF_NULL(output);
+  }
+  if (frame_size == 0) {
+    MS_LOG(ERROR) << "The frame is empty.";
+    return false;
+  }
+  const uint8_t *ip = reinterpret_cast<const uint8_t *>(frame);
+  const uint8_t *ip_end = ip + frame_size;
+  uint8_t *dst = reinterpret_cast<uint8_t *>(output);
+  uint8_t *op = dst;
+  uint8_t *op_end = dst + output_size;
+  if (*ip++ == kRawFrame) {
+    if (frame_size - 1 != output_size) {
+      MS_LOG(ERROR) << "The raw frame size " << (frame_size - 1) << " is not equal to the output size " << output_size;
+      return false;
+    }
+    if (output_size != 0) {
+      (void)std::memcpy(dst, ip, output_size);
+    }
+    return true;
+  }
+
+  while (ip < ip_end) {
+    size_t token = *ip++;
+    size_t literal_length = token >> kTokenLiteralShift;
+    if (literal_length == kTokenLengthMask && !ReadExtendedLength(&ip, ip_end, &literal_length)) {
+      MS_LOG(ERROR) << "The frame is broken, can not read literal length.";
+      return false;
+    }
+    if (literal_length > static_cast<size_t>(ip_end - ip) || literal_length > static_cast<size_t>(op_end - op)) {
+      MS_LOG(ERROR) << "The frame is broken, the literal length " << literal_length << " is out of range.";
+      return false;
+    }
+    (void)std::memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    // The last sequence only contains the literals.
+    if (ip == ip_end) {
+      break;
+    }
+
+    if (static_cast<size_t>(ip_end - ip) < kOffsetBytes) {
+      MS_LOG(ERROR) << "The frame is broken, can not read match offset.";
+      return false;
+    }
+    size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << kByteBits);
+    ip += kOffsetBytes;
+    size_t match_length = token & kTokenLengthMask;
+    if (match_length == kTokenLengthMask && !ReadExtendedLength(&ip, ip_end, &match_length)) {
+      MS_LOG(ERROR) << "The frame is broken, can not read match length.";
+      return false;
+    }
+    match_length += kMinMatchLength;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst) || match_length > static_cast<size_t>(op_end - op)) {
+      MS_LOG(ERROR) << "The frame is broken, the match offset " << offset << " or length " << match_length
+                    << " is out of range.";
+      return false;
+    }
+    const uint8_t *match = op - offset;
+    if (offset >= match_length) {
+      (void)std::memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      // The overlapped match repeats the last offset bytes.
+      for (size_t i = 0; i < match_length; ++i) {
+        *op++ = match[i];
+      }
+    }
+  }
+
+  if (op != op_end) {
+    MS_LOG(ERROR) << "The decompressed size " << (op - dst) << " is not equal to the output size " << output_size;
+    return false;
+  }
+  return true;
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LZ_CODEC_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LZ_CODEC_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// A fast LZ77 codec in the style of LZ4, which is used to compress the block files. The block files are written and
+// reloaded on the critical path of saving and restoring the embedding tables, so the codec trades compression ratio for
+// speed as LZ4 does, and it is built in because no compression library is linked into the backend: zlib is only
+// fetched to build gRPC, and its deflate is several times slower.
+// Every compressed frame starts with a flag byte: the data is stored raw if it can not be compressed, otherwise it is a
+// sequence list. Every sequence consists of a token(4 bits literal length and 4 bits match length), the extended
+// literal length, the literals, the 2 bytes match offset and the extended match length, and the last sequence only
+// contains the literals.
+class LZCodec {
+ public:
+  // Compress the data and append the frame to the output.
+  static void Compress(const void *data, size_t size, std::vector<char> *output);
+
+  // Decompress the frame to the output buffer whose size should be equal to the origin data size.
+  static bool Decompress(const void *frame, size_t frame_size, void *output, size_t output_size);
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LZ_CODEC_H_
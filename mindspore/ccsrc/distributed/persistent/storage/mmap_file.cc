@@ -0,0 +1,422 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/mmap_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <tuple>
+
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
+#include "distributed/persistent/storage/file_io_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+// Every record of change log consists of the header and the row data of all the inputs.
+struct ChangeLogRecordHeader {
+  uint64_t row_;
+  uint64_t length_;
+  uint32_t crc_;
+  uint32_t reserved_;
+};
+
+uint32_t CalcRecordCrc(uint64_t row, const char *data, size_t length) {
+  auto crc = system::Crc32c::MakeCrc32c(0, reinterpret_cast<const char *>(&row), sizeof(row));
+  return system::Crc32c::MakeCrc32c(crc, data, length);
+}
+
+bool WriteAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    auto ret = write(fd, data, size);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Write file failed, errno: " << errno;
+      return false;
+    }
+    data += ret;
+    size -= LongToSize(ret);
+  }
+  return true;
+}
+
+bool ReadAll(int fd, size_t offset, char *data, size_t size) {
+  while (size > 0) {
+    auto ret = pread(fd, data, size, SizeToLong(offset));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Read file failed, errno: " << errno;
+      return false;
+    }
+    data += ret;
+    offset += LongToSize(ret);
+    size -= LongToSize(ret);
+  }
+  return true;
+}
+
+// The memcpy_s can copy SECUREC_MEM_MAX_LEN bytes at most, so the large buffer is copied piece by piece.
+bool CopyData(void *dst, const void *src, size_t size) {
+  for (size_t offset = 0; offset < size; offset += SECUREC_MEM_MAX_LEN) {
+    size_t copy_len = std::min(size - offset, static_cast<size_t>(SECUREC_MEM_MAX_LEN));
+    auto ret = memcpy_s(reinterpret_cast<char *>(dst) + offset, copy_len,
+                        reinterpret_cast<const char *>(src) + offset, copy_len);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errno[" << ret << "]";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+MmapFile::MmapFile(const std::map<std::string, std::string> &storage_config) {
+  auto file_path_iter = storage_config.find(kFileStoragePath);
+  if (file_path_iter != storage_config.end()) {
+    file_path_ = file_path_iter->second;
+  }
+  data_file_name_ = file_path_ + "/" + kMmapDataFileName;
+  change_log_file_name_ = file_path_ + "/" + kChangeLogFileName;
+
+  auto threshold_iter = storage_config.find(kCompactionThreshold);
+  if (threshold_iter != storage_config.end() && !(threshold_iter->second).empty()) {
+    compaction_threshold_ = std::stoul(threshold_iter->second);
+  } else {
+    compaction_threshold_ = DEFAULT_COMPACTION_THRESHOLD;
+  }
+}
+
+MmapFile::~MmapFile() { CloseFiles(); }
+
+void MmapFile::Write(const InputData &input, const DirtyInfo &dirty_info) {
+  std::vector<InputData> inputs = {input};
+  Write(inputs, dirty_info);
+}
+
+void MmapFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
+  if (inputs.empty()) {
+    MS_LOG(EXCEPTION) << "The inputs is empty";
+  }
+
+  // Create the data file and write all inputs at the first time.
+  if (data_addr_ == nullptr) {
+    if (!CreateDataFile(inputs)) {
+      MS_LOG(EXCEPTION) << "Create data file[" << data_file_name_ << "] failed.";
+    }
+    return;
+  }
+
+  size_t input_size = row_num_ * row_length_;
+  if (inputs.size() != input_num_) {
+    MS_LOG(EXCEPTION) << "The inputs number[" << inputs.size() << "] is not equal to the saved inputs number["
+                      << input_num_ << "]";
+  }
+  for (const auto &input : inputs) {
+    if (std::get<1>(input) == nullptr || std::get<2>(input) != input_size) {
+      MS_LOG(EXCEPTION) << "The input size[" << std::get<2>(input) << "] is not equal to the saved input size["
+                        << input_size << "] or the input is null.";
+    }
+  }
+  if (dirty_info.empty()) {
+    return;
+  }
+
+  // The dirty rows are recorded in the change log before written in place, so they can be recovered if the process
+  // exits before the mapped data file is synchronized to disk.
+  if (!AppendChangeLog(inputs, dirty_info)) {
+    MS_LOG(EXCEPTION) << "Append dirty rows to change log[" << change_log_file_name_ << "] failed.";
+  }
+  for (const auto &row : dirty_info) {
+    size_t row_offset = IntToSize(row) * row_length_;
+    for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
+      const char *src = reinterpret_cast<const char *>(std::get<1>(inputs[input_index])) + row_offset;
+      if (!CopyData(data_addr_ + input_index * input_size + row_offset, src, row_length_)) {
+        MS_LOG(EXCEPTION) << "Write row[" << row << "] to data file[" << data_file_name_ << "] failed.";
+      }
+    }
+  }
+
+  if (change_log_size_ >= compaction_threshold_ && !Compact()) {
+    MS_LOG(EXCEPTION) << "Compact data file[" << data_file_name_ << "] failed.";
+  }
+}
+
+void MmapFile::Read(const OutputData &output) {
+  std::vector<OutputData> outputs = {output};
+  Read(outputs);
+}
+
+void MmapFile::Read(const std::vector<OutputData> &outputs) {
+  if (data_addr_ == nullptr && !LoadDataFile()) {
+    MS_LOG(EXCEPTION) << "Load data file[" << data_file_name_ << "] failed.";
+  }
+
+  size_t input_size = row_num_ * row_length_;
+  if (outputs.size() > input_num_) {
+    MS_LOG(EXCEPTION) << "The outputs number[" << outputs.size() << "] exceeds the saved inputs number[" << input_num_
+                      << "]";
+  }
+  for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
+    void *data = outputs[output_index].first;
+    size_t size = outputs[output_index].second;
+    MS_EXCEPTION_IF_NULL(data);
+    if (size > input_size) {
+      MS_LOG(EXCEPTION) << "The output size[" << size << "] exceeds the saved input size[" << input_size << "]";
+    }
+    // Copy from the page cache of data file to the output directly, without the intermediate buffer of file stream.
+    if (!CopyData(data, data_addr_ + output_index * input_size, size)) {
+      MS_LOG(EXCEPTION) << "Read data file[" << data_file_name_ << "] failed.";
+    }
+  }
+}
+
+bool MmapFile::CreateDataFile(const std::vector<InputData> &inputs) {
+  const std::vector<int> &shape = std::get<0>(inputs.front());
+  size_t first_dim = 0;
+  if (shape.size() > 0) {
+    first_dim = IntToSize(shape[0]);
+  }
+  if (first_dim == 0) {
+    MS_LOG(ERROR) << "The dimension of input shape contain zero.";
+    return false;
+  }
+  size_t input_size = std::get<2>(inputs.front());
+  if (input_size == 0 || input_size % first_dim != 0) {
+    MS_LOG(ERROR) << "The input size[" << input_size << "] can not be divided by the first dimension[" << first_dim
+                  << "]";
+    return false;
+  }
+  for (const auto &input : inputs) {
+    if (std::get<1>(input) == nullptr || std::get<2>(input) != input_size) {
+      MS_LOG(ERROR) << "All inputs should have the same size and the input can not be null.";
+      return false;
+    }
+  }
+
+  CloseFiles();
+  if (!FileIOUtils::IsFileOrDirExist(file_path_)) {
+    FileIOUtils::CreateDirRecursive(file_path_);
+  }
+  input_num_ = inputs.size();
+  row_num_ = first_dim;
+  row_length_ = input_size / first_dim;
+  data_size_ = input_num_ * input_size;
+
+  data_fd_ = open(data_file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (data_fd_ < 0) {
+    MS_LOG(ERROR) << "Open file[" << data_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  if (ftruncate(data_fd_, SizeToLong(data_size_)) != 0) {
+    MS_LOG(ERROR) << "Resize file[" << data_file_name_ << "] to " << data_size_ << " bytes failed, errno: " << errno;
+    return false;
+  }
+  if (!MapDataFile()) {
+    return false;
+  }
+  for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
+    if (!CopyData(data_addr_ + input_index * input_size, std::get<1>(inputs[input_index]), input_size)) {
+      return false;
+    }
+  }
+  if (msync(data_addr_, data_size_, MS_SYNC) != 0) {
+    MS_LOG(ERROR) << "Synchronize file[" << data_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+
+  // The meta file is written after the data file is synchronized to disk.
+  meta_ = std::make_shared<BlockMeta>(file_path_ + "/" + kMmapMetaFileName);
+  if (!meta_->Initialize()) {
+    return false;
+  }
+  meta_->Insert(kInputNum, input_num_);
+  meta_->Insert(kRowNum, row_num_);
+  meta_->Insert(kRowLength, row_length_);
+
+  change_log_fd_ = open(change_log_file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+  if (change_log_fd_ < 0) {
+    MS_LOG(ERROR) << "Open file[" << change_log_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  change_log_size_ = 0;
+  return true;
+}
+
+bool MmapFile::LoadDataFile() {
+  std::string meta_file_name = file_path_ + "/" + kMmapMetaFileName;
+  if (!FileIOUtils::IsFileOrDirExist(data_file_name_) || !FileIOUtils::IsFileOrDirExist(meta_file_name)) {
+    MS_LOG(ERROR) << "The data file[" << data_file_name_ << "] or meta file[" << meta_file_name << "] is not exist";
+    return false;
+  }
+  meta_ = std::make_shared<BlockMeta>(meta_file_name);
+  if (!meta_->Initialize() || !meta_->Exists(kInputNum) || !meta_->Exists(kRowNum) || !meta_->Exists(kRowLength)) {
+    MS_LOG(ERROR) << "Load meta file[" << meta_file_name << "] failed.";
+    return false;
+  }
+  input_num_ = meta_->Get<size_t>(kInputNum);
+  row_num_ = meta_->Get<size_t>(kRowNum);
+  row_length_ = meta_->Get<size_t>(kRowLength);
+  data_size_ = input_num_ * row_num_ * row_length_;
+
+  data_fd_ = open(data_file_name_.c_str(), O_RDWR);
+  if (data_fd_ < 0) {
+    MS_LOG(ERROR) << "Open file[" << data_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(data_fd_, &file_stat) != 0 || LongToSize(file_stat.st_size) != data_size_) {
+    MS_LOG(ERROR) << "The size of data file[" << data_file_name_ << "] is not equal to " << data_size_ << " bytes.";
+    return false;
+  }
+  if (!MapDataFile()) {
+    return false;
+  }
+
+  change_log_fd_ = open(change_log_file_name_.c_str(), O_RDWR | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+  if (change_log_fd_ < 0) {
+    MS_LOG(ERROR) << "Open file[" << change_log_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  if (fstat(change_log_fd_, &file_stat) != 0) {
+    MS_LOG(ERROR) << "Get the size of file[" << change_log_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  change_log_size_ = LongToSize(file_stat.st_size);
+  return ReplayChangeLog() && Compact();
+}
+
+bool MmapFile::MapDataFile() {
+  void *addr = mmap(nullptr, data_size_, PROT_READ | PROT_WRITE, MAP_SHARED, data_fd_, 0);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map file[" << data_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  data_addr_ = reinterpret_cast<char *>(addr);
+  return true;
+}
+
+void MmapFile::CloseFiles() {
+  if (data_addr_ != nullptr) {
+    (void)munmap(data_addr_, data_size_);
+    data_addr_ = nullptr;
+  }
+  if (data_fd_ >= 0) {
+    (void)close(data_fd_);
+    data_fd_ = -1;
+  }
+  if (change_log_fd_ >= 0) {
+    (void)close(change_log_fd_);
+    change_log_fd_ = -1;
+  }
+}
+
+bool MmapFile::AppendChangeLog(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
+  size_t record_length = input_num_ * row_length_;
+  std::vector<char> buffer(dirty_info.size() * (sizeof(ChangeLogRecordHeader) + record_length));
+  char *record = buffer.data();
+  for (const auto &row : dirty_info) {
+    if (row < 0 || IntToSize(row) >= row_num_) {
+      MS_LOG(ERROR) << "The dirty row[" << row << "] is out of range[0, " << row_num_ << ")";
+      return false;
+    }
+    char *record_data = record + sizeof(ChangeLogRecordHeader);
+    size_t row_offset = IntToSize(row) * row_length_;
+    for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
+      const char *src = reinterpret_cast<const char *>(std::get<1>(inputs[input_index])) + row_offset;
+      if (!CopyData(record_data + input_index * row_length_, src, row_length_)) {
+        return false;
+      }
+    }
+    ChangeLogRecordHeader header = {static_cast<uint64_t>(row), record_length,
+                                    CalcRecordCrc(static_cast<uint64_t>(row), record_data, record_length), 0};
+    if (!CopyData(record, &header, sizeof(header))) {
+      return false;
+    }
+    record = record_data + record_length;
+  }
+
+  if (!WriteAll(change_log_fd_, buffer.data(), buffer.size())) {
+    MS_LOG(ERROR) << "Write file[" << change_log_file_name_ << "] failed.";
+    return false;
+  }
+  if (fdatasync(change_log_fd_) != 0) {
+    MS_LOG(ERROR) << "Synchronize file[" << change_log_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  change_log_size_ += buffer.size();
+  return true;
+}
+
+bool MmapFile::ReplayChangeLog() {
+  size_t record_length = input_num_ * row_length_;
+  size_t input_size = row_num_ * row_length_;
+  std::vector<char> record_data(record_length);
+  size_t offset = 0;
+  size_t record_num = 0;
+  while (offset + sizeof(ChangeLogRecordHeader) + record_length <= change_log_size_) {
+    ChangeLogRecordHeader header;
+    if (!ReadAll(change_log_fd_, offset, reinterpret_cast<char *>(&header), sizeof(header)) ||
+        !ReadAll(change_log_fd_, offset + sizeof(header), record_data.data(), record_length)) {
+      MS_LOG(ERROR) << "Read file[" << change_log_file_name_ << "] failed.";
+      return false;
+    }
+    // The incomplete record at the tail is written by the persistence which is interrupted, ignore it.
+    if (header.length_ != record_length || header.row_ >= row_num_ ||
+        header.crc_ != CalcRecordCrc(header.row_, record_data.data(), record_length)) {
+      MS_LOG(WARNING) << "The change log[" << change_log_file_name_ << "] is broken at offset " << offset
+                      << ", ignore the following records.";
+      break;
+    }
+    size_t row_offset = header.row_ * row_length_;
+    for (size_t input_index = 0; input_index < input_num_; ++input_index) {
+      if (!CopyData(data_addr_ + input_index * input_size + row_offset, record_data.data() + input_index * row_length_,
+                    row_length_)) {
+        return false;
+      }
+    }
+    offset += sizeof(header) + record_length;
+    ++record_num;
+  }
+  MS_LOG(INFO) << "Replay " << record_num << " records of change log[" << change_log_file_name_ << "]";
+  return true;
+}
+
+bool MmapFile::Compact() {
+  if (msync(data_addr_, data_size_, MS_SYNC) != 0) {
+    MS_LOG(ERROR) << "Synchronize file[" << data_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  if (ftruncate(change_log_fd_, 0) != 0 || fsync(change_log_fd_) != 0) {
+    MS_LOG(ERROR) << "Clear file[" << change_log_file_name_ << "] failed, errno: " << errno;
+    return false;
+  }
+  change_log_size_ = 0;
+  return true;
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_MMAP_FILE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_MMAP_FILE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "distributed/persistent/storage/storage.h"
+#include "distributed/persistent/storage/block.h"
+#include "distributed/persistent/storage/constants.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// The default size of change log which triggers the compaction : 1GB.
+constexpr size_t DEFAULT_COMPACTION_THRESHOLD = 1UL << 30;
+
+// Memory mapped file type persistence storage implementation class, which is suitable for the large embedding tables
+// whose few rows are modified between two persistences.
+// All the inputs are saved in one data file which is mapped into memory. The dirty rows are appended to the change log
+// file and synchronized to disk first, then written to the mapped data file in place, so a persistence only costs a
+// sequential write of the dirty rows. When the change log exceeds the compaction threshold, the data file is
+// synchronized to disk and the change log is cleared. The change log is replayed when the data file is loaded, which
+// recovers the rows whose in place writing is not synchronized to disk.
+class MmapFile : public StorageBase {
+ public:
+  explicit MmapFile(const std::map<std::string, std::string> &storage_config);
+  ~MmapFile() override;
+
+  // The following two methods are override version function for Write:
+  // 1. Create and map the data file and write the entire blob data of inputs at the first time.
+  // 2. Append the dirty rows to change log and write them to the mapped data file in place at other times.
+  void Write(const InputData &input, const DirtyInfo &dirty_info) override;
+  void Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) override;
+
+  // The following two methods are override version function for Read:
+  // 1. Map the data file and replay the change log if the data file has not been mapped.
+  // 2. Copy data from the mapped data file to the outputs directly.
+  void Read(const OutputData &output) override;
+  void Read(const std::vector<OutputData> &outputs) override;
+
+ private:
+  // Create the data file and change log file, and write the entire blob data of inputs to the data file.
+  bool CreateDataFile(const std::vector<InputData> &inputs);
+  // Map the existing data file and replay the change log.
+  bool LoadDataFile();
+  // Map the data file of data_size_ bytes.
+  bool MapDataFile();
+  // Unmap the data file and close the files.
+  void CloseFiles();
+
+  // Append the dirty rows of inputs to change log and synchronize it to disk.
+  bool AppendChangeLog(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info);
+  // Write the rows recorded in the change log to the mapped data file.
+  bool ReplayChangeLog();
+  // Synchronize the mapped data file to disk and clear the change log.
+  bool Compact();
+
+  // Folder path to save the data file, meta file and change log file.
+  std::string file_path_;
+  std::string data_file_name_;
+  std::string change_log_file_name_;
+
+  // The meta info of the data file: row number, row length and input number.
+  std::shared_ptr<BlockMeta> meta_;
+
+  // Compact when the size of change log is not less than the threshold.
+  size_t compaction_threshold_;
+
+  // The file descriptors and the mapped address of the data file.
+  int data_fd_{-1};
+  int change_log_fd_{-1};
+  char *data_addr_{nullptr};
+
+  // The data file saves the inputs one by one, every input has row_num_ rows and every row has row_length_ bytes.
+  size_t input_num_{0};
+  size_t row_num_{0};
+  size_t row_length_{0};
+  size_t data_size_{0};
+  size_t change_log_size_{0};
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_MMAP_FILE_H_
@@ -16,7 +16,12 @@
 
 #include "distributed/rpc/tcp/connection.h"
 
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
@@ -31,6 +36,15 @@ static size_t kPrintCount = 0;
 static std::mutex kPrintCountMutex;
 const size_t kPrintCountInterval = 1000;
 const int kPrintTimeInterval = 50000;
+// The maximum time in milliseconds to wait for the zero copy completion notifications when closing the connection.
+const int kZeroCopyDrainTimeout = 1000;
+
+// Whether there is a pending error on the socket.
+static bool HasSocketError(int fd) {
+  int so_error = 0;
+  socklen_t len = sizeof(so_error);
+  return getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0 || so_error != 0;
+}
 
 // Handle socket events like read/write.
 void SocketEventHandler(int fd, uint32_t events, void *context) {
@@ -53,6 +67,15 @@ void SocketEventHandler(int fd, uint32_t events, void *context) {
     }
     return;
   }
+  // The completion notifications of zero copy sending are reported by EPOLLERR as well, which is not a socket error.
+  // The notifications may have been read by the sending thread already, so check the pending error of the socket.
+  if ((events & EPOLLERR) > 0 && conn->zero_copy_threshold > 0 && conn->conn_mutex != nullptr) {
+    std::lock_guard<std::mutex> lock(*conn->conn_mutex);
+    (void)conn->ReapZeroCopyCompletions();
+    if (!HasSocketError(fd)) {
+      events &= ~static_cast<uint32_t>(EPOLLERR);
+    }
+  }
   // Handle write event.
   if ((events & EPOLLOUT) > 0) {
     (void)conn->recv_event_loop->UpdateEpollEvent(fd, EPOLLIN | EPOLLHUP | EPOLLERR);
@@ -257,6 +280,8 @@ void Connection::Close() {
     tmpMsg = nullptr;
   }
 
+  // The completion notifications are read from the socket, so wait for them before closing it.
+  WaitForZeroCopyCompletions();
   if (socket_operation != nullptr) {
     socket_operation->Close(this);
     delete socket_operation;
@@ -385,6 +410,7 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       total_send_len =
         UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + real_data_size;
       send_message = msg;
+      send_zero_copy = (zero_copy_threshold > 0 && real_data_size >= zero_copy_threshold);
 
       // update metrics
       send_metrics->UpdateMax(real_data_size);
@@ -473,6 +499,9 @@ void Connection::FillRecvMessage() {
 
 int Connection::Flush() {
   int total_send_bytes = 0;
+  if (!zero_copy_pending_messages.empty()) {
+    (void)ReapZeroCopyCompletions();
+  }
   while (!send_message_queue.empty() || total_send_len != 0) {
     if (total_send_len == 0) {
       FillSendMessage(send_message_queue.front(), source, false);
@@ -490,8 +519,14 @@ int Connection::Flush() {
         output_buffer_size -= real_data_size;
         total_send_bytes += real_data_size;
 
-        FreeMessageMemory(send_message);
-        delete send_message;
+        if (send_zero_copy) {
+          (void)zero_copy_pending_messages.emplace_back(send_message, zero_copy_send_count);
+          send_zero_copy = false;
+          (void)ReapZeroCopyCompletions();
+        } else {
+          FreeMessageMemory(send_message);
+          delete send_message;
+        }
         send_message = nullptr;
         break;
       }
@@ -621,6 +656,104 @@ bool Connection::FreeMessageMemory(MessageBase *msg) {
   return true;
 }
 
+void Connection::EnableZeroCopy(size_t threshold) {
+  if (threshold == 0 || enable_ssl) {
+    return;
+  }
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+  int option_val = 1;
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_ZEROCOPY, &option_val, sizeof(option_val)) != 0) {
+    MS_LOG(WARNING) << "Failed to enable zero copy sending for fd: " << socket_fd << ", errno: " << errno;
+    return;
+  }
+  zero_copy_threshold = threshold;
+#else
+  MS_LOG(WARNING) << "Zero copy sending is not supported on this platform.";
+#endif
+}
+
+bool Connection::ReapZeroCopyCompletions() {
+  bool reaped = false;
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+  if (zero_copy_threshold == 0) {
+    return false;
+  }
+  constexpr size_t kControlLen = CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6));
+  char control[kControlLen];
+  while (true) {
+    struct msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    // The error queue is empty if recvmsg fails with EAGAIN.
+    if (recvmsg(socket_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      break;
+    }
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      bool is_recv_err = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                         (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+      if (!is_recv_err) {
+        continue;
+      }
+      auto *err = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cmsg));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // The notification covers the sendmsg calls in range [ee_info, ee_data], and TCP completes them in order.
+      uint32_t completed_count = err->ee_data + 1;
+      if (static_cast<int32_t>(completed_count - zero_copy_completed_count) > 0) {
+        zero_copy_completed_count = completed_count;
+      }
+      reaped = true;
+    }
+  }
+
+  while (!zero_copy_pending_messages.empty() &&
+         static_cast<int32_t>(zero_copy_completed_count - zero_copy_pending_messages.front().second) >= 0) {
+    MessageBase *msg = zero_copy_pending_messages.front().first;
+    zero_copy_pending_messages.pop_front();
+    (void)FreeMessageMemory(msg);
+    delete msg;
+  }
+#endif
+  return reaped;
+}
+
+void Connection::WaitForZeroCopyCompletions() {
+  if (zero_copy_pending_messages.empty()) {
+    return;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kZeroCopyDrainTimeout);
+  (void)ReapZeroCopyCompletions();
+  while (!zero_copy_pending_messages.empty()) {
+    auto remaining =
+      std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    if (remaining <= 0) {
+      break;
+    }
+    // The notifications in the error queue are reported by POLLERR, which is always polled.
+    struct pollfd poll_fd = {socket_fd, 0, 0};
+    if (poll(&poll_fd, 1, static_cast<int>(remaining)) < 0 && errno != EINTR) {
+      break;
+    }
+    // A socket error is reported by POLLERR as well, avoid spinning on it until the notifications arrive.
+    if (!ReapZeroCopyCompletions()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  if (!zero_copy_pending_messages.empty()) {
+    MS_LOG(WARNING) << "Timed out waiting for the zero copy completion notifications of "
+                    << zero_copy_pending_messages.size() << " messages for fd: " << socket_fd
+                    << ", release them anyway.";
+  }
+  while (!zero_copy_pending_messages.empty()) {
+    MessageBase *msg = zero_copy_pending_messages.front().first;
+    zero_copy_pending_messages.pop_front();
+    (void)FreeMessageMemory(msg);
+    delete msg;
+  }
+}
+
 void *Connection::GetMessageBaseRealData(MessageBase *msg) {
   MS_ERROR_IF_NULL_W_RET_VAL(msg, nullptr);
   // The 'data' attribute is preferred.
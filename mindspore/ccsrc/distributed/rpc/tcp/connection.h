@@ -17,10 +17,12 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_CONNECTION_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_CONNECTION_H_
 
+#include <deque>
 #include <queue>
 #include <string>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/constants.h"
@@ -139,6 +141,28 @@ struct Connection {
    */
   bool FreeMessageMemory(MessageBase *msg);
 
+  /**
+   * @description: Enable sending the message body with MSG_ZEROCOPY for this connection, which is only supported by TCP
+   * connection on linux.
+   * @param {size_t} threshold: The message body whose size is not less than the threshold is sent with zero copy.
+   * @return {void}
+   */
+  void EnableZeroCopy(size_t threshold);
+
+  /**
+   * @description: Read the completion notifications of zero copy sending from the error queue of the socket, and
+   * release the messages whose body is no longer referenced by the kernel.
+   * @return {bool}: Whether any completion notification is read.
+   */
+  bool ReapZeroCopyCompletions();
+
+  /**
+   * @description: Wait for the completion notifications of all the messages sent with zero copy for a bounded time
+   * and release them, which is called before closing the socket.
+   * @return {void}
+   */
+  void WaitForZeroCopyCompletions();
+
   // The socket used by this connection.
   int socket_fd;
 
@@ -224,6 +248,21 @@ struct Connection {
   // Buffer for messages to be sent.
   std::queue<MessageBase *> send_message_queue;
 
+  // The minimum body size of the message sent with zero copy, zero means zero copy sending is disabled.
+  size_t zero_copy_threshold{0};
+
+  // Indicates whether the body of send_message is sent with zero copy.
+  bool send_zero_copy{false};
+
+  // The number of sendmsg calls with MSG_ZEROCOPY and the number of calls completed by the kernel, which are used as
+  // the sequence numbers of the completion notifications.
+  uint32_t zero_copy_send_count{0};
+  uint32_t zero_copy_completed_count{0};
+
+  // The messages which have been sent with zero copy and the send count after sending them. The kernel may still read
+  // the body after sendmsg returns, so these messages are released after the completion notifications arrive.
+  std::deque<std::pair<MessageBase *, uint32_t>> zero_copy_pending_messages;
+
   uint64_t output_buffer_size;
 
   // The error code when sending or receiving messages.
@@ -48,6 +48,10 @@ using MemAllocateCallback = std::function<void *(size_t size)>;
  */
 using MemFreeCallback = std::function<bool(void *data)>;
 
+// The message body whose size is not less than the value of this environment variable in bytes is sent with
+// MSG_ZEROCOPY, and zero copy sending is disabled if it is not set.
+constexpr char kEnvRpcZeroCopyThreshold[] = "MS_DEV_RPC_ZERO_COPY_THRESHOLD";
+
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
 
@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "actor/aid.h"
+#include "utils/ms_utils.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 
@@ -185,6 +186,15 @@ bool TCPComm::Initialize() {
     return false;
   }
 
+  auto zero_copy_threshold = common::GetEnv(kEnvRpcZeroCopyThreshold);
+  if (!zero_copy_threshold.empty()) {
+    try {
+      zero_copy_threshold_ = std::stoul(zero_copy_threshold);
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Invalid value of environment variable " << kEnvRpcZeroCopyThreshold << ": "
+                      << zero_copy_threshold << ", zero copy sending is disabled.";
+    }
+  }
   return true;
 }
 
@@ -437,6 +447,7 @@ bool TCPComm::Connect(const std::string &dst_url) {
     }
 
     conn->socket_fd = sock_fd;
+    conn->EnableZeroCopy(zero_copy_threshold_);
     conn->event_callback = std::bind(&TCPComm::EventCallBack, this, std::placeholders::_1);
     conn->write_callback = std::bind(&TCPComm::WriteCallBack, this, std::placeholders::_1);
     conn->read_callback = std::bind(&TCPComm::ReadCallBack, this, std::placeholders::_1);
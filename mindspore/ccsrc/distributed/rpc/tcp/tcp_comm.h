@@ -134,6 +134,10 @@ class TCPComm {
   // The method used to allocate memory when tcp servers of this TcpComm receive message from the remote.
   MemAllocateCallback allocate_cb_;
 
+  // The message body whose size is not less than this threshold is sent with zero copy by the client connections, zero
+  // means zero copy sending is disabled.
+  size_t zero_copy_threshold_{0};
+
   bool enable_ssl_;
 
   friend void OnAccept(int server, uint32_t events, void *arg);
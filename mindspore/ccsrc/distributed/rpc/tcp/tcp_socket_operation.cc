@@ -119,9 +119,29 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
   *sendLen = 0;
 
   while (*sendLen != totalSendLen) {
-    auto retval = sendmsg(connection->socket_fd, sendMsg, MSG_NOSIGNAL);
+    int flags = MSG_NOSIGNAL;
+    size_t iovlen = sendMsg->msg_iovlen;
+#ifdef MSG_ZEROCOPY
+    // Only the body is sent with zero copy, and the header and urls which are reused by the next message are copied.
+    if (connection->send_zero_copy) {
+      if (iovlen > 1) {
+        sendMsg->msg_iovlen = iovlen - 1;
+      } else {
+        flags |= MSG_ZEROCOPY;
+      }
+    }
+#endif
+    auto retval = sendmsg(connection->socket_fd, sendMsg, flags);
+    sendMsg->msg_iovlen = iovlen;
     if (retval < 0) {
       ++eagainCount;
+#ifdef MSG_ZEROCOPY
+      // The socket runs out of the memory for zero copy notifications, release the completed messages and retry.
+      if ((flags & MSG_ZEROCOPY) != 0 && errno == ENOBUFS) {
+        (void)connection->ReapZeroCopyCompletions();
+        errno = EAGAIN;
+      }
+#endif
       if (errno != EAGAIN) {
         MS_LOG(ERROR) << "Failed to call sendmsg and errno is: " << errno;
         connection->error_code = errno;
@@ -138,6 +158,11 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
       }
       std::this_thread::sleep_for(eagainCount * std::chrono::microseconds(sleep_interval_factor));
     } else {
+#ifdef MSG_ZEROCOPY
+      if ((flags & MSG_ZEROCOPY) != 0) {
+        ++connection->zero_copy_send_count;
+      }
+#endif
       *sendLen += retval;
 
       if (*sendLen == totalSendLen) {
@@ -159,6 +184,11 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
           break;
         }
       }
+      // Skip the io vectors which have been sent completely.
+      while (sendMsg->msg_iovlen > 0 && sendMsg->msg_iov[0].iov_len == 0) {
+        ++sendMsg->msg_iov;
+        --sendMsg->msg_iovlen;
+      }
       eagainCount = 0;
     }
   }
@@ -32,6 +32,7 @@
 #include "minddata/dataset/include/dataset/iterator.h"
 #include "minddata/dataset/include/dataset/samplers.h"
 #include "minddata/dataset/kernels/c_func_op.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
@@ -493,6 +494,25 @@ FilterDataset::FilterDataset(const std::shared_ptr<Dataset> &input,
     ir_node_ = std::static_pointer_cast<DatasetNode>(ds);
   }
 }
+
+FilterDataset::FilterDataset(const std::shared_ptr<Dataset> &input, const std::shared_ptr<TensorOperation> &predicate,
+                             const std::vector<std::vector<char>> &input_columns) {
+  std::shared_ptr<TensorOp> tensor_op = nullptr;
+  if (predicate != nullptr) {
+    Status rc = predicate->ValidateParams();
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "FilterDataset: invalid predicate: " << rc;
+    } else {
+      tensor_op = predicate->Build();
+    }
+  }
+  if (input == nullptr) {
+    ir_node_ = nullptr;
+  } else {
+    auto ds = std::make_shared<FilterNode>(input->IRNode(), tensor_op, VectorCharToString(input_columns));
+    ir_node_ = std::static_pointer_cast<DatasetNode>(ds);
+  }
+}
 #endif
 
 MapDataset::MapDataset(const std::shared_ptr<Dataset> &input,
@@ -910,8 +930,10 @@ std::shared_ptr<DatasetCache> CreateDatasetCacheCharIF(session_id_type id, uint6
                                                        const std::optional<std::vector<char>> &hostname,
                                                        const std::optional<int32_t> &port,
                                                        const std::optional<int32_t> &num_connections,
-                                                       const std::optional<int32_t> &prefetch_sz) {
-  auto cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname, port, num_connections, prefetch_sz);
+                                                       const std::optional<int32_t> &prefetch_sz,
+                                                       bool zero_copy_fetch) {
+  auto cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname, port, num_connections, prefetch_sz,
+                                                  zero_copy_fetch);
   return cache;
 }
 
@@ -71,6 +71,16 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
+                    .def("set_enable_tfrecord_crc_check", &ConfigManager::set_enable_tfrecord_crc_check)
+                    .def("get_enable_tfrecord_crc_check", &ConfigManager::enable_tfrecord_crc_check)
+                    .def("set_text_file_split_size", &ConfigManager::set_text_file_split_size)
+                    .def("get_text_file_split_size", &ConfigManager::text_file_split_size)
+                    .def("set_batch_buffer_ring_size", &ConfigManager::set_batch_buffer_ring_size)
+                    .def("get_batch_buffer_ring_size", &ConfigManager::batch_buffer_ring_size)
+                    .def("set_pin_batch_buffer", &ConfigManager::set_pin_batch_buffer)
+                    .def("get_pin_batch_buffer", &ConfigManager::pin_batch_buffer)
+                    .def("set_jpeg_dct_scaling", &ConfigManager::set_jpeg_dct_scaling)
+                    .def("get_jpeg_dct_scaling", &ConfigManager::jpeg_dct_scaling)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
                     .def("get_multiprocessing_timeout_interval", &ConfigManager::multiprocessing_timeout_interval)
                     .def("set_dynamic_shape", &ConfigManager::set_dynamic_shape)
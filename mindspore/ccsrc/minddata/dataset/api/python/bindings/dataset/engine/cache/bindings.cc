@@ -25,7 +25,8 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
                     .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill,
                                      std::optional<std::string> hostname, std::optional<int32_t> port,
-                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz) {
+                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz,
+                                     bool zero_copy_fetch) {
                       std::shared_ptr<CacheClient> cc;
                       CacheClient::Builder builder;
                       builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill);
@@ -33,6 +34,7 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                       if (port) builder.SetPort(port.value());
                       if (num_connections) builder.SetNumConnections(num_connections.value());
                       if (prefetch_sz) builder.SetPrefetchSize(prefetch_sz.value());
+                      builder.SetZeroCopyFetch(zero_copy_fetch);
                       THROW_IF_ERROR(builder.Build(&cc));
                       return cc;
                     }))
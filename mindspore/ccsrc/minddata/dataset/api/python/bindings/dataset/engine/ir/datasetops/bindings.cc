@@ -181,8 +181,16 @@ PYBIND_REGISTER(FilterNode, 2, ([](const py::module *m) {
                                                                                          "to create a FilterNode")
                     .def(py::init([](const std::shared_ptr<DatasetNode> &self, const py::object &predicate,
                                      const std::vector<std::string> &input_columns) {
-                      auto filter =
-                        std::make_shared<FilterNode>(self, toPyFuncOp(predicate, DataType::DE_BOOL), input_columns);
+                      std::shared_ptr<TensorOp> predicate_op;
+                      // A C++ predicate such as Mask may be pushed down into the reader by ReadPushdownPass.
+                      if (py::isinstance<TensorOperation>(predicate)) {
+                        auto operation = toTensorOperation(predicate);
+                        THROW_IF_ERROR(operation->ValidateParams());
+                        predicate_op = operation->Build();
+                      } else {
+                        predicate_op = toPyFuncOp(predicate, DataType::DE_BOOL);
+                      }
+                      auto filter = std::make_shared<FilterNode>(self, predicate_op, input_columns);
                       THROW_IF_ERROR(filter->ValidateParams());
                       return filter;
                     }));
@@ -54,6 +54,11 @@ ConfigManager::ConfigManager()
       save_autoconfig_(false),
       autotune_interval_(kCfgAutoTuneInterval),
       enable_watchdog_(true),
+      enable_tfrecord_crc_check_(false),
+      text_file_split_size_(0),
+      batch_buffer_ring_size_(0),
+      pin_batch_buffer_(false),
+      jpeg_dct_scaling_(false),
       multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval) {
   autotune_json_filepath_ = kEmptyString;
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
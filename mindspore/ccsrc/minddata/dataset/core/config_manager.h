@@ -267,6 +267,46 @@ class ConfigManager {
   // @return - Flag to indicate whether watchdog python thread is enabled
   bool enable_watchdog() const { return enable_watchdog_; }
 
+  // setter function
+  // @param enable - To verify the crc of every record read from TFRecord files
+  void set_enable_tfrecord_crc_check(bool enable) { enable_tfrecord_crc_check_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the crc of TFRecord records is verified
+  bool enable_tfrecord_crc_check() const { return enable_tfrecord_crc_check_; }
+
+  // setter function
+  // @param size - Split text and csv files into pieces of about this many bytes, read by different workers
+  void set_text_file_split_size(int64_t size) { text_file_split_size_ = size; }
+
+  // getter function
+  // @return - The size of the pieces text and csv files are split into, 0 if files are not split
+  int64_t text_file_split_size() const { return text_file_split_size_; }
+
+  // setter function
+  // @param size - Number of free batch buffers each BatchOp worker keeps for reuse per buffer size, 0 to disable
+  void set_batch_buffer_ring_size(int32_t size) { batch_buffer_ring_size_ = size; }
+
+  // getter function
+  // @return - Number of free batch buffers each BatchOp worker keeps for reuse per buffer size
+  int32_t batch_buffer_ring_size() const { return batch_buffer_ring_size_; }
+
+  // setter function
+  // @param enable - Page lock the batch buffers kept by BatchOp workers
+  void set_pin_batch_buffer(bool enable) { pin_batch_buffer_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the batch buffers kept by BatchOp workers are page locked
+  bool pin_batch_buffer() const { return pin_batch_buffer_; }
+
+  // setter function
+  // @param enable - Decode the JPEG images of RandomCropDecodeResize at the smallest DCT scale fit for the output size
+  void set_jpeg_dct_scaling(bool enable) { jpeg_dct_scaling_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether RandomCropDecodeResize decodes the JPEG images at a reduced DCT scale
+  bool jpeg_dct_scaling() const { return jpeg_dct_scaling_; }
+
   // getter function
   // @return - multiprocessing timeout interval in seconds
   uint32_t multiprocessing_timeout_interval() const { return multiprocessing_timeout_interval_; }
@@ -314,6 +354,11 @@ class ConfigManager {
   bool save_autoconfig_;  // True if should save AutoTune configuration
   int64_t autotune_interval_;
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
+  bool enable_tfrecord_crc_check_;             // Verify the crc of records read from TFRecord files
+  int64_t text_file_split_size_;               // Size of the pieces text and csv files are split into, 0 to disable
+  int32_t batch_buffer_ring_size_;             // Free batch buffers kept per BatchOp worker and size, 0 to disable
+  bool pin_batch_buffer_;                      // Page lock the batch buffers kept by BatchOp workers
+  bool jpeg_dct_scaling_;                      // Decode JPEG images at a reduced DCT scale when the output is small
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
   bool dynamic_shape_{false};
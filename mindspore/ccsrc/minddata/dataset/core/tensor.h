@@ -50,6 +50,7 @@ namespace py = pybind11;
 namespace mindspore {
 namespace dataset {
 class Tensor;
+class MemoryPool;
 template <typename T>
 class Allocator;
 
@@ -105,6 +106,19 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a tensor which refers to a buffer in memory instead of copying it. The buffer is owned by the memory pool,
+  /// and is given back to the memory pool when the tensor is destroyed.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] src pointer to the buffer
+  /// \param[in] length length of the buffer
+  /// \param[in] pool memory pool which owns the buffer
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromExternalMemory(const TensorShape &shape, const DataType &type, uchar *src,
+                                         const dsize_t &length, const std::shared_ptr<MemoryPool> &pool,
+                                         TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -443,6 +443,7 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
+                  << std::setw(10) << "Promoted" << std::setw(10) << "Demoted" << std::setw(16) << "Read ahead hit"
                   << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
@@ -450,6 +451,9 @@ Status CacheAdminArgHandler::RunCommand() {
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_promoted;
+          std::string stat_demoted;
+          std::string stat_read_ahead_hit;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -460,10 +464,18 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          stat_promoted =
+            (curr_session.stats.num_promoted == 0) ? "n/a" : std::to_string(curr_session.stats.num_promoted);
+          stat_demoted =
+            (curr_session.stats.num_demoted == 0) ? "n/a" : std::to_string(curr_session.stats.num_demoted);
+          stat_read_ahead_hit = (curr_session.stats.num_read_ahead_hit == 0)
+                                  ? "n/a"
+                                  : std::to_string(curr_session.stats.num_read_ahead_hit);
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(10) << stat_promoted << std::setw(10)
+                    << stat_demoted << std::setw(16) << stat_read_ahead_hit << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
@@ -24,7 +24,14 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      zero_copy_fetch_(false) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -36,7 +43,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+                                       prefetch_size_, zero_copy_fetch_);
   return Status::OK();
 }
 
@@ -55,7 +62,7 @@ Status CacheClient::Builder::SanityCheck() {
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+                         int32_t port, int32_t num_connections, int32_t prefetch_size, bool zero_copy_fetch)
     : cache_mem_sz_(cache_mem_sz),
       spill_(spill),
       server_connection_id_(0),
@@ -63,6 +70,7 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
+      zero_copy_fetch_(zero_copy_fetch),
       fetch_all_keys_(true) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname, port, num_connections_);
@@ -102,7 +110,7 @@ void CacheClient::Print(std::ostream &out) const {
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << GetCacheMemSz()
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Number of rpc workers: " << GetNumConnections()
       << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << SupportLocalClient() << "\n  Zero copy fetch: " << std::boolalpha << IsZeroCopyFetch();
 }
 
 std::string CacheClient::GetHostname() const { return comm_->GetHostname(); }
@@ -134,7 +142,8 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   RETURN_IF_NOT_OK(rq->Wait());
   int64_t mem_addr;
   Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
-  // Free the memory by sending a request back to the server.
+  // Free the memory by sending a request back to the server. In zero copy mode, the memory is leased to the
+  // restored tensors instead and no address is returned.
   if (mem_addr != -1) {
     auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, mem_addr);
     Status rc2 = PushRequest(mfree_req);
@@ -146,6 +155,15 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   return rc;
 }
 
+Status CacheClient::ReadAhead(const std::vector<row_id_type> &row_id, bool reset) const {
+  if (!spill_ || row_id.empty()) {
+    return Status::OK();
+  }
+  auto rq = std::make_shared<ReadAheadRowsRequest>(this, row_id, reset);
+  // It is only a hint. We won't wait for the result.
+  return PushRequest(rq);
+}
+
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
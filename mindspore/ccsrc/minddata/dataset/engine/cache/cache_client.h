@@ -117,6 +117,15 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to fetch rows from cache server in zero copy mode. The fetched tensors refer to the shared
+    /// memory directly, which is given back to the server when the tensors are destroyed.
+    /// \param zero_copy_fetch
+    /// \return Builder object itself
+    Builder &SetZeroCopyFetch(bool zero_copy_fetch) {
+      zero_copy_fetch_ = zero_copy_fetch;
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -125,6 +134,7 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    bool IsZeroCopyFetch() const { return zero_copy_fetch_; }
 
     Status SanityCheck();
 
@@ -138,14 +148,16 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    bool zero_copy_fetch_;
   };
 
   /// \brief Constructor
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param zero_copy_fetch Fetched tensors refer to the shared memory directly instead of a copy
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+              int32_t num_connections, int32_t prefetch_size, bool zero_copy_fetch = false);
 
   /// \brief Destructor
   ~CacheClient();
@@ -163,6 +175,13 @@ class CacheClient {
   /// \return return code
   Status GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const;
 
+  /// \brief Hint the cache server of the rows to be fetched next, so that the rows spilled to disk can be read ahead.
+  /// It is a no-op if the cache doesn't spill.
+  /// \param row_id A vector of row id's in the order of fetching
+  /// \param reset Drop the hints given before, e.g. at the start of an epoch
+  /// \return return code
+  Status ReadAhead(const std::vector<row_id_type> &row_id, bool reset) const;
+
   /// \brief Create a cache.
   /// \param tree_crc  A crc that was generated during tree prepare phase
   /// \param generate_id Let the cache service generate row id
@@ -232,6 +251,7 @@ class CacheClient {
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
   int32_t GetClientId() const { return client_id_; }
+  bool IsZeroCopyFetch() const { return zero_copy_fetch_; }
   std::string GetHostname() const;
   int32_t GetPort() const;
 
@@ -286,6 +306,7 @@ class CacheClient {
   bool local_bypass_;
   int32_t num_connections_;
   int32_t prefetch_size_;
+  bool zero_copy_fetch_;
   mutable std::shared_ptr<CacheClientGreeter> comm_;
   std::atomic<bool> fetch_all_keys_;
   WaitPost cache_miss_keys_wp_;
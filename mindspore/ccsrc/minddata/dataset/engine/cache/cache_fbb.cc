@@ -102,7 +102,8 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
   }
 }
 
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        const std::shared_ptr<MemoryPool> &lease) {
   RETURN_UNEXPECTED_IF_NULL(col_ts);
   auto shape_in = col_ts->dims();
   auto type_in = col_ts->type();
@@ -135,8 +136,15 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
 
   DataType type(dest);
   std::shared_ptr<Tensor> ts;
-  RETURN_IF_NOT_OK(
-    Tensor::CreateFromMemory(shape, type, static_cast<const unsigned char *>(data.GetPointer()), data.GetSize(), &ts));
+  auto *src = static_cast<const unsigned char *>(data.GetPointer());
+  // Tensor data is only referred to in place if it is aligned to its element type. Otherwise we fall back to copy.
+  size_t alignment = type.IsNumeric() ? type.SizeInBytes() : sizeof(offset_t);
+  if (lease != nullptr && alignment > 0 && reinterpret_cast<uintptr_t>(src) % alignment == 0) {
+    RETURN_IF_NOT_OK(
+      Tensor::CreateFromExternalMemory(shape, type, const_cast<unsigned char *>(src), data.GetSize(), lease, &ts));
+  } else {
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, type, src, data.GetSize(), &ts));
+  }
   // Next we restore the real data which can be embedded or stored separately.
   if (ts->SizeInBytes() != data.GetSize()) {
     MS_LOG(ERROR) << "Unexpected length. Read " << data.GetSize() << ". Expected " << ts->SizeInBytes() << ".\n"
@@ -147,5 +155,43 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
   *out = std::move(ts);
   return Status::OK();
 }
+
+Status RestoreTensorRows(const void *buf, const std::vector<row_id_type> &row_id, TensorTable *out,
+                         const std::shared_ptr<MemoryPool> &lease) {
+  RETURN_UNEXPECTED_IF_NULL(buf);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto num_elements = row_id.size();
+  auto *offset_array = reinterpret_cast<const int64_t *>(buf);
+  ReadableSlice all(buf, offset_array[num_elements]);
+  TensorTable tbl;
+  tbl.reserve(num_elements);
+  for (auto i = 0; i < num_elements; ++i) {
+    auto len = offset_array[i + 1] - offset_array[i];
+    TensorRow row;
+    row.setId(row_id.at(i));
+    if (len > 0) {
+      ReadableSlice row_data(all, offset_array[i], len);
+      // Next we de-serialize flat buffer to get back each column
+      auto msg = GetTensorRowHeaderMsg(row_data.GetPointer());
+      auto msg_sz = msg->size_of_this();
+      // Start of the tensor data
+      auto ts_offset = msg_sz;
+      row.reserve(msg->column()->size());
+      for (auto k = 0; k < msg->column()->size(); ++k) {
+        auto col_ts = msg->column()->Get(k);
+        std::shared_ptr<Tensor> ts;
+        ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
+        RETURN_IF_NOT_OK(RestoreOneTensor(col_ts, data, &ts, lease));
+        row.push_back(ts);
+        ts_offset += data.GetSize();
+      }
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(len == 0, "Data corruption detected.");
+    }
+    tbl.push_back(std::move(row));
+  }
+  *out = std::move(tbl);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
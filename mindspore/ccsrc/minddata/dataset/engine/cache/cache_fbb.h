@@ -24,6 +24,7 @@
 #include <vector>
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
 
@@ -39,8 +40,20 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \param col_ts A serialized version of Tensor meta data
 /// \param data Tensor data wrapped in a slice
 /// \param out Tensor
+/// \param lease Optional. If given, the tensor refers to the data in place and holds the lease instead of a copy
 /// \return Status object
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        const std::shared_ptr<MemoryPool> &lease = nullptr);
+
+/// \brief A function used by BatchFetchRequest to deserialize the fetched rows. The buffer starts with an array of
+///     the offsets of the rows, followed by each row serialized as its TensorRow header and the data of its tensors.
+/// \param buf The buffer of the fetched rows
+/// \param row_id The ids of the fetched rows
+/// \param out The restored rows
+/// \param lease Optional. If given, the tensors refer to the buffer in place and hold the lease instead of a copy
+/// \return Status object
+Status RestoreTensorRows(const void *buf, const std::vector<row_id_type> &row_id, TensorTable *out,
+                         const std::shared_ptr<MemoryPool> &lease = nullptr);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
@@ -66,6 +66,9 @@ class NumaMemoryPool : public MemoryPool {
   /// \brief Return the configured or computed memory cap ratio
   float GetMemoryCapRatio() const { return memory_cap_ratio_; }
 
+  /// \brief Return the hardware info the pool is laid out with
+  const std::shared_ptr<CacheServerHW> &GetHWControl() const { return hw_; }
+
  private:
   std::shared_ptr<CacheServerHW> hw_;
   float memory_cap_ratio_;
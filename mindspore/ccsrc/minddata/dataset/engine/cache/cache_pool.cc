@@ -16,13 +16,30 @@
 #include <algorithm>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
-#include "minddata/dataset/engine/cache/cache_server.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
 #include "minddata/dataset/util/services.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, int32_t num_workers)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      num_workers_(num_workers),
+      mem_usage_(0),
+      mem_cap_(0),
+      num_access_(0),
+      max_key_(0),
+      clock_hand_(0),
+      aging_pending_(false),
+      staged_bytes_(0),
+      staging_key_(-1),
+      staging_cancelled_(false),
+      num_promoted_(0),
+      num_demoted_(0),
+      num_read_ahead_hit_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -35,10 +52,16 @@ Status CachePool::DoServiceStart() {
   if (!root_.ToString().empty()) {
     Path spill = GetSpillPath();
     RETURN_IF_NOT_OK(spill.CreateDirectories());
-    auto &cs = CacheServer::GetInstance();
-    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
+    sm_ = std::make_shared<StorageManager>(spill, num_workers_);
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
+    // Rows are tiered between memory and disk by their access frequency.
+    freq_sketch_ = std::make_unique<std::atomic<uint8_t>[]>(kFreqSketchSize);
+    for (size_t i = 0; i < kFreqSketchSize; ++i) {
+      freq_sketch_[i] = 0;
+    }
+    RETURN_IF_NOT_OK(tier_cv_.Register(tier_tg_.GetIntrpService()));
+    RETURN_IF_NOT_OK(tier_tg_.CreateAsyncTask("Cache pool tiering", std::bind(&CachePool::TieringWorker, this)));
   }
   return Status::OK();
 }
@@ -47,12 +70,19 @@ Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
   if (sm_ != nullptr) {
+    // Stop the tiering task first as it is still using the storage manager.
+    tier_tg_.interrupt_all();
+    rc = tier_tg_.join_all(Task::WaitFlag::kNonBlocking);
+    if (rc.IsError()) {
+      rc2 = rc;
+    }
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
       rc2 = rc;
     }
   }
   sm_.reset();
+  staged_rows_.clear();
 
   // We used to free the memory allocated from each DataLocator but
   // since all of them are coming from NumaMemoryPool and we will
@@ -88,27 +118,11 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
-  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
-  // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
-    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
-                    << ". The cache server will not cache any more data.";
-    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
-  } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
-    // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
-      soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
-      temp_mem_usage_ = 0;
-    }
-  }
+  rc = AllocateRow(sz, &bl.ptr);
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
-      auto &cs = CacheServer::GetInstance();
-      auto node_id = cs.GetHWControl()->GetMyNode();
+      auto node_id = mp_->GetHWControl()->GetMyNode();
       bl.node_id = mp_->FindNode(bl.ptr);
       CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
       bl.node_hit = (bl.node_id == node_id);
@@ -125,7 +139,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       pos += v.GetSize();
     }
     if (rc.IsError()) {
-      mp_->Deallocate(bl.ptr);
+      FreeRow(bl.ptr, bl.sz);
       bl.ptr = nullptr;
       return rc;
     }
@@ -134,6 +148,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      bl.on_disk = true;
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -150,35 +165,369 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   }
   // Duplicate key is treated as error and we will also free the memory.
   if (rc.IsError() && bl.ptr != nullptr) {
-    mp_->Deallocate(bl.ptr);
+    FreeRow(bl.ptr, bl.sz);
     bl.ptr = nullptr;
     return rc;
   }
+  if (rc.IsOk() && IsTiered()) {
+    auto max_key = max_key_.load();
+    while (key > max_key && !max_key_.compare_exchange_weak(max_key, key)) {
+    }
+  }
+  return rc;
+}
+
+void CachePool::SetMemoryCap(uint64_t sz) {
+  std::unique_lock<std::mutex> lck(mem_mux_);
+  mem_cap_ = sz;
+}
+
+Status CachePool::AllocateRow(size_t sz, pointer *p) {
+  {
+    // The memory is reserved before it is allocated, so that the concurrent inserts and the tiering task can't
+    // overshoot the limit together.
+    std::unique_lock<std::mutex> lck(mem_mux_);
+    // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got
+    // killed or crashing the machine, set lower bound memory, which means stopping cache once the rest available
+    // memory is less than the lower bound. (The default is 20% of physical RAM)
+    if (soft_mem_limit_ < min_avail_mem_ + temp_mem_usage_ + sz) {
+      MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
+                      << ". The cache server will not cache any more data.";
+      return STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+    }
+    if (mem_cap_ > 0 && mem_usage_ + sz > mem_cap_) {
+      return STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+    }
+    temp_mem_usage_ += sz;
+    mem_usage_ += sz;
+  }
+  Status rc = mp_->Allocate(sz, reinterpret_cast<void **>(p));
+  std::unique_lock<std::mutex> lck(mem_mux_);
+  if (rc.IsError()) {
+    temp_mem_usage_ -= std::min<uint64_t>(temp_mem_usage_, sz);
+    mem_usage_ -= sz;
+    return rc;
+  }
+  // Adjust the soft limit and usage counting when every 100M memory are used.
+  if (temp_mem_usage_ >= kMemoryCapAdjustInterval) {
+    soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
+    temp_mem_usage_ = 0;
+  }
   return rc;
 }
 
+void CachePool::FreeRow(pointer p, size_t sz) {
+  mp_->Deallocate(p);
+  std::unique_lock<std::mutex> lck(mem_mux_);
+  temp_mem_usage_ -= std::min<uint64_t>(temp_mem_usage_, sz);
+  mem_usage_ -= std::min<uint64_t>(mem_usage_, sz);
+}
+
 Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
   RETURN_UNEXPECTED_IF_NULL(dest);
-  auto r = tree_->Search(key);
-  if (r.second) {
+  std::vector<WritableSlice> v{*dest};
+  std::vector<size_t> sz;
+  RETURN_IF_NOT_OK(BatchRead({key}, &v, &sz));
+  if (bytesRead != nullptr) {
+    *bytesRead = sz[0];
+  }
+  return Status::OK();
+}
+
+Status CachePool::BatchRead(const std::vector<key_type> &keys, std::vector<WritableSlice> *dest,
+                            std::vector<size_t> *bytesRead) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  RETURN_UNEXPECTED_IF_NULL(bytesRead);
+  CHECK_FAIL_RETURN_UNEXPECTED(keys.size() == dest->size(), "Number of keys and destination buffers mismatch");
+  bytesRead->assign(keys.size(), 0);
+  // Spilled rows which are not read ahead are collected and read from disk in one batch.
+  std::vector<StorageManager::key_type> storage_keys;
+  std::vector<WritableSlice> storage_dest;
+  std::vector<size_t> storage_inx;
+  std::vector<key_type> hot_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto key = keys[i];
+    uint8_t freq = IsTiered() ? Touch(key) : 0;
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
     auto &it = r.first;
+    auto &buf = (*dest)[i];
+    (*bytesRead)[i] = it->sz;
+    std::vector<uint8_t> staged;
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
-      size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
-                      << " Internal key: " << key << "\n";
+      RETURN_IF_NOT_OK(WritableSlice::Copy(&buf, src));
+      continue;
+    } else if (sm_ == nullptr) {
+      continue;
+    } else if (TakeStagedRow(key, &staged)) {
+      CHECK_FAIL_RETURN_UNEXPECTED(staged.size() == it->sz, "Length mismatch of the row read ahead.");
+      ReadableSlice src(staged.data(), staged.size());
+      RETURN_IF_NOT_OK(WritableSlice::Copy(&buf, src));
+    } else {
+      // The copy on disk stays even if the row is promoted before we read it.
+      storage_keys.push_back(it->storage_key);
+      storage_dest.push_back(buf);
+      storage_inx.push_back(i);
+    }
+    // A spilled row which is read often is promoted into memory in the background.
+    if (freq >= kPromoteThreshold) {
+      hot_keys.push_back(key);
+    }
+  }
+  if (!storage_keys.empty()) {
+    std::vector<size_t> expectedLength;
+    RETURN_IF_NOT_OK(sm_->Read(storage_keys, &storage_dest, &expectedLength));
+    for (size_t j = 0; j < storage_inx.size(); ++j) {
+      auto sz = (*bytesRead)[storage_inx[j]];
+      if (expectedLength[j] != sz) {
+        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength[j] << ". Expected " << sz << "."
+                      << " Internal key: " << keys[storage_inx[j]] << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
     }
-    if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+  }
+  if (!hot_keys.empty()) {
+    std::unique_lock<std::mutex> lck(tier_mux_);
+    for (auto key : hot_keys) {
+      if (promote_keys_.size() < kMaxPromoteQueue) {
+        promote_keys_.push_back(key);
+      }
     }
-  } else {
-    RETURN_STATUS_UNEXPECTED("Key not found");
+    tier_cv_.NotifyAll();
+  }
+  return Status::OK();
+}
+
+Status CachePool::ReadAhead(const std::vector<key_type> &keys, bool reset) {
+  if (!IsTiered()) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lck(tier_mux_);
+  if (reset) {
+    ResetReadAhead();
+  }
+  for (auto key : keys) {
+    if (read_ahead_pending_.insert(key).second) {
+      read_ahead_keys_.push_back(key);
+    }
+  }
+  tier_cv_.NotifyAll();
+  return Status::OK();
+}
+
+void CachePool::ResetReadAhead() {
+  read_ahead_keys_.clear();
+  read_ahead_pending_.clear();
+  staged_rows_.clear();
+  staged_bytes_ = 0;
+  staging_cancelled_ = true;
+}
+
+uint8_t CachePool::Touch(key_type key) const {
+  // Have the tiering task halve all the frequencies once in a while, so that the readers don't pay for it.
+  if ((num_access_.fetch_add(1) + 1) % kFreqAgingInterval == 0) {
+    std::unique_lock<std::mutex> lck(tier_mux_);
+    aging_pending_ = true;
+    tier_cv_.NotifyAll();
+  }
+  // Saturating 4-bit counter. Keys sharing the same slot only make the frequency over estimated.
+  constexpr uint8_t kMaxFreq = 15;
+  auto &cnt = freq_sketch_[FreqSlot(key)];
+  uint8_t freq = cnt.load();
+  while (freq < kMaxFreq && !cnt.compare_exchange_weak(freq, static_cast<uint8_t>(freq + 1))) {
+  }
+  return freq < kMaxFreq ? static_cast<uint8_t>(freq + 1) : kMaxFreq;
+}
+
+void CachePool::AgeFrequencies() {
+  for (size_t i = 0; i < kFreqSketchSize; ++i) {
+    freq_sketch_[i] = static_cast<uint8_t>(freq_sketch_[i] >> 1);
+  }
+}
+
+bool CachePool::TakeStagedRow(key_type key, std::vector<uint8_t> *row) const {
+  std::unique_lock<std::mutex> lck(tier_mux_);
+  auto it = staged_rows_.find(key);
+  if (it == staged_rows_.end()) {
+    // Not staged yet. Don't bother reading it ahead any more.
+    (void)read_ahead_pending_.erase(key);
+    if (staging_key_ == key) {
+      staging_cancelled_ = true;
+    }
+    return false;
+  }
+  *row = std::move(it->second);
+  staged_bytes_ -= row->size();
+  (void)staged_rows_.erase(it);
+  ++num_read_ahead_hit_;
+  // Wake up the tiering task which may be waiting for space in the staging area.
+  tier_cv_.NotifyAll();
+  return true;
+}
+
+Status CachePool::TieringWorker() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    key_type key = -1;
+    bool promote = false;
+    bool age = false;
+    {
+      std::unique_lock<std::mutex> lck(tier_mux_);
+      RETURN_IF_NOT_OK(tier_cv_.Wait(&lck, [this]() {
+        return aging_pending_ || !promote_keys_.empty() ||
+               (!read_ahead_keys_.empty() && staged_bytes_ < kMaxReadAheadBytes);
+      }));
+      if (aging_pending_) {
+        aging_pending_ = false;
+        age = true;
+      } else if (!promote_keys_.empty()) {
+        key = promote_keys_.front();
+        promote_keys_.pop_front();
+        promote = true;
+      } else {
+        key = read_ahead_keys_.front();
+        read_ahead_keys_.pop_front();
+        // Skip the row if it has been fetched already.
+        if (read_ahead_pending_.erase(key) == 0) {
+          continue;
+        }
+        staging_key_ = key;
+        staging_cancelled_ = false;
+      }
+    }
+    if (age) {
+      AgeFrequencies();
+      continue;
+    }
+    Status rc = promote ? PromoteRow(key) : StageRow(key);
+    if (!promote) {
+      std::unique_lock<std::mutex> lck(tier_mux_);
+      staging_key_ = -1;
+    }
+    // Tiering is only an optimization. Log the error and carry on.
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to " << (promote ? "promote" : "read ahead") << " row " << key << ". " << rc;
+    }
+  }
+}
+
+Status CachePool::PromoteRow(key_type key) {
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second || r.first->ptr != nullptr) {
+      return Status::OK();
+    }
+    bl = *(r.first);
+  }
+  auto freq = GetFrequency(key);
+  Status rc = AllocateRow(bl.sz, &bl.ptr);
+  // Make room for the row by demoting colder rows to disk.
+  while (rc == StatusCode::kMDOutOfMemory) {
+    size_t freed = 0;
+    RETURN_IF_NOT_OK(DemoteColdRow(freq, &freed));
+    if (freed == 0) {
+      // Every row probed is at least as hot as this one. Leave it on disk.
+      return Status::OK();
+    }
+    rc = AllocateRow(bl.sz, &bl.ptr);
+  }
+  RETURN_IF_NOT_OK(rc);
+  WritableSlice dest(bl.ptr, bl.sz);
+  size_t bytesRead = 0;
+  rc = sm_->Read(bl.storage_key, &dest, &bytesRead);
+  if (rc.IsOk() && bytesRead != bl.sz) {
+    rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, "Length mismatch of the spilled row.");
+  }
+  if (rc.IsError()) {
+    FreeRow(bl.ptr, bl.sz);
+    return rc;
+  }
+  if (CacheServerHW::numa_enabled()) {
+    bl.node_id = mp_->FindNode(bl.ptr);
+    bl.node_hit = (bl.node_id == mp_->GetHWControl()->GetMyNode());
+  }
+  // The copy on disk is kept so the row can be demoted again without writing it out.
+  (void)tree_->DoUpdate(key, bl);
+  ++num_promoted_;
+  // The row is fetched from memory from now on, so nobody is going to take the copy read ahead.
+  std::unique_lock<std::mutex> lck(tier_mux_);
+  auto it = staged_rows_.find(key);
+  if (it != staged_rows_.end()) {
+    staged_bytes_ -= it->second.size();
+    (void)staged_rows_.erase(it);
+  }
+  (void)read_ahead_pending_.erase(key);
+  return Status::OK();
+}
+
+Status CachePool::DemoteColdRow(uint8_t freq, size_t *freed) {
+  RETURN_UNEXPECTED_IF_NULL(freed);
+  *freed = 0;
+  auto max_key = max_key_.load();
+  key_type victim = -1;
+  uint8_t victim_freq = freq;
+  for (int32_t i = 0; i < kVictimProbes; ++i) {
+    clock_hand_ = clock_hand_ >= max_key ? 0 : clock_hand_ + 1;
+    auto f = GetFrequency(clock_hand_);
+    if (f < victim_freq) {
+      auto r = tree_->Search(clock_hand_);
+      if (r.second && r.first->ptr != nullptr) {
+        victim = clock_hand_;
+        victim_freq = f;
+      }
+    }
+  }
+  if (victim == -1) {
+    return Status::OK();
+  }
+  DataLocator bl;
+  {
+    // Readers of the row are blocked by the leaf lock until the update below.
+    auto r = tree_->Search(victim);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Row " + std::to_string(victim) + " not found.");
+    bl = *(r.first);
+    if (!bl.on_disk) {
+      std::vector<ReadableSlice> v;
+      v.emplace_back(bl.ptr, bl.sz);
+      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, v));
+      bl.on_disk = true;
+    }
+  }
+  auto p = bl.ptr;
+  bl.ptr = nullptr;
+  bl.node_hit = false;
+  (void)tree_->DoUpdate(victim, bl);
+  // Readers which found the row in memory hold the leaf lock which DoUpdate has waited for. Safe to free it now.
+  FreeRow(p, bl.sz);
+  *freed = bl.sz;
+  ++num_demoted_;
+  return Status::OK();
+}
+
+Status CachePool::StageRow(key_type key) {
+  std::vector<uint8_t> row;
+  {
+    auto r = tree_->Search(key);
+    // Rows in memory don't need to be read ahead.
+    if (!r.second || r.first->ptr != nullptr) {
+      return Status::OK();
+    }
+    auto &it = r.first;
+    row.resize(it->sz);
+    WritableSlice dest(row.data(), row.size());
+    size_t bytesRead = 0;
+    RETURN_IF_NOT_OK(sm_->Read(it->storage_key, &dest, &bytesRead));
+    CHECK_FAIL_RETURN_UNEXPECTED(bytesRead == it->sz, "Length mismatch of the spilled row.");
+  }
+  std::unique_lock<std::mutex> lck(tier_mux_);
+  // The row may have been fetched, or the read ahead reset, while we were reading it.
+  if (staging_key_ == key && !staging_cancelled_) {
+    staged_bytes_ += row.size();
+    (void)staged_rows_.emplace(key, std::move(row));
   }
   return Status::OK();
 }
@@ -189,8 +538,12 @@ Path CachePool::GetSpillPath() const {
 }
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
+  CacheStat cs{-1, -1, 0, 0, 0, 0, num_promoted_, num_demoted_, num_read_ahead_hit_, 0};
+  if (IsTiered()) {
+    std::unique_lock<std::mutex> lck(tier_mux_);
+    cs.read_ahead_bytes = static_cast<int64_t>(staged_bytes_);
+  }
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -237,7 +590,9 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     bld.add_key(key);
     bld.add_size(it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    // Rows can move between memory and disk if they are tiered. Let the fetch look them up again under the lock.
+    bld.add_addr(IsTiered() ? 0 : reinterpret_cast<int64_t>(it->ptr));
+    bld.add_spilled(IsTiered() && it->ptr == nullptr);
     auto offset = bld.Finish();
     *out = offset;
   } else {
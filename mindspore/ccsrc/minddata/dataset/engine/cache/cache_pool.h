@@ -16,9 +16,13 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/cache_common.h"
@@ -29,12 +33,18 @@
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/util/btree.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+///
+/// If a disk directory is provided, the rows are also tiered by their access frequency. A spilled row which is read
+/// often is promoted back into memory, and a colder row in memory is demoted to disk to make room for it. Spilled rows
+/// can also be read ahead from disk into a bounded staging area in the order they are going to be fetched.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -48,7 +58,7 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0), on_disk(false) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
@@ -58,9 +68,11 @@ class CachePool : public Service {
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
+      on_disk = other.on_disk;
       other.ptr = nullptr;
       other.sz = 0;
       other.storage_key = 0;
+      other.on_disk = false;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
@@ -69,9 +81,11 @@ class CachePool : public Service {
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
+        on_disk = other.on_disk;
         other.ptr = nullptr;
         other.sz = 0;
         other.storage_key = 0;
+        other.on_disk = false;
       }
       return *this;
     }
@@ -80,6 +94,7 @@ class CachePool : public Service {
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
+    bool on_disk;  // a copy is saved in the storage manager, which is the only copy if ptr is null
   };
 
   using data_index = BPlusTree<int64_t, DataLocator>;
@@ -95,13 +110,18 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_promoted;        // number of times a spilled row is promoted into memory
+    int64_t num_demoted;         // number of times a row in memory is demoted to disk
+    int64_t num_read_ahead_hit;  // number of spilled rows fetched from the read ahead staging area
+    int64_t read_ahead_bytes;    // number of bytes read ahead and not fetched yet
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param num_workers Number of workers to read and write the spilled rows
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "", int32_t num_workers = 1);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -129,6 +149,20 @@ class CachePool : public Service {
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
+  /// \brief Read a batch of buffers. The spilled buffers are read from disk in one batch.
+  /// \param[in] keys Keys of the buffers
+  /// \param[in] dest Destination of each buffer
+  /// \param[out] bytesRead Size of each buffer
+  /// \return Error code
+  Status BatchRead(const std::vector<key_type> &keys, std::vector<WritableSlice> *dest,
+                   std::vector<size_t> *bytesRead) const;
+
+  /// \brief Read ahead the spilled rows from disk in the order they are going to be fetched
+  /// \param[in] keys Keys in the order of fetching. Keys which are not spilled are ignored.
+  /// \param[in] reset Drop the rows read ahead previously, e.g. at the start of an epoch
+  /// \return Error code
+  Status ReadAhead(const std::vector<key_type> &keys, bool reset);
+
   /// \brief Serialize a DataLocator
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
@@ -140,20 +174,109 @@ class CachePool : public Service {
   std::string MyName() const { return subfolder_; }
 
   /// \brief Toggle locking
-  /// \note Once locking is off. It is user's responsibility to ensure concurrency
-  void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
+  /// \note Once locking is off. It is user's responsibility to ensure concurrency. Locking stays on if rows are tiered
+  /// because the tiering updates the index concurrently.
+  void SetLocking(bool on_off) { tree_->SetLocking(on_off || IsTiered()); }
+
+  /// \brief Cap the memory taken by the rows in memory. The rows beyond the cap are spilled to disk, if enabled.
+  /// \param[in] sz Number of bytes. 0 means the rows are only bounded by the available memory of the machine.
+  void SetMemoryCap(uint64_t sz);
 
  private:
+  // Size of the access frequency sketch
+  static constexpr int kFreqSketchBits = 20;
+  static constexpr size_t kFreqSketchSize = 1u << kFreqSketchBits;
+  // The frequencies are halved after this number of accesses, so that the rows not read for a while turn cold
+  static constexpr uint64_t kFreqAgingInterval = kFreqSketchSize * 8;
+  // A spilled row is promoted once its frequency reaches this threshold
+  static constexpr uint8_t kPromoteThreshold = 2;
+  // Number of keys probed to find the coldest row in memory to be demoted
+  static constexpr int32_t kVictimProbes = 16;
+  // Maximum number of spilled rows waiting to be promoted
+  static constexpr size_t kMaxPromoteQueue = 1024;
+  // Maximum number of bytes staged by read ahead
+  static constexpr size_t kMaxReadAheadBytes = 256 * 1048576L;
+
+  /// \brief Rows are tiered if spilling to disk is enabled
+  bool IsTiered() const { return sm_ != nullptr; }
+
+  /// \brief Allocate memory for a row, fail with kMDOutOfMemory if the memory usage will exceed the limit
+  Status AllocateRow(size_t sz, pointer *p);
+
+  /// \brief Free the memory of a row allocated by AllocateRow
+  void FreeRow(pointer p, size_t sz);
+
+  /// \brief Record an access of a row
+  /// \return The access frequency of the row
+  uint8_t Touch(key_type key) const;
+
+  /// \brief Get the access frequency of a row
+  uint8_t GetFrequency(key_type key) const { return freq_sketch_[FreqSlot(key)].load(); }
+
+  /// \brief Fibonacci hashing of the key to its slot in the frequency sketch
+  static size_t FreqSlot(key_type key) {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> (64 - kFreqSketchBits));
+  }
+
+  /// \brief Take the row out of the read ahead staging area, or cancel the read ahead of the row if it is not staged
+  /// \return True if the row is taken from the staging area
+  bool TakeStagedRow(key_type key, std::vector<uint8_t> *row) const;
+
+  /// \brief Background task which promotes the hot spilled rows, reads ahead the spilled rows and ages the frequencies
+  Status TieringWorker();
+
+  /// \brief Halve all the frequencies so that the rows which are no longer read turn cold
+  void AgeFrequencies();
+
+  /// \brief Promote a spilled row into memory, demote colder rows to disk if there is no memory for it
+  Status PromoteRow(key_type key);
+
+  /// \brief Find the coldest row in memory around the clock hand, and demote it to disk if it is colder than freq
+  /// \param[in] freq Frequency of the row to be promoted
+  /// \param[out] freed Number of bytes freed
+  Status DemoteColdRow(uint8_t freq, size_t *freed);
+
+  /// \brief Read a spilled row from disk into the staging area
+  Status StageRow(key_type key);
+
+  /// \brief Drop all the read ahead keys and staged rows. Caller must hold tier_mux_
+  void ResetReadAhead();
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
-  std::atomic<uint64_t> soft_mem_limit_;  // the available memory in the machine
-  std::atomic<uint64_t> temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
-                                          // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
-  uint64_t min_avail_mem_;                // lower bound of the available memory
+  const int32_t num_workers_;
+  std::mutex mem_mux_;       // guards the memory accounting below, which the inserts and the tiering task update
+  uint64_t soft_mem_limit_;  // the available memory in the machine
+  uint64_t temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
+                             // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
+  uint64_t min_avail_mem_;   // lower bound of the available memory
+  uint64_t mem_usage_;       // memory taken by the rows in memory
+  uint64_t mem_cap_;         // cap on mem_usage_, 0 if not capped
   const int kMemoryCapAdjustInterval = 104857600;
+
+  // Tiering of rows, only used if spilling to disk is enabled.
+  std::unique_ptr<std::atomic<uint8_t>[]> freq_sketch_;  // approximate access frequency of the rows
+  // The readers record the accesses and consume the rows read ahead, hence the mutable members below.
+  mutable std::atomic<uint64_t> num_access_;
+  std::atomic<key_type> max_key_;  // the clock hand goes around [0, max_key_] to find the rows to demote
+  key_type clock_hand_;
+  mutable std::mutex tier_mux_;
+  mutable CondVar tier_cv_;
+  mutable bool aging_pending_;  // the frequencies are due to be halved by the tiering worker
+  mutable std::deque<key_type> promote_keys_;
+  std::deque<key_type> read_ahead_keys_;
+  mutable std::unordered_set<key_type> read_ahead_pending_;  // keys in read_ahead_keys_ which are not consumed yet
+  mutable std::unordered_map<key_type, std::vector<uint8_t>> staged_rows_;
+  mutable size_t staged_bytes_;
+  key_type staging_key_;            // key being read ahead by the tiering worker, -1 if none
+  mutable bool staging_cancelled_;  // the row being read ahead has been fetched in the meantime
+  std::atomic<int64_t> num_promoted_;
+  std::atomic<int64_t> num_demoted_;
+  mutable std::atomic<int64_t> num_read_ahead_hit_;
+  TaskGroup tier_tg_;
 };
 }  // namespace dataset
 }  // namespace mindspore
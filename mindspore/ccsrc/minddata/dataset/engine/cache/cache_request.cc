@@ -139,6 +139,9 @@ CacheRowRequest::CacheRowRequest(const CacheClient *cc)
 
 BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id)
     : BaseRequest(RequestType::kBatchFetchRows), support_local_bypass_(cc->local_bypass_), row_id_(row_id) {
+  if (support_local_bypass_ && cc->zero_copy_fetch_) {
+    zero_copy_comm_ = cc->comm_;
+  }
   rq_.set_connection_id(cc->server_connection_id_);
   rq_.set_client_id(cc->client_id_);
   rq_.set_flag(support_local_bypass_ ? kLocalClientSupport : 0);
@@ -152,6 +155,21 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
+ReadAheadRowsRequest::ReadAheadRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id, bool reset)
+    : BaseRequest(RequestType::kReadAheadRows) {
+  rq_.set_connection_id(cc->server_connection_id_);
+  rq_.set_client_id(cc->client_id_);
+  // First piece of data is the row id, followed by the reset flag.
+  flatbuffers::FlatBufferBuilder fbb;
+  auto off_t = fbb.CreateVector(row_id);
+  TensorRowIdsBuilder bld(fbb);
+  bld.add_row_id(off_t);
+  auto off = bld.Finish();
+  fbb.Finish(off);
+  rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
+  rq_.add_buf_data(reset ? "reset" : "append");
+}
+
 Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto num_elements = row_id_.size();
@@ -173,36 +191,34 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
   sz = offset_array[num_elements];
   CHECK_FAIL_RETURN_UNEXPECTED(support_local_bypass_ || sz == reply_.result().length(), "Length mismatch");
-  TensorTable tbl;
-  tbl.reserve(num_elements);
-  ReadableSlice all(ptr, sz);
-  for (auto i = 0; i < num_elements; ++i) {
-    auto len = offset_array[i + 1] - offset_array[i];
-    TensorRow row;
-    row.setId(row_id_.at(i));
-    if (len > 0) {
-      ReadableSlice row_data(all, offset_array[i], len);
-      // Next we de-serialize flat buffer to get back each column
-      auto msg = GetTensorRowHeaderMsg(row_data.GetPointer());
-      auto msg_sz = msg->size_of_this();
-      // Start of the tensor data
-      auto ts_offset = msg_sz;
-      row.reserve(msg->column()->size());
-      for (auto k = 0; k < msg->column()->size(); ++k) {
-        auto col_ts = msg->column()->Get(k);
-        std::shared_ptr<Tensor> ts;
-        ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
-        row.push_back(ts);
-        ts_offset += data.GetSize();
-      }
-    } else {
-      CHECK_FAIL_RETURN_UNEXPECTED(len == 0, "Data corruption detected.");
-    }
-    tbl.push_back(std::move(row));
+  // In zero copy mode, the tensors refer to the shared memory block in place, and the block is freed by the lease
+  // when the last of them is destroyed, rather than by the caller.
+  std::shared_ptr<SharedBlockLease> lease;
+  if (dataOnSharedMemory && zero_copy_comm_ != nullptr) {
+    auto comm = zero_copy_comm_;
+    auto connection_id = rq_.connection_id();
+    auto client_id = rq_.client_id();
+    lease = std::make_shared<SharedBlockLease>(*out_addr, [comm, connection_id, client_id](int64_t addr) {
+      FreeLeasedBlock(comm, connection_id, client_id, addr);
+    });
+    *out_addr = -1;
+  }
+  return RestoreTensorRows(ptr, row_id_, out, lease);
+}
+
+void BatchFetchRequest::FreeLeasedBlock(const std::shared_ptr<CacheClientGreeter> &comm,
+                                        connection_id_type connection_id, int32_t client_id, int64_t addr) {
+  // The server can only be told to free the block while the comm layer is still running.
+  if (comm->ServiceState() != Service::STATE::kRunning) {
+    MS_LOG(WARNING) << "Shared memory block " << addr << " outlives the cache client and can't be freed.";
+    return;
+  }
+  auto rq = std::make_shared<FreeSharedBlockRequest>(connection_id, client_id, addr);
+  // We won't wait for the result for the sake of performance.
+  Status rc = comm->HandleRequest(rq);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to free shared memory block " << addr << ". " << rc;
   }
-  *out = std::move(tbl);
-  return Status::OK();
 }
 
 CreateCacheRequest::CreateCacheRequest(CacheClient *cc, const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
@@ -303,6 +319,9 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_promoted = msg->num_promoted();
+  stat_.num_demoted = msg->num_demoted();
+  stat_.num_read_ahead_hit = msg->num_read_ahead_hit();
   return Status::OK();
 }
 
@@ -331,6 +350,9 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_promoted = current_session_info->stats()->num_promoted();
+    stats.num_demoted = current_session_info->stats()->num_demoted();
+    stats.num_read_ahead_hit = current_session_info->stats()->num_read_ahead_hit();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
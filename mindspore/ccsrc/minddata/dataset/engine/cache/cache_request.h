@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_REQ_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <iostream>
 #include <string>
@@ -30,12 +31,14 @@
 #include "proto/cache_grpc.pb.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/wait_post.h"
 
 namespace mindspore {
 namespace dataset {
 class CacheClient;
+class CacheClientGreeter;
 /// \brief Statistic structure for GetStat request
 struct CacheServiceStat {
   int64_t num_mem_cached;
@@ -45,6 +48,9 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_promoted;
+  int64_t num_demoted;
+  int64_t num_read_ahead_hit;
 };
 
 struct CacheServerCfgInfo {
@@ -87,6 +93,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kReadAheadRows = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -136,7 +143,7 @@ class BaseRequest {
   bool IsRowRequest() const {
     return type_ == RequestType::kBatchCacheRows || type_ == RequestType::kBatchFetchRows ||
            type_ == RequestType::kInternalCacheRow || type_ == RequestType::kInternalFetchRow ||
-           type_ == RequestType::kCacheRow;
+           type_ == RequestType::kCacheRow || type_ == RequestType::kReadAheadRows;
   }
 
   /// \brief Return if the request is of admin request type
@@ -179,6 +186,34 @@ class FreeSharedBlockRequest : public BaseRequest {
   ~FreeSharedBlockRequest() override = default;
 };
 
+/// \brief A lease on a shared memory block which holds the rows fetched in zero copy mode. Tensors restored from the
+/// block refer to the data in place and hold the lease as their memory pool. The block is given back to the server
+/// when the last of these tensors is destroyed.
+class SharedBlockLease : public MemoryPool {
+ public:
+  /// \param addr Offset of the shared memory block
+  /// \param release Function to give the block back, called once when the lease is destroyed
+  SharedBlockLease(int64_t addr, std::function<void(int64_t)> release) : addr_(addr), release_(std::move(release)) {}
+  ~SharedBlockLease() override {
+    if (release_ != nullptr) {
+      release_(addr_);
+    }
+  }
+
+  Status Allocate(size_t, void **) override { RETURN_STATUS_UNEXPECTED("Can't allocate from a shared block lease"); }
+  Status Reallocate(void **, size_t, size_t) override {
+    RETURN_STATUS_UNEXPECTED("Can't reallocate from a shared block lease");
+  }
+  // Tensors don't free their own piece of the block. The whole block is freed in the destructor.
+  void Deallocate(void *) override {}
+  uint64_t get_max_size() const override { return 0; }
+  int PercentFree() const override { return 0; }
+
+ private:
+  int64_t addr_;
+  std::function<void(int64_t)> release_;
+};
+
 /// \brief Request to cache a single TensorRow
 class CacheRowRequest : public BaseRequest {
  public:
@@ -233,11 +268,32 @@ class BatchFetchRequest : public BaseRequest {
   friend class CacheService;
   BatchFetchRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id);
   ~BatchFetchRequest() override = default;
+
+  /// \brief Restore the fetched rows from the reply
+  /// \param[out] out The fetched rows
+  /// \param[in] baseAddr Base address of the shared memory
+  /// \param[out] out_addr Offset of the shared memory block to be freed by the caller, -1 if there is none. In zero
+  ///     copy mode, the block is leased to the restored tensors and -1 is returned.
+  /// \return Status object
   Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
 
  private:
+  /// \brief Give a block leased to the fetched tensors back to the server. The comm layer is captured by the lease,
+  ///     which keeps the shared memory attached until then.
+  static void FreeLeasedBlock(const std::shared_ptr<CacheClientGreeter> &comm, connection_id_type connection_id,
+                              int32_t client_id, int64_t addr);
+
   bool support_local_bypass_;
   std::vector<row_id_type> row_id_;
+  std::shared_ptr<CacheClientGreeter> zero_copy_comm_;  // not null if the rows are fetched in zero copy mode
+};
+
+/// \brief Request to read ahead the spilled rows in the order they are going to be fetched
+class ReadAheadRowsRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  ReadAheadRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id, bool reset);
+  ~ReadAheadRowsRequest() override = default;
 };
 
 /// \brief Request to create a cache for the current connection
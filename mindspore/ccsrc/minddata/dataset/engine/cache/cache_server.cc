@@ -437,6 +437,9 @@ Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuil
   int64_t data_offset = (num_elements + 1) * sizeof(int64_t);
   auto *offset_array = reinterpret_cast<int64_t *>(out->GetMutablePointer());
   offset_array[0] = data_offset;
+  // Spilled rows are not dispatched to the workers one by one, but read from disk in one batch.
+  std::vector<row_id_type> spilled_keys;
+  std::vector<WritableSlice> spilled_dest;
   for (uint32_t i = 0; i < num_elements; ++i) {
     auto data_locator = p->rows()->Get(i);
     auto node_id = data_locator->node_id();
@@ -448,7 +451,10 @@ Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuil
     // not run into false sharing problem. We are going to round up sz to 4k.
     auto sz_4k = round_up_4K(sz);
     offset_array[i + 1] = offset_array[i] + sz_4k;
-    if (sz > 0) {
+    if (sz > 0 && data_locator->spilled()) {
+      spilled_keys.push_back(key);
+      spilled_dest.emplace_back(*out, offset_array[i], sz);
+    } else if (sz > 0) {
       WritableSlice row_data(*out, offset_array[i], sz);
       // Get a request and send to the proper worker (at some numa node) to do the fetch.
       worker_id_t worker_id = IsNumaAffinityOn() ? GetWorkerByNumaId(node_id) : GetRandomWorker();
@@ -476,6 +482,21 @@ Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuil
       RETURN_IF_NOT_OK(batch_wait->Set(Status::OK()));
     }
   }
+  if (!spilled_keys.empty()) {
+    Status rc;
+    {
+      SharedLock lck(&rwLock_);
+      CacheService *cs = GetService(connection_id);
+      if (cs == nullptr) {
+        rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, "Connection " + std::to_string(connection_id) + " not found");
+      } else {
+        rc = cs->InternalFetchRows(spilled_keys, &spilled_dest);
+      }
+    }
+    for (size_t i = 0; i < spilled_keys.size(); ++i) {
+      RETURN_IF_NOT_OK(batch_wait->Set(rc));
+    }
+  }
   // Now wait for all of them to come back.
   RETURN_IF_NOT_OK(batch_wait->Wait());
   // Return the result
@@ -577,6 +598,9 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_promoted(svc_stat.stat_.num_promoted);
+    bld.add_num_demoted(svc_stat.stat_.num_demoted);
+    bld.add_num_read_ahead_hit(svc_stat.stat_.num_read_ahead_hit);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -694,6 +718,29 @@ Status CacheServer::ToggleWriteMode(CacheRequest *rq) {
   return Status::OK();
 }
 
+Status CacheServer::ReadAheadRows(CacheRequest *rq) {
+  auto connection_id = rq->connection_id();
+  // Hold the shared lock to prevent the cache from being dropped.
+  SharedLock lck(&rwLock_);
+  CacheService *cs = GetService(connection_id);
+  if (cs == nullptr) {
+    std::string errMsg = "Cache id " + std::to_string(connection_id) + " not found";
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  } else {
+    CHECK_FAIL_RETURN_UNEXPECTED(rq->buf_data_size() == 2, "Missing row id or reset flag");
+    auto p = flatbuffers::GetRoot<TensorRowIds>(rq->buf_data(0).data());
+    std::vector<row_id_type> row_id;
+    auto sz = p->row_id()->size();
+    row_id.reserve(sz);
+    for (uint32_t i = 0; i < sz; ++i) {
+      row_id.push_back(p->row_id()->Get(i));
+    }
+    bool reset = (rq->buf_data(1) == "reset");
+    RETURN_IF_NOT_OK(cs->ReadAhead(row_id, reset));
+  }
+  return Status::OK();
+}
+
 Status CacheServer::ListSessions(CacheReply *reply) {
   SharedLock sess_lck(&sessions_lock_);
   SharedLock lck(&rwLock_);
@@ -710,7 +757,9 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.stat_.num_promoted, svc_stat.stat_.num_demoted,
+                                                  svc_stat.stat_.num_read_ahead_hit);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -832,6 +881,10 @@ Status CacheServer::ProcessRowRequest(CacheServerRequest *cache_req, bool *inter
       cache_req->rc_ = InternalFetchRow(&rq);
       break;
     }
+    case BaseRequest::RequestType::kReadAheadRows: {
+      cache_req->rc_ = ReadAheadRows(&rq);
+      break;
+    }
     default:
       std::string errMsg("Internal error, request type is not row request: ");
       errMsg += std::to_string(static_cast<uint16_t>(cache_req->type_));
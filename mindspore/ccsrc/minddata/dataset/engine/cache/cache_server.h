@@ -406,6 +406,9 @@ class CacheServer : public Service {
   /// \brief Toggle write mode for a service
   Status ToggleWriteMode(CacheRequest *rq);
 
+  /// \brief Read ahead the spilled rows of a service
+  Status ReadAheadRows(CacheRequest *rq);
+
   /// \brief List the sessions and their caches
   /// \param reply
   /// \return Status object
@@ -53,7 +53,7 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, cs.GetNumWorkers());
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -230,6 +230,15 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
   return Status::OK();
 }
 
+Status CacheService::ReadAhead(const std::vector<row_id_type> &v, bool reset) {
+  SharedLock rw(&rw_lock_);
+  // Rows are still being cached. Nothing to read ahead yet.
+  if (HasBuildPhase() && st_ != CacheServiceState::kFetchPhase) {
+    return Status::OK();
+  }
+  return cp_->ReadAhead(v, reset);
+}
+
 Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
                                    const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb) {
   SharedLock rw(&rw_lock_);
@@ -280,6 +289,22 @@ Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   return Status::OK();
 }
 
+Status CacheService::InternalFetchRows(const std::vector<row_id_type> &keys, std::vector<WritableSlice> *dest) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  SharedLock rw(&rw_lock_);
+  std::vector<size_t> bytesRead;
+  RETURN_IF_NOT_OK(cp_->BatchRead(keys, dest, &bytesRead));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (bytesRead[i] != (*dest)[i].GetSize()) {
+      std::string errMsg = "Unexpected length. Read " + std::to_string(bytesRead[i]) + ". Expected " +
+                           std::to_string((*dest)[i].GetSize()) + "." + " Internal key: " + std::to_string(keys[i]);
+      MS_LOG(ERROR) << errMsg;
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+  }
+  return Status::OK();
+}
+
 Status CacheService::CacheSchema(const void *buf, int64_t len) {
   UniqueLock rw(&rw_lock_);
   // In case we are calling the same function from multiple threads, only
@@ -75,6 +75,12 @@ class CacheService : public Service {
   Status PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
                        const std::shared_ptr<flatbuffers::FlatBufferBuilder> &);
 
+  /// \brief Read ahead the spilled rows in the order they are going to be fetched
+  /// \param[in] v A vector of row id in the order of fetching
+  /// \param[in] reset Drop the rows read ahead previously
+  /// \return Status object
+  Status ReadAhead(const std::vector<row_id_type> &v, bool reset);
+
   /// \brief Getter function
   /// \return Spilling path
   Path GetSpillPath() const;
@@ -145,6 +151,12 @@ class CacheService : public Service {
   row_id_type GetNextRowId() { return next_id_.fetch_add(1); }
 
   Status InternalFetchRow(const FetchRowMsg *p);
+
+  /// \brief Fetch a batch of rows at once. Used for the spilled rows so that they are read from disk in one batch.
+  /// \param[in] keys Row ids
+  /// \param[in] dest Destination of each row, which must be of the exact size of the row
+  /// \return Status object
+  Status InternalFetchRows(const std::vector<row_id_type> &keys, std::vector<WritableSlice> *dest);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -63,7 +63,10 @@ void CachePerfRun::PrintHelp() {
                "       --connection:     Set number of TCP/IP connections per pipeline. Default = "
             << kDftNumConnections << "\n"
             << "       --port:           TCP/IP port of the cache server. Default = " << kCfgDefaultCachePort << "\n"
-            << "       --hostname:       Hostname of the cache server. Default = " << kCfgDefaultCacheHost << "\n";
+            << "       --hostname:       Hostname of the cache server. Default = " << kCfgDefaultCacheHost << "\n"
+            << "       --zero_copy:      Fetch rows in zero copy mode. Default = false\n"
+            << "       --spill_stress:   Spill most of the rows to disk by limiting the cache size to 1/"
+            << kSpillStressMemRatio << " of the data. Can't be used with --cache_size\n";
 }
 
 int32_t CachePerfRun::ProcessArgsHelper(int32_t opt) {
@@ -198,6 +201,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 
   int shuffle = 0;
   int spill = 0;
+  int zero_copy = 0;
+  int spill_stress = 0;
 
   const char *const short_opts = ":n:e:p:a:s:r:w:";
   const option long_opts[] = {{"pipeline", required_argument, nullptr, 'n'},
@@ -211,6 +216,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
                               {"port", required_argument, nullptr, port_opt},
                               {"hostname", required_argument, nullptr, hostname_opt},
                               {"spill", no_argument, &spill, 1},
+                              {"zero_copy", no_argument, &zero_copy, 1},
+                              {"spill_stress", no_argument, &spill_stress, 1},
                               {"connection", required_argument, nullptr, connect_opt},
                               {"help", no_argument, nullptr, 'h'},
                               {nullptr, no_argument, nullptr, 0}};
@@ -249,6 +256,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
           shuffle_ = true;
         } else if (long_opts[option_indxex].flag == &spill) {
           cache_builder_.SetSpill(true);
+        } else if (long_opts[option_indxex].flag == &zero_copy) {
+          cache_builder_.SetZeroCopyFetch(true);
         }
         continue;
       }
@@ -268,6 +277,16 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
     return rc;
   }
 
+  if (spill_stress) {
+    if (seen_opts.find('a') != seen_opts.end()) {
+      std::cerr << "The spill_stress argument can't be used with cache_size." << std::endl;
+      return -1;
+    }
+    // Only a small portion of the rows can be cached in memory. The rest go through the spill path.
+    int64_t data_sz = static_cast<int64_t>(num_rows_) * row_size_ / 1048576L;
+    cache_builder_.SetSpill(true).SetCacheMemSz(std::max<int64_t>(1, data_sz / kSpillStressMemRatio));
+  }
+
   pid_lists_.reserve(num_pipelines_);
   return 0;
 }
@@ -345,14 +364,15 @@ CachePerfRun::~CachePerfRun() {
 void CachePerfRun::PrintEpochSummary() const {
   std::cout << std::setw(12) << "Pipeline #" << std::setw(10) << "worker id" << std::setw(11) << "min (μs)"
             << std::setw(11) << "max (μs)" << std::setw(11) << "avg (μs)" << std::setw(14) << "median (μs)"
-            << std::setw(14) << "buffer count" << std::setw(18) << "Elapsed time (s)" << std::endl;
+            << std::setw(14) << "buffer count" << std::setw(18) << "Elapsed time (s)" << std::setw(16) << "avg cpu (μs)"
+            << std::endl;
   for (auto &it : epoch_results_) {
     auto epoch_worker_summary = it.second;
     std::cout << std::setw(12) << (epoch_worker_summary.pipeline() + 1) << std::setw(10)
               << epoch_worker_summary.worker() << std::setw(10) << epoch_worker_summary.min() << std::setw(10)
               << epoch_worker_summary.max() << std::setw(10) << epoch_worker_summary.avg() << std::setw(13)
               << epoch_worker_summary.med() << std::setw(14) << epoch_worker_summary.cnt() << std::setw(18)
-              << epoch_worker_summary.elapse() << std::endl;
+              << epoch_worker_summary.elapse() << std::setw(15) << epoch_worker_summary.cpu() << std::endl;
   }
 }
 
@@ -454,7 +474,8 @@ Status CachePerfRun::StartPipelines() {
                                std::to_string(cache_builder_.GetPrefetchSize()) + "," +
                                std::to_string(cache_builder_.GetCacheMemSz()) + "," +
                                std::to_string(cache_builder_.GetNumConnections()) + "," +
-                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data());
+                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data()) +
+                               "," + (cache_builder_.IsZeroCopyFetch() ? "true" : "false");
       char *argv[4];
       argv[0] = const_cast<char *>(kCachePipelineBinary);
       argv[1] = pipeline_cfg.data();
@@ -45,6 +45,8 @@ constexpr int32_t kDftNumberOfEpochs = 10;
 constexpr int32_t kDftCacheSize = 0;
 constexpr bool kDftShuffle = false;
 constexpr bool kDftSpill = false;
+// With --spill_stress, only 1/kSpillStressMemRatio of the data fits in memory.
+constexpr int64_t kSpillStressMemRatio = 8;
 
 class CachePerfRun {
  public:
@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/engine/cache/perf/cache_pipeline_run.h"
 
+#include <time.h>
 #include <algorithm>
 
 #include "minddata/dataset/core/tensor.h"
@@ -25,6 +26,19 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Cpu time consumed by the calling thread in microseconds.
+int64_t ThreadCpuTimeInMicroSec() {
+  struct timespec ts {};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0;
+  }
+  constexpr int64_t kMicroSecPerSec = 1000000;
+  constexpr int64_t kNanoSecPerMicroSec = 1000;
+  return static_cast<int64_t>(ts.tv_sec) * kMicroSecPerSec + ts.tv_nsec / kNanoSecPerMicroSec;
+}
+}  // namespace
+
 void CachePipelineRun::PrintHelp() { std::cout << "Please run the executable cache_perf instead." << std::endl; }
 
 int32_t CachePipelineRun::ProcessPipelineArgs(char *argv) {
@@ -88,11 +102,13 @@ int32_t CachePipelineRun::ProcessClientArgs(char *argv) {
         cache_builder_.SetNumConnections(std::stoi(s));
       } else if (numArgs == 5) {
         cache_builder_.SetSpill(strcmp(s.data(), "true") == 0);
+      } else if (numArgs == 6) {
+        cache_builder_.SetZeroCopyFetch(strcmp(s.data(), "true") == 0);
       }
       ++numArgs;
     }
-    if (numArgs != 6) {
-      std::cerr << "Incomplete arguments. Expect 6. But get " << numArgs << std::endl;
+    if (numArgs != 7) {
+      std::cerr << "Incomplete arguments. Expect 7. But get " << numArgs << std::endl;
       return -1;
     }
   } catch (const std::exception &e) {
@@ -342,6 +358,7 @@ Status CachePipelineRun::WriterWorkerEntry(int32_t worker_id) {
     // average
     int64_t avg = total_val / sz;
     proto.set_avg(avg);
+    proto.set_cpu(total_cpu / static_cast<int64_t>(sz));
   }
   CachePerfMsg msg;
   RETURN_IF_NOT_OK(SendMessage(&msg, CachePerfMsg::MessageType::kEpochResult, &proto));
@@ -408,6 +425,7 @@ Status CachePipelineRun::ReaderWorkerEntry(int32_t worker_id) {
   int64_t min_val = std::numeric_limits<int64_t>::max();
   int64_t max_val = 0;
   int64_t total_val = 0;
+  int64_t total_cpu = 0;
   int64_t cnt = 0;
   std::vector<int64_t> duration;
   duration.reserve(num_rows_ / num_pipelines_ / cfg_.num_parallel_workers());
@@ -436,10 +454,12 @@ Status CachePipelineRun::ReaderWorkerEntry(int32_t worker_id) {
     }
     // Get the rows from the server
     TensorTable ttbl;
-    // Measure how long it takes for the row to come back.
+    // Measure how long it takes for the row to come back, and how much cpu time this worker spends on it.
     auto start_tick = std::chrono::steady_clock::now();
+    auto start_cpu = ThreadCpuTimeInMicroSec();
     RETURN_IF_NOT_OK(cc_->GetRows(prefetch_keys, &ttbl));
     auto end_tick = std::chrono::steady_clock::now();
+    total_cpu += ThreadCpuTimeInMicroSec() - start_cpu;
     int64_t ms = std::chrono::duration_cast<std::chrono::microseconds>(end_tick - start_tick).count();
     min_val = std::min(min_val, ms);
     max_val = std::max(max_val, ms);
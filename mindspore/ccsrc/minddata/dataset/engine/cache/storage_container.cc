@@ -15,7 +15,9 @@
  */
 #include "minddata/dataset/engine/cache/storage_container.h"
 
+#include <sys/uio.h>
 #include <unistd.h>
+#include <algorithm>
 #include <vector>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -81,6 +83,41 @@ Status StorageContainer::Read(WritableSlice *dest, off64_t offset) const noexcep
   return Status::OK();
 }
 
+Status StorageContainer::ReadV(std::vector<Extent> *extents) const noexcept {
+  MS_ASSERT(is_open_);
+  RETURN_UNEXPECTED_IF_NULL(extents);
+#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
+  // No preadv64. Read them one by one.
+  for (auto &e : *extents) {
+    RETURN_IF_NOT_OK(Read(&e.second, e.first));
+  }
+#else
+  std::sort(extents->begin(), extents->end(), [](const Extent &a, const Extent &b) { return a.first < b.first; });
+  std::vector<struct iovec> iov;
+  size_t i = 0;
+  while (i < extents->size()) {
+    off64_t offset = (*extents)[i].first;
+    off64_t end = offset;
+    size_t sz = 0;
+    iov.clear();
+    // Coalesce the extents which are next to each other on disk into one system call.
+    while (i < extents->size() && (*extents)[i].first == end && iov.size() < IOV_MAX) {
+      auto &dest = (*extents)[i].second;
+      iov.push_back({dest.GetMutablePointer(), dest.GetSize()});
+      end += static_cast<off64_t>(dest.GetSize());
+      sz += dest.GetSize();
+      ++i;
+    }
+    auto r_sz = preadv64(fd_, iov.data(), static_cast<int>(iov.size()), offset);
+    if (r_sz != sz) {
+      errno_t err = (r_sz == 0) ? EOF : errno;
+      RETURN_STATUS_UNEXPECTED(strerror(err));
+    }
+  }
+#endif
+  return Status::OK();
+}
+
 Status StorageContainer::Write(const ReadableSlice &dest, off64_t offset) const noexcept {
   MS_ASSERT(is_open_);
   auto sz = dest.GetSize();
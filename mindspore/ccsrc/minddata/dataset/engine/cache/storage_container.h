@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include "minddata/dataset/util/system_pool.h"
 #include "minddata/dataset/util/buddy.h"
@@ -36,6 +37,9 @@ class StorageContainer {
  public:
   friend class StorageManager;
 
+  /// \brief An extent of the container and the buffer it is read into
+  using Extent = std::pair<off64_t, WritableSlice>;
+
   ~StorageContainer() noexcept;
 
   StorageContainer(const StorageContainer &) = delete;
@@ -54,6 +58,12 @@ class StorageContainer {
 
   Status Read(WritableSlice *dest, off64_t offset) const noexcept;
 
+  /// \brief Read a list of extents. The extents are sorted by their offsets, and the adjacent ones are read by a
+  /// single vectored read.
+  /// \param[in,out] extents Extents to read. They will be sorted on return.
+  /// \return Status object
+  Status ReadV(std::vector<Extent> *extents) const noexcept;
+
   Status Truncate() const noexcept;
 
   bool IsOpen() const { return is_open_; }
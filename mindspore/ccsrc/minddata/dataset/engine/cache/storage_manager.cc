@@ -15,7 +15,9 @@
  */
 #include "minddata/dataset/engine/cache/storage_manager.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <map>
 
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -64,9 +66,25 @@ Status StorageManager::DoServiceStart() {
   } else {
     RETURN_STATUS_UNEXPECTED("Not a directory");
   }
+  // Spin up the I/O workers for batch read.
+  auto num_io_workers = std::min<size_t>(pool_size_, kMaxNumIoWorkers);
+  io_que_ = std::make_unique<Queue<std::shared_ptr<ReadJob>>>(kMaxNumContainers);
+  RETURN_IF_NOT_OK(io_que_->Register(&io_tg_));
+  for (size_t i = 0; i < num_io_workers; ++i) {
+    RETURN_IF_NOT_OK(io_tg_.CreateAsyncTask("Storage I/O worker", std::bind(&StorageManager::IoWorker, this)));
+  }
   return Status::OK();
 }
 
+Status StorageManager::IoWorker() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    std::shared_ptr<ReadJob> job;
+    RETURN_IF_NOT_OK(io_que_->PopFront(&job));
+    job->wait->Set(job->cont->ReadV(&job->extents));
+  }
+}
+
 Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &buf) {
   RETURN_UNEXPECTED_IF_NULL(key);
   size_t sz = 0;
@@ -154,9 +172,63 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::Read(const std::vector<key_type> &keys, std::vector<WritableSlice> *dest,
+                            std::vector<size_t> *bytesRead) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  RETURN_UNEXPECTED_IF_NULL(bytesRead);
+  CHECK_FAIL_RETURN_UNEXPECTED(keys.size() == dest->size(), "Number of keys and destination buffers mismatch");
+  bytesRead->assign(keys.size(), 0);
+  // Group the extents by their containers.
+  std::map<size_t, std::vector<StorageContainer::Extent>> extents;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto r = index_.Search(keys[i]);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    value_type v = *(r.first);
+    size_t container_inx = v.first;
+    off_t offset = v.second.first;
+    size_t sz = v.second.second;
+    auto &buf = (*dest)[i];
+    if (buf.GetSize() < sz) {
+      std::string errMsg = "Destination buffer too small. Expect at least " + std::to_string(sz) +
+                           " but length = " + std::to_string(buf.GetSize());
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+    (*bytesRead)[i] = sz;
+    extents[container_inx].emplace_back(offset, WritableSlice(buf, 0, sz));
+  }
+  if (extents.empty()) {
+    return Status::OK();
+  }
+  // Hand all the containers but the first one to the I/O workers, and read the first one ourselves.
+  auto wait = std::make_shared<BatchReadWait>(extents.size() - 1);
+  auto it = extents.begin();
+  for (++it; it != extents.end(); ++it) {
+    auto job = std::make_shared<ReadJob>();
+    job->cont = containers_.at(it->first);
+    job->extents = std::move(it->second);
+    job->wait = wait;
+    RETURN_IF_NOT_OK(io_que_->Add(std::move(job)));
+  }
+  Status rc = containers_.at(extents.begin()->first)->ReadV(&extents.begin()->second);
+  if (extents.size() > 1) {
+    Status rc2 = wait->Wait();
+    if (rc.IsOk()) {
+      rc = rc2;
+    }
+  }
+  return rc;
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
+  // Stop the I/O workers before we truncate the containers.
+  io_tg_.interrupt_all();
+  rc = io_tg_.join_all(Task::WaitFlag::kNonBlocking);
+  if (rc.IsError()) {
+    rc1 = rc;
+  }
+  io_que_.reset();
   for (auto const &p : containers_) {
     // The destructor of StorageContainer is not called automatically until the use
     // count drops to 0. But it is not always the case. We will do it ourselves.
@@ -19,6 +19,7 @@
 #include <unistd.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,8 +30,11 @@
 #include "minddata/dataset/util/lock.h"
 #include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/wait_post.h"
 
 using ListOfContainers = std::vector<std::shared_ptr<mindspore::dataset::StorageContainer>>;
 
@@ -51,6 +55,7 @@ class StorageManager : public Service {
   using storage_index = AutoIndexObj<value_type, std::allocator<value_type>, StorageBPlusTreeTraits>;
   using key_type = storage_index::key_type;
   constexpr static int32_t kMaxNumContainers = 1000;
+  constexpr static int32_t kMaxNumIoWorkers = 8;
 
   explicit StorageManager(const Path &);
 
@@ -66,6 +71,14 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Read a batch of buffers in one call. The buffers in the same container are read with as few system calls
+  /// as possible, and the containers are read concurrently by the I/O workers.
+  /// \param[in] keys Keys of the buffers
+  /// \param[in] dest Destination of each buffer
+  /// \param[out] bytesRead Size of each buffer
+  /// \return Status object
+  Status Read(const std::vector<key_type> &keys, std::vector<WritableSlice> *dest, std::vector<size_t> *bytesRead);
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -73,6 +86,41 @@ class StorageManager : public Service {
   friend std::ostream &operator<<(std::ostream &os, const StorageManager &s);
 
  private:
+  /// \brief Wait for all the parts of a batch read to finish
+  class BatchReadWait {
+   public:
+    explicit BatchReadWait(int64_t n) : num_left_(n) {}
+    ~BatchReadWait() = default;
+
+    void Set(const Status &rc) {
+      std::unique_lock<std::mutex> lck(mux_);
+      if (rc.IsError() && rc_.IsOk()) {
+        rc_ = rc;
+      }
+      if (--num_left_ == 0) {
+        wp_.Set();
+      }
+    }
+
+    Status Wait() {
+      RETURN_IF_NOT_OK(wp_.Wait());
+      return rc_;
+    }
+
+   private:
+    std::mutex mux_;
+    WaitPost wp_;
+    int64_t num_left_;
+    Status rc_;
+  };
+
+  /// \brief Extents of one container to be read by an I/O worker
+  struct ReadJob {
+    std::shared_ptr<StorageContainer> cont;
+    std::vector<StorageContainer::Extent> extents;
+    std::shared_ptr<BatchReadWait> wait;
+  };
+
   Path root_;
   ListOfContainers containers_;
   int file_id_;
@@ -80,6 +128,8 @@ class StorageManager : public Service {
   storage_index index_;
   std::vector<size_t> writable_containers_pool_;
   size_t pool_size_;
+  TaskGroup io_tg_;
+  std::unique_ptr<Queue<std::shared_ptr<ReadJob>>> io_que_;
 
   static std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
@@ -91,6 +141,9 @@ class StorageManager : public Service {
   /// container in the pool. If not provided, will just append the newly created container to the end of the pool.
   /// \return Status object
   Status AddOneContainer(int replaced_container_pos = -1);
+
+  /// \brief Entry function of the I/O workers serving the batch read
+  Status IoWorker();
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -23,6 +23,7 @@
 #endif
 
 #include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/util/buffer_ring.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -165,7 +166,7 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
-                          bool concat_batch) {
+                          bool concat_batch, const std::shared_ptr<MemoryPool> &pool) {
   RETURN_UNEXPECTED_IF_NULL(src);
   RETURN_UNEXPECTED_IF_NULL(dest);
   if ((*src)->size() != batch_size) {
@@ -188,7 +189,7 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
   auto num_columns = (*src)->front().size();
   for (size_t i = 0; i < num_columns; i++) {
     std::shared_ptr<Tensor> new_tensor;
-    RETURN_IF_NOT_OK(ConvertRowsToTensor(src, &new_tensor, batch_size, i));
+    RETURN_IF_NOT_OK(ConvertRowsToTensor(src, &new_tensor, batch_size, i, pool));
     dest->emplace_back(new_tensor);
   }
 
@@ -196,7 +197,7 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
 }
 
 Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, std::shared_ptr<Tensor> *dst,
-                                    dsize_t batch_size, size_t col) {
+                                    dsize_t batch_size, size_t col, const std::shared_ptr<MemoryPool> &pool) {
   RETURN_UNEXPECTED_IF_NULL(src);
   RETURN_UNEXPECTED_IF_NULL(dst);
   std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(col);  // first row, column i
@@ -206,7 +207,20 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, st
 
   std::shared_ptr<Tensor> new_tensor;
   if (first_type.IsNumeric()) {  // numeric tensor
-    RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+    auto num_bytes = static_cast<dsize_t>(first_type.SizeInBytes()) * new_shape.NumOfElements();
+    if (pool != nullptr && num_bytes > 0) {
+      // The rows are copied straight into a buffer of the pool, which gets it back when the batch is consumed
+      void *buf = nullptr;
+      RETURN_IF_NOT_OK(pool->Allocate(static_cast<size_t>(num_bytes), &buf));
+      Status rc = Tensor::CreateFromExternalMemory(new_shape, first_type, static_cast<uchar *>(buf), num_bytes, pool,
+                                                   &new_tensor);
+      if (rc.IsError()) {
+        pool->Deallocate(buf);
+        return rc;
+      }
+    } else {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+    }
     dsize_t j = 0;
     for (auto row : **src) {
       std::shared_ptr<Tensor> old_tensor = row.at(col);  // row j, column i
@@ -241,6 +255,13 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, st
 
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
+  // Each worker owns the ring of the buffers its batches are assembled in. The ring outlives the worker as long as
+  // any of its batches is alive, e.g., queued in the device queue op.
+  std::shared_ptr<MemoryPool> pool = nullptr;
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  if (cfg->batch_buffer_ring_size() > 0) {
+    pool = std::make_shared<BufferRing>(cfg->batch_buffer_ring_size(), cfg->pin_batch_buffer());
+  }
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
   RETURN_IF_NOT_OK(worker_in_queues_[workerId]->PopFront(&table_pair));
   while (table_pair.second.ctrl_ != batchCtrl::kQuit) {
@@ -252,7 +273,7 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagWait)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       TensorRow new_row;
-      RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &new_row));
+      RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &new_row, pool));
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(std::move(new_row)));
     }
     RETURN_IF_NOT_OK(worker_in_queues_[workerId]->PopFront(&table_pair));
@@ -260,7 +281,8 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
   return Status::OK();
 }
 
-Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row) {
+Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row,
+                               const std::shared_ptr<MemoryPool> &pool) {
   RETURN_UNEXPECTED_IF_NULL(table_pair.first);
   bool concat_batch = false;
 #ifdef ENABLE_PYTHON
@@ -271,7 +293,7 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
   if (pad_) {
     RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));
   }  // do padding if needed
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size(), concat_batch));
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size(), concat_batch, pool));
   return Status::OK();
 }
 
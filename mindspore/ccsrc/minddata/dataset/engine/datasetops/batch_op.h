@@ -31,6 +31,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -198,18 +199,20 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
   // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const std::shared_ptr<MemoryPool> &pool - pool to allocate the numeric batched tensors from, if not null
   // @return Status The status code returned
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
-                          bool concat_batch = false);
+                          bool concat_batch = false, const std::shared_ptr<MemoryPool> &pool = nullptr);
 
   // convert the rows to tensor
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dst - dest_table to hold batched rows
   // @param int32_t size - batch_size
   // @param int32_t size - col
+  // @param const std::shared_ptr<MemoryPool> &pool - pool to allocate a numeric batched tensor from, if not null
   // @return Status The status code returned
   static Status ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, std::shared_ptr<Tensor> *dst,
-                                    dsize_t batch_size, size_t col);
+                                    dsize_t batch_size, size_t col, const std::shared_ptr<MemoryPool> &pool = nullptr);
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -244,8 +247,10 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   Status WorkerEntry(int32_t worker_id) override;
 
   // Generate row with batched tensors
+  // @param const std::shared_ptr<MemoryPool> &pool - pool of the worker to allocate the batched tensors from
   // @return Status The status code returned
-  Status MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row);
+  Status MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row,
+                        const std::shared_ptr<MemoryPool> &pool = nullptr);
 
 #ifdef ENABLE_PYTHON
   // Function that calls pyfunc to perform map on batch
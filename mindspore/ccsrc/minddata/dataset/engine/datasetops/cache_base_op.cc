@@ -94,8 +94,14 @@ Status CacheBase::FetchSamplesToWorkers() {
     prefetch_keys.reserve(prefetch_size_);
     TensorRow sample_row;
     RETURN_IF_NOT_OK(sampler_->GetNextSample(&sample_row));
+    // Drop the rows the server has read ahead for the previous epoch.
+    bool reset_read_ahead = true;
     while (!sample_row.eoe()) {
       std::shared_ptr<Tensor> sample_ids = sample_row[0];
+      // Let the server read ahead the spilled rows in the order of the sampler.
+      std::vector<row_id_type> read_ahead_keys(sample_ids->begin<int64_t>(), sample_ids->end<int64_t>());
+      RETURN_IF_NOT_OK(cache_client_->ReadAhead(read_ahead_keys, reset_read_ahead));
+      reset_read_ahead = false;
       for (auto itr = sample_ids->begin<int64_t>(); itr != sample_ids->end<int64_t>(); ++itr) {
         ++row_cnt_;
         prefetch_keys.push_back(*itr);
@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <stdexcept>
@@ -28,14 +29,18 @@
 
 namespace mindspore {
 namespace dataset {
+// Size of the blocks a file is read in when counting its rows
+constexpr size_t kCountRowsBlockSize = 1 << 20;
 
 CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
              const std::vector<std::shared_ptr<BaseRecord>> &column_default,
              const std::vector<std::string> &column_name, int32_t num_workers, int64_t num_samples,
              int32_t worker_connector_size, int32_t op_connector_size, bool shuffle_files, int32_t num_devices,
              int32_t device_id)
-    : NonMappableLeafOp(std::min(num_workers, static_cast<int32_t>(csv_files_list.size())), worker_connector_size,
-                        num_samples, op_connector_size, shuffle_files, num_devices, device_id),
+    : NonMappableLeafOp(GlobalContext::config_manager()->text_file_split_size() > 0
+                          ? num_workers
+                          : std::min(num_workers, static_cast<int32_t>(csv_files_list.size())),
+                        worker_connector_size, num_samples, op_connector_size, shuffle_files, num_devices, device_id),
       csv_files_list_(std::move(csv_files_list)),
       field_delim_(field_delim),
       column_default_list_(column_default),
@@ -242,6 +247,54 @@ int CsvOp::CsvParser::CountRows(int c) {
   return it->second.second(*this, c);
 }
 
+void CsvOp::CsvParser::CountRows(const char *data, size_t size, std::pair<int64_t, int64_t> *row_start) {
+  row_start->second = -1;
+  // A carriage return ends a line as a new line does, it is only looked for when the block has one
+  bool has_cr = memchr(data, '\r', size) != nullptr;
+  const char *begin = data;
+  const char *end = data + size;
+  const char *pos = begin;
+  while (pos < end) {
+    if (cur_state_ == State::QUOTE) {
+      // Nothing but a quote ends a quoted field, the new lines in it included
+      auto *quote = static_cast<const char *>(memchr(pos, '"', static_cast<size_t>(end - pos)));
+      if (quote == nullptr) {
+        break;
+      }
+      cur_state_ = State::SECOND_QUOTE;
+      pos = quote + 1;
+      continue;
+    }
+    char c = *pos;
+    if (c == '\r' || c == '\n') {
+      if (cur_state_ == State::UNQUOTE || cur_state_ == State::SECOND_QUOTE) {
+        (void)AddRow(c);
+        cur_state_ = State::END_OF_LINE;
+      }
+      ++pos;
+      continue;
+    }
+    if (cur_state_ == State::START_OF_FILE || cur_state_ == State::END_OF_LINE) {
+      *row_start = std::make_pair(total_rows_, static_cast<int64_t>(pos - begin));
+    }
+    if (c == '"') {
+      cur_state_ = State::QUOTE;
+      ++pos;
+      continue;
+    }
+    // Skip the rest of the unquoted field, up to the next quote or end of line
+    cur_state_ = State::UNQUOTE;
+    auto *stop = static_cast<const char *>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    stop = stop == nullptr ? end : stop;
+    if (has_cr) {
+      auto *cr = static_cast<const char *>(memchr(pos, '\r', static_cast<size_t>(stop - pos)));
+      stop = cr == nullptr ? stop : cr;
+    }
+    auto *quote = static_cast<const char *>(memchr(pos, '"', static_cast<size_t>(stop - pos)));
+    pos = quote == nullptr ? stop : quote;
+  }
+}
+
 Status CsvOp::CsvParser::InitCsvParser() {
   str_buf_.resize(CSV_BUFFER_SIZE);
   InitSDL();
@@ -483,11 +536,18 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open " + file + ", the file is damaged or permission denied.");
   }
-  if (column_name_list_.empty()) {
+  // Seek to the closest row before the start offset instead of parsing every row up to it, the header is before it
+  int64_t offset_row = 0;
+  int64_t offset = 0;
+  FindRowOffset(file, start_offset, &offset_row, &offset);
+  if (offset > 0) {
+    (void)ifs.seekg(offset, std::ios::beg);
+  } else if (column_name_list_.empty()) {
     std::string tmp;
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+  csv_parser.SetTotalRows(offset_row);
   try {
     while (ifs.good()) {
       // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
@@ -504,6 +564,10 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
                                  std::to_string(csv_parser.GetTotalRows() + 1) +
                                  ". Error message: " + csv_parser.GetErrorMessage());
       }
+      // The rows after the end offset are read by another worker, or not at all
+      if (csv_parser.GetTotalRows() >= end_offset) {
+        break;
+      }
     }
   } catch (std::invalid_argument &ia) {
     std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
@@ -566,10 +630,8 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        RETURN_IF_NOT_OK(
+          PushFileToBlockQueue(file_info.second, file_info.first, start_offset, end_offset, &queue_index));
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -633,11 +695,31 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     getline(ifs, tmp);
   }
   csv_parser.Reset();
-  while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.CountRows(chr) != 0) {
+  // Count the rows of the file block by block. When the file is to be split, the start of a row is recorded every
+  // file_split_size_ bytes, so that the workers can seek to it. These are the rows the quote aware state diagram
+  // counts, a new line in a quoted field never starts one.
+  std::vector<char> block(kCountRowsBlockSize);
+  std::vector<std::pair<int64_t, int64_t>> row_offsets;
+  int64_t block_offset = std::max(static_cast<int64_t>(ifs.tellg()), static_cast<int64_t>(0));
+  int64_t last_row_offset = block_offset;
+  while (ifs) {
+    (void)ifs.read(block.data(), static_cast<std::streamsize>(block.size()));
+    auto block_size = static_cast<size_t>(ifs.gcount());
+    if (block_size == 0) {
       break;
     }
+    std::pair<int64_t, int64_t> row_start;
+    csv_parser.CountRows(block.data(), block_size, &row_start);
+    if (file_split_size_ > 0 && row_start.second >= 0 &&
+        block_offset + row_start.second - last_row_offset >= file_split_size_) {
+      last_row_offset = block_offset + row_start.second;
+      row_offsets.emplace_back(row_start.first, last_row_offset);
+    }
+    block_offset += static_cast<int64_t>(block_size);
+  }
+  (void)csv_parser.CountRows(std::char_traits<char>::eof());
+  if (!row_offsets.empty()) {
+    filename_row_offsets_[file] = std::move(row_offsets);
   }
 
   return csv_parser.GetTotalRows();
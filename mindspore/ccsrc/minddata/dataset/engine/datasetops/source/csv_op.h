@@ -76,10 +76,20 @@ class CsvOp : public NonMappableLeafOp {
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
+    void SetTotalRows(int64_t total_rows) { total_rows_ = total_rows; }
+
     int ProcessMessage(int c);
 
     int CountRows(int c);
 
+    /// Count the rows in a block of the file, the same as calling CountRows on every character of the block but
+    /// without the state diagram lookups. The quoted fields and the unquoted fields are skipped with memchr.
+    /// @param data - the start of the block.
+    /// @param size - the size of the block.
+    /// @param row_start - the number of rows before the last row which starts in the block and the position in the
+    ///     block where it starts, the position is -1 if no row starts in the block.
+    void CountRows(const char *data, size_t size, std::pair<int64_t, int64_t> *row_start);
+
     Status InitCsvParser();
 
     int64_t GetTotalRows() { return total_rows_; }
@@ -35,7 +35,11 @@ Multi30kOp::Multi30kOp(int32_t num_workers, int64_t num_samples, const std::vect
                        int32_t num_devices, int32_t device_id)
     : TextFileOp(num_workers, num_samples, worker_connector_size, std::move(schema), std::move(text_files_list),
                  op_connector_size, shuffle_files, num_devices, device_id),
-      language_pair_(language_pair) {}
+      language_pair_(language_pair) {
+  // The lines of each file are paired with the lines of the file in the other language, so the files can not be
+  // split at the line offsets counted by TextFileOp.
+  file_split_size_ = 0;
+}
 
 // Print info of operator.
 void Multi30kOp::Print(std::ostream &out, bool show_all) {
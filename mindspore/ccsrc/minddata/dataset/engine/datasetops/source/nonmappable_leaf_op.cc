@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -41,6 +42,12 @@ NonMappableLeafOp::NonMappableLeafOp(int32_t num_workers, int32_t worker_connect
       num_rows_per_shard_(0),
       num_rows_(0) {
   worker_connector_size_ = worker_connector_size;
+#if !defined(_WIN32) && !defined(_WIN64)
+  file_split_size_ = GlobalContext::config_manager()->text_file_split_size();
+#else
+  // Files are read in text mode on Windows, where byte offsets can not be worked out from the characters read
+  file_split_size_ = 0;
+#endif
 }
 
 // Class functor operator () override.
@@ -49,6 +56,15 @@ NonMappableLeafOp::NonMappableLeafOp(int32_t num_workers, int32_t worker_connect
 Status NonMappableLeafOp::operator()() {
   RETURN_IF_NOT_OK(CalculateNumRowsPerShard());
 
+  // Every piece of a split file is an IOBlock of its own, make room in the queues for all of them
+  if (!filename_row_offsets_.empty()) {
+    int64_t num_blocks = static_cast<int64_t>(filename_index_->size());
+    for (const auto &row_offsets : filename_row_offsets_) {
+      num_blocks += static_cast<int64_t>(row_offsets.second.size());
+    }
+    io_block_queues_.Init(num_workers_, static_cast<int32_t>(num_blocks / num_workers_) + 2);
+  }
+
   // Put here to avoid register failed when Worker_Entry thread exits unexpected
   RETURN_IF_NOT_OK(io_block_queue_wait_post_.Register(tree_->AllTasks()));
 
@@ -244,6 +260,51 @@ bool NonMappableLeafOp::NeedPushFileToBlockQueue(const std::string &file_name, i
   return push;
 }
 
+Status NonMappableLeafOp::PushFileToBlockQueue(int64_t file_key, const std::string &file_name, int64_t start_offset,
+                                               int64_t end_offset, int32_t *queue_index) {
+  RETURN_UNEXPECTED_IF_NULL(queue_index);
+  int64_t piece_start = start_offset;
+  auto iter = filename_row_offsets_.find(file_name);
+  if (iter != filename_row_offsets_.end()) {
+    for (const auto &row_offset : iter->second) {
+      if (row_offset.first <= piece_start) {
+        continue;
+      }
+      if (row_offset.first >= end_offset) {
+        break;
+      }
+      auto io_block = std::make_unique<FilenameBlock>(file_key, piece_start, row_offset.first, IOBlock::kDeIoBlockNone);
+      RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+      *queue_index = (*queue_index + 1) % num_workers_;
+      piece_start = row_offset.first;
+    }
+  }
+  auto io_block = std::make_unique<FilenameBlock>(file_key, piece_start, end_offset, IOBlock::kDeIoBlockNone);
+  RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+  *queue_index = (*queue_index + 1) % num_workers_;
+  return Status::OK();
+}
+
+void NonMappableLeafOp::FindRowOffset(const std::string &file_name, int64_t row, int64_t *offset_row,
+                                      int64_t *offset) const {
+  *offset_row = 0;
+  *offset = 0;
+  auto iter = filename_row_offsets_.find(file_name);
+  if (iter == filename_row_offsets_.end()) {
+    return;
+  }
+  const auto &row_offsets = iter->second;
+  auto next = std::upper_bound(row_offsets.begin(), row_offsets.end(), row,
+                               [](int64_t r, const std::pair<int64_t, int64_t> &row_offset) {
+                                 return r < row_offset.first;
+                               });
+  if (next != row_offsets.begin()) {
+    --next;
+    *offset_row = next->first;
+    *offset = next->second;
+  }
+}
+
 void NonMappableLeafOp::ShuffleKeys(std::vector<int64_t> *i_keys, uint32_t seed) {
   std::mt19937 rng(seed);
   std::shuffle(i_keys->begin(), i_keys->end(), rng);
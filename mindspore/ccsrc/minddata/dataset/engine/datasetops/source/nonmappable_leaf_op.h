@@ -20,6 +20,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -131,6 +132,25 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
   bool NeedPushFileToBlockQueue(const std::string &file_name, int64_t *start_offset, int64_t *end_offset,
                                 const int64_t &pre_count);
 
+  // Push the IOBlocks that read the rows [start_offset, end_offset) of a file. If row offsets were recorded for the
+  // file, the rows are cut at them into pieces which go to consecutive workers, so that one file is read in parallel.
+  // @param file_key - the key of the file in the filename index.
+  // @param file_name - the name of the file.
+  // @param start_offset - the first row to read.
+  // @param end_offset - one past the last row to read.
+  // @param queue_index - the IOBlock queue to push to, advanced past every queue pushed to.
+  // @return Status - the error code returned.
+  Status PushFileToBlockQueue(int64_t file_key, const std::string &file_name, int64_t start_offset,
+                              int64_t end_offset, int32_t *queue_index);
+
+  // Find the last recorded row offset at or before a row of a file, so that reading can seek there instead of
+  // reading the file from its beginning.
+  // @param file_name - the name of the file.
+  // @param row - the first row to read.
+  // @param offset_row - the recorded row, 0 if there is no recorded row offset at or before row.
+  // @param offset - the byte offset in the file where offset_row starts, 0 if there is none.
+  void FindRowOffset(const std::string &file_name, int64_t row, int64_t *offset_row, int64_t *offset) const;
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   virtual Status CalculateNumRowsPerShard() = 0;
@@ -149,6 +169,10 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
 
   QueueList<std::unique_ptr<FilenameBlock>> io_block_queues_;
   std::map<std::string, int64_t> filename_numrows_;
+  // The row offsets recorded while counting the rows of each file, as pairs of row and byte offset of the row.
+  // Only filled by the ops which can seek to a row, when file_split_size_ is set.
+  std::map<std::string, std::vector<std::pair<int64_t, int64_t>>> filename_row_offsets_;
+  int64_t file_split_size_;  // Record a row offset every this many bytes, 0 to read every file with one worker
   bool finished_reading_dataset_;
   int64_t total_rows_;
 
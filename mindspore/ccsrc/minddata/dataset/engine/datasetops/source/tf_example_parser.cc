@@ -0,0 +1,547 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Wire types of the protobuf encoding
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLength = 2;
+constexpr uint32_t kWireFixed32 = 5;
+constexpr uint32_t kWireTypeBits = 3;
+constexpr uint32_t kWireTypeMask = 7;
+
+// Field numbers of example.proto and feature.proto
+constexpr uint32_t kExampleFeatures = 1;
+constexpr uint32_t kFeaturesFeature = 1;
+constexpr uint32_t kMapEntryKey = 1;
+constexpr uint32_t kMapEntryValue = 2;
+constexpr uint32_t kFeatureBytesList = 1;
+constexpr uint32_t kFeatureFloatList = 2;
+constexpr uint32_t kFeatureInt64List = 3;
+constexpr uint32_t kListValue = 1;
+
+constexpr uint8_t kVarintMoreBit = 0x80;
+constexpr uint8_t kVarintPayloadMask = 0x7F;
+constexpr uint32_t kVarintShift = 7;
+constexpr uint32_t kMaxVarintShift = 63;
+
+// A cursor over one serialized message. Every read returns false if the message is malformed.
+class WireReader {
+ public:
+  WireReader(const uint8_t *data, size_t size) : cur_(data), end_(data + size) {}
+
+  bool Done() const { return cur_ >= end_; }
+
+  bool ReadVarint(uint64_t *value) {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift <= kMaxVarintShift && cur_ < end_; shift += kVarintShift) {
+      uint8_t byte = *cur_++;
+      result |= static_cast<uint64_t>(byte & kVarintPayloadMask) << shift;
+      if ((byte & kVarintMoreBit) == 0) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+    uint64_t tag = 0;
+    if (!ReadVarint(&tag)) {
+      return false;
+    }
+    *field = static_cast<uint32_t>(tag >> kWireTypeBits);
+    *wire_type = static_cast<uint32_t>(tag & kWireTypeMask);
+    return *field != 0;
+  }
+
+  bool ReadLengthDelimited(const uint8_t **data, size_t *size) {
+    uint64_t len = 0;
+    if (!ReadVarint(&len) || len > static_cast<uint64_t>(end_ - cur_)) {
+      return false;
+    }
+    *data = cur_;
+    *size = static_cast<size_t>(len);
+    cur_ += len;
+    return true;
+  }
+
+  bool ReadFixed32(const uint8_t **data) { return ReadFixed(sizeof(uint32_t), data); }
+
+  // Skip the value of a field we are not interested in. Groups are deprecated and not skipped.
+  bool Skip(uint32_t wire_type) {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    uint64_t value = 0;
+    switch (wire_type) {
+      case kWireVarint:
+        return ReadVarint(&value);
+      case kWireFixed64:
+        return ReadFixed(sizeof(uint64_t), &data);
+      case kWireLength:
+        return ReadLengthDelimited(&data, &size);
+      case kWireFixed32:
+        return ReadFixed(sizeof(uint32_t), &data);
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool ReadFixed(size_t len, const uint8_t **data) {
+    if (len > static_cast<size_t>(end_ - cur_)) {
+      return false;
+    }
+    *data = cur_;
+    cur_ += len;
+    return true;
+  }
+
+  const uint8_t *cur_;
+  const uint8_t *end_;
+};
+
+// Count the values of a FloatList or an Int64List. The values can be packed, which is what protobuf writes for
+// proto3, or one value per field, which parsers must also accept.
+bool CountListValues(const uint8_t *data, size_t size, uint32_t value_wire_type, int64_t *count) {
+  WireReader list(data, size);
+  *count = 0;
+  while (!list.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!list.ReadTag(&field, &wire_type)) {
+      return false;
+    }
+    if (field != kListValue) {
+      if (!list.Skip(wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    if (wire_type == kWireLength) {
+      const uint8_t *packed = nullptr;
+      size_t packed_size = 0;
+      if (!list.ReadLengthDelimited(&packed, &packed_size)) {
+        return false;
+      }
+      if (value_wire_type == kWireFixed32) {
+        if (packed_size % sizeof(float) != 0) {
+          return false;
+        }
+        *count += static_cast<int64_t>(packed_size / sizeof(float));
+      } else {
+        // Every varint ends at the first byte without the continuation bit.
+        if (packed_size > 0 && (packed[packed_size - 1] & kVarintMoreBit) != 0) {
+          return false;
+        }
+        *count += std::count_if(packed, packed + packed_size, [](uint8_t b) { return (b & kVarintMoreBit) == 0; });
+      }
+    } else if (wire_type == value_wire_type) {
+      if (!list.Skip(wire_type)) {
+        return false;
+      }
+      ++(*count);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy the values of a FloatList into a buffer sized by CountListValues. The wire format stores floats in little
+// endian, which is the byte order of every platform we build for, so the packed values are copied as they are.
+bool DecodeFloatList(const uint8_t *data, size_t size, float *out, size_t out_size) {
+  WireReader list(data, size);
+  size_t remaining = out_size * sizeof(float);
+  auto *dst = reinterpret_cast<uint8_t *>(out);
+  while (!list.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    const uint8_t *values = nullptr;
+    size_t values_size = sizeof(float);
+    if (!list.ReadTag(&field, &wire_type)) {
+      return false;
+    }
+    if (field != kListValue) {
+      if (!list.Skip(wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    if (wire_type == kWireLength) {
+      if (!list.ReadLengthDelimited(&values, &values_size)) {
+        return false;
+      }
+    } else if (!list.ReadFixed32(&values)) {
+      return false;
+    }
+    if (values_size > 0 && memcpy_s(dst, remaining, values, values_size) != EOK) {
+      return false;
+    }
+    dst += values_size;
+    remaining -= values_size;
+  }
+  return true;
+}
+
+// Decode the values of an Int64List into a tensor of type T, cast the same way as the protobuf path does.
+template <typename T>
+bool DecodeInt64List(const uint8_t *data, size_t size, std::shared_ptr<Tensor> *tensor) {
+  WireReader list(data, size);
+  auto it = (*tensor)->begin<T>();
+  while (!list.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    uint64_t value = 0;
+    if (!list.ReadTag(&field, &wire_type)) {
+      return false;
+    }
+    if (field != kListValue) {
+      if (!list.Skip(wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    if (wire_type == kWireLength) {
+      const uint8_t *packed = nullptr;
+      size_t packed_size = 0;
+      if (!list.ReadLengthDelimited(&packed, &packed_size)) {
+        return false;
+      }
+      WireReader values(packed, packed_size);
+      while (!values.Done()) {
+        if (!values.ReadVarint(&value)) {
+          return false;
+        }
+        *it = static_cast<T>(static_cast<int64_t>(value));
+        ++it;
+      }
+    } else {
+      if (!list.ReadVarint(&value)) {
+        return false;
+      }
+      *it = static_cast<T>(static_cast<int64_t>(value));
+      ++it;
+    }
+  }
+  return true;
+}
+
+// Collect the values of a BytesList and the size of the longest one.
+bool ReadBytesList(const uint8_t *data, size_t size, std::vector<std::pair<const uint8_t *, size_t>> *values,
+                   size_t *max_size) {
+  WireReader list(data, size);
+  *max_size = 0;
+  while (!list.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!list.ReadTag(&field, &wire_type)) {
+      return false;
+    }
+    if (field != kListValue) {
+      if (!list.Skip(wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    const uint8_t *value = nullptr;
+    size_t value_size = 0;
+    if (wire_type != kWireLength || !list.ReadLengthDelimited(&value, &value_size)) {
+      return false;
+    }
+    values->emplace_back(value, value_size);
+    *max_size = std::max(*max_size, value_size);
+  }
+  return true;
+}
+
+bool IsSingleByteType(const DataType &type) {
+  return type == DataType::DE_UINT8 || type == DataType::DE_INT8;
+}
+
+// Work out the size every value of a BytesList is padded to, the same way as TFReaderOp::LoadBytesList.
+// Returns false for the shapes that the protobuf path rejects, or if a value is longer than the pad size.
+bool GetBytesPadSize(const ColDescriptor &current_col, size_t max_size, size_t *pad_size) {
+  *pad_size = max_size;
+  if (!current_col.HasShape()) {
+    return true;
+  }
+  TensorShape cur_shape = current_col.Shape();
+  if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
+    int64_t new_pad_size = 1;
+    for (int i = 1; i < cur_shape.Size(); ++i) {
+      if (cur_shape[i] == TensorShape::kDimUnknown) {
+        return false;
+      }
+      new_pad_size *= cur_shape[i];
+    }
+    *pad_size = static_cast<size_t>(new_pad_size);
+    return *pad_size >= max_size;
+  }
+  return !cur_shape.known() || cur_shape.NumOfElements() == static_cast<int64_t>(max_size);
+}
+}  // namespace
+
+TFExampleParser::TFExampleParser(const DataSchema &schema) {
+  for (int32_t col = 0; col < static_cast<int32_t>(schema.NumColumns()); ++col) {
+    const ColDescriptor &current_col = schema.Column(col);
+    columns_.push_back(current_col);
+    column_names_.push_back(current_col.Name());
+    if (current_col.HasShape() && current_col.Shape().known()) {
+      fixed_shapes_.push_back(current_col.Shape());
+    } else if (!current_col.HasShape() && current_col.Rank() == 0) {
+      fixed_shapes_.push_back(TensorShape::CreateScalar());
+    } else {
+      fixed_shapes_.push_back(TensorShape::CreateUnknownRankShape());
+    }
+  }
+  for (int32_t col = 0; col < static_cast<int32_t>(column_names_.size()); ++col) {
+    column_index_[column_names_[col]] = col;
+  }
+}
+
+bool TFExampleParser::IsSupported(const DataSchema &schema) {
+  for (int32_t col = 0; col < static_cast<int32_t>(schema.NumColumns()); ++col) {
+    const ColDescriptor &current_col = schema.Column(col);
+    if (current_col.Type() != DataType::DE_FLOAT32 && !current_col.Type().IsInt()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status TFExampleParser::Parse(const std::string &serialized_example, TensorRow *out_row, bool *parsed) const {
+  RETURN_UNEXPECTED_IF_NULL(out_row);
+  RETURN_UNEXPECTED_IF_NULL(parsed);
+  *parsed = false;
+  // Locate the serialized Feature of every column. A key seen twice keeps the last value, same as a protobuf map.
+  std::vector<std::pair<const uint8_t *, size_t>> features(columns_.size(), {nullptr, 0});
+  WireReader example(reinterpret_cast<const uint8_t *>(serialized_example.data()), serialized_example.size());
+  while (!example.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!example.ReadTag(&field, &wire_type)) {
+      return Status::OK();
+    }
+    if (field != kExampleFeatures || wire_type != kWireLength) {
+      if (!example.Skip(wire_type)) {
+        return Status::OK();
+      }
+      continue;
+    }
+    const uint8_t *features_data = nullptr;
+    size_t features_size = 0;
+    if (!example.ReadLengthDelimited(&features_data, &features_size)) {
+      return Status::OK();
+    }
+    WireReader feature_map(features_data, features_size);
+    while (!feature_map.Done()) {
+      const uint8_t *entry_data = nullptr;
+      size_t entry_size = 0;
+      if (!feature_map.ReadTag(&field, &wire_type)) {
+        return Status::OK();
+      }
+      if (field != kFeaturesFeature || wire_type != kWireLength) {
+        if (!feature_map.Skip(wire_type)) {
+          return Status::OK();
+        }
+        continue;
+      }
+      if (!feature_map.ReadLengthDelimited(&entry_data, &entry_size)) {
+        return Status::OK();
+      }
+      WireReader entry(entry_data, entry_size);
+      const uint8_t *key = nullptr;
+      size_t key_size = 0;
+      std::pair<const uint8_t *, size_t> value(nullptr, 0);
+      while (!entry.Done()) {
+        if (!entry.ReadTag(&field, &wire_type)) {
+          return Status::OK();
+        }
+        if (field == kMapEntryKey && wire_type == kWireLength) {
+          if (!entry.ReadLengthDelimited(&key, &key_size)) {
+            return Status::OK();
+          }
+        } else if (field == kMapEntryValue && wire_type == kWireLength && value.first == nullptr) {
+          if (!entry.ReadLengthDelimited(&value.first, &value.second)) {
+            return Status::OK();
+          }
+        } else if (field == kMapEntryValue) {
+          // A value split over several fields is merged by protobuf.
+          return Status::OK();
+        } else if (!entry.Skip(wire_type)) {
+          return Status::OK();
+        }
+      }
+      auto iter = column_index_.find(std::string_view(reinterpret_cast<const char *>(key), key_size));
+      if (iter != column_index_.end()) {
+        features[iter->second] = value;
+      }
+    }
+  }
+
+  for (int32_t col = 0; col < static_cast<int32_t>(columns_.size()); ++col) {
+    // A missing column, or an entry without a value, gets its error from the protobuf path.
+    if (features[col].first == nullptr) {
+      return Status::OK();
+    }
+    bool feature_parsed = false;
+    RETURN_IF_NOT_OK(ParseFeature(col, features[col].first, features[col].second, &(*out_row)[col], &feature_parsed));
+    if (!feature_parsed) {
+      return Status::OK();
+    }
+  }
+  *parsed = true;
+  return Status::OK();
+}
+
+Status TFExampleParser::CreateColumnTensor(int32_t col, int64_t num_elements, std::shared_ptr<Tensor> *out) const {
+  const ColDescriptor &current_col = columns_[col];
+  const TensorShape &fixed_shape = fixed_shapes_[col];
+  if (fixed_shape.known() && fixed_shape.NumOfElements() == num_elements) {
+    return Tensor::CreateEmpty(fixed_shape, current_col.Type(), out);
+  }
+  TensorShape shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(static_cast<int32_t>(num_elements), &shape));
+  return Tensor::CreateEmpty(shape, current_col.Type(), out);
+}
+
+Status TFExampleParser::ParseFeature(int32_t col, const uint8_t *data, size_t size, std::shared_ptr<Tensor> *out,
+                                     bool *parsed) const {
+  *parsed = false;
+  const ColDescriptor &current_col = columns_[col];
+  uint32_t kind = 0;
+  const uint8_t *list_data = nullptr;
+  size_t list_size = 0;
+  WireReader feature(data, size);
+  while (!feature.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!feature.ReadTag(&field, &wire_type)) {
+      return Status::OK();
+    }
+    if (field != kFeatureBytesList && field != kFeatureFloatList && field != kFeatureInt64List) {
+      if (!feature.Skip(wire_type)) {
+        return Status::OK();
+      }
+      continue;
+    }
+    // The kind is a oneof, a second one either merges into or replaces the first. Leave that to protobuf.
+    if (kind != 0 || wire_type != kWireLength || !feature.ReadLengthDelimited(&list_data, &list_size)) {
+      return Status::OK();
+    }
+    kind = field;
+  }
+
+  const DataType type = current_col.Type();
+  int64_t num_elements = 0;
+  if (kind == kFeatureFloatList && type == DataType::DE_FLOAT32) {
+    if (!CountListValues(list_data, list_size, kWireFixed32, &num_elements)) {
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(CreateColumnTensor(col, num_elements, out));
+    if (num_elements > 0) {
+      float *dst = &(*(*out)->begin<float>());
+      *parsed = DecodeFloatList(list_data, list_size, dst, static_cast<size_t>(num_elements));
+    } else {
+      *parsed = true;
+    }
+    return Status::OK();
+  }
+
+  if (kind == kFeatureInt64List && type.IsInt()) {
+    if (!CountListValues(list_data, list_size, kWireVarint, &num_elements)) {
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(CreateColumnTensor(col, num_elements, out));
+    switch (type.value()) {
+      case DataType::DE_UINT64:
+        *parsed = DecodeInt64List<uint64_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_INT64:
+        *parsed = DecodeInt64List<int64_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_UINT32:
+        *parsed = DecodeInt64List<uint32_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_INT32:
+        *parsed = DecodeInt64List<int32_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_UINT16:
+        *parsed = DecodeInt64List<uint16_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_INT16:
+        *parsed = DecodeInt64List<int16_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_UINT8:
+        *parsed = DecodeInt64List<uint8_t>(list_data, list_size, out);
+        break;
+      case DataType::DE_INT8:
+        *parsed = DecodeInt64List<int8_t>(list_data, list_size, out);
+        break;
+      default:
+        break;
+    }
+    return Status::OK();
+  }
+
+  if (kind == kFeatureBytesList && IsSingleByteType(type)) {
+    std::vector<std::pair<const uint8_t *, size_t>> values;
+    size_t max_size = 0;
+    size_t pad_size = 0;
+    if (!ReadBytesList(list_data, list_size, &values, &max_size) ||
+        !GetBytesPadSize(current_col, max_size, &pad_size)) {
+      return Status::OK();
+    }
+    num_elements = static_cast<int64_t>(values.size() * pad_size);
+    RETURN_IF_NOT_OK(CreateColumnTensor(col, num_elements, out));
+    if (num_elements == 0) {
+      *parsed = true;
+      return Status::OK();
+    }
+    // Every value is padded with spaces to the longest one, same as Tensor::CreateFromByteList.
+    auto *dst = reinterpret_cast<uint8_t *>(&(*(*out)->begin<uint8_t>()));
+    size_t remaining = static_cast<size_t>(num_elements);
+    for (const auto &value : values) {
+      if (value.second > 0) {
+        CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, remaining, value.first, value.second) == EOK,
+                                     "memcpy_s failed when reading bytesList element into Tensor");
+      }
+      if (pad_size > value.second) {
+        CHECK_FAIL_RETURN_UNEXPECTED(
+          memset_s(dst + value.second, remaining - value.second, ' ', pad_size - value.second) == EOK,
+          "memset_s failed when padding Tensor");
+      }
+      dst += pad_size;
+      remaining -= pad_size;
+    }
+    *parsed = true;
+    return Status::OK();
+  }
+
+  // A type mismatch, or no kind at all, gets its error from the protobuf path.
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A schema driven parser of serialized dataengine::Example records.
+///     The parser walks the protobuf wire format of the record once and decodes the features of the schema
+///     columns straight into their tensors, without building the Example, Features and Feature messages and the
+///     map of all the features in between. Features which are not in the schema are skipped unparsed.
+/// \note A record the parser does not handle is reported back to the caller, which is expected to parse it with
+///     protobuf instead. This keeps the error messages of the malformed records in one place.
+class TFExampleParser {
+ public:
+  /// \brief Constructor
+  /// \param[in] schema The schema of the rows to produce.
+  explicit TFExampleParser(const DataSchema &schema);
+
+  ~TFExampleParser() = default;
+
+  // column_index_ refers to the names owned by this parser, so it is not copied.
+  TFExampleParser(const TFExampleParser &) = delete;
+  TFExampleParser &operator=(const TFExampleParser &) = delete;
+
+  /// \brief Check if the parser can decode every column of a schema. Only the int and float32 columns are decoded
+  ///     by the parser, the string columns are left to protobuf.
+  /// \param[in] schema The schema to check.
+  /// \return True if the parser supports the schema.
+  static bool IsSupported(const DataSchema &schema);
+
+  /// \brief Decode one serialized Example into a row.
+  /// \param[in] serialized_example The bytes of the record.
+  /// \param[out] out_row The row to fill, which must have one slot per column of the schema.
+  /// \param[out] parsed False if the record has to be parsed with protobuf, in which case out_row is undefined.
+  /// \return Status The status code returned.
+  Status Parse(const std::string &serialized_example, TensorRow *out_row, bool *parsed) const;
+
+ private:
+  /// \brief Decode the Feature message of one column.
+  /// \param[in] col The index of the column in the schema.
+  /// \param[in] data The start of the serialized Feature.
+  /// \param[in] size The size of the serialized Feature.
+  /// \param[out] out The tensor of the column.
+  /// \param[out] parsed False if the feature has to be parsed with protobuf.
+  /// \return Status The status code returned.
+  Status ParseFeature(int32_t col, const uint8_t *data, size_t size, std::shared_ptr<Tensor> *out,
+                      bool *parsed) const;
+
+  /// \brief Create the empty tensor of a column for a number of elements.
+  /// \param[in] col The index of the column in the schema.
+  /// \param[in] num_elements The number of elements decoded from the feature.
+  /// \param[out] out The tensor of the column.
+  /// \return Status The status code returned.
+  Status CreateColumnTensor(int32_t col, int64_t num_elements, std::shared_ptr<Tensor> *out) const;
+
+  std::vector<ColDescriptor> columns_;
+  // The shape of every column whose shape does not depend on the record, i.e. a known shape or a scalar, and an
+  // unknown shape for the others. It saves materializing the same shape for every record.
+  std::vector<TensorShape> fixed_shapes_;
+  // The names of the columns, which own the keys of column_index_.
+  std::vector<std::string> column_names_;
+  // The keys are views, so the key of every feature in a record is looked up without a copy.
+  std::unordered_map<std::string_view, int32_t> column_index_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
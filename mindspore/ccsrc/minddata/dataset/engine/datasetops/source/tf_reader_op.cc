@@ -91,7 +91,8 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       dataset_files_list_(std::move(dataset_files_list)),
       columns_to_load_(std::move(columns_to_load)),
       data_schema_(std::move(data_schema)),
-      equal_rows_per_shard_(equal_rows_per_shard) {}
+      equal_rows_per_shard_(equal_rows_per_shard),
+      verify_crc_(GlobalContext::config_manager()->enable_tfrecord_crc_check()) {}
 
 // A print method typically used for debugging
 void TFReaderOp::Print(std::ostream &out, bool show_all) const {
@@ -135,6 +136,11 @@ Status TFReaderOp::Init() {
       std::to_string(total_rows_));
   }
 
+  // Decode the records without protobuf when the parser can produce every column of the schema
+  if (TFExampleParser::IsSupported(*data_schema_)) {
+    example_parser_ = std::make_unique<TFExampleParser>(*data_schema_);
+  }
+
   // Build the index with our files such that each file corresponds to a key id.
   RETURN_IF_NOT_OK(filename_index_->insert(dataset_files_list_));
 
@@ -308,34 +314,53 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     int64_t record_length = 0;
     (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
 
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    // read crc header
+    uint32_t length_crc = 0;
+    (void)reader.read(reinterpret_cast<char *>(&length_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
+    if (verify_crc_ &&
+        length_crc != system::Crc32c::GetMaskCrc32cValue(reinterpret_cast<char *>(&record_length), sizeof(int64_t))) {
+      RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename + ", the crc of the length of row " +
+                               std::to_string(rows_total) + " does not match, the file may be corrupted.");
+    }
 
     // read serialized Example
     std::string serialized_example;
     serialized_example.resize(record_length);
     (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
 
+    // read crc footer
+    uint32_t data_crc = 0;
+    (void)reader.read(reinterpret_cast<char *>(&data_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
+
     int32_t num_columns = data_schema_->NumColumns();
     TensorRow newRow(num_columns, nullptr);
 
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
+      if (verify_crc_ && data_crc != system::Crc32c::GetMaskCrc32cValue(serialized_example.data(), record_length)) {
+        RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename + ", the crc of the data of row " +
+                                 std::to_string(rows_total) + " does not match, the file may be corrupted.");
+      }
+      bool parsed = false;
+      if (example_parser_ != nullptr) {
+        RETURN_IF_NOT_OK(example_parser_->Parse(serialized_example, &newRow, &parsed));
+      }
+      if (!parsed) {
+        dataengine::Example tf_file;
+        if (!tf_file.ParseFromString(serialized_example)) {
+          std::string errMsg =
+            "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
+          MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
+          RETURN_STATUS_UNEXPECTED(errMsg);
+        }
+        RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
       }
 
       std::vector<std::string> file_path(num_columns, filename);
       newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
       rows_read++;
       RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
     }
 
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
     rows_total++;
   }
 
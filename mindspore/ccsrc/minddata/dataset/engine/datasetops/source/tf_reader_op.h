@@ -33,6 +33,7 @@
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 
 namespace dataengine {
@@ -208,6 +209,8 @@ class TFReaderOp : public NonMappableLeafOp {
   static std::set<std::string> large_files_;
 
   bool equal_rows_per_shard_;
+  bool verify_crc_;                                  // Verify the crc of the length and the data of every record
+  std::unique_ptr<TFExampleParser> example_parser_;  // Decodes the records without protobuf, if the schema allows
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -35,7 +35,11 @@ UDPOSOp::UDPOSOp(int32_t num_workers, int64_t total_rows, int32_t worker_connect
                  std::unique_ptr<DataSchema> schema, const std::vector<std::string> &udpos_files_list,
                  int32_t op_connector_size, bool shuffle_files, int32_t num_devices, int32_t device_id)
     : TextFileOp(num_workers, total_rows, worker_connector_size, std::move(schema), udpos_files_list, op_connector_size,
-                 shuffle_files, num_devices, device_id) {}
+                 shuffle_files, num_devices, device_id) {
+  // The rows of the file are built from several lines, so the file can not be split at the line offsets counted
+  // by TextFileOp.
+  file_split_size_ = 0;
+}
 
 // A print method typically used for debugging.
 void UDPOSOp::Print(std::ostream &out, bool show_all) const {
@@ -0,0 +1,305 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_adjacency.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+// Below this number of samples, a row is sampled without replacement by Floyd's algorithm, which does not
+// touch the whole row but checks every pick against the previous ones.
+constexpr int32_t kMaxFloydSamples = 32;
+}  // namespace
+
+Status GraphAdjacency::AddEdge(EdgeIdType edge_id, NodeIdType src_id, NodeIdType dst_id, NodeType dst_type,
+                               WeightType weight) {
+  CHECK_FAIL_RETURN_UNEXPECTED(tables_.empty() && node_ids_.empty(),
+                               "[Internal Error] Edges can not be added after the adjacency is built.");
+  staged_edges_.push_back({edge_id, src_id, dst_id, weight, dst_type});
+  return Status::OK();
+}
+
+Status GraphAdjacency::Build(std::vector<NodeIdType> node_ids) {
+  CHECK_FAIL_RETURN_UNEXPECTED(tables_.empty() && node_ids_.empty(),
+                               "[Internal Error] The adjacency can only be built once.");
+  CHECK_FAIL_RETURN_UNEXPECTED(staged_edges_.size() <= std::numeric_limits<uint32_t>::max(),
+                               "Invalid data, the number of edges exceeds " +
+                                 std::to_string(std::numeric_limits<uint32_t>::max()) + ".");
+  std::sort(node_ids.begin(), node_ids.end());
+  auto duplicate = std::adjacent_find(node_ids.begin(), node_ids.end());
+  if (duplicate != node_ids.end()) {
+    std::string err_msg = "Invalid data, duplicate node id:" + std::to_string(*duplicate);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  node_ids_ = std::move(node_ids);
+  node_ids_.shrink_to_fit();
+  dense_ids_ = !node_ids_.empty() &&
+               static_cast<int64_t>(node_ids_.back()) - node_ids_.front() + 1 == static_cast<int64_t>(node_ids_.size());
+  const size_t num_nodes = node_ids_.size();
+
+  // Count the neighbors of every row, then turn the counts into offsets
+  for (const auto &edge : staged_edges_) {
+    size_t row = 0;
+    RETURN_IF_NOT_OK(GetRow(edge.src_id, &row));
+    auto &offsets = tables_[edge.dst_type].offsets;
+    if (offsets.empty()) {
+      offsets.assign(num_nodes + 1, 0);
+    }
+    ++offsets[row + 1];
+  }
+  std::map<NodeType, std::vector<uint32_t>> cursors;
+  std::map<NodeType, std::vector<WeightType>> weights;
+  for (auto &item : tables_) {
+    auto &table = item.second;
+    std::partial_sum(table.offsets.begin(), table.offsets.end(), table.offsets.begin());
+    table.neighbors.resize(table.offsets.back());
+    table.edge_ids.resize(table.offsets.back());
+    weights[item.first].resize(table.offsets.back());
+    cursors[item.first] = table.offsets;
+  }
+
+  // Fill the rows, keeping the neighbors of a row in the order their edges were added
+  for (const auto &edge : staged_edges_) {
+    size_t row = 0;
+    RETURN_IF_NOT_OK(GetRow(edge.src_id, &row));
+    uint32_t position = cursors[edge.dst_type][row]++;
+    tables_[edge.dst_type].neighbors[position] = edge.dst_id;
+    tables_[edge.dst_type].edge_ids[position] = edge.edge_id;
+    weights[edge.dst_type][position] = edge.weight;
+  }
+  std::vector<StagedEdge>().swap(staged_edges_);
+
+  // Sort the positions of every row by neighbor id, the stable sort keeps the first added of duplicate edges first
+  for (auto &item : tables_) {
+    auto &table = item.second;
+    table.sorted.resize(table.neighbors.size());
+    std::iota(table.sorted.begin(), table.sorted.end(), 0);
+    for (size_t row = 0; row < num_nodes; ++row) {
+      std::stable_sort(table.sorted.begin() + table.offsets[row], table.sorted.begin() + table.offsets[row + 1],
+                       [&table](uint32_t a, uint32_t b) { return table.neighbors[a] < table.neighbors[b]; });
+    }
+  }
+
+  // Rows whose weights are all the same are sampled uniformly, the alias tables are only needed for the others
+  for (auto &item : tables_) {
+    auto &table = item.second;
+    const auto &table_weights = weights[item.first];
+    bool uniform = true;
+    for (size_t row = 0; row < num_nodes && uniform; ++row) {
+      uniform = std::all_of(table_weights.begin() + table.offsets[row], table_weights.begin() + table.offsets[row + 1],
+                            [&](WeightType w) { return w == table_weights[table.offsets[row]]; });
+    }
+    if (uniform) {
+      continue;
+    }
+    table.alias_probability.resize(table.neighbors.size());
+    table.alias.resize(table.neighbors.size());
+    for (size_t row = 0; row < num_nodes; ++row) {
+      BuildAliasTable(table_weights, table.offsets[row], table.offsets[row + 1], &table);
+    }
+  }
+  MS_LOG(INFO) << "Built the adjacency of " << num_nodes << " nodes with " << tables_.size()
+               << " neighbor types, size: " << MemorySize() << " bytes.";
+  return Status::OK();
+}
+
+void GraphAdjacency::BuildAliasTable(const std::vector<WeightType> &weights, uint32_t begin, uint32_t end,
+                                     NeighborTable *table) {
+  const uint32_t degree = end - begin;
+  double sum = 0.0;
+  for (uint32_t i = begin; i < end; ++i) {
+    sum += std::max(weights[i], 0.0f);
+  }
+  // Scale the weights to an average of 1, then pair every pick below 1 with one above 1 to make up for it
+  std::vector<double> scaled(degree);
+  std::vector<uint32_t> smaller;
+  std::vector<uint32_t> larger;
+  for (uint32_t i = 0; i < degree; ++i) {
+    scaled[i] = sum > 0.0 ? std::max(weights[begin + i], 0.0f) * degree / sum : 1.0;
+    scaled[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
+  }
+  while (!smaller.empty() && !larger.empty()) {
+    uint32_t small = smaller.back();
+    smaller.pop_back();
+    uint32_t large = larger.back();
+    larger.pop_back();
+    table->alias_probability[begin + small] = static_cast<float>(scaled[small]);
+    table->alias[begin + small] = large;
+    scaled[large] = (scaled[large] + scaled[small]) - 1.0;
+    scaled[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
+  }
+  // What is left is 1 up to rounding errors
+  larger.insert(larger.end(), smaller.begin(), smaller.end());
+  for (auto i : larger) {
+    table->alias_probability[begin + i] = 1.0f;
+    table->alias[begin + i] = i;
+  }
+}
+
+Status GraphAdjacency::GetRow(NodeIdType node_id, size_t *row) const {
+  if (dense_ids_) {
+    int64_t index = static_cast<int64_t>(node_id) - node_ids_.front();
+    if (index >= 0 && index < static_cast<int64_t>(node_ids_.size())) {
+      *row = static_cast<size_t>(index);
+      return Status::OK();
+    }
+  } else {
+    auto itr = std::lower_bound(node_ids_.begin(), node_ids_.end(), node_id);
+    if (itr != node_ids_.end() && *itr == node_id) {
+      *row = static_cast<size_t>(itr - node_ids_.begin());
+      return Status::OK();
+    }
+  }
+  std::string err_msg = "Invalid node id:" + std::to_string(node_id);
+  RETURN_STATUS_UNEXPECTED(err_msg);
+}
+
+Status GraphAdjacency::GetAllNeighbors(NodeIdType node_id, NodeType neighbor_type,
+                                       std::vector<NodeIdType> *out_neighbors, bool exclude_itself) const {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  size_t row = 0;
+  RETURN_IF_NOT_OK(GetRow(node_id, &row));
+  out_neighbors->clear();
+  if (!exclude_itself) {
+    out_neighbors->emplace_back(node_id);
+  }
+  auto itr = tables_.find(neighbor_type);
+  if (itr == tables_.end() || itr->second.offsets[row] == itr->second.offsets[row + 1]) {
+    MS_LOG(DEBUG) << "No neighbors. node_id:" << node_id << " neighbor_type:" << neighbor_type;
+    return Status::OK();
+  }
+  const auto &table = itr->second;
+  out_neighbors->insert(out_neighbors->end(), table.neighbors.begin() + table.offsets[row],
+                        table.neighbors.begin() + table.offsets[row + 1]);
+  return Status::OK();
+}
+
+void GraphAdjacency::SampleWithoutReplacement(const NeighborTable &table, uint32_t begin, uint32_t degree,
+                                              int32_t count, std::vector<NodeIdType> *out, std::mt19937 *rnd) {
+  if (count <= kMaxFloydSamples) {
+    std::vector<uint32_t> picked;
+    picked.reserve(count);
+    for (uint32_t j = degree - count; j < degree; ++j) {
+      uint32_t pick = std::uniform_int_distribution<uint32_t>(0, j)(*rnd);
+      if (std::find(picked.begin(), picked.end(), pick) != picked.end()) {
+        pick = j;
+      }
+      picked.push_back(pick);
+    }
+    std::shuffle(picked.begin(), picked.end(), *rnd);
+    for (auto index : picked) {
+      out->emplace_back(table.neighbors[begin + index]);
+    }
+    return;
+  }
+  // Partial Fisher-Yates shuffle of the row
+  std::vector<uint32_t> shuffled(degree);
+  std::iota(shuffled.begin(), shuffled.end(), 0);
+  for (int32_t i = 0; i < count; ++i) {
+    uint32_t j = std::uniform_int_distribution<uint32_t>(i, degree - 1)(*rnd);
+    std::swap(shuffled[i], shuffled[j]);
+    out->emplace_back(table.neighbors[begin + shuffled[i]]);
+  }
+}
+
+Status GraphAdjacency::GetSampledNeighbors(NodeIdType node_id, NodeType neighbor_type, int32_t samples_num,
+                                           SamplingStrategy strategy, std::vector<NodeIdType> *out_neighbors,
+                                           std::mt19937 *rnd) const {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  RETURN_UNEXPECTED_IF_NULL(rnd);
+  size_t row = 0;
+  RETURN_IF_NOT_OK(GetRow(node_id, &row));
+  out_neighbors->reserve(out_neighbors->size() + std::max(samples_num, 0));
+  auto itr = tables_.find(neighbor_type);
+  if (itr == tables_.end() || itr->second.offsets[row] == itr->second.offsets[row + 1]) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << node_id << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    out_neighbors->insert(out_neighbors->end(), std::max(samples_num, 0), kDefaultNodeId);
+    return Status::OK();
+  }
+  const auto &table = itr->second;
+  const uint32_t begin = table.offsets[row];
+  const uint32_t degree = table.offsets[row + 1] - begin;
+  if (strategy == SamplingStrategy::kRandom) {
+    // Without replacement, the row is sampled again once all of its neighbors are picked
+    for (int32_t remaining = samples_num; remaining > 0;) {
+      int32_t count = static_cast<int32_t>(std::min(static_cast<uint32_t>(remaining), degree));
+      SampleWithoutReplacement(table, begin, degree, count, out_neighbors, rnd);
+      remaining -= count;
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    std::uniform_int_distribution<uint32_t> pick_dist(0, degree - 1);
+    if (table.alias.empty()) {
+      for (int32_t i = 0; i < samples_num; ++i) {
+        out_neighbors->emplace_back(table.neighbors[begin + pick_dist(*rnd)]);
+      }
+    } else {
+      std::uniform_real_distribution<float> keep_dist(0.0f, 1.0f);
+      for (int32_t i = 0; i < samples_num; ++i) {
+        uint32_t pick = pick_dist(*rnd);
+        if (keep_dist(*rnd) >= table.alias_probability[begin + pick]) {
+          pick = table.alias[begin + pick];
+        }
+        out_neighbors->emplace_back(table.neighbors[begin + pick]);
+      }
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+Status GraphAdjacency::GetEdge(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *out_edge_id) const {
+  RETURN_UNEXPECTED_IF_NULL(out_edge_id);
+  size_t row = 0;
+  RETURN_IF_NOT_OK(GetRow(src_id, &row));
+  for (const auto &item : tables_) {
+    const auto &table = item.second;
+    auto end = table.sorted.begin() + table.offsets[row + 1];
+    auto itr = std::lower_bound(table.sorted.begin() + table.offsets[row], end, dst_id,
+                                [&table](uint32_t position, NodeIdType id) { return table.neighbors[position] < id; });
+    if (itr != end && table.neighbors[*itr] == dst_id) {
+      *out_edge_id = table.edge_ids[*itr];
+      return Status::OK();
+    }
+  }
+  *out_edge_id = -1;
+  MS_LOG(WARNING) << "Number " << dst_id << " node is not adjacent to number " << src_id << " node.";
+  return Status::OK();
+}
+
+int64_t GraphAdjacency::MemorySize() const {
+  int64_t size = static_cast<int64_t>(node_ids_.capacity() * sizeof(NodeIdType));
+  for (const auto &item : tables_) {
+    const auto &table = item.second;
+    size += static_cast<int64_t>(table.offsets.capacity() * sizeof(uint32_t) +
+                                 table.neighbors.capacity() * sizeof(NodeIdType) +
+                                 table.edge_ids.capacity() * sizeof(EdgeIdType) +
+                                 table.sorted.capacity() * sizeof(uint32_t) +
+                                 table.alias_probability.capacity() * sizeof(float) +
+                                 table.alias.capacity() * sizeof(uint32_t));
+  }
+  return size;
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
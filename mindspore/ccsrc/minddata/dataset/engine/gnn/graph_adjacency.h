@@ -0,0 +1,135 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_ADJACENCY_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_ADJACENCY_H_
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// The neighbors of all the nodes of the graph, stored in compressed sparse row format.
+// The neighbors are grouped by their node type, each type has a table with one row per node of the graph:
+// row i spans [offsets[i], offsets[i + 1]) of the neighbor ids and edge ids, in the order the edges were added.
+// Weighted sampling uses an alias table per row, which is only kept for the tables with non uniform weights.
+// The edges are staged with AddEdge and compressed by Build, after which the adjacency is read only.
+class GraphAdjacency {
+ public:
+  GraphAdjacency() = default;
+
+  ~GraphAdjacency() = default;
+
+  // Reserve room for the edges to be staged
+  // @param size_t num_edges - number of edges
+  void Reserve(size_t num_edges) { staged_edges_.reserve(num_edges); }
+
+  // Stage an edge, the staged edges are compressed by Build
+  // @param EdgeIdType edge_id - id of the edge
+  // @param NodeIdType src_id - id of the source node
+  // @param NodeIdType dst_id - id of the destination node, which becomes a neighbor of the source node
+  // @param NodeType dst_type - type of the destination node
+  // @param WeightType weight - weight of the edge, used by weighted sampling
+  // @return Status The status code returned
+  Status AddEdge(EdgeIdType edge_id, NodeIdType src_id, NodeIdType dst_id, NodeType dst_type, WeightType weight);
+
+  // Compress the staged edges into the neighbor tables and release them
+  // @param std::vector<NodeIdType> node_ids - ids of all the nodes of the graph
+  // @return Status The status code returned
+  Status Build(std::vector<NodeIdType> node_ids);
+
+  // Get the all neighbors of a node
+  // @param NodeIdType node_id - id of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id, led by the node itself unless excluded
+  // @param bool exclude_itself - whether to leave the node itself out of the neighbors
+  // @return Status The status code returned
+  Status GetAllNeighbors(NodeIdType node_id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                         bool exclude_itself = false) const;
+
+  // Sample neighbors of a node, the samples are appended to out_neighbors
+  // @param NodeIdType node_id - id of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param SamplingStrategy strategy - Sampling strategy
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id, kDefaultNodeId if there are no neighbors
+  // @param std::mt19937 *rnd - random generator
+  // @return Status The status code returned
+  Status GetSampledNeighbors(NodeIdType node_id, NodeType neighbor_type, int32_t samples_num,
+                             SamplingStrategy strategy, std::vector<NodeIdType> *out_neighbors,
+                             std::mt19937 *rnd) const;
+
+  // Get the edge from a node to one of its neighbors, the first added one if there are several
+  // @param NodeIdType src_id - id of the source node
+  // @param NodeIdType dst_id - id of the destination node
+  // @param EdgeIdType *out_edge_id - Returned edge id, -1 if the nodes are not adjacent
+  // @return Status The status code returned
+  Status GetEdge(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *out_edge_id) const;
+
+  // @return int64_t - The number of bytes the neighbor tables take
+  int64_t MemorySize() const;
+
+ private:
+  struct NeighborTable {
+    std::vector<uint32_t> offsets;         // num_nodes + 1 row offsets, the edge ids of the graph are 32 bits too
+    std::vector<NodeIdType> neighbors;     // neighbor ids of all the rows
+    std::vector<EdgeIdType> edge_ids;      // id of the edge to every neighbor
+    std::vector<uint32_t> sorted;          // positions of every row sorted by neighbor id, to look up the edges
+    std::vector<float> alias_probability;  // probability to keep a pick of a row, empty if all weights are uniform
+    std::vector<uint32_t> alias;           // the index in the row to switch a rejected pick to
+  };
+
+  struct StagedEdge {
+    EdgeIdType edge_id;
+    NodeIdType src_id;
+    NodeIdType dst_id;
+    WeightType weight;
+    NodeType dst_type;
+  };
+
+  // Find the row of a node
+  // @param NodeIdType node_id - id of the node
+  // @param size_t *row - Returned row
+  // @return Status The status code returned
+  Status GetRow(NodeIdType node_id, size_t *row) const;
+
+  // Build the alias table of a row with Vose's method
+  // @param const std::vector<WeightType> &weights - weights of all the rows of the table
+  // @param uint32_t begin - first edge of the row
+  // @param uint32_t end - end of the row
+  // @param NeighborTable *table - table whose alias_probability and alias are filled for the row
+  static void BuildAliasTable(const std::vector<WeightType> &weights, uint32_t begin, uint32_t end,
+                              NeighborTable *table);
+
+  // Pick count distinct neighbors of a row uniformly, in random order
+  static void SampleWithoutReplacement(const NeighborTable &table, uint32_t begin, uint32_t degree, int32_t count,
+                                       std::vector<NodeIdType> *out, std::mt19937 *rnd);
+
+  std::vector<NodeIdType> node_ids_;  // sorted ids of the nodes, the index of an id is its row
+  bool dense_ids_ = false;            // whether node_ids_ is a range, so the row is node_id - node_ids_[0]
+  std::map<NodeType, NeighborTable> tables_;
+  std::vector<StagedEdge> staged_edges_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_ADJACENCY_H_
@@ -57,6 +57,11 @@ Status GraphLoader::GetNodesAndEdges() {
     }
   }
 
+  size_t num_edges = 0;
+  for (const std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
+    num_edges += dq.size();
+  }
+  graph_impl_->adjacency_.Reserve(num_edges);
   for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
     while (!dq.empty()) {
       std::shared_ptr<Edge> edge_ptr = dq.front();
@@ -73,8 +78,8 @@ Status GraphLoader::GetNodesAndEdges() {
 
       RETURN_IF_NOT_OK(edge_ptr->SetNode(src_itr->second->id(), dst_itr->second->id()));
 
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second, edge_ptr->weight()));
-      RETURN_IF_NOT_OK(src_itr->second->AddAdjacent(dst_itr->second, edge_ptr));
+      RETURN_IF_NOT_OK(graph_impl_->adjacency_.AddEdge(edge_ptr->id(), src_id, dst_id, dst_itr->second->type(),
+                                                       edge_ptr->weight()));
 
       e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
       graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
@@ -82,6 +87,13 @@ Status GraphLoader::GetNodesAndEdges() {
     }
   }
 
+  std::vector<NodeIdType> node_ids;
+  node_ids.reserve(n_id_map->size());
+  for (const auto &itr : *n_id_map) {
+    node_ids.push_back(itr.first);
+  }
+  RETURN_IF_NOT_OK(graph_impl_->adjacency_.Build(std::move(node_ids)));
+
   for (auto &itr : graph_impl_->node_type_map_) {
     itr.second.shrink_to_fit();
   }
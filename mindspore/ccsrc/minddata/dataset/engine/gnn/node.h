@@ -34,8 +34,6 @@ using EdgeIdType = int32_t;
 
 constexpr NodeIdType kDefaultNodeId = -1;
 
-class Edge;
-
 class Node {
  public:
   // Constructor
@@ -61,39 +59,6 @@ class Node {
   // @return Status The status code returned
   virtual Status GetFeatures(FeatureType feature_type, std::shared_ptr<Feature> *out_feature) = 0;
 
-  // Get the all neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  virtual Status GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
-                                 bool exclude_itself = false) = 0;
-
-  // Get the sampled neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param int32_t samples_num - Number of neighbors to be acquired
-  // @param SamplingStrategy strategy - Sampling strategy
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  virtual Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
-                                     std::vector<NodeIdType> *out_neighbors, std::mt19937 *rnd) = 0;
-
-  // Add neighbor of node
-  // @param std::shared_ptr<Node> node
-  // @return Status The status code returned
-  virtual Status AddNeighbor(const std::shared_ptr<Node> &node, const WeightType &weight) = 0;
-
-  // Add adjacent node and relative edge for source node
-  // @param std::shared_ptr<Node> node - the node to be inserted into adjacent table
-  // @param std::shared_ptr<Edge> edge - the edge related to the adjacent node of source node
-  // @return Status - The status code that indicate the result of function execution
-  virtual Status AddAdjacent(const std::shared_ptr<Node> &node, const std::shared_ptr<Edge> &edge) = 0;
-
-  // Get relative connecting edge of adjacent node by node id
-  // @param NodeIdType - The id of adjacent node to be processed
-  // @param std::shared_ptr<EdgeIdType> - The id of relative connecting edge
-  // @return Status - The status code that indicate the result of function execution
-  virtual Status GetEdgeByAdjNodeId(const NodeIdType &adj_node_id, EdgeIdType *out_edge_id) = 0;
-
   // Update feature of node
   // @param std::shared_ptr<Feature> feature -
   // @return Status The status code returned
@@ -41,6 +41,7 @@ Status DatasetCache::from_json(nlohmann::json json_obj, std::shared_ptr<DatasetC
     std::optional<int32_t> port = std::nullopt;
     std::optional<int32_t> num_connections = std::nullopt;
     std::optional<int32_t> prefetch_sz = std::nullopt;
+    bool zero_copy_fetch = false;
     if (json_cache.find("hostname") != json_cache.end()) {
       std::optional<std::string> hostname = json_cache["hostname"];
       hostname_c = std::vector<char>(hostname->begin(), hostname->end());
@@ -54,7 +55,11 @@ Status DatasetCache::from_json(nlohmann::json json_obj, std::shared_ptr<DatasetC
     if (json_cache.find("cache_prefetch_size") != json_cache.end()) {
       prefetch_sz = json_cache["cache_prefetch_size"];
     }
-    *cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz);
+    if (json_cache.find("zero_copy_fetch") != json_cache.end()) {
+      zero_copy_fetch = json_cache["zero_copy_fetch"];
+    }
+    *cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz,
+                                                zero_copy_fetch);
   }
   return Status::OK();
 }
@@ -44,6 +44,7 @@ Status DatasetCacheImpl::Build() {
   if (prefetch_sz_) {
     (void)builder.SetPrefetchSize(prefetch_sz_.value());
   }
+  (void)builder.SetZeroCopyFetch(zero_copy_fetch_);
   return builder.Build(&cache_client_);
 }
 
@@ -98,6 +99,9 @@ Status DatasetCacheImpl::to_json(nlohmann::json *out_json) {
   if (prefetch_sz_) {
     args["cache_prefetch_size"] = prefetch_sz_.value();
   }
+  if (zero_copy_fetch_) {
+    args["zero_copy_fetch"] = zero_copy_fetch_;
+  }
   *out_json = args;
   return Status::OK();
 }
@@ -33,7 +33,7 @@ class PreBuiltDatasetCache : public DatasetCacheImpl {
   /// \param cc a pre-built cache client
   explicit PreBuiltDatasetCache(std::shared_ptr<CacheClient> cc)
       : DatasetCacheImpl(cc->session_id(), cc->GetCacheMemSz(), cc->isSpill(), StringToChar(cc->GetHostname()),
-                         cc->GetPort(), cc->GetNumConnections(), cc->GetPrefetchSize()) {
+                         cc->GetPort(), cc->GetNumConnections(), cc->GetPrefetchSize(), cc->IsZeroCopyFetch()) {
     cache_client_ = std::move(cc);
   }
 
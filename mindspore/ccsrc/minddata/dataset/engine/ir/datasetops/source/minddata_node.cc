@@ -70,6 +70,7 @@ std::shared_ptr<DatasetNode> MindDataNode::Copy() {
                                           shuffle_mode_, cache_);
   }
   node->SetSampleBytes(&sample_bytes_);
+  node->SetRowCriteria(row_criteria_);
   return node;
 }
 
@@ -199,6 +200,9 @@ Status MindDataNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_o
                                  "Internal error. MindDataNode's sampler should be a MindRecordSamplerObj object");
     RETURN_IF_NOT_OK(mr_sampler->GetShardReader(&shard_reader));
   }
+  if (!row_criteria_.empty()) {
+    shard_reader->SetRowCriteria(row_criteria_);
+  }
 
   std::shared_ptr<MindRecordOp> mindrecord_op;
   // If pass a string to MindData(), it will be treated as a pattern to search for matched files,
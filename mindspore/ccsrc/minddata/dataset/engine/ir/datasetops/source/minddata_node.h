@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/engine/datasetops/source/mindrecord_op.h"
@@ -105,6 +106,20 @@ class MindDataNode : public MappableSourceNode {
   /// \return Status of the node visit
   Status AcceptAfter(IRNodePass *const p, bool *const modified) override;
 
+  /// \brief Getter functions
+  const std::vector<std::string> &ColumnsList() const { return columns_list_; }
+  const std::shared_ptr<SamplerObj> &InputSampler() const { return input_sampler_; }
+  int64_t NumPadded() const { return num_padded_; }
+  const std::vector<std::pair<std::string, std::string>> &RowCriteria() const { return row_criteria_; }
+
+  /// \brief Setter of the columns to be read, used by the read pushdown pass
+  void SetColumnsList(const std::vector<std::string> &columns_list) { columns_list_ = columns_list; }
+
+  /// \brief Setter of the criteria on index fields pushed down to the shard reader, used by the read pushdown pass
+  void SetRowCriteria(const std::vector<std::pair<std::string, std::string>> &row_criteria) {
+    row_criteria_ = row_criteria;
+  }
+
  private:
   std::string dataset_file_;                // search_for_pattern_ will be true in this mode
   std::vector<std::string> dataset_files_;  // search_for_pattern_ will be false in this mode
@@ -118,6 +133,7 @@ class MindDataNode : public MappableSourceNode {
   int64_t num_padded_;
   std::vector<std::shared_ptr<ShardOperator>> operators_;
   ShuffleMode shuffle_mode_;
+  std::vector<std::pair<std::string, std::string>> row_criteria_;  // only the rows meeting all criteria are read
 };
 }  // namespace dataset
 }  // namespace mindspore
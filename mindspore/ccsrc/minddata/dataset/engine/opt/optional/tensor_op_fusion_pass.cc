@@ -20,11 +20,16 @@
 #include <vector>
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 namespace mindspore {
@@ -54,16 +59,62 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    *modified = true;
+  }
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
+  RETURN_IF_NOT_OK(FuseNormalize(&ops, modified));
   node->setOperations(ops);
-  *modified = true;
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseNormalize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  auto is_op = [](const std::shared_ptr<TensorOperation> &op, const std::string &nm) {
+    return op != nullptr && op->Name() == nm;
+  };
+  for (auto itr = ops->begin(); itr != ops->end(); ++itr) {
+    if (!is_op(*itr, vision::kNormalizeOperation)) {
+      continue;
+    }
+    nlohmann::json normalize_args;
+    RETURN_IF_NOT_OK((*itr)->to_json(&normalize_args));
+    if (!normalize_args["is_hwc"].get<bool>()) {
+      continue;
+    }
+    // [RandomHorizontalFlip | HorizontalFlip] Normalize [HwcToChw]
+    auto first = itr;
+    float flip_prob = 0;
+    if (itr != ops->begin() && is_op(*(itr - 1), vision::kRandomHorizontalFlipOperation)) {
+      nlohmann::json flip_args;
+      RETURN_IF_NOT_OK((*(itr - 1))->to_json(&flip_args));
+      flip_prob = flip_args["prob"].get<float>();
+      first = itr - 1;
+    } else if (itr != ops->begin() && is_op(*(itr - 1), vision::kHorizontalFlipOperation)) {
+      flip_prob = 1;
+      first = itr - 1;
+    }
+    auto last = itr + 1;
+    bool to_chw = last != ops->end() && is_op(*last, vision::kHwcToChwOperation);
+    if (to_chw) {
+      ++last;
+    }
+    // nothing to fuse with a lone Normalize
+    if (last - first < 2) {
+      continue;
+    }
+    std::vector<float> mean = normalize_args["mean"];
+    std::vector<float> std = normalize_args["std"];
+    MS_LOG(INFO) << "Fusing " << (last - first) << " ops around Normalize into one FusedNormalize.";
+    (*first) = std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<FusedNormalizeOp>(flip_prob, mean, std, to_chw));
+    itr = ops->erase(first + 1, last) - 1;
+    *modified = true;
+  }
   return Status::OK();
 }
 }  // namespace dataset
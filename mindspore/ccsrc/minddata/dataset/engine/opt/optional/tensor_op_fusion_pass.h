@@ -17,7 +17,10 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
+
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
 
 namespace mindspore {
 namespace dataset {
@@ -31,6 +34,13 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Fuses each RandomHorizontalFlip or HorizontalFlip, Normalize of an HWC image and HwcToChw chain (the
+  ///     flip and the HwcToChw are optional, but at least one of them is needed) into one FusedNormalize
+  /// \param[in, out] ops The tensor operations of the MapNode
+  /// \param[in, out] *modified indicates whether the operations have been modified
+  /// \return Status The status code returned
+  Status FuseNormalize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
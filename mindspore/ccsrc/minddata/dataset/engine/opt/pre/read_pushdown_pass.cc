@@ -0,0 +1,207 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/pre/read_pushdown_pass.h"
+
+#include <algorithm>
+
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/filter_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
+#include "minddata/dataset/kernels/data/mask_op.h"
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+#ifndef ENABLE_ANDROID
+// Get the column and value of a simple predicate, which is a Mask(RelationalOp::kEqual, value) on a single column.
+bool GetSimplePredicate(const std::shared_ptr<FilterNode> &node, std::pair<std::string, std::string> *criteria) {
+  auto mask_op = std::dynamic_pointer_cast<MaskOp>(node->Predicate());
+  if (mask_op == nullptr || node->InputColumns().size() != 1 || mask_op->Operator() != RelationalOp::kEqual ||
+      mask_op->Type() != DataType(DataType::DE_BOOL)) {
+    return false;
+  }
+  const auto &value = mask_op->Value();
+  if (value == nullptr || value->Size() != 1) {
+    return false;
+  }
+  std::vector<dsize_t> index(value->Rank(), 0);
+  // the index fields in mindrecord are int32, int64 and string, the float value is not pushed down for precision
+  if (value->type().IsSignedInt()) {
+    int64_t number = 0;
+    if (value->GetItemAt<int64_t>(&number, index).IsError()) {
+      return false;
+    }
+    *criteria = std::make_pair(node->InputColumns()[0], std::to_string(number));
+    return true;
+  }
+  if (value->type() == DataType::DE_STRING) {
+    std::string_view str;
+    if (value->GetItemAt(&str, index).IsError()) {
+      return false;
+    }
+    *criteria = std::make_pair(node->InputColumns()[0], std::string(str));
+    return true;
+  }
+  return false;
+}
+
+// Only the sampler which reads all the rows is commutative with the filter, e.g. SequentialSampler without start_index
+// and num_samples, RandomSampler without replacement and num_samples, DistributedSampler with a single shard and
+// without offset and num_samples. A DistributedSampler with more shards splits the rows after the criteria are applied
+// by the shard reader, so each shard would get other rows than the ones it filters in the original pipeline.
+bool IsFullSampler(const std::shared_ptr<SamplerObj> &sampler) {
+  nlohmann::json args;
+  if (sampler == nullptr || sampler->to_json(&args).IsError()) {
+    return false;
+  }
+  const std::vector<std::string> full_samplers = {"SequentialSampler", "RandomSampler", "DistributedSampler"};
+  if (args.find("sampler_name") == args.end() ||
+      std::find(full_samplers.begin(), full_samplers.end(), args["sampler_name"].get<std::string>()) ==
+        full_samplers.end()) {
+    return false;
+  }
+  if (args.find("child_sampler") != args.end() || args.value("num_samples", 0) != 0 ||
+      args.value("start_index", 0) != 0 || args.value("replacement", false) || args.value("offset", -1) != -1 ||
+      args.value("num_shards", 1) != 1) {
+    return false;
+  }
+  return true;
+}
+#endif
+}  // namespace
+
+ReadPushdownPass::ReadNodes::ReadNodes() : projected_(false) {}
+
+void ReadPushdownPass::ReadNodes::Reset() {
+  projected_ = false;
+  needed_columns_.clear();
+  criteria_.clear();
+}
+
+// The lowest ProjectNode on the path decides the columns to be read, the predicates above it are still valid.
+Status ReadPushdownPass::ReadNodes::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
+  if (node->IsCached()) {
+    Reset();
+    return Status::OK();
+  }
+  projected_ = true;
+  needed_columns_ = node->Columns();
+  return Status::OK();
+}
+
+Status ReadPushdownPass::ReadNodes::Visit(std::shared_ptr<FilterNode> node, bool *const modified) {
+  if (node->IsCached()) {
+    Reset();
+    return Status::OK();
+  }
+  // the predicate takes all the columns if no input column is specified, so the columns can not be projected
+  if (node->InputColumns().empty()) {
+    projected_ = false;
+    needed_columns_.clear();
+  }
+  for (const auto &column : node->InputColumns()) {
+    if (std::find(needed_columns_.begin(), needed_columns_.end(), column) == needed_columns_.end()) {
+      needed_columns_.push_back(column);
+    }
+  }
+#ifndef ENABLE_ANDROID
+  std::pair<std::string, std::string> criteria;
+  if (GetSimplePredicate(node, &criteria)) {
+    criteria_.push_back(criteria);
+  }
+#endif
+  return Status::OK();
+}
+
+#ifndef ENABLE_ANDROID
+Status ReadPushdownPass::ReadNodes::Visit(std::shared_ptr<MindDataNode> node, bool *const modified) {
+  if (node->IsCached() || node->IsDescendantOfCache()) {
+    Reset();
+    return Status::OK();
+  }
+  std::vector<std::string> columns;
+  if (projected_) {
+    const auto &columns_list = node->ColumnsList();
+    if (columns_list.empty()) {
+      columns = needed_columns_;
+    } else {
+      // keep the order of columns_list, and do not project if some needed column is not in columns_list
+      for (const auto &column : columns_list) {
+        if (std::find(needed_columns_.begin(), needed_columns_.end(), column) != needed_columns_.end()) {
+          columns.push_back(column);
+        }
+      }
+      if (columns.size() != needed_columns_.size() || columns.size() == columns_list.size()) {
+        columns.clear();
+      }
+    }
+  }
+  std::vector<std::pair<std::string, std::string>> criteria;
+  if (node->NumPadded() == 0 && IsFullSampler(node->InputSampler())) {
+    criteria = criteria_;
+  }
+  if (!columns.empty() || !criteria.empty()) {
+    (void)pushdown_nodes_.emplace_back(node, columns, criteria);
+  }
+  Reset();
+  return Status::OK();
+}
+#endif
+
+Status ReadPushdownPass::ReadNodes::Visit(std::shared_ptr<DatasetNode> node, bool *const modified) {
+  Reset();
+  return Status::OK();
+}
+
+// constructor
+ReadPushdownPass::ReadPushdownPass() {}
+
+// Walk the tree to push down the projection and predicates into MindDataNode.
+Status ReadPushdownPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  MS_LOG(INFO) << "Pre pass: read pushdown pass started.";
+  std::unique_ptr<ReadPushdownPass::ReadNodes> read_nodes = std::make_unique<ReadPushdownPass::ReadNodes>();
+  RETURN_IF_NOT_OK(read_nodes->Run(root_ir, modified));
+
+#ifndef ENABLE_ANDROID
+  for (const auto &iter : read_nodes->pushdown_nodes()) {
+    const auto &node = std::get<0>(iter);
+    const auto &columns = std::get<1>(iter);
+    if (!columns.empty()) {
+      MS_LOG(INFO) << "Pushing down the projection of " << columns.size() << " columns into " << node->Name();
+      node->SetColumnsList(columns);
+    }
+    // the criteria are appended, as the node may have been pushed down by a previous run
+    auto criteria = node->RowCriteria();
+    for (const auto &item : std::get<2>(iter)) {
+      MS_LOG(INFO) << "Pushing down the predicate " << item.first << " == " << item.second << " into " << node->Name();
+      if (std::find(criteria.begin(), criteria.end(), item) == criteria.end()) {
+        criteria.push_back(item);
+      }
+    }
+    node->SetRowCriteria(criteria);
+    *modified = true;
+  }
+#endif
+
+  MS_LOG(INFO) << "Pre pass: read pushdown pass is complete.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_READ_PUSHDOWN_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_READ_PUSHDOWN_PASS_H_
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetNode;
+class FilterNode;
+class MindDataNode;
+class ProjectNode;
+
+/// \class ReadPushdownPass read_pushdown_pass.h
+/// \brief This is a tree pass that pushes the column projection and the simple predicates down into MindDataNode, so
+///     that the shard reader only reads the needed columns of the rows which meet the predicates. It uses ReadNodes to
+///     collect the projected columns of ProjectNode and the predicates of FilterNode on the path to a MindDataNode.
+///     A simple predicate is a Mask(RelationalOp::kEqual, value) on a single column, which is created by Filter with a
+///     transforms::Mask in C++ or a transforms.Mask in Python. The predicate functions are opaque and never pushed
+///     down. The FilterNode is kept in the tree, so the rows skipped by the shard reader are exactly the rows that
+///     would be dropped by the filter.
+class ReadPushdownPass : public IRTreePass {
+  /// \class ReadNodes
+  /// \brief This is a NodePass whose job is to collect the projection and the predicates on the path from the top to a
+  ///     MindDataNode. The path is cut by any node other than ProjectNode and FilterNode.
+  ///     It works in conjunction with the ReadPushdownPass.
+  class ReadNodes : public IRNodePass {
+   public:
+    /// \brief Constructor
+    ReadNodes();
+
+    /// \brief Destructor
+    ~ReadNodes() = default;
+
+    /// \brief Collect the projected columns of a ProjectNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ProjectNode> node, bool *const modified) override;
+
+    /// \brief Collect the input columns and the simple predicate of a FilterNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<FilterNode> node, bool *const modified) override;
+
+#ifndef ENABLE_ANDROID
+    /// \brief Decide the columns and the criteria to be pushed down into a MindDataNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MindDataNode> node, bool *const modified) override;
+#endif
+
+    /// \brief Cut the path on any other node
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<DatasetNode> node, bool *const modified) override;
+
+    /// \brief Getter
+    /// \return All the MindDataNodes to be pushed down, with the columns to be read and the criteria of rows
+    const std::vector<std::tuple<std::shared_ptr<MindDataNode>, std::vector<std::string>,
+                                 std::vector<std::pair<std::string, std::string>>>> &
+    pushdown_nodes() const {
+      return pushdown_nodes_;
+    }
+
+   private:
+    /// \brief Reset the collected projection and predicates
+    void Reset();
+
+    std::vector<std::tuple<std::shared_ptr<MindDataNode>, std::vector<std::string>,
+                           std::vector<std::pair<std::string, std::string>>>>
+      pushdown_nodes_;
+    bool projected_;                                             // whether the columns are projected on the path
+    std::vector<std::string> needed_columns_;                    // projected columns and input columns of filters
+    std::vector<std::pair<std::string, std::string>> criteria_;  // pairs of column and value from the predicates
+  };
+
+ public:
+  /// \brief Constructor
+  ReadPushdownPass();
+
+  /// \brief Destructor
+  ~ReadPushdownPass() = default;
+
+  /// \brief Runs a read pushdown pass to push down the projection and predicates into MindDataNode.
+  /// \param[in, out] tree The tree to operate on.
+  /// \param[in, out] Indicate of the tree was modified.
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_READ_PUSHDOWN_PASS_H_
@@ -22,6 +22,7 @@
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_offload_pass.h"
+#include "minddata/dataset/engine/opt/pre/read_pushdown_pass.h"
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
 #endif
 #include "minddata/dataset/engine/opt/pass.h"
@@ -70,6 +71,7 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
     (void)actions.emplace_back(std::make_unique<GetterPass>());
   }
 #ifndef ENABLE_ANDROID
+  (void)actions.emplace_back(std::make_unique<ReadPushdownPass>());
   (void)actions.emplace_back(std::make_unique<CacheTransformPass>());
 
   std::unique_ptr<NodeOffloadPass> offload = std::make_unique<NodeOffloadPass>();
@@ -374,6 +374,25 @@ class MS_API Dataset : public std::enable_shared_from_this<Dataset> {
     return std::make_shared<FilterDataset>(shared_from_this(), predicate, VectorStringToChar(input_columns));
   }
 
+  /// \brief Function to filter dataset by a predicate transform.
+  /// \note The predicate transform must output a boolean scalar. A transforms::Mask(RelationalOp::kEqual, constant) on
+  ///     a single index field of MindDataset is pushed down into the reader, which then skips the other rows.
+  /// \param[in] predicate TensorTransform which returns a boolean value. If false then filter the element.
+  /// \param[in] input_columns List of names of the input columns to filter.
+  /// \return Shared pointer to the current Dataset.
+  /// \par Example
+  /// \code
+  ///      /* Keep the rows whose label is 3 */
+  ///      mindspore::MSTensor constant;  // scalar tensor of value 3
+  ///      auto mask = std::make_shared<transforms::Mask>(RelationalOp::kEqual, constant);
+  ///      std::shared_ptr<Dataset> ds = ds->Filter(mask, {"label"});
+  /// \endcode
+  std::shared_ptr<FilterDataset> Filter(const std::shared_ptr<TensorTransform> &predicate,
+                                        const std::vector<std::string> &input_columns = {}) {
+    return std::make_shared<FilterDataset>(shared_from_this(), predicate != nullptr ? predicate->Parse() : nullptr,
+                                           VectorStringToChar(input_columns));
+  }
+
   /// \brief Function to create a MapDataset.
   /// \note Applies each operation in operations to this dataset.
   /// \param[in] operations Vector of raw pointers to TensorTransform objects to be applied on the dataset. Operations
@@ -846,6 +865,14 @@ class MS_API FilterDataset : public Dataset {
   FilterDataset(const std::shared_ptr<Dataset> &input, const std::function<MSTensorVec(MSTensorVec)> &predicate,
                 const std::vector<std::vector<char>> &input_columns);
 
+  /// \brief Constructor of FilterDataset.
+  /// \note If input_columns is not provided or empty, all columns will be used.
+  /// \param[in] input The dataset which need to apply filter operation.
+  /// \param[in] predicate TensorOperation which returns a boolean value. If false then filter the element.
+  /// \param[in] input_columns List of names of the input columns to filter.
+  FilterDataset(const std::shared_ptr<Dataset> &input, const std::shared_ptr<TensorOperation> &predicate,
+                const std::vector<std::vector<char>> &input_columns);
+
   /// \brief Destructor of FilterDataset.
   ~FilterDataset() override = default;
 };
@@ -6178,11 +6205,13 @@ inline std::shared_ptr<YesNoDataset> MS_API YesNo(const std::string &dataset_dir
 /// \param[in] port optional port (default=std::nullopt, means to use 50052).
 /// \param[in] num_connections optional number of connections (default=std::nullopt, means to use 12).
 /// \param[in] prefetch_sz optional prefetch size (default=std::nullopt, means to use 20).
+/// \param[in] zero_copy_fetch Fetched tensors refer to the shared memory of a local cache server directly instead of
+///     a copy (default=false).
 /// \return Shared pointer to DatasetCache. If error, nullptr is returned.
 std::shared_ptr<DatasetCache> MS_API CreateDatasetCacheCharIF(
   session_id_type id, uint64_t mem_sz, bool spill, const std::optional<std::vector<char>> &hostname = std::nullopt,
   const std::optional<int32_t> &port = std::nullopt, const std::optional<int32_t> &num_connections = std::nullopt,
-  const std::optional<int32_t> &prefetch_sz = std::nullopt);
+  const std::optional<int32_t> &prefetch_sz = std::nullopt, bool zero_copy_fetch = false);
 
 /// \brief Function the create a cache to be attached to a dataset.
 /// \param[in] id A user assigned session id for the current pipeline.
@@ -6193,6 +6222,8 @@ std::shared_ptr<DatasetCache> MS_API CreateDatasetCacheCharIF(
 /// \param[in] port optional port (default=std::nullopt, means to use 50052).
 /// \param[in] num_connections optional number of connections (default=std::nullopt, means to use 12).
 /// \param[in] prefetch_sz optional prefetch size (default=std::nullopt, means to use 20).
+/// \param[in] zero_copy_fetch Fetched tensors refer to the shared memory of a local cache server directly instead of
+///     a copy (default=false).
 /// \return Shared pointer to DatasetCache. If error, nullptr is returned.
 /// \par Example
 /// \code
@@ -6209,12 +6240,12 @@ std::shared_ptr<DatasetCache> MS_API CreateDatasetCacheCharIF(
 inline std::shared_ptr<DatasetCache> MS_API CreateDatasetCache(
   session_id_type id, uint64_t mem_sz, bool spill, const std::optional<std::string> &hostname = std::nullopt,
   const std::optional<int32_t> &port = std::nullopt, const std::optional<int32_t> &num_connections = std::nullopt,
-  const std::optional<int32_t> &prefetch_sz = std::nullopt) {
+  const std::optional<int32_t> &prefetch_sz = std::nullopt, bool zero_copy_fetch = false) {
   std::optional<std::vector<char>> hostname_c = std::nullopt;
   if (hostname != std::nullopt) {
     hostname_c = std::vector<char>(hostname->begin(), hostname->end());
   }
-  return CreateDatasetCacheCharIF(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz);
+  return CreateDatasetCacheCharIF(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz, zero_copy_fetch);
 }
 
 /// \brief Function to create a ZipDataset.
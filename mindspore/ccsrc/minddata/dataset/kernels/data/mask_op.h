@@ -43,6 +43,11 @@ class MaskOp : public TensorOp {
 
   std::string Name() const override { return kMaskOp; }
 
+  /// \brief Getter functions
+  RelationalOp Operator() const { return op_; }
+  const std::shared_ptr<Tensor> &Value() const { return value_; }
+  const DataType &Type() const { return type_; }
+
  private:
   RelationalOp op_;
   std::shared_ptr<Tensor> value_;
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kNumPixelValues = 256;
+
+// Normalize an HWC image in one pass. The columns are read from right to left when the image is flipped, and every
+// value is written to its place in the CHW or HWC output. normalize(value, channel) gives the output value.
+template <typename T, typename F>
+void NormalizeImage(const T *src, float *dst, int64_t height, int64_t width, int64_t channels, bool flip, bool to_chw,
+                    F normalize) {
+  const int64_t plane = height * width;
+  for (int64_t y = 0; y < height; ++y) {
+    const T *row = src + y * width * channels;
+    for (int64_t x = 0; x < width; ++x) {
+      const T *pixel = row + (flip ? width - 1 - x : x) * channels;
+      if (to_chw) {
+        float *out = dst + y * width + x;
+        for (int64_t c = 0; c < channels; ++c) {
+          out[c * plane] = normalize(pixel[c], c);
+        }
+      } else {
+        float *out = dst + (y * width + x) * channels;
+        for (int64_t c = 0; c < channels; ++c) {
+          out[c] = normalize(pixel[c], c);
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedNormalizeOp::FusedNormalizeOp(float flip_prob, const std::vector<float> &mean, const std::vector<float> &std,
+                                   bool to_chw)
+    : flip_prob_(flip_prob), mean_(mean), std_(std), to_chw_(to_chw), distribution_(flip_prob) {
+  if (flip_prob_ > 0 && flip_prob_ < 1) {
+    is_deterministic_ = false;
+  }
+  rnd_.seed(GetSeed());
+  // The same arithmetic as Normalize, so that the fused path gives the same floats
+  lut_.resize(mean_.size() * kNumPixelValues);
+  for (size_t c = 0; c < mean_.size(); ++c) {
+    for (int64_t v = 0; v < kNumPixelValues; ++v) {
+      lut_[c * kNumPixelValues + v] = (static_cast<float>(v) - mean_[c]) / std_[c];
+    }
+  }
+  // The flip decision is drawn by this op, the flip op of the fallback always flips
+  if (flip_prob_ > 0) {
+    flip_op_ = std::make_shared<RandomHorizontalFlipOp>(1.0);
+  }
+  normalize_op_ = std::make_shared<NormalizeOp>(mean_, std_, true);
+  if (to_chw_) {
+    hwc_to_chw_op_ = std::make_shared<HwcToChwOp>();
+  }
+}
+
+Status FusedNormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  bool flip = flip_prob_ > 0 && distribution_(rnd_);
+  const TensorShape &shape = input->shape();
+  const auto type = input->type();
+  if (shape.Rank() != kDefaultImageRank || (type != DataType::DE_UINT8 && type != DataType::DE_FLOAT32) ||
+      (mean_.size() != 1 && static_cast<dsize_t>(mean_.size()) != shape[kChannelIndexHWC])) {
+    return ComputeUnfused(input, flip, output);
+  }
+  const int64_t height = shape[0];
+  const int64_t width = shape[1];
+  const int64_t channels = shape[kChannelIndexHWC];
+  TensorShape out_shape = to_chw_ ? TensorShape({channels, height, width}) : shape;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, DataType(DataType::DE_FLOAT32), output));
+  float *dst = &(*(*output)->begin<float>());
+  RETURN_UNEXPECTED_IF_NULL(dst);
+  // caller provided 1 mean/std value, use it for every channel
+  const bool broadcast = mean_.size() == 1;
+  if (type == DataType::DE_UINT8) {
+    const float *lut = lut_.data();
+    NormalizeImage(input->GetBuffer(), dst, height, width, channels, flip, to_chw_,
+                   [lut, broadcast](uint8_t v, int64_t c) { return lut[(broadcast ? 0 : c) * kNumPixelValues + v]; });
+  } else {
+    const float *mean = mean_.data();
+    const float *std = std_.data();
+    NormalizeImage(reinterpret_cast<const float *>(input->GetBuffer()), dst, height, width, channels, flip, to_chw_,
+                   [mean, std, broadcast](float v, int64_t c) {
+                     int64_t i = broadcast ? 0 : c;
+                     return (v - mean[i]) / std[i];
+                   });
+  }
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::ComputeUnfused(const std::shared_ptr<Tensor> &input, bool flip,
+                                        std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> image = input;
+  if (flip) {
+    std::shared_ptr<Tensor> flipped;
+    RETURN_IF_NOT_OK(flip_op_->Compute(image, &flipped));
+    image = std::move(flipped);
+  }
+  if (!to_chw_) {
+    return normalize_op_->Compute(image, output);
+  }
+  std::shared_ptr<Tensor> normalized;
+  RETURN_IF_NOT_OK(normalize_op_->Compute(image, &normalized));
+  return hwc_to_chw_op_->Compute(normalized, output);
+}
+
+void FusedNormalizeOp::Print(std::ostream &out) const {
+  out << Name() << ", flip probability: " << flip_prob_ << ", mean: {";
+  for (const auto &m : mean_) {
+    out << m << ", ";
+  }
+  out << "}, std: {";
+  for (const auto &s : std_) {
+    out << s << ", ";
+  }
+  out << "}, to CHW: " << to_chw_ << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief The fusion of an optional (random) horizontal flip, a Normalize of an HWC image and an optional HWC to
+///     CHW transpose, which are the last steps of most image classification pipelines. Instead of running the three
+///     ops one after another, each of them allocating and writing a full image, the fused op reads every pixel of
+///     the input once, from the mirrored column when the image is flipped, and writes the normalized value straight
+///     to its place in the float32 output. The result is the same as the one of the op chain.
+/// \note Only the uint8 and float32 images of rank 3 take the fused path, other inputs go through the ops of the chain.
+class FusedNormalizeOp : public TensorOp {
+ public:
+  /// \brief Constructor
+  /// \param[in] flip_prob The probability to flip the image horizontally, 0 if there is no flip in the chain.
+  /// \param[in] mean The mean of each channel.
+  /// \param[in] std The standard deviation of each channel.
+  /// \param[in] to_chw Whether to transpose the output image to CHW.
+  FusedNormalizeOp(float flip_prob, const std::vector<float> &mean, const std::vector<float> &std, bool to_chw);
+
+  ~FusedNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  std::string Name() const override { return kFusedNormalizeOp; }
+
+ private:
+  /// \brief Run the ops of the chain one after another, for the inputs the fused path does not handle.
+  /// \param[in] input The input image.
+  /// \param[in] flip Whether to flip the image.
+  /// \param[out] output The output image.
+  /// \return Status The status code returned.
+  Status ComputeUnfused(const std::shared_ptr<Tensor> &input, bool flip, std::shared_ptr<Tensor> *output);
+
+  float flip_prob_;
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool to_chw_;
+  std::vector<float> lut_;  // the normalized value of each uint8 pixel value, 256 entries per channel of mean_
+  std::mt19937 rnd_;
+  std::bernoulli_distribution distribution_;
+  std::shared_ptr<TensorOp> flip_op_;
+  std::shared_ptr<TensorOp> normalize_op_;
+  std::shared_ptr<TensorOp> hwc_to_chw_op_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
@@ -15,6 +15,8 @@
  */
 #include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
 
+#include <algorithm>
+
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/kernels/image/image_utils.h"
 #else
@@ -28,6 +30,12 @@ Status HwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   IO_CHECK(input, output);
   // input.shape == HWC
   // output.shape == CHW
+#ifndef ENABLE_ANDROID
+  if (input->Rank() > kDefaultImageRank) {
+    // input.shape == <..., H, W, C>, output.shape == <..., C, H, W>
+    return HwcToChwBatch(input, output);
+  }
+#endif
   return HwcToChw(input, output);
 }
 Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -35,10 +43,16 @@ Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vect
   outputs.clear();
   CHECK_FAIL_RETURN_UNEXPECTED(inputs.size() > 0, "HwcToChwOp::OutputShape inputs size should > 0");
   TensorShape in = inputs[0];
-  TensorShape out = TensorShape{in[2], in[0], in[1]};
-  if (inputs[0].Rank() == 3) {
-    (void)outputs.emplace_back(out);
+  if (in.Rank() == 3) {
+    (void)outputs.emplace_back(TensorShape{in[2], in[0], in[1]});
   }
+#ifndef ENABLE_ANDROID
+  if (in.Rank() > 3) {
+    std::vector<dsize_t> out = in.AsVector();
+    std::rotate(out.end() - 3, out.end() - 1, out.end());
+    (void)outputs.emplace_back(TensorShape(out));
+  }
+#endif
   if (!outputs.empty()) {
     return Status::OK();
   }
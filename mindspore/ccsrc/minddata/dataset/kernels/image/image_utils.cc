@@ -499,8 +499,22 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
     STATUS_ERROR(StatusCode::kMDUnexpectedError, "Error raised by libjpeg: " + std::string(jpeg_error_msg)));
 }
 
+// The largest scale denominator of libjpeg at which a crop_w x crop_h crop is still at least min_w x min_h pixels
+static unsigned int JpegScaleDenom(int crop_w, int crop_h, int min_w, int min_h) {
+  if (min_w <= 0 || min_h <= 0) {
+    return 1;
+  }
+  constexpr int kMaxScaleDenom = 8;
+  for (int denom = kMaxScaleDenom; denom > 1; denom /= 2) {
+    if (crop_w / denom >= min_w && crop_h / denom >= min_h) {
+      return static_cast<unsigned int>(denom);
+    }
+  }
+  return 1;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int min_w, int min_h) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -535,6 +549,25 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
       std::to_string(crop_w) + ", crop height:" + std::to_string(crop_h) +
       ", and crop x coordinate:" + std::to_string(crop_x) + ", crop y coordinate:" + std::to_string(crop_y));
   }
+  const unsigned int scale_denom = JpegScaleDenom(crop_w, crop_h, min_w, min_h);
+  if (scale_denom > 1) {
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
+    try {
+      jpeg_calc_output_dimensions(&cinfo);
+      RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
+    } catch (std::runtime_error &e) {
+      return DestroyDecompressAndReturnError(e.what());
+    }
+    // the crop window in the pixels of the scaled image, covering every pixel of the original window
+    const int denom = static_cast<int>(scale_denom);
+    const int crop_x_end = std::min((crop_x + crop_w + denom - 1) / denom, static_cast<int>(cinfo.output_width));
+    const int crop_y_end = std::min((crop_y + crop_h + denom - 1) / denom, static_cast<int>(cinfo.output_height));
+    crop_x /= denom;
+    crop_y /= denom;
+    crop_w = crop_x_end - crop_x;
+    crop_h = crop_y_end - crop_y;
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -593,6 +626,35 @@ Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
   return Status::OK();
 }
 
+Status RescaleBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
+  const TensorShape &shape = input->shape();
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.Rank() > kDefaultImageRank,
+                               "Rescale: input tensor is not in shape of <..., H, W, C>, got rank: " +
+                                 std::to_string(shape.Rank()));
+  // the types which OpenCV can not convert are rejected like the single image Rescale does
+  RETURN_IF_NOT_OK(ValidateImageDtype("Rescale", input->type()));
+  const int64_t image_size = shape[-3] * shape[-2] * shape[-1];
+  const int64_t num_images = image_size == 0 ? 0 : input->Size() / image_size;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_FLOAT32), output));
+  const int cv_type = input->type().AsCVType();
+  const uint8_t element_size = input->type().SizeInBytes();
+  auto *src = const_cast<uchar *>(input->GetBuffer());
+  float *dst = &(*(*output)->begin<float>());
+  try {
+    // each image is converted as a single row of values, with the same arithmetic as Rescale
+    cv::parallel_for_(cv::Range(0, static_cast<int>(num_images)), [&](const cv::Range &range) {
+      for (int64_t n = range.start; n < range.end; ++n) {
+        cv::Mat in(1, static_cast<int>(image_size), cv_type, src + n * image_size * element_size);
+        cv::Mat out(1, static_cast<int>(image_size), CV_32F, dst + n * image_size);
+        in.convertTo(out, CV_32F, rescale, shift);
+      }
+    });
+  } catch (const cv::Exception &e) {
+    RETURN_STATUS_UNEXPECTED("Rescale: " + std::string(e.what()));
+  }
+  return Status::OK();
+}
+
 Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y, int w, int h) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
@@ -702,6 +764,63 @@ Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output)
   }
 }
 
+template <typename T>
+void HwcToChwImages(const T *src, T *dst, int64_t num_images, int64_t plane_size, int64_t num_channels) {
+  cv::parallel_for_(cv::Range(0, static_cast<int>(num_images)), [&](const cv::Range &range) {
+    for (int64_t n = range.start; n < range.end; ++n) {
+      const T *in = src + n * plane_size * num_channels;
+      T *out = dst + n * plane_size * num_channels;
+      for (int64_t c = 0; c < num_channels; ++c) {
+        T *out_channel = out + c * plane_size;
+        for (int64_t p = 0; p < plane_size; ++p) {
+          out_channel[p] = in[p * num_channels + c];
+        }
+      }
+    }
+  });
+}
+
+Status HwcToChwBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  const TensorShape &shape = input->shape();
+  const dsize_t rank = shape.Rank();
+  CHECK_FAIL_RETURN_UNEXPECTED(rank > kDefaultImageRank,
+                               "HWC2CHW: input tensor is not in shape of <..., H, W, C>, got rank: " +
+                                 std::to_string(rank));
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type().IsNumeric(), "HWC2CHW: input tensor type should be numeric.");
+  const int64_t height = shape[-3];
+  const int64_t width = shape[-2];
+  const int64_t num_channels = shape[-1];
+  std::vector<dsize_t> out_dims = shape.AsVector();
+  out_dims[rank - 3] = num_channels;
+  out_dims[rank - 2] = height;
+  out_dims[rank - 1] = width;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(out_dims), input->type(), output));
+  const int64_t plane_size = height * width;
+  const int64_t num_images = plane_size * num_channels == 0 ? 0 : input->Size() / (plane_size * num_channels);
+  // only the size of the values matters to move them around
+  switch (input->type().SizeInBytes()) {
+    case sizeof(uint8_t):
+      HwcToChwImages(&(*input->begin<uint8_t>()), &(*(*output)->begin<uint8_t>()), num_images, plane_size,
+                     num_channels);
+      break;
+    case sizeof(uint16_t):
+      HwcToChwImages(&(*input->begin<uint16_t>()), &(*(*output)->begin<uint16_t>()), num_images, plane_size,
+                     num_channels);
+      break;
+    case sizeof(uint32_t):
+      HwcToChwImages(&(*input->begin<uint32_t>()), &(*(*output)->begin<uint32_t>()), num_images, plane_size,
+                     num_channels);
+      break;
+    case sizeof(uint64_t):
+      HwcToChwImages(&(*input->begin<uint64_t>()), &(*(*output)->begin<uint64_t>()), num_images, plane_size,
+                     num_channels);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HWC2CHW: unsupported type: " + input->type().ToString());
+  }
+  return Status::OK();
+}
+
 Status MaskWithTensor(const std::shared_ptr<Tensor> &sub_mat, std::shared_ptr<Tensor> *input, int x, int y,
                       int crop_width, int crop_height, ImageFormat image_format) {
   if (image_format == ImageFormat::HWC) {
@@ -1072,6 +1191,108 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   return Status::OK();
 }
 
+template <typename T>
+void NormalizeImages(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int64_t num_images,
+                     int64_t plane_size, const std::vector<float> &mean, const std::vector<float> &std,
+                     bool is_hwc) {
+  const T *src = &(*input->begin<T>());
+  float *dst = &(*(*output)->begin<float>());
+  const auto num_channels = static_cast<int64_t>(mean.size());
+  const int64_t image_size = plane_size * num_channels;
+  cv::parallel_for_(cv::Range(0, static_cast<int>(num_images)), [&](const cv::Range &range) {
+    for (int64_t n = range.start; n < range.end; ++n) {
+      const T *in = src + n * image_size;
+      float *out = dst + n * image_size;
+      if (is_hwc) {
+        for (int64_t p = 0; p < image_size; p += num_channels) {
+          for (int64_t c = 0; c < num_channels; ++c) {
+            out[p + c] = (static_cast<float>(in[p + c]) - mean[c]) / std[c];
+          }
+        }
+      } else {
+        // every channel is a contiguous plane with a single mean and std
+        for (int64_t c = 0; c < num_channels; ++c) {
+          const T *in_channel = in + c * plane_size;
+          float *out_channel = out + c * plane_size;
+          const float m = mean[c];
+          const float s = std[c];
+          for (int64_t p = 0; p < plane_size; ++p) {
+            out_channel[p] = (static_cast<float>(in_channel[p]) - m) / s;
+          }
+        }
+      }
+    }
+  });
+}
+
+Status NormalizeBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std, bool is_hwc) {
+  const TensorShape &shape = input->shape();
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.Rank() > kDefaultImageRank,
+                               "Normalize: input tensor is not in shape of <..., H, W, C> or <..., C, H, W>, "
+                               "got rank: " +
+                                 std::to_string(shape.Rank()));
+  CHECK_FAIL_RETURN_UNEXPECTED(std.size() == mean.size(),
+                               "Normalize: mean and std vectors are not of same size, got size of std: " +
+                                 std::to_string(std.size()) + ", and mean size: " + std::to_string(mean.size()));
+  const dsize_t num_channels = is_hwc ? shape[-1] : shape[-3];
+  const int64_t plane_size = is_hwc ? shape[-3] * shape[-2] : shape[-2] * shape[-1];
+  // caller provided 1 mean/std value and there is more than one channel --> duplicate mean/std value
+  if (mean.size() == 1 && num_channels != 1) {
+    mean.resize(num_channels, mean[0]);
+    std.resize(num_channels, std[0]);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(num_channels == static_cast<dsize_t>(mean.size()),
+                               "Normalize: number of channels does not match the size of mean and std vectors, got "
+                               "channels: " +
+                                 std::to_string(num_channels) + ", size of mean: " + std::to_string(mean.size()));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_FLOAT32), output));
+  const int64_t num_images = plane_size * num_channels == 0 ? 0 : input->Size() / (plane_size * num_channels);
+  switch (static_cast<int>(input->type().value())) {
+    case DataType::DE_BOOL:
+      NormalizeImages<bool>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_INT8:
+      NormalizeImages<int8_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_UINT8:
+      NormalizeImages<uint8_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_INT16:
+      NormalizeImages<int16_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_UINT16:
+      NormalizeImages<uint16_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_INT32:
+      NormalizeImages<int32_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_UINT32:
+      NormalizeImages<uint32_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_INT64:
+      NormalizeImages<int64_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_UINT64:
+      NormalizeImages<uint64_t>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_FLOAT16:
+      NormalizeImages<float16>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_FLOAT32:
+      NormalizeImages<float>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    case DataType::DE_FLOAT64:
+      NormalizeImages<double>(input, output, num_images, plane_size, mean, std, is_hwc);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED(
+        "Normalize: unsupported type, currently supported types include "
+        "[bool,int8_t,uint8_t,int16_t,uint16_t,int32_t,uint32_t,int64_t,uint64_t,float16,float,double].");
+  }
+  return Status::OK();
+}
+
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                     std::vector<float> std, const std::string &dtype, bool is_hwc) {
   RETURN_IF_NOT_OK(ValidateImageRank("NormalizePad", input->Rank()));
@@ -157,8 +157,14 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decode a crop of a JPEG image, only the MCU rows and columns covering the crop are decoded.
+/// \param input: Tensor of the encoded JPEG image.
+/// \param output: Decoded crop of shape <h, w, 3>, or of the reduced scale, see min_w and min_h.
+/// \param x, y, w, h: Crop window in the pixels of the full resolution image, all 0 to decode the whole image.
+/// \param min_w, min_h: If greater than 0, the crop is decoded at the smallest DCT scale of libjpeg (1/8, 1/4, 1/2 or
+///     1) at which it is still at least min_w x min_h pixels, for a caller which resizes it to that size afterwards.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int min_w = 0, int min_h = 0);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -167,6 +173,13 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 /// \param output: Rescaled image Tensor of same input shape and type DE_FLOAT32
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift);
 
+/// \brief Returns a Rescaled batch of images, the images are split among the threads of OpenCV
+/// \param input: Tensor of shape <..., H, W, C> and any OpenCv compatible type, see CVTensor.
+/// \param rescale: rescale parameter
+/// \param shift: shift parameter
+/// \param output: Rescaled batch Tensor of same input shape and type DE_FLOAT32
+Status RescaleBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift);
+
 /// \brief Returns cropped ROI of an image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \param x: starting horizontal position of ROI
@@ -187,6 +200,11 @@ Status ConvertColor(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor
 /// \param output: Tensor of shape <C,H,W> or <H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+/// \brief Swaps the channels of a batch of images in one pass, the images are split among the threads of OpenCV
+/// \param input: Tensor of shape <..., H, W, C> and any numeric type.
+/// \param output: Tensor of shape <..., C, H, W> and same input type.
+Status HwcToChwBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
 /// \brief Masks the given part of the input image with a another image (sub_mat)
 /// \param[in] sub_mat The image we want to mask with
 /// \param[in] input The pointer to the image we want to mask
@@ -249,6 +267,16 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                  std::vector<float> std, bool is_hwc);
 
+/// \brief Returns a Normalized batch of images, computed in one pass over the contiguous batch instead of image by
+///     image, the images are split among the threads of OpenCV
+/// \param input: Tensor of shape <..., H, W, C> or <..., C, H, W> and any numeric type.
+/// \param mean: vector of float values which are mean of each channel
+/// \param std:  vector of float values which are std of each channel
+/// \param is_hwc: Check if input is HWC/CHW format
+/// \param output: Normalized batch Tensor of same input shape and type DE_FLOAT32
+Status NormalizeBatch(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std, bool is_hwc);
+
 /// \brief Returns Normalized and padded image
 /// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param mean: vector of float values which are mean of each channel
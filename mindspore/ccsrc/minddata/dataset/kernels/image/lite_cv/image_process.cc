@@ -15,6 +15,7 @@
  */
 
 #include "minddata/dataset/kernels/image/lite_cv/image_process.h"
+#include "minddata/dataset/kernels/image/lite_cv/simd_x86.h"
 
 #include <cfloat>
 #include <climits>
@@ -170,7 +171,14 @@ static bool ResizeBilinear3C(const unsigned char *src, int src_width, int src_he
     int16_t *row1_ptr1 = row1_ptr;
     unsigned char *dst_ptr = dst + dst_width * 3 * (y);
 
-    for (int k = 0; k < dst_width * 3; k++) {
+    int k = 0;
+#ifdef ENABLE_X86_SIMD
+    k = ResizeBilinearRowX86(row0_ptr0, row1_ptr1, y_weight[0], y_weight[1], dst_ptr, dst_width * 3);
+    row0_ptr0 += k;
+    row1_ptr1 += k;
+    dst_ptr += k;
+#endif
+    for (; k < dst_width * 3; k++) {
       int16_t t0 = (int16_t)((y_weight[0] * (int16_t)(*row0_ptr0++)) >> 16);
       int16_t t1 = (int16_t)((y_weight[1] * (int16_t)(*row1_ptr1++)) >> 16);
       *dst_ptr++ = static_cast<unsigned char>((t0 + t1 + 2) >> 2);
@@ -266,7 +274,14 @@ static bool ResizeBilinear1C(const unsigned char *src, int src_width, int src_he
     int16_t *row1_ptr1 = row1_ptr;
     unsigned char *dst_ptr = dst + dst_width * (y);
 
-    for (int k = 0; k < dst_width; k++) {
+    int k = 0;
+#ifdef ENABLE_X86_SIMD
+    k = ResizeBilinearRowX86(row0_ptr0, row1_ptr1, y_weight[0], y_weight[1], dst_ptr, dst_width);
+    row0_ptr0 += k;
+    row1_ptr1 += k;
+    dst_ptr += k;
+#endif
+    for (; k < dst_width; k++) {
       int16_t t0 = (int16_t)((y_weight[0] * (int16_t)(*row0_ptr0++)) >> 16);
       int16_t t1 = (int16_t)((y_weight[1] * (int16_t)(*row1_ptr1++)) >> 16);
       *dst_ptr++ = static_cast<unsigned char>((t0 + t1 + 2) >> 2);
@@ -663,6 +678,8 @@ bool ConvertTo(const LiteMat &src, LiteMat &dst, double scale) {
     vst1q_f32(dst_ptr + x + 8, v_hl_f32x4);
     vst1q_f32(dst_ptr + x + 12, v_hh_f32x4);
   }
+#elif defined(ENABLE_X86_SIMD)
+  x = ConvertToX86(src_ptr, dst_ptr, total_size, scale);
 #endif
   for (; x < total_size; x++) {
     dst_ptr[x] = static_cast<float>(src_ptr[x] * scale);
@@ -749,52 +766,39 @@ static bool CheckMeanAndStd(const LiteMat &src, LiteMat &dst, int channel, const
   return true;
 }
 
+template <typename T>
+static void SubStractMeanNormalizeImpl(const T *src_ptr, float *dst_ptr, int64_t total_size, int channel,
+                                       const std::vector<float> &mean, const std::vector<float> &std) {
+  int64_t x = 0;
+#ifdef ENABLE_X86_SIMD
+  x = NormalizeX86(src_ptr, dst_ptr, total_size, channel, mean.data(), std.data());
+#endif
+  int c = static_cast<int>(x % channel);
+  for (; x < total_size; x++) {
+    dst_ptr[x] = (static_cast<float>(src_ptr[x]) - mean[c]) / std[c];
+    if (++c == channel) {
+      c = 0;
+    }
+  }
+}
+
 bool SubStractMeanNormalize(const LiteMat &src, LiteMat &dst, const std::vector<float> &mean,
                             const std::vector<float> &std) {
   if (!CheckMeanAndStd(src, dst, src.channel_, mean, std)) {
     return false;
   }
-  LiteMat src_f;
+  // Subtracting a mean of 0 and dividing by a std of 1 leave the pixels unchanged, so a missing mean or std
+  // is filled in with them.
+  std::vector<float> mean_c = mean.empty() ? std::vector<float>(src.channel_, 0.0f) : mean;
+  std::vector<float> std_c = std.empty() ? std::vector<float>(src.channel_, 1.0f) : std;
+  int64_t total_size = static_cast<int64_t>(src.height_) * src.width_ * src.channel_;
+  float *dst_ptr = reinterpret_cast<float *>(dst.data_ptr_);
   if (src.data_type_ == LDataType::UINT8) {
-    ConvertTo(src, src_f, 1.0);
-  } else {
-    src_f = src;
-  }
-
-  const float *src_start_p = src_f;
-  float *dst_start_p = dst;
-  if ((!mean.empty()) && std.empty()) {
-    for (int h = 0; h < src_f.height_; h++) {
-      for (int w = 0; w < src_f.width_; w++) {
-        uint32_t src_start = (h * src_f.width_ + w) * src_f.channel_;
-        for (int c = 0; c < src_f.channel_; c++) {
-          uint32_t index = src_start + c;
-          dst_start_p[index] = src_start_p[index] - mean[c];
-        }
-      }
-    }
-  } else if (mean.empty() && (!std.empty())) {
-    for (int h = 0; h < src_f.height_; h++) {
-      for (int w = 0; w < src_f.width_; w++) {
-        uint32_t src_start = (h * src_f.width_ + w) * src_f.channel_;
-        for (int c = 0; c < src_f.channel_; c++) {
-          uint32_t index = src_start + c;
-          dst_start_p[index] = src_start_p[index] / std[c];
-        }
-      }
-    }
-  } else if ((!mean.empty()) && (!std.empty())) {
-    for (int h = 0; h < src_f.height_; h++) {
-      for (int w = 0; w < src_f.width_; w++) {
-        uint32_t src_start = (h * src_f.width_ + w) * src_f.channel_;
-        for (int c = 0; c < src_f.channel_; c++) {
-          uint32_t index = src_start + c;
-          dst_start_p[index] = (src_start_p[index] - mean[c]) / std[c];
-        }
-      }
-    }
+    SubStractMeanNormalizeImpl(reinterpret_cast<const uint8_t *>(src.data_ptr_), dst_ptr, total_size, src.channel_,
+                               mean_c, std_c);
   } else {
-    return false;
+    SubStractMeanNormalizeImpl(reinterpret_cast<const float *>(src.data_ptr_), dst_ptr, total_size, src.channel_,
+                               mean_c, std_c);
   }
   return true;
 }
@@ -808,7 +812,7 @@ static void PadWithConstant(const LiteMat &src, LiteMat &dst, const int top, con
   int src_step = src.width_ * src.channel_ * src.elem_size_;
   int dst_step = dst.width_ * dst.channel_ * dst.elem_size_;
   if (dst.channel_ == 1) {
-    for (int i = 0; i < dst_step; i++) {
+    for (int i = 0; i < dst.width_; i++) {
       const_ptr[i] = fill_b_or_gray;
     }
   } else if (dst.channel_ == 3) {
@@ -870,16 +874,34 @@ static void PadImplement(const LiteMat &src, LiteMat &dst, const int top, const
 
   const T *src_ptr = src;
   T *dst_ptr = dst;
-  for (int y = 0; y < dst.height_; y++) {
-    for (int x = 0; x < dst.width_; x++) {
-      if (y < top || y >= dst.height_ - bottom || x < left || x >= dst.width_ - right) {
-        int src_y = PadFromPos(y - top, src.height_, pad_type);
-        int src_x = PadFromPos(x - left, src.width_, pad_type);
-        for (int cn = 0; cn < dst.channel_; cn++) {
-          dst_ptr[y * dst_step + x * dst.channel_ + cn] = src_ptr[src_y * src_step + src_x * src.channel_ + cn];
-        }
-      }
-    }
+  // Fill the left and right borders of the rows of the image first, the top and bottom borders are then whole
+  // padded rows, which are copied instead of being computed pixel by pixel.
+  auto pad_pixel = [&](T *dst_row, const T *src_row, int x) {
+    int src_x = PadFromPos(x - left, src.width_, pad_type);
+    for (int cn = 0; cn < dst.channel_; cn++) {
+      dst_row[x * dst.channel_ + cn] = src_row[src_x * src.channel_ + cn];
+    }
+  };
+  for (int y = top; y < dst.height_ - bottom; y++) {
+    T *dst_row = dst_ptr + y * dst_step;
+    const T *src_row = src_ptr + (y - top) * src_step;
+    for (int x = 0; x < left; x++) {
+      pad_pixel(dst_row, src_row, x);
+    }
+    for (int x = dst.width_ - right; x < dst.width_; x++) {
+      pad_pixel(dst_row, src_row, x);
+    }
+  }
+  auto pad_row = [&](int y) {
+    int src_y = PadFromPos(y - top, src.height_, pad_type);
+    // mindspore lite version, there is no securec lib
+    memcpy(dst_ptr + y * dst_step, dst_ptr + (src_y + top) * dst_step, dst_step * sizeof(T));
+  };
+  for (int y = 0; y < top; y++) {
+    pad_row(y);
+  }
+  for (int y = dst.height_ - bottom; y < dst.height_; y++) {
+    pad_row(y);
   }
 }
 
@@ -0,0 +1,315 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/lite_cv/simd_x86.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#ifdef ENABLE_X86_SIMD
+#include <immintrin.h>
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace mindspore {
+namespace dataset {
+static std::atomic<int> g_x86_isa_limit(static_cast<int>(X86Isa::kAvx512));
+
+static X86Isa DetectX86Isa() {
+#ifdef ENABLE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return X86Isa::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return X86Isa::kAvx2;
+  }
+#endif
+  return X86Isa::kScalar;
+}
+
+X86Isa GetX86Isa() {
+  static const X86Isa cpu_isa = DetectX86Isa();
+  return static_cast<X86Isa>(std::min(static_cast<int>(cpu_isa), g_x86_isa_limit.load()));
+}
+
+X86Isa SetX86IsaLimit(X86Isa isa) { return static_cast<X86Isa>(g_x86_isa_limit.exchange(static_cast<int>(isa))); }
+
+#ifdef ENABLE_X86_SIMD
+TARGET_AVX2 static int64_t ConvertToAvx2(const uint8_t *src, float *dst, int64_t size, double scale) {
+  // Multiply in double like the scalar code, so that the result is rounded to float only once
+  const __m256d v_scale = _mm256_set1_pd(scale);
+  const int64_t step = 8;
+  int64_t x = 0;
+  for (; x <= size - step; x += step) {
+    __m256i v_src = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + x)));
+    __m256d v_lo = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(v_src)), v_scale);
+    __m256d v_hi = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(v_src, 1)), v_scale);
+    _mm_storeu_ps(dst + x, _mm256_cvtpd_ps(v_lo));
+    _mm_storeu_ps(dst + x + 4, _mm256_cvtpd_ps(v_hi));
+  }
+  return x;
+}
+
+TARGET_AVX512 static int64_t ConvertToAvx512(const uint8_t *src, float *dst, int64_t size, double scale) {
+  const __m512d v_scale = _mm512_set1_pd(scale);
+  const int64_t step = 16;
+  int64_t x = 0;
+  for (; x <= size - step; x += step) {
+    __m512i v_src = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x)));
+    __m512d v_lo = _mm512_mul_pd(_mm512_cvtepi32_pd(_mm512_castsi512_si256(v_src)), v_scale);
+    __m512d v_hi = _mm512_mul_pd(_mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(v_src, 1)), v_scale);
+    _mm256_storeu_ps(dst + x, _mm512_cvtpd_ps(v_lo));
+    _mm256_storeu_ps(dst + x + 8, _mm512_cvtpd_ps(v_hi));
+  }
+  return x;
+}
+
+int64_t ConvertToX86(const uint8_t *src, float *dst, int64_t size, double scale) {
+  switch (GetX86Isa()) {
+    case X86Isa::kAvx512:
+      return ConvertToAvx512(src, dst, size, scale);
+    case X86Isa::kAvx2:
+      return ConvertToAvx2(src, dst, size, scale);
+    default:
+      return 0;
+  }
+}
+
+TARGET_AVX2 static inline __m256 LoadAvx2(const uint8_t *src) {
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src))));
+}
+
+TARGET_AVX2 static inline __m256 LoadAvx2(const float *src) { return _mm256_loadu_ps(src); }
+
+TARGET_AVX512 static inline __m512 LoadAvx512(const uint8_t *src) {
+  return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))));
+}
+
+TARGET_AVX512 static inline __m512 LoadAvx512(const float *src) { return _mm512_loadu_ps(src); }
+
+// The channel of a lane changes from one vector to the next, the mean and std of the lanes repeat every
+// channel vectors. Lay them out for a block of channel vectors.
+static void InitNormalizeBlock(int64_t block, int channel, const float *mean, const float *std,
+                               std::vector<float> *mean_block, std::vector<float> *std_block) {
+  mean_block->resize(block);
+  std_block->resize(block);
+  for (int64_t i = 0; i < block; i++) {
+    (*mean_block)[i] = mean[i % channel];
+    (*std_block)[i] = std[i % channel];
+  }
+}
+
+template <typename T>
+TARGET_AVX2 static int64_t NormalizeAvx2(const T *src, float *dst, int64_t size, int channel, const float *mean,
+                                         const float *std) {
+  const int64_t lanes = 8;
+  const int64_t block = lanes * channel;
+  std::vector<float> mean_block;
+  std::vector<float> std_block;
+  InitNormalizeBlock(block, channel, mean, std, &mean_block, &std_block);
+  int64_t x = 0;
+  for (; x <= size - block; x += block) {
+    for (int64_t i = 0; i < block; i += lanes) {
+      __m256 v_src = LoadAvx2(src + x + i);
+      __m256 v_sub = _mm256_sub_ps(v_src, _mm256_loadu_ps(&mean_block[i]));
+      __m256 v_dst = _mm256_div_ps(v_sub, _mm256_loadu_ps(&std_block[i]));
+      _mm256_storeu_ps(dst + x + i, v_dst);
+    }
+  }
+  return x;
+}
+
+template <typename T>
+TARGET_AVX512 static int64_t NormalizeAvx512(const T *src, float *dst, int64_t size, int channel, const float *mean,
+                                             const float *std) {
+  const int64_t lanes = 16;
+  const int64_t block = lanes * channel;
+  std::vector<float> mean_block;
+  std::vector<float> std_block;
+  InitNormalizeBlock(block, channel, mean, std, &mean_block, &std_block);
+  int64_t x = 0;
+  for (; x <= size - block; x += block) {
+    for (int64_t i = 0; i < block; i += lanes) {
+      __m512 v_src = LoadAvx512(src + x + i);
+      __m512 v_sub = _mm512_sub_ps(v_src, _mm512_loadu_ps(&mean_block[i]));
+      __m512 v_dst = _mm512_div_ps(v_sub, _mm512_loadu_ps(&std_block[i]));
+      _mm512_storeu_ps(dst + x + i, v_dst);
+    }
+  }
+  return x;
+}
+
+int64_t NormalizeX86(const uint8_t *src, float *dst, int64_t size, int channel, const float *mean, const float *std) {
+  switch (GetX86Isa()) {
+    case X86Isa::kAvx512:
+      return NormalizeAvx512(src, dst, size, channel, mean, std);
+    case X86Isa::kAvx2:
+      return NormalizeAvx2(src, dst, size, channel, mean, std);
+    default:
+      return 0;
+  }
+}
+
+int64_t NormalizeX86(const float *src, float *dst, int64_t size, int channel, const float *mean, const float *std) {
+  switch (GetX86Isa()) {
+    case X86Isa::kAvx512:
+      return NormalizeAvx512(src, dst, size, channel, mean, std);
+    case X86Isa::kAvx2:
+      return NormalizeAvx2(src, dst, size, channel, mean, std);
+    default:
+      return 0;
+  }
+}
+
+TARGET_AVX2 static inline __m256i BlendRowsAvx2(const int16_t *row0, const int16_t *row1, __m256i v_w0, __m256i v_w1) {
+  __m256i v_t0 = _mm256_mulhi_epi16(v_w0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0)));
+  __m256i v_t1 = _mm256_mulhi_epi16(v_w1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1)));
+  return _mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(v_t0, v_t1), _mm256_set1_epi16(2)), 2);
+}
+
+TARGET_AVX2 static int ResizeBilinearRowAvx2(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1,
+                                             uint8_t *dst, int size) {
+  const __m256i v_w0 = _mm256_set1_epi16(w0);
+  const __m256i v_w1 = _mm256_set1_epi16(w1);
+  const int step = 32;
+  int x = 0;
+  for (; x <= size - step; x += step) {
+    __m256i v_lo = BlendRowsAvx2(row0 + x, row1 + x, v_w0, v_w1);
+    __m256i v_hi = BlendRowsAvx2(row0 + x + step / 2, row1 + x + step / 2, v_w0, v_w1);
+    // packus works on 128 bit lanes, put the quarters back in order
+    __m256i v_dst = _mm256_permute4x64_epi64(_mm256_packus_epi16(v_lo, v_hi), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), v_dst);
+  }
+  return x;
+}
+
+int ResizeBilinearRowX86(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1, uint8_t *dst, int size) {
+  if (GetX86Isa() < X86Isa::kAvx2) {
+    return 0;
+  }
+  return ResizeBilinearRowAvx2(row0, row1, w0, w1, dst, size);
+}
+
+TARGET_AVX2 static int WarpAffineCoordsAvx2(int x0, int y0, const int *a, const int *b, int shift, int bits,
+                                            int16_t *xy, int16_t *alpha, int size) {
+  const __m256i v_x0 = _mm256_set1_epi32(x0);
+  const __m256i v_y0 = _mm256_set1_epi32(y0);
+  const __m256i v_mask = _mm256_set1_epi32((1 << bits) - 1);
+  const __m128i v_shift = _mm_cvtsi32_si128(shift);
+  const __m128i v_bits = _mm_cvtsi32_si128(bits);
+  const int step = 8;
+  int x = 0;
+  for (; x <= size - step; x += step) {
+    __m256i v_x = _mm256_sra_epi32(_mm256_add_epi32(v_x0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + x))),
+                                   v_shift);
+    __m256i v_y = _mm256_sra_epi32(_mm256_add_epi32(v_y0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + x))),
+                                   v_shift);
+    __m256i v_sx = _mm256_sra_epi32(v_x, v_bits);
+    __m256i v_sy = _mm256_sra_epi32(v_y, v_bits);
+    // Interleave x and y by 32 bits first, so that the saturating pack keeps the pixels in order
+    __m256i v_xy = _mm256_packs_epi32(_mm256_unpacklo_epi32(v_sx, v_sy), _mm256_unpackhi_epi32(v_sx, v_sy));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(xy + 2 * x), v_xy);
+    __m256i v_alpha = _mm256_or_si256(_mm256_sll_epi32(_mm256_and_si256(v_y, v_mask), v_bits),
+                                      _mm256_and_si256(v_x, v_mask));
+    v_alpha = _mm256_permute4x64_epi64(_mm256_packs_epi32(v_alpha, v_alpha), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(alpha + x), _mm256_castsi256_si128(v_alpha));
+  }
+  return x;
+}
+
+int WarpAffineCoordsX86(int x0, int y0, const int *a, const int *b, int shift, int bits, int16_t *xy, int16_t *alpha,
+                        int size) {
+  if (GetX86Isa() < X86Isa::kAvx2) {
+    return 0;
+  }
+  return WarpAffineCoordsAvx2(x0, y0, a, b, shift, bits, xy, alpha, size);
+}
+
+TARGET_AVX2 static int RemapBilinearAvx2(const uint8_t *src, size_t src_step, int cn, const int16_t *xy,
+                                         const uint16_t *alpha, const int16_t *wblock, uint8_t *dst, int size) {
+  // Every channel gathers 4 bytes of the top row from its top left neighbour, and 4 bytes of the bottom row ending
+  // at its bottom right neighbour, so that no read goes past the 2x2 neighbourhood of the last pixel of the image.
+  // The shuffles then pick the two neighbours of each row as a pair of int16 to be weighted by madd.
+  const int kLanes = 8;
+  const int kLaneBytes = 4;
+  alignas(32) int8_t top_mask[kLanes * kLaneBytes];
+  alignas(32) int8_t bottom_mask[kLanes * kLaneBytes];
+  for (int i = 0; i < kLanes; i++) {
+    int8_t base = static_cast<int8_t>((i % 4) * kLaneBytes);
+    int8_t top[] = {base, -1, static_cast<int8_t>(base + cn), -1};
+    int8_t bottom[] = {static_cast<int8_t>(base + kLaneBytes - 1 - cn), -1, static_cast<int8_t>(base + kLaneBytes - 1),
+                       -1};
+    memcpy(top_mask + i * kLaneBytes, top, kLaneBytes);
+    memcpy(bottom_mask + i * kLaneBytes, bottom, kLaneBytes);
+  }
+  const __m256i v_top_mask = _mm256_load_si256(reinterpret_cast<const __m256i *>(top_mask));
+  const __m256i v_bottom_mask = _mm256_load_si256(reinterpret_cast<const __m256i *>(bottom_mask));
+  const __m256i v_step = _mm256_set1_epi32(static_cast<int>(src_step));
+  const __m256i v_cn = _mm256_set1_epi32(cn);
+  const __m256i v_bottom = _mm256_set1_epi32(static_cast<int>(src_step) + cn + 1 - kLaneBytes);
+  const __m256i v_round = _mm256_set1_epi32(1 << 14);
+  const int *wblock_ptr = reinterpret_cast<const int *>(wblock);
+  int x = 0;
+  for (; x <= size - kLanes; x += kLanes) {
+    __m256i v_xy = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xy + 2 * x));
+    __m256i v_sx = _mm256_srai_epi32(_mm256_slli_epi32(v_xy, 16), 16);
+    __m256i v_sy = _mm256_srai_epi32(v_xy, 16);
+    __m256i v_top_offset = _mm256_add_epi32(_mm256_mullo_epi32(v_sy, v_step), _mm256_mullo_epi32(v_sx, v_cn));
+    __m256i v_bottom_offset = _mm256_add_epi32(v_top_offset, v_bottom);
+    __m256i v_w_index =
+      _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha + x))), 2);
+    __m256i v_w01 = _mm256_i32gather_epi32(wblock_ptr, v_w_index, 2);
+    __m256i v_w23 = _mm256_i32gather_epi32(wblock_ptr, _mm256_add_epi32(v_w_index, _mm256_set1_epi32(2)), 2);
+    for (int k = 0; k < cn; k++) {
+      const int *src_ptr = reinterpret_cast<const int *>(src + k);
+      __m256i v_top = _mm256_shuffle_epi8(_mm256_i32gather_epi32(src_ptr, v_top_offset, 1), v_top_mask);
+      __m256i v_bottom_row = _mm256_shuffle_epi8(_mm256_i32gather_epi32(src_ptr, v_bottom_offset, 1), v_bottom_mask);
+      __m256i v_sum = _mm256_add_epi32(_mm256_madd_epi16(v_top, v_w01), _mm256_madd_epi16(v_bottom_row, v_w23));
+      v_sum = _mm256_srai_epi32(_mm256_add_epi32(v_sum, v_round), 15);
+      __m256i v_u16 = _mm256_packus_epi32(v_sum, v_sum);
+      __m256i v_u8 = _mm256_packus_epi16(v_u16, v_u16);
+      uint32_t lo = static_cast<uint32_t>(_mm256_cvtsi256_si32(v_u8));
+      uint32_t hi = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(v_u8, 1)));
+      if (cn == 1) {
+        memcpy(dst + x, &lo, sizeof(lo));
+        memcpy(dst + x + kLanes / 2, &hi, sizeof(hi));
+      } else {
+        uint8_t values[kLanes];
+        memcpy(values, &lo, sizeof(lo));
+        memcpy(values + kLanes / 2, &hi, sizeof(hi));
+        for (int i = 0; i < kLanes; i++) {
+          dst[(x + i) * cn + k] = values[i];
+        }
+      }
+    }
+  }
+  return x;
+}
+
+int RemapBilinearX86(const uint8_t *src, size_t src_step, int cn, const int16_t *xy, const uint16_t *alpha,
+                     const int16_t *wblock, uint8_t *dst, int size) {
+  if (GetX86Isa() < X86Isa::kAvx2 || cn < 1 || cn > 3) {
+    return 0;
+  }
+  return RemapBilinearAvx2(src, src_step, cn, xy, alpha, wblock, dst, size);
+}
+#endif
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMD_X86_H_
+#define SIMD_X86_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// The x86 kernels are compiled for their instruction set with function target attributes and picked at runtime,
+// so that the library itself still runs on any x86-64 cpu.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ENABLE_NEON)
+#define ENABLE_X86_SIMD
+#endif
+
+namespace mindspore {
+namespace dataset {
+/// \brief The x86 instruction sets the lite_cv kernels are vectorized for, in increasing order.
+enum class X86Isa : int { kScalar = 0, kAvx2 = 1, kAvx512 = 2 };
+
+/// \brief Get the instruction set the kernels run with, which is the best one supported by the cpu,
+///     capped by SetX86IsaLimit. Always kScalar if the x86 kernels are not compiled in.
+X86Isa GetX86Isa();
+
+/// \brief Cap the instruction set the kernels run with, e.g. to compare the vectorized kernels with the scalar ones.
+/// \param[in] isa The best instruction set to use.
+/// \return The previous cap.
+X86Isa SetX86IsaLimit(X86Isa isa);
+
+#ifdef ENABLE_X86_SIMD
+// The kernels below compute the leading elements of a loop of the scalar implementation, bit exactly, and return
+// how many of them were done. The caller finishes the remaining ones with its scalar code. They return 0 when the
+// cpu does not support the instruction set they need.
+
+/// \brief dst[i] = static_cast<float>(src[i] * scale), the loop of ConvertTo.
+int64_t ConvertToX86(const uint8_t *src, float *dst, int64_t size, double scale);
+
+/// \brief dst[i] = (src[i] - mean[i % channel]) / std[i % channel], the loop of SubStractMeanNormalize.
+int64_t NormalizeX86(const uint8_t *src, float *dst, int64_t size, int channel, const float *mean, const float *std);
+
+int64_t NormalizeX86(const float *src, float *dst, int64_t size, int channel, const float *mean, const float *std);
+
+/// \brief The vertical pass of ResizeBilinear, which blends two rows of horizontally interpolated pixels
+///     dst[i] = (((w0 * row0[i]) >> 16) + ((w1 * row1[i]) >> 16) + 2) >> 2.
+int ResizeBilinearRowX86(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1, uint8_t *dst, int size);
+
+/// \brief The source coordinates of WarpAffineBilinear for a row of destination pixels
+///     X = (x0 + a[i]) >> shift, Y = (y0 + b[i]) >> shift,
+///     xy[2 * i] = saturate(X >> bits), xy[2 * i + 1] = saturate(Y >> bits),
+///     alpha[i] = (Y & mask) << bits | (X & mask), with mask = (1 << bits) - 1.
+int WarpAffineCoordsX86(int x0, int y0, const int *a, const int *b, int shift, int bits, int16_t *xy, int16_t *alpha,
+                        int size);
+
+/// \brief The bilinear remap of a span of destination pixels whose 2x2 source neighbourhood is inside the image
+///     dst[i * cn + k] = saturate((p00 * w[0] + p01 * w[1] + p10 * w[2] + p11 * w[3] + (1 << 14)) >> 15),
+///     with p the neighbours of channel k at xy[2 * i], xy[2 * i + 1] and w = wblock + alpha[i] * 4.
+///     Only 1, 2 and 3 channels are vectorized.
+int RemapBilinearX86(const uint8_t *src, size_t src_step, int cn, const int16_t *xy, const uint16_t *alpha,
+                     const int16_t *wblock, uint8_t *dst, int size);
+#endif
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // SIMD_X86_H_
@@ -19,6 +19,7 @@
 
 #include "lite_cv/lite_mat.h"
 #include "lite_cv/image_process.h"
+#include "lite_cv/simd_x86.h"
 
 constexpr int kBits = 5;
 constexpr int kBits1 = 15;
@@ -296,6 +297,9 @@ static void RemapBilinear(const LiteMat &_src, LiteMat &_dst, const LiteMat &_hw
 
       if (!curLine) {
         int length = 0;
+#ifdef ENABLE_X86_SIMD
+        length = RemapBilinearX86(src_ptr, src_step, cn, HW + dx * 2, FHW + dx, wblock, dst_ptr, H1 - dx);
+#endif
         dst_ptr += length * cn;
         dx += length;
 
@@ -445,6 +449,9 @@ bool WarpAffineBilinear(const LiteMat &src, LiteMat &dst, const LiteMat &M, int
         int Y0 = round((IM[4] * (y + y1) + IM[5]) * SCALE) + r_delta;
         int16_t *t_a = A_Ptr + y1 * t_bw;
         x1 = 0;
+#ifdef ENABLE_X86_SIMD
+        x1 = WarpAffineCoordsX86(X0, Y0, a + x, b + x, 10 - kBits, kBits, t_xy, t_a, t_bw);
+#endif
         for (; x1 < t_bw; x1++) {
           int X = (X0 + a[x + x1]) >> (10 - kBits);
           int Y = (Y0 + b[x + x1]) >> (10 - kBits);
@@ -47,6 +47,10 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
     return Normalize(input, output, mean_, std_);
 #endif
   } else {
+#ifndef ENABLE_ANDROID
+    // [..., H, W, C] or [..., C, H, W], normalize the whole batch in one pass
+    return NormalizeBatch(input, output, mean_, std_, is_hwc_);
+#else
     // reshape [..., H, W, C] to [N, H, W, C]
     dsize_t num_batch = input->Size() / (input_shape[-3] * input_shape[-2] * input_shape[-1]);
     TensorShape new_shape({num_batch, input_shape[-3], input_shape[-2], input_shape[-1]});
@@ -68,6 +72,7 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
     RETURN_IF_NOT_OK(TensorVectorToBatchTensor(output_vector_hwc, &(*output)));
     RETURN_IF_NOT_OK((*output)->Reshape(input_shape));
     return Status::OK();
+#endif
   }
 }
 
@@ -25,7 +25,11 @@ RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(int32_t target_height, int32_
                                                    float scale_ub, float aspect_lb, float aspect_ub,
                                                    InterpolationMode interpolation, int32_t max_attempts)
     : RandomCropAndResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub, interpolation,
-                            max_attempts) {}
+                            max_attempts),
+      jpeg_dct_scaling_(GlobalContext::config_manager()->jpeg_dct_scaling()) {}
+
+RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs)
+    : RandomCropAndResizeOp(rhs), jpeg_dct_scaling_(GlobalContext::config_manager()->jpeg_dct_scaling()) {}
 
 Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
@@ -53,7 +57,11 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
         RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
       }
       std::shared_ptr<Tensor> decoded_tensor = nullptr;
-      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
+      // with DCT scaling the crop is decoded at a reduced scale, which the resize below brings to the target size
+      const int min_width = jpeg_dct_scaling_ ? target_width_ : 0;
+      const int min_height = jpeg_dct_scaling_ ? target_height_ : 0;
+      RETURN_IF_NOT_OK(
+        JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height, min_width, min_height));
       RETURN_IF_NOT_OK(Resize(decoded_tensor, &(*output)[i], target_height_, target_width_, 0.0, 0.0, interpolation_));
     }
   }
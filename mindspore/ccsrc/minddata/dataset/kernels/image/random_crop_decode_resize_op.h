@@ -35,7 +35,7 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
                            InterpolationMode interpolation = kDefInterpolation, int32_t max_attempts = kDefMaxIter);
 
-  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs) : RandomCropAndResizeOp(rhs) {}
+  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs);
 
   ~RandomCropDecodeResizeOp() override = default;
 
@@ -46,6 +46,10 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+ private:
+  // Decode the crop of a JPEG image at the smallest DCT scale still larger than the target size
+  bool jpeg_dct_scaling_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -22,6 +22,10 @@ namespace mindspore {
 namespace dataset {
 Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
+  if (input->Rank() > kDefaultImageRank) {
+    // [..., H, W, C], rescale the images of the batch in parallel
+    return RescaleBatch(input, output, rescale_, shift_);
+  }
   return Rescale(input, output, rescale_, shift_);
 }
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
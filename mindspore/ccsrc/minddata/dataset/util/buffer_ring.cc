@@ -0,0 +1,164 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/buffer_ring.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "./securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+// The number of sizes free buffers are kept for. The buffers of any other size are given back to the system, so
+// that a producer of ever changing sizes does not grow the pool without bound.
+constexpr size_t kMaxBufferSizes = 16;
+
+BufferRing::BufferRing(int32_t capacity, bool pin_memory)
+    : capacity_(std::max(capacity, 0)),
+      pin_memory_(pin_memory),
+      pin_failed_(false),
+      num_system_allocations_(0),
+      num_reused_allocations_(0) {}
+
+BufferRing::~BufferRing() {
+  for (auto &sz_buffers : free_) {
+    for (auto &buffer : sz_buffers.second) {
+      Release(buffer.first, buffer.second);
+    }
+  }
+  free_.clear();
+  MS_LOG(INFO) << "Buffer ring released. System allocations: " << num_system_allocations_
+               << ", reused allocations: " << num_reused_allocations_ << ".";
+}
+
+Status BufferRing::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto it = free_.find(n);
+    if (it != free_.end() && !it->second.empty()) {
+      auto buffer = it->second.back();
+      it->second.pop_back();
+      (void)in_use_.emplace(buffer.first, buffer.second);
+      num_reused_allocations_++;
+      *p = buffer.first;
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  Buffer buffer{n, false};
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (pin_memory_) {
+    // The pinned buffers take whole pages, otherwise unlocking a buffer would also unlock the pages it shares with
+    // its neighbours.
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (posix_memalign(&q, page_size, PinnedSize(n)) != 0) {
+      RETURN_STATUS_OOM("Out of memory.");
+    }
+    buffer.pinned = mlock(q, PinnedSize(n)) == 0;
+  }
+#endif
+  if (q == nullptr) {
+    RETURN_IF_NOT_OK(DeMalloc(std::max(n, static_cast<size_t>(1)), &q, false));
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  if (pin_memory_ && !buffer.pinned && !pin_failed_) {
+    pin_failed_ = true;
+    MS_LOG(WARNING) << "Failed to pin the batch buffers, they are used unpinned. Check the limit of locked memory "
+                    << "(ulimit -l).";
+  }
+  (void)in_use_.emplace(q, buffer);
+  num_system_allocations_++;
+  *p = q;
+  return Status::OK();
+}
+
+Status BufferRing::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (old_sz >= new_sz) {
+    // Do nothing if we shrink.
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err != EOK) {
+    Deallocate(q);
+    RETURN_STATUS_UNEXPECTED("Failed to copy the buffer, error code: " + std::to_string(err));
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void BufferRing::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = in_use_.find(p);
+  if (it == in_use_.end()) {
+    MS_LOG(ERROR) << "The buffer " << p << " is not allocated from this buffer ring.";
+    return;
+  }
+  Buffer buffer = it->second;
+  (void)in_use_.erase(it);
+  auto sz_it = free_.find(buffer.size);
+  if (sz_it == free_.end() && free_.size() < kMaxBufferSizes) {
+    sz_it = free_.emplace(buffer.size, std::vector<std::pair<void *, Buffer>>()).first;
+  }
+  if (sz_it != free_.end() && sz_it->second.size() < static_cast<size_t>(capacity_)) {
+    sz_it->second.emplace_back(p, buffer);
+    return;
+  }
+  lck.unlock();
+  Release(p, buffer);
+}
+
+uint64_t BufferRing::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+int64_t BufferRing::NumSystemAllocations() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return num_system_allocations_;
+}
+
+int64_t BufferRing::NumReusedAllocations() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return num_reused_allocations_;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+size_t BufferRing::PinnedSize(size_t n) {
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return (std::max(n, static_cast<size_t>(1)) + page_size - 1) / page_size * page_size;
+}
+#endif
+
+void BufferRing::Release(void *p, const Buffer &buffer) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (buffer.pinned) {
+    (void)munlock(p, PinnedSize(buffer.size));
+  }
+#endif
+  free(p);
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_RING_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool that recycles the buffers given back to it. The pool is meant
+// for a producer that allocates buffers of the same few sizes over and over,
+// e.g., the batches of a BatchOp worker. A buffer freed by its consumer is kept
+// on a free list of its size, up to capacity buffers per size, and handed out
+// again by the next allocation of that size instead of going to the system.
+// Buffers can optionally be page locked (pinned) when they are first allocated,
+// so that they are not swapped out and can be copied to a device without being
+// staged. Deallocate can be called from any thread.
+class BufferRing : public MemoryPool {
+ public:
+  // @param capacity - the number of free buffers kept for each size
+  // @param pin_memory - page lock the buffers
+  BufferRing(int32_t capacity, bool pin_memory);
+
+  BufferRing(const BufferRing &) = delete;
+
+  BufferRing &operator=(const BufferRing &) = delete;
+
+  ~BufferRing() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override { return 100; }
+
+  // @return The number of allocations that went to the system
+  int64_t NumSystemAllocations() const;
+
+  // @return The number of allocations served by a recycled buffer
+  int64_t NumReusedAllocations() const;
+
+ private:
+  struct Buffer {
+    size_t size;
+    bool pinned;
+  };
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  // @return The size of a pinned buffer of n bytes, rounded up to whole pages
+  static size_t PinnedSize(size_t n);
+#endif
+
+  // Give a buffer back to the system
+  void Release(void *p, const Buffer &buffer);
+
+  int32_t capacity_;
+  bool pin_memory_;
+  bool pin_failed_;
+  mutable std::mutex mux_;
+  std::unordered_map<void *, Buffer> in_use_;
+  std::map<size_t, std::vector<std::pair<void *, Buffer>>> free_;
+  int64_t num_system_allocations_;
+  int64_t num_reused_allocations_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_RING_H_
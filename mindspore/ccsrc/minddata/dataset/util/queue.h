@@ -242,6 +242,7 @@ class QueueList {
   QueueList() {}
 
   void Init(int num_queues, int capacity) {
+    queue_list_.clear();
     (void)queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
       (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
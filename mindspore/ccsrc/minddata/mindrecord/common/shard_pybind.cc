@@ -126,6 +126,11 @@ void BindShardWriter(py::module *m) {
            THROW_IF_ERROR(s.SetShardHeader(header_data));
            return SUCCESS;
          })
+    .def("enable_pipeline",
+         [](ShardWriter &s, uint32_t queue_capacity) {
+           THROW_IF_ERROR(s.EnablePipeline(queue_capacity));
+           return SUCCESS;
+         })
     .def("write_raw_data",
          [](ShardWriter &s, std::map<uint64_t, std::vector<py::handle>> &raw_data, vector<vector<uint8_t>> &blob_data,
             bool sign, bool parallel_writer) {
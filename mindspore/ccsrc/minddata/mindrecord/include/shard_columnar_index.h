@@ -0,0 +1,155 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kColumnarIndexSuffix[] = ".idx";  // suffix of columnar index file, beside the sqlite meta file ".db"
+
+/// \brief offset columns of every row, the same as the columns of table INDEXES in sqlite meta file
+enum class ColumnarOffset {
+  kRowId = 0,
+  kRowGroupId,
+  kPageIdRaw,
+  kPageOffsetRaw,
+  kPageOffsetRawEnd,
+  kPageIdBlob,
+  kPageOffsetBlob,
+  kPageOffsetBlobEnd,
+  kNum,
+};
+constexpr size_t kColumnarOffsetNum = static_cast<size_t>(ColumnarOffset::kNum);
+
+/// \brief compact columnar index of one shard, which can replace the sqlite meta file when reading.
+///
+/// The index file saves the offset columns of all rows sorted by row id, and every index field as a sorted dictionary
+/// of distinct values plus the dictionary code of every row. The file is memory mapped when loading, so opening a
+/// shard only costs parsing the dictionaries.
+class MINDRECORD_API ShardColumnarIndex {
+ public:
+  ShardColumnarIndex() = default;
+
+  /// \brief constructor to build the index of a shard
+  /// \param[in] shard_name file name of the shard
+  /// \param[in] field_names index field names in sqlite meta file, e.g. label_0
+  ShardColumnarIndex(const std::string &shard_name, const std::vector<std::string> &field_names);
+
+  ~ShardColumnarIndex();
+
+  ShardColumnarIndex(const ShardColumnarIndex &) = delete;
+  ShardColumnarIndex &operator=(const ShardColumnarIndex &) = delete;
+
+  /// \brief add one row when building the index
+  /// \param[in] offsets the offset columns of row
+  /// \param[in] values the values of index fields, in the order of field_names
+  void AddRow(const std::array<uint64_t, kColumnarOffsetNum> &offsets, const std::vector<std::string> &values);
+
+  /// \brief save the built index beside the mindrecord file
+  /// \param[in] file_path the path of mindrecord file
+  /// \return Status
+  Status Save(const std::string &file_path);
+
+  /// \brief check whether the columnar index of mindrecord file exists
+  static bool Exist(const std::string &file_path);
+
+  /// \brief load the columnar index of mindrecord file, fail if the index does not match the mindrecord file
+  /// \param[in] file_path the path of mindrecord file
+  /// \param[out] index_ptr the loaded index
+  /// \return Status
+  static Status Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index_ptr);
+
+  uint64_t GetRowCount() const { return row_count_; }
+
+  uint64_t GetOffset(ColumnarOffset column, uint64_t row) const { return offsets_[static_cast<size_t>(column)][row]; }
+
+  /// \brief get the id of index field, -1 if the field is not in index
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief get the value of index field in row
+  const std::string &GetFieldValue(int field_id, uint64_t row) const {
+    return dictionaries_[field_id][codes_[field_id][row]];
+  }
+
+  /// \brief get the sorted distinct values of index field
+  const std::vector<std::string> &GetDistinctValues(int field_id) const { return dictionaries_[field_id]; }
+
+  /// \brief find the row by row id
+  /// \return true if the row is found
+  bool FindRow(uint64_t row_id, uint64_t *row) const;
+
+  /// \brief select the rows in blob page whose index field is equal to value
+  /// \param[in] page_id the blob page id
+  /// \param[in] field_id the index field id, select all rows in page if it is -1
+  /// \param[in] value the value of index field, which is compared by number if is_number is true
+  /// \param[in] is_number whether the index field is number type
+  /// \return the selected rows
+  std::vector<uint64_t> SelectRowsInPage(uint64_t page_id, int field_id = -1, const std::string &value = "",
+                                         bool is_number = false) const;
+
+  /// \brief get the distinct blob pages of the rows whose index field is equal to value
+  std::vector<uint64_t> SelectPages(int field_id, const std::string &value, bool is_number) const;
+
+  /// \brief keep the rows whose index field is equal to value
+  /// \param[in] field_id the index field id
+  /// \param[in] value the value of index field, which is compared by number if is_number is true
+  /// \param[in] is_number whether the index field is number type
+  /// \param[in, out] rows the rows to be filtered, the order is kept
+  void FilterRows(int field_id, const std::string &value, bool is_number, std::vector<uint64_t> *rows) const;
+
+ private:
+  /// \brief get the dictionary codes of value, there may be several codes equal to the number value, e.g. 1 and 1.0
+  std::vector<bool> MatchCodes(int field_id, const std::string &value, bool is_number) const;
+
+  /// \brief parse the index file content
+  Status Parse(const uint8_t *data, uint64_t size);
+
+  std::string shard_name_;
+  std::vector<std::string> field_names_;
+  uint64_t row_count_{0};
+  uint64_t data_file_size_{0};   // size of the mindrecord file when the index is built
+  uint64_t data_file_mtime_{0};  // modification time of the mindrecord file when the index is built
+
+  // the columns are saved in building rows, or point to the file content after loading
+  std::vector<std::array<uint64_t, kColumnarOffsetNum>> building_offsets_;
+  std::vector<std::vector<std::string>> building_values_;
+  std::array<const uint64_t *, kColumnarOffsetNum> offsets_{};
+  std::vector<const uint32_t *> codes_;
+  std::vector<std::vector<std::string>> dictionaries_;
+
+  // rows of every blob page
+  std::unordered_map<uint64_t, std::vector<uint64_t>> page_rows_;
+
+  // the content of index file, which is memory mapped, or read into buffer if mmap is not supported
+  void *mapped_addr_{nullptr};
+  uint64_t mapped_size_{0};
+  std::vector<uint8_t> buffer_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
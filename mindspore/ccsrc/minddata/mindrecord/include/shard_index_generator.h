@@ -25,6 +25,7 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -99,6 +100,10 @@ class MINDRECORD_API ShardIndexGenerator {
 
   Status CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
+  /// \brief add the rows bound to sqlite to the columnar index
+  static Status AddColumnarRows(const ROW_DATA &data, const std::vector<std::string> &field_names,
+                                ShardColumnarIndex *columnar_index);
+
   Status AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,   // NOLINT
                          const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,  // NOLINT
                          std::fstream &in);                                                          // NOLINT
@@ -26,6 +26,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
@@ -46,6 +47,7 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -61,6 +63,13 @@ using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, st
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+const char kEnvReadMode[] = "MS_DEV_MINDRECORD_READ_MODE";  // read mode of mindrecord files, "stream" or "pread"
+
+/// \brief the way to read blob and raw pages from mindrecord files
+enum class ShardReadMode {
+  kStream,      // every consumer seeks and reads by its own file streams
+  kPositional,  // all consumers read by pread on the shared file descriptors concurrently
+};
 
 class MINDRECORD_API ShardReader {
  public:
@@ -95,6 +104,10 @@ class MINDRECORD_API ShardReader {
   /// \return MSRStatus the status of MSRStatus
   Status ExtendRandomFileStreams(const int n_new_consumers);
 
+  /// \brief get the read mode which is decided by environment variable MS_DEV_MINDRECORD_READ_MODE when opening
+  /// \return the read mode
+  ShardReadMode GetReadMode() const { return read_mode_; }
+
   /// \brief decrease number of random file streams for parallel read
   /// \param[in] n_remove_consumers number of file streams to be removed
   /// \return MSRStatus the status of MSRStatus
@@ -189,6 +202,20 @@ class MINDRECORD_API ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set the criteria pushed down from the pipeline, only the rows whose index fields are equal to all the
+  ///     criteria are read. It only takes effect when the tasks are created by row, and is ignored in lazy load mode.
+  /// \param[in] criteria pairs of index field and value
+  void SetRowCriteria(const std::vector<std::pair<std::string, std::string>> &criteria) { row_criteria_ = criteria; }
+
+  /// \brief get the number of bytes read from blob pages by the consumers
+  uint64_t GetBlobReadBytes() const { return blob_read_bytes_; }
+
+  /// \brief get the number of shards whose rows are indexed by the columnar index instead of sqlite
+  int GetColumnarIndexNum() const {
+    return static_cast<int>(std::count_if(columnar_indexes_.begin(), columnar_indexes_.end(),
+                                          [](const auto &index) { return index != nullptr; }));
+  }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
@@ -224,10 +251,28 @@ class MINDRECORD_API ShardReader {
   Status ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                           const uint32_t &sample_id, std::shared_ptr<ROW_GROUPS> *row_group_ptr);
 
-  /// \brief read all rows in one shard
+  /// \brief read all rows in one shard, or only the row of sample_id if it is not -1
   Status ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr, int64_t sample_id = -1);
+
+  /// \brief get labels of rows from columnar index, in the same layout as the sql in ReadAllRowGroup
+  Status GetRowsFromColumnarIndex(int shard_id, const std::vector<uint64_t> &rows,
+                                  const std::vector<std::string> &columns,
+                                  std::vector<std::vector<std::string>> *labels);
+
+  /// \brief get the field id of criteria in columnar index, -1 if the criteria is empty
+  Status GetColumnarFieldId(int shard_id, const std::string &field, int *field_id, bool *is_number);
+
+  /// \brief select rows of page in columnar index by criteria
+  Status SelectColumnarRows(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                            std::vector<uint64_t> *rows);
+
+  /// \brief get the sql condition of row criteria, the invalid criteria are dropped
+  std::string GetRowCriteriaCondition();
+
+  /// \brief keep the rows of columnar index which meet the row criteria
+  Status FilterColumnarRows(int shard_id, std::vector<uint64_t> *rows);
 
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
@@ -281,6 +326,9 @@ class MINDRECORD_API ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief open shared file descriptors for positional read
+  Status OpenFileDescriptors();
+
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
@@ -301,6 +349,12 @@ class MINDRECORD_API ShardReader {
                  std::shared_ptr<std::vector<std::string>> *addresses_ptr);
 
  protected:
+  /// \brief read data of mindrecord file at offset, by the file streams of consumer or the shared file descriptor
+  Status ReadFromFile(int shard_id, int consumer_id, uint64_t offset, uint64_t size, uint8_t *dst);
+
+  /// \brief read data of mindrecord file at offset by the shared file descriptor, thread safe
+  Status PositionalRead(int shard_id, uint64_t offset, uint64_t size, uint8_t *dst) const;
+
   uint64_t header_size_;                       // header size
   uint64_t page_size_;                         // page size
   int shard_count_;                            // number of shards
@@ -308,9 +362,13 @@ class MINDRECORD_API ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardColumnarIndex>> columnar_indexes_;            // columnar index list
+  bool load_columnar_index_ = true;  // use columnar index instead of sqlite if it exists
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<int> file_descriptors_;                                            // shared file descriptor list
+  ShardReadMode read_mode_;                                                      // read mode of blob and raw pages
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -323,6 +381,10 @@ class MINDRECORD_API ShardReader {
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  bool read_blob_ = true;     // if any blob field is selected
+
+  std::vector<std::pair<std::string, std::string>> row_criteria_;  // criteria on index fields pushed down
+  std::atomic<uint64_t> blob_read_bytes_{0};                       // bytes read from blob pages
 
   int64_t num_padded_;  // number of padding samples
 
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -46,6 +48,8 @@
 
 namespace mindspore {
 namespace mindrecord {
+const uint32_t kPipelineQueueCapacity = 4;  // default number of row batches queued between two pipeline stages
+
 class MINDRECORD_API ShardWriter {
  public:
   ShardWriter();
@@ -101,6 +105,13 @@ class MINDRECORD_API ShardWriter {
                       std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign = true,  // NOLINT
                       bool parallel_writer = false);
 
+  /// \brief Enable pipelined writing, must be called before writing any data.
+  ///        WriteRawData only queues the rows, which are validated, compressed and serialized, and written to disk by
+  ///        three stage threads in order. The error of a stage is returned by the following WriteRawData or Commit.
+  /// \param[in] queue_capacity the max number of row batches queued before every stage
+  /// \return Status
+  Status EnablePipeline(uint32_t queue_capacity = kPipelineQueueCapacity);
+
   Status MergeBlobData(const std::vector<string> &blob_fields,
                        const std::map<std::string, std::unique_ptr<std::vector<uint8_t>>> &row_bin_data,
                        std::shared_ptr<std::vector<uint8_t>> *output);
@@ -213,10 +224,10 @@ class MINDRECORD_API ShardWriter {
   /// \brief Unlock writer and save pages info
   Status UnlockWriter(int fd, bool parallel_writer = false);
 
-  /// \brief Check raw data before writing
+  /// \brief Check raw data before writing, add the dummy blobs or ids and compress the blobs if needed
   Status WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &raw_data,  // NOLINT
                               vector<vector<uint8_t>> &blob_data,               // NOLINT
-                              bool sign, int *schema_count, int *row_count);
+                              bool sign, int *schema_count, int *row_count, bool compress_blob = true);
 
   /// \brief Get full path from file name
   Status GetFullPathFromFileName(const std::vector<std::string> &paths);
@@ -230,6 +241,52 @@ class MINDRECORD_API ShardWriter {
   /// \brief Remove lock file
   Status InitLockFile();
 
+  /// \brief rows written by WriteRawData in pipeline mode
+  struct PipelineBatch {
+    std::map<uint64_t, std::vector<json>> raw_data;
+    std::vector<std::vector<uint8_t>> blob_data;
+    std::vector<std::vector<uint8_t>> bin_raw_data;
+    bool sign = true;
+    int schema_count = 0;
+    int row_count = 0;
+  };
+
+  /// \brief bounded blocking queue before a pipeline stage, a null batch marks the end of rows
+  class PipelineQueue {
+   public:
+    explicit PipelineQueue(size_t capacity) : capacity_(capacity) {}
+    ~PipelineQueue() = default;
+
+    void Push(std::unique_ptr<PipelineBatch> batch);
+
+    std::unique_ptr<PipelineBatch> Pop();
+
+   private:
+    size_t capacity_;
+    std::deque<std::unique_ptr<PipelineBatch>> batches_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+  };
+
+  /// \brief pipeline stage: check the free disk, validate the rows and delete the invalid rows
+  Status ValidateBatch(PipelineBatch *batch);
+
+  /// \brief pipeline stage: compress the blobs and serialize the raw data
+  Status SerializeBatch(PipelineBatch *batch);
+
+  /// \brief pipeline stage: write the rows to pages of shards
+  Status WriteBatch(PipelineBatch *batch);
+
+  /// \brief run a pipeline stage until the end of rows, the rows are dropped after any stage fails
+  void RunPipelineStage(PipelineQueue *input, PipelineQueue *output, Status (ShardWriter::*stage)(PipelineBatch *));
+
+  /// \brief send the end of rows and wait for the pipeline stages done
+  Status StopPipeline();
+
+  /// \brief get the first error of pipeline stages
+  Status GetPipelineStatus();
+
  private:
   const std::string kLockFileSuffix = "_Locker";
   const std::string kPageFileSuffix = "_Pages";
@@ -255,6 +312,13 @@ class MINDRECORD_API ShardWriter {
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
   std::atomic<int64_t> compression_size_;
+
+  // pipeline mode, the queues are in the order of validate, serialize and write stage
+  std::vector<std::unique_ptr<PipelineQueue>> pipeline_queues_;
+  std::vector<std::thread> pipeline_threads_;
+  std::mutex pipeline_mutex_;
+  Status pipeline_status_;
+  std::atomic<bool> pipeline_failed_{false};
 };
 }  // namespace mindrecord
 }  // namespace mindspore
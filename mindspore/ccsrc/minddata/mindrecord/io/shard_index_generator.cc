@@ -511,6 +511,16 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  std::vector<std::string> field_names;
+  for (const auto &field : fields_) {
+    std::shared_ptr<std::string> fn_ptr;
+    RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateFieldName(field, &fn_ptr), db, in);
+    field_names.push_back(*fn_ptr);
+  }
+  std::shared_ptr<std::string> shard_name_ptr;
+  RELEASE_AND_RETURN_IF_NOT_OK_MR(GetFileName(shard_address, &shard_name_ptr), db, in);
+  ShardColumnarIndex columnar_index(*shard_name_ptr, field_names);
+
   (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
@@ -519,6 +529,7 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
+    RELEASE_AND_RETURN_IF_NOT_OK_MR(AddColumnarRows(*row_data_ptr, field_names, &columnar_index), db, in);
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
   }
   (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
@@ -527,6 +538,50 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+
+  // the columnar index is written after the sqlite meta file, the reader falls back to sqlite if it is missing
+  RETURN_IF_NOT_OK_MR(columnar_index.Save(realpath.value()));
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::AddColumnarRows(const ROW_DATA &data, const std::vector<std::string> &field_names,
+                                            ShardColumnarIndex *columnar_index) {
+  RETURN_UNEXPECTED_IF_NULL_MR(columnar_index);
+  static const std::map<std::string, ColumnarOffset> offset_placeholders = {
+    {":ROW_ID", ColumnarOffset::kRowId},
+    {":ROW_GROUP_ID", ColumnarOffset::kRowGroupId},
+    {":PAGE_ID_RAW", ColumnarOffset::kPageIdRaw},
+    {":PAGE_OFFSET_RAW", ColumnarOffset::kPageOffsetRaw},
+    {":PAGE_OFFSET_RAW_END", ColumnarOffset::kPageOffsetRawEnd},
+    {":PAGE_ID_BLOB", ColumnarOffset::kPageIdBlob},
+    {":PAGE_OFFSET_BLOB", ColumnarOffset::kPageOffsetBlob},
+    {":PAGE_OFFSET_BLOB_END", ColumnarOffset::kPageOffsetBlobEnd}};
+  std::map<std::string, size_t> field_placeholders;
+  for (size_t i = 0; i < field_names.size(); ++i) {
+    field_placeholders[":" + field_names[i]] = i;
+  }
+  for (const auto &row : data) {
+    std::array<uint64_t, kColumnarOffsetNum> offsets{};
+    std::vector<std::string> values(field_names.size());
+    for (const auto &item : row) {
+      const auto &place_holder = std::get<0>(item);
+      auto offset_iter = offset_placeholders.find(place_holder);
+      if (offset_iter != offset_placeholders.end()) {
+        try {
+          offsets[static_cast<size_t>(offset_iter->second)] = std::stoull(std::get<2>(item));
+        } catch (const std::exception &e) {
+          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to convert " + place_holder + ": " + std::get<2>(item) +
+                                      " to integer.");
+        }
+        continue;
+      }
+      auto field_iter = field_placeholders.find(place_holder);
+      if (field_iter != field_placeholders.end()) {
+        values[field_iter->second] = std::get<2>(item);
+      }
+    }
+    columnar_index->AddRow(offsets, values);
+  }
   return Status::OK();
 }
 
@@ -16,7 +16,9 @@
 
 #include "minddata/mindrecord/include/shard_reader.h"
 
+#include <fcntl.h>
 #include <algorithm>
+#include <numeric>
 #include <thread>
 
 #include "utils/file_utils.h"
@@ -38,6 +40,7 @@ ShardReader::ShardReader()
     : header_size_(0),
       page_size_(0),
       shard_count_(0),
+      read_mode_(ShardReadMode::kStream),
       n_consumer_(0),
       num_padded_(0),
       num_rows_(0),
@@ -82,9 +85,21 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+    std::shared_ptr<ShardColumnarIndex> columnar_index;
+    if (load_columnar_index_ && ShardColumnarIndex::Exist(file)) {
+      auto ret = ShardColumnarIndex::Load(file, &columnar_index);
+      if (ret.IsError()) {
+        MS_LOG(WARNING) << "Failed to load the columnar index of mindrecord file: " << file
+                        << ", fall back to the meta file. " << ret.ToString();
+        columnar_index = nullptr;
+      }
+    }
     sqlite3 *db = nullptr;
-    RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    if (columnar_index == nullptr) {
+      RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    }
     database_paths_.push_back(db);
+    columnar_indexes_.push_back(columnar_index);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK_MR(sh.BuildDataset(file_paths_, load_dataset));
@@ -180,6 +195,18 @@ Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_col
 }
 
 Status ShardReader::Open(int n_consumer) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto read_mode = common::GetEnv(kEnvReadMode);
+  if (read_mode != "stream") {
+    if (!read_mode.empty() && read_mode != "pread") {
+      MS_LOG(WARNING) << "The value of environment variable " << kEnvReadMode
+                      << " should be 'stream' or 'pread', but got: " << read_mode << ". Use 'pread' instead.";
+    }
+    read_mode_ = ShardReadMode::kPositional;
+    return OpenFileDescriptors();
+  }
+#endif
+  read_mode_ = ShardReadMode::kStream;
   file_streams_random_ =
     std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
   for (const auto &file : file_paths_) {
@@ -214,10 +241,72 @@ Status ShardReader::Open(int n_consumer) {
   return Status::OK();
 }
 
+Status ShardReader::OpenFileDescriptors() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (const auto &file : file_paths_) {
+    auto realpath = FileUtils::GetRealPath(file.c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      realpath.has_value(), "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file);
+    int fd = open(realpath.value().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      RETURN_STATUS_UNEXPECTED_MR(
+        "Invalid file, failed to open files for reading mindrecord files. Please check file path, permission and "
+        "open files limit(ulimit -a): " +
+        file + ", errno: " + std::to_string(errno));
+    }
+    file_descriptors_.push_back(fd);
+    MS_LOG(INFO) << "Succeed to open file, path: " << file;
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Positional read of mindrecord files is not supported on Windows.");
+#endif
+}
+
+Status ShardReader::ReadFromFile(int shard_id, int consumer_id, uint64_t offset, uint64_t size, uint8_t *dst) {
+  if (read_mode_ == ShardReadMode::kPositional) {
+    return PositionalRead(shard_id, offset, size, dst);
+  }
+  auto &fs = file_streams_random_[consumer_id][shard_id];
+  auto &io_seekg = fs->seekg(offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(dst), size);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  }
+  return Status::OK();
+}
+
+Status ShardReader::PositionalRead(int shard_id, uint64_t offset, uint64_t size, uint8_t *dst) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id >= 0 && shard_id < static_cast<int>(file_descriptors_.size()),
+                                  "[Internal ERROR] The file of shard " + std::to_string(shard_id) + " is not opened.");
+  // pread does not change the file offset, so the consumers can read the same file concurrently without lock.
+  uint64_t read_size = 0;
+  while (read_size < size) {
+    auto ret =
+      pread(file_descriptors_[shard_id], dst + read_size, size - read_size, static_cast<off_t>(offset + read_size));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret > 0, "[Internal ERROR] Failed to read file, path: " + file_paths_[shard_id] +
+                                               ", errno: " + std::to_string(errno));
+    read_size += static_cast<uint64_t>(ret);
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Positional read of mindrecord files is not supported on Windows.");
+#endif
+}
+
 Status ShardReader::ExtendRandomFileStreams(const int n_new_consumers) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(n_new_consumers > 0,
                                   "n_new_consumers must be a positive number. Got: " + std::to_string(n_new_consumers));
-  CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_streams_random_.empty(),
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_streams_random_.empty() || !file_descriptors_.empty(),
                                   "ExtendRandomFileStreams() must not be called prior to calling Open()");
   // make sure we won't exceed the number of allowed threads.
   uint32_t thread_limit = GetMaxThreadNum();
@@ -227,6 +316,14 @@ Status ShardReader::ExtendRandomFileStreams(const int n_new_consumers) {
                                     std::to_string(n_new_consumers) +
                                     ", new n_consumers: " + std::to_string(n_consumer_ + n_new_consumers));
 
+  // the shared file descriptors serve any number of consumers
+  if (read_mode_ == ShardReadMode::kPositional) {
+    n_consumer_ += n_new_consumers;
+    MS_LOG(INFO) << "n_consumer_ is increased by " + std::to_string(n_new_consumers) + " to " +
+                      std::to_string(n_consumer_);
+    return Status::OK();
+  }
+
   for (int i = 0; i < n_new_consumers; i++) {
     (void)file_streams_random_.emplace_back(std::vector<std::shared_ptr<std::fstream>>());
   }
@@ -269,7 +366,7 @@ Status ShardReader::ExtendRandomFileStreams(const int n_new_consumers) {
 Status ShardReader::ShrinkRandomFileStreams(const int n_remove_consumers) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(
     n_remove_consumers > 0, "n_remove_consumers must be a positive number. Got: " + std::to_string(n_remove_consumers));
-  CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_streams_random_.empty(),
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_streams_random_.empty() || !file_descriptors_.empty(),
                                   "ShrinkRandomFileStreams() must not be called prior to calling Open()");
   // make sure we won't go below the number of allowed threads.
   CHECK_FAIL_RETURN_UNEXPECTED_MR(n_consumer_ - n_remove_consumers >= kMinConsumerCount,
@@ -278,7 +375,7 @@ Status ShardReader::ShrinkRandomFileStreams(const int n_remove_consumers) {
                                     std::to_string(n_remove_consumers) +
                                     ", new n_consumers: " + std::to_string(n_consumer_ - n_remove_consumers));
 
-  for (int i = n_consumer_ - 1; i >= n_consumer_ - n_remove_consumers; i--) {
+  for (int i = n_consumer_ - 1; i >= n_consumer_ - n_remove_consumers && !file_streams_random_.empty(); i--) {
     for (int j = static_cast<int>(file_streams_random_[i].size()) - 1; j >= 0; --j) {
       if (file_streams_random_[i][j] != nullptr) {
         file_streams_random_[i][j]->close();
@@ -306,6 +403,14 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto fd : file_descriptors_) {
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+  }
+#endif
+  file_descriptors_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -403,15 +508,20 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
         uint64_t label_end = std::stoull(labels[i][5]);
         auto len = label_end - label_start;
         auto label_raw = std::vector<uint8_t>(len);
-        auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-        if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-        }
-        auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-        if (!io_read.good() || io_read.fail() || io_read.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+        if (read_mode_ == ShardReadMode::kPositional) {
+          RETURN_IF_NOT_OK_MR(
+            PositionalRead(shard_id, page_size_ * raw_page_id + header_size_ + label_start, len, label_raw.data()));
+        } else {
+          auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+          if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+            fs->close();
+            RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+          }
+          auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+          if (!io_read.good() || io_read.fail() || io_read.bad()) {
+            fs->close();
+            RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+          }
         }
         json label_json = json::from_msgpack(label_raw);
         json tmp;
@@ -467,11 +577,27 @@ Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, cons
 }
 Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                                       int64_t sample_id) {
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+  int rc = SQLITE_OK;
+  if (columnar_indexes_[shard_id] != nullptr) {
+    const auto &columnar_index = columnar_indexes_[shard_id];
+    std::vector<uint64_t> rows;
+    uint64_t row = 0;
+    if (sample_id < 0) {
+      rows.resize(columnar_index->GetRowCount());
+      std::iota(rows.begin(), rows.end(), 0);
+      RETURN_IF_NOT_OK_MR(FilterColumnarRows(shard_id, &rows));
+    } else if (columnar_index->FindRow(static_cast<uint64_t>(sample_id), &row)) {
+      rows.push_back(row);
+    }
+    RETURN_IF_NOT_OK_MR(GetRowsFromColumnarIndex(shard_id, rows, columns, &labels));
+  } else {
+    rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+  }
   if (rc != SQLITE_OK) {
     std::ostringstream oss;
     oss << "[Internal ERROR] Failed to execute the sql [ " << sql << " ] while reading meta file, " << errmsg;
@@ -492,7 +618,7 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, con
   }
 
   std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
-  if (!all_in_index_) {
+  if (!all_in_index_ && read_mode_ == ShardReadMode::kStream) {
     fs->open(realpath.value(), std::ios::in | std::ios::binary);
     if (!fs->good()) {
       sqlite3_free(errmsg);
@@ -507,6 +633,82 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, con
   return ConvertLabelToJson(labels, fs, offset_ptr, shard_id, columns, col_val_ptr);
 }
 
+Status ShardReader::GetRowsFromColumnarIndex(int shard_id, const std::vector<uint64_t> &rows,
+                                             const std::vector<std::string> &columns,
+                                             std::vector<std::vector<std::string>> *labels) {
+  RETURN_UNEXPECTED_IF_NULL_MR(labels);
+  const auto &columnar_index = columnar_indexes_[shard_id];
+  std::vector<int> field_ids;
+  if (all_in_index_) {
+    for (const auto &column : columns) {
+      std::shared_ptr<std::string> fn_ptr;
+      RETURN_IF_NOT_OK_MR(
+        ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[column], column), &fn_ptr));
+      auto field_id = columnar_index->GetFieldId(*fn_ptr);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field_id >= 0, "[Internal ERROR] 'column': " + column +
+                                                       " can not found in columnar index of mindrecord file: " +
+                                                       file_paths_[shard_id]);
+      field_ids.push_back(field_id);
+    }
+  }
+  labels->reserve(labels->size() + rows.size());
+  for (auto row : rows) {
+    std::vector<std::string> label{
+      std::to_string(columnar_index->GetOffset(ColumnarOffset::kRowGroupId, row)),
+      std::to_string(columnar_index->GetOffset(ColumnarOffset::kPageOffsetBlob, row)),
+      std::to_string(columnar_index->GetOffset(ColumnarOffset::kPageOffsetBlobEnd, row))};
+    if (all_in_index_) {
+      for (auto field_id : field_ids) {
+        label.push_back(columnar_index->GetFieldValue(field_id, row));
+      }
+    } else {
+      label.push_back(std::to_string(columnar_index->GetOffset(ColumnarOffset::kPageIdRaw, row)));
+      label.push_back(std::to_string(columnar_index->GetOffset(ColumnarOffset::kPageOffsetRaw, row)));
+      label.push_back(std::to_string(columnar_index->GetOffset(ColumnarOffset::kPageOffsetRawEnd, row)));
+    }
+    labels->push_back(std::move(label));
+  }
+  return Status::OK();
+}
+
+Status ShardReader::FilterColumnarRows(int shard_id, std::vector<uint64_t> *rows) {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  for (const auto &criteria : row_criteria_) {
+    int field_id = -1;
+    bool is_number = false;
+    RETURN_IF_NOT_OK_MR(GetColumnarFieldId(shard_id, criteria.first, &field_id, &is_number));
+    columnar_indexes_[shard_id]->FilterRows(field_id, criteria.second, is_number, rows);
+  }
+  return Status::OK();
+}
+
+Status ShardReader::GetColumnarFieldId(int shard_id, const std::string &field, int *field_id, bool *is_number) {
+  RETURN_UNEXPECTED_IF_NULL_MR(field_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(is_number);
+  *field_id = -1;
+  *is_number = false;
+  if (field.empty()) {
+    return Status::OK();
+  }
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema();
+  *is_number = kNumberFieldTypeSet.find(schema["schema"][field]["type"]) != kNumberFieldTypeSet.end();
+  *field_id = columnar_indexes_[shard_id]->GetFieldId(field + "_" + std::to_string(column_schema_id_[field]));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    *field_id >= 0, "[Internal ERROR] 'field': " + field + " can not found in columnar index of mindrecord file: " +
+                      file_paths_[shard_id]);
+  return Status::OK();
+}
+
+Status ShardReader::SelectColumnarRows(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                       std::vector<uint64_t> *rows) {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  int field_id = -1;
+  bool is_number = false;
+  RETURN_IF_NOT_OK_MR(GetColumnarFieldId(shard_id, criteria.first, &field_id, &is_number));
+  *rows = columnar_indexes_[shard_id]->SelectRowsInPage(page_id, field_id, criteria.second, is_number);
+  return Status::OK();
+}
+
 Status ShardReader::GetAllClasses(const std::string &category_field,
                                   std::shared_ptr<std::set<std::string>> category_ptr) {
   std::map<std::string, uint64_t> index_columns;
@@ -521,14 +723,34 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   RETURN_IF_NOT_OK_MR(
     ShardIndexGenerator::GenerateFieldName(std::make_pair(index_columns[category_field], category_field), &fn_ptr));
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
+  // the distinct values of the shards with columnar index are the dictionary of the index, no need to query in thread.
+  // They are collected before starting the threads and merged after joining them, so category_ptr is only written by
+  // the threads, under shard_locker_, in the meantime.
+  std::set<std::string> columnar_categories;
+  for (int x = 0; x < shard_count_; x++) {
+    if (columnar_indexes_[x] == nullptr) {
+      continue;
+    }
+    auto field_id = columnar_indexes_[x]->GetFieldId(*fn_ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(field_id >= 0, "[Internal ERROR] 'class_column': " + category_field +
+                                                     " can not found in columnar index of mindrecord file: " +
+                                                     file_paths_[x]);
+    const auto &values = columnar_indexes_[x]->GetDistinctValues(field_id);
+    columnar_categories.insert(values.begin(), values.end());
+  }
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    if (columnar_indexes_[x] == nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
+  category_ptr->insert(columnar_categories.begin(), columnar_categories.end());
   return Status::OK();
 }
 
@@ -577,11 +799,12 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
     fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
   }
 
-  std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
+  std::string sql = "SELECT " + fields + " FROM INDEXES" + GetRowCriteriaCondition() + " ORDER BY ROW_ID ;";
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
+    thread_read_db[x] =
+      std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr, -1);
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -591,6 +814,51 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   return Status::OK();
 }
 
+std::string ShardReader::GetRowCriteriaCondition() {
+  if (row_criteria_.empty()) {
+    return "";
+  }
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema();
+  std::map<std::string, uint64_t> index_fields;
+  for (auto &field : shard_header_->GetFields()) {
+    index_fields[field.second] = field.first;
+  }
+  std::vector<std::pair<std::string, std::string>> valid_criteria;
+  std::string condition;
+  for (const auto &criteria : row_criteria_) {
+    if (index_fields.find(criteria.first) == index_fields.end()) {
+      MS_LOG(INFO) << "The criteria field: " << criteria.first << " is not an index field, it is ignored.";
+      continue;
+    }
+    column_schema_id_[criteria.first] = index_fields[criteria.first];
+    std::string value = criteria.second;
+    // not number field should add '' in sql
+    if (kNumberFieldTypeSet.find(schema["schema"][criteria.first]["type"]) != kNumberFieldTypeSet.end()) {
+      size_t pos = 0;
+      try {
+        (void)std::stold(value, &pos);
+      } catch (const std::exception &) {
+        pos = 0;
+      }
+      if (pos == 0 || pos != value.size()) {
+        MS_LOG(WARNING) << "The criteria value: " << value << " of number field: " << criteria.first
+                        << " is not a number, it is ignored.";
+        continue;
+      }
+    } else {
+      for (size_t pos = value.find('\''); pos != std::string::npos; pos = value.find('\'', pos + 2)) {
+        (void)value.insert(pos, 1, '\'');
+      }
+      value = "'" + value + "'";
+    }
+    condition += (condition.empty() ? " WHERE " : " AND ") + criteria.first + "_" +
+                 std::to_string(index_fields[criteria.first]) + " = " + value;
+    valid_criteria.push_back(criteria);
+  }
+  row_criteria_ = valid_criteria;
+  return condition;
+}
+
 Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                                      const uint32_t &sample_id,
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
@@ -613,7 +881,7 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
 
   std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
 
-  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr));
+  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr, sample_id));
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -672,6 +940,21 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (columnar_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    auto ret = SelectColumnarRows(page_id, shard_id, criteria, &rows);
+    if (ret.IsError()) {
+      MS_LOG(ERROR) << ret.ToString();
+      return std::vector<std::vector<uint64_t>>();
+    }
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row : rows) {
+      res.emplace_back(
+        std::vector<uint64_t>{columnar_indexes_[shard_id]->GetOffset(ColumnarOffset::kPageOffsetBlob, row) + kInt64Len,
+                              columnar_indexes_[shard_id]->GetOffset(ColumnarOffset::kPageOffsetBlobEnd, row)});
+    }
+    return res;
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -720,6 +1003,14 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(pages_ptr);
+  if (columnar_indexes_[shard_id] != nullptr) {
+    int field_id = -1;
+    bool is_number = false;
+    RETURN_IF_NOT_OK_MR(GetColumnarFieldId(shard_id, criteria.first, &field_id, &is_number));
+    auto pages = columnar_indexes_[shard_id]->SelectPages(field_id, criteria.second, is_number);
+    (*pages_ptr)->insert((*pages_ptr)->end(), pages.begin(), pages.end());
+    return Status::OK();
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -819,11 +1110,13 @@ Status ShardReader::GetLabelsFromBinaryFile(int shard_id, const std::vector<std:
     "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file_name);
 
   std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
-  fs->open(realpath.value(), std::ios::in | std::ios::binary);
-  CHECK_FAIL_RETURN_UNEXPECTED_MR(fs->good(),
-                                  "Invalid file, failed to open files for reading mindrecord files. Please check file "
-                                  "path, permission and open files limit(ulimit -a): " +
-                                    file_name);
+  if (read_mode_ == ShardReadMode::kStream) {
+    fs->open(realpath.value(), std::ios::in | std::ios::binary);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(fs->good(),
+                                    "Invalid file, failed to open files for reading mindrecord files. Please check "
+                                    "file path, permission and open files limit(ulimit -a): " +
+                                      file_name);
+  }
   // init the return
   for (unsigned int i = 0; i < label_offsets.size(); ++i) {
     (*labels_ptr)->emplace_back(json{});
@@ -841,16 +1134,21 @@ Status ShardReader::GetLabelsFromBinaryFile(int shard_id, const std::vector<std:
     int raw_page_id = std::stoi(labelOffset[0]);
     auto len = label_end - label_start;
     auto label_raw = std::vector<uint8_t>(len);
-    auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-      fs->close();
-      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file, path: " + file_name);
-    }
+    if (read_mode_ == ShardReadMode::kPositional) {
+      RETURN_IF_NOT_OK_MR(
+        PositionalRead(shard_id, page_size_ * raw_page_id + header_size_ + label_start, len, label_raw.data()));
+    } else {
+      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+        fs->close();
+        RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file, path: " + file_name);
+      }
 
-    auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-    if (!io_read.good() || io_read.fail() || io_read.bad()) {
-      fs->close();
-      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file, path: " + file_name);
+      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+      if (!io_read.good() || io_read.fail() || io_read.bad()) {
+        fs->close();
+        RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file, path: " + file_name);
+      }
     }
 
     json label_json = json::from_msgpack(label_raw);
@@ -873,7 +1171,16 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
   auto label_offset_ptr = std::make_shared<std::vector<std::vector<std::string>>>();
-  if (!criteria.first.empty()) {
+  if (columnar_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    RETURN_IF_NOT_OK_MR(SelectColumnarRows(page_id, shard_id, criteria, &rows));
+    for (auto row : rows) {
+      label_offset_ptr->emplace_back(std::vector<std::string>{
+        std::to_string(columnar_indexes_[shard_id]->GetOffset(ColumnarOffset::kPageIdRaw, row)),
+        std::to_string(columnar_indexes_[shard_id]->GetOffset(ColumnarOffset::kPageOffsetRaw, row)),
+        std::to_string(columnar_indexes_[shard_id]->GetOffset(ColumnarOffset::kPageOffsetRawEnd, row))});
+    }
+  } else if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
     RETURN_IF_NOT_OK_MR(QueryWithCriteria(db, sql, criteria.second, label_offset_ptr));
   } else {
@@ -915,7 +1222,22 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
     }
     auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
-    if (!criteria.first.empty()) {
+    if (columnar_indexes_[shard_id] != nullptr) {
+      std::vector<uint64_t> rows;
+      RETURN_IF_NOT_OK_MR(SelectColumnarRows(page_id, shard_id, criteria, &rows));
+      std::vector<int> field_ids(columns.size(), -1);
+      for (unsigned int i = 0; i < columns.size(); ++i) {
+        bool is_number = false;
+        RETURN_IF_NOT_OK_MR(GetColumnarFieldId(shard_id, columns[i], &field_ids[i], &is_number));
+      }
+      for (auto row : rows) {
+        std::vector<std::string> label;
+        for (auto field_id : field_ids) {
+          label.push_back(columnar_indexes_[shard_id]->GetFieldValue(field_id, row));
+        }
+        labels->push_back(std::move(label));
+      }
+    } else if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
       RETURN_IF_NOT_OK_MR(QueryWithCriteria(db, sql, criteria.second, labels));
     } else {
@@ -990,6 +1312,17 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    if (x < static_cast<int>(columnar_indexes_.size()) && columnar_indexes_[x] != nullptr) {
+      auto field_id = columnar_indexes_[x]->GetFieldId(*fn_ptr);
+      if (field_id < 0) {
+        MS_LOG(ERROR) << "[Internal ERROR] 'category_field' " << category_field
+                      << " can not found in columnar index of mindrecord file: " << file_paths_[x];
+        return -1;
+      }
+      const auto &values = columnar_indexes_[x]->GetDistinctValues(field_id);
+      category_ptr->insert(values.begin(), values.end());
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1007,7 +1340,9 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   }
 
   for (int x = 0; x < shard_count; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   sqlite3_close(db);
   return category_ptr->size();
@@ -1092,6 +1427,12 @@ Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_d
 
   selected_columns_ = selected_columns;
   RETURN_IF_NOT_OK_MR(CheckColumnList(selected_columns_));
+  // the blob pages are not read at all if no blob field is selected
+  auto blob_fields = GetBlobFields().second;
+  read_blob_ = selected_columns_.empty() ||
+               std::any_of(selected_columns_.begin(), selected_columns_.end(), [&blob_fields](const std::string &col) {
+                 return std::find(blob_fields.begin(), blob_fields.end(), col) != blob_fields.end();
+               });
 
   // Initialize argument
   shard_count_ = static_cast<int>(file_paths_.size());
@@ -1214,6 +1555,15 @@ Status ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, int,
   for (int shard_id = 0; shard_id < shard_count_; shard_id++) {
     sample_count += offsets[shard_id].size();
   }
+  if (!row_criteria_.empty()) {
+    // the samplers split the rows by the sample count of every shard, which is changed by the row criteria
+    shard_sample_count_.clear();
+    int64_t total_count = 0;
+    for (int shard_id = 0; shard_id < shard_count_; shard_id++) {
+      total_count += static_cast<int64_t>(offsets[shard_id].size());
+      shard_sample_count_.push_back(total_count);
+    }
+  }
   MS_LOG(DEBUG) << "Succeed to get " << sample_count << " records from dataset.";
 
   // Init the tasks_ size
@@ -1290,6 +1640,11 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
     }
   }
 
+  if (!row_criteria_.empty() && (lazy_load_ || category_operator != -1)) {
+    MS_LOG(WARNING) << "The row criteria can not be applied in lazy load mode or with category operator, "
+                    << "all the rows will be read.";
+    row_criteria_.clear();
+  }
   if (-1 == category_operator) {
     if (lazy_load_ == false) {
       RETURN_IF_NOT_OK_MR(CreateTasksByRow(row_group_summary, operators));
@@ -1383,19 +1738,12 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
   // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-  }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  std::vector<uint8_t> images;
+  if (read_blob_) {
+    images.resize(blob_end - blob_start);
+    auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+    RETURN_IF_NOT_OK_MR(ReadFromFile(shard_id, consumer_id, file_offset, blob_end - blob_start, images.data()));
+    blob_read_bytes_ += blob_end - blob_start;
   }
 
   // Deliver batch data to output map
@@ -23,7 +23,11 @@
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { SetAllInIndex(false); }
+ShardSegment::ShardSegment() {
+  SetAllInIndex(false);
+  // the segment queries the sqlite meta file directly
+  load_columnar_index_ = false;
+}
 
 Status ShardSegment::GetCategoryFields(std::shared_ptr<vector<std::string>> *fields_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(fields_ptr);
@@ -203,19 +207,7 @@ Status ShardSegment::PackImages(int group_id, int shard_id, std::vector<uint64_t
   (*images_ptr)->resize(offset[1] - offset[0]);
 
   auto file_offset = header_size_ + page_size_ * page_ptr->GetPageID() + offset[0];
-  auto &io_seekg = file_streams_random_[0][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[0][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("Failed to seekg file.");
-  }
-
-  auto &io_read =
-    file_streams_random_[0][shard_id]->read(reinterpret_cast<char *>(&((*(*images_ptr))[0])), offset[1] - offset[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[0][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("Failed to read file.");
-  }
-  return Status::OK();
+  return ReadFromFile(shard_id, 0, file_offset, offset[1] - offset[0], (*images_ptr)->data());
 }
 
 Status ShardSegment::ReadAtPageByName(std::string category_name, int64_t page_no, int64_t n_rows_of_page,
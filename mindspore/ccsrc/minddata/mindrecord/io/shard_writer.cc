@@ -18,6 +18,7 @@
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "./securec.h"
 
 namespace mindspore {
@@ -28,6 +29,7 @@ ShardWriter::ShardWriter()
 }
 
 ShardWriter::~ShardWriter() {
+  (void)StopPipeline();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -103,6 +105,14 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // the columnar index is optional, it is rebuilt together with the sqlite meta file
+          auto idx_file = whole_path.value() + kColumnarIndexSuffix;
+          (void)std::remove(idx_file.c_str());
+          CHECK_FAIL_RETURN_UNEXPECTED_MR(!std::ifstream(idx_file) == true,
+                                          "Invalid file, failed to remove the old mindrecord columnar index files when "
+                                          "trying to overwrite mindrecord files. Please check file path and "
+                                          "permission: " +
+                                            file + kColumnarIndexSuffix);
         } else {
           RETURN_STATUS_UNEXPECTED_MR(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
@@ -193,6 +203,7 @@ Status ShardWriter::OpenForAppend(const std::string &path) {
 }
 
 Status ShardWriter::Commit() {
+  RETURN_IF_NOT_OK_MR(StopPipeline());
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
@@ -418,19 +429,19 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
                                     std::shared_ptr<std::pair<int, int>> *count_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(count_ptr);
   auto rawdata_iter = raw_data.begin();
-  schema_count_ = raw_data.size();
-  CHECK_FAIL_RETURN_UNEXPECTED_MR(schema_count_ > 0, "Invalid data, the number of schema should be positive but got: " +
-                                                       std::to_string(schema_count_) +
-                                                       ". Please check the input schema.");
+  uint32_t schema_count = raw_data.size();
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(schema_count > 0, "Invalid data, the number of schema should be positive but got: " +
+                                                      std::to_string(schema_count) +
+                                                      ". Please check the input schema.");
 
   // keep schema_id
   std::set<int64_t> schema_ids;
-  row_count_ = (rawdata_iter->second).size();
+  uint32_t row_count = (rawdata_iter->second).size();
 
   // Determine if the number of schemas is the same
-  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_header_->GetSchemas().size() == schema_count_,
-                                  "[Internal ERROR] 'schema_count_' and the schema count in schema: " +
-                                    std::to_string(schema_count_) + " do not match.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_header_->GetSchemas().size() == schema_count,
+                                  "[Internal ERROR] 'schema_count' and the schema count in schema: " +
+                                    std::to_string(schema_count) + " do not match.");
   // Determine raw_data size == blob_data size
   CHECK_FAIL_RETURN_UNEXPECTED_MR(raw_data[0].size() == blob_data.size(),
                                   "[Internal ERROR] raw data size: " + std::to_string(raw_data[0].size()) +
@@ -438,8 +449,8 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
 
   // Determine whether the number of samples corresponding to each schema is the same
   for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
-    CHECK_FAIL_RETURN_UNEXPECTED_MR(row_count_ == rawdata_iter->second.size(),
-                                    "[Internal ERROR] 'row_count_': " + std::to_string(rawdata_iter->second.size()) +
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(row_count == rawdata_iter->second.size(),
+                                    "[Internal ERROR] 'row_count': " + std::to_string(rawdata_iter->second.size()) +
                                       " for each schema is not the same.");
     (void)schema_ids.insert(rawdata_iter->first);
   }
@@ -451,19 +462,20 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
                                                }),
                                   "[Internal ERROR] schema id in 'schemas' can not found in 'schema_ids'.");
   if (!sign) {
-    *count_ptr = std::make_shared<std::pair<int, int>>(schema_count_, row_count_);
+    *count_ptr = std::make_shared<std::pair<int, int>>(schema_count, row_count);
     return Status::OK();
   }
 
-  // check the data according the schema
+  // check the data according the schema, the errors of previous rows are discarded
+  err_mg_.clear();
   RETURN_IF_NOT_OK_MR(CheckData(raw_data));
 
   // delete wrong data from raw data
   DeleteErrorData(raw_data, blob_data);
 
   // update raw count
-  row_count_ = row_count_ - err_mg_.begin()->second.size();
-  *count_ptr = std::make_shared<std::pair<int, int>>(schema_count_, row_count_);
+  row_count = row_count - err_mg_.begin()->second.size();
+  *count_ptr = std::make_shared<std::pair<int, int>>(schema_count, row_count);
   return Status::OK();
 }
 
@@ -554,7 +566,7 @@ Status ShardWriter::UnlockWriter(int fd, bool parallel_writer) {
 
 Status ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &raw_data,
                                          std::vector<std::vector<uint8_t>> &blob_data, bool sign, int *schema_count,
-                                         int *row_count) {
+                                         int *row_count, bool compress_blob) {
   // check the free disk size
   std::shared_ptr<uint64_t> size_ptr;
   RETURN_IF_NOT_OK_MR(GetDiskSize(file_paths_[0], kFreeSize, &size_ptr));
@@ -562,7 +574,7 @@ Status ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &
     *size_ptr >= kMinFreeDiskSize,
     "No free disk to be used while writing mindrecord files, available free disk size: " + std::to_string(*size_ptr));
   // compress blob
-  if (shard_column_->CheckCompressBlob()) {
+  if (compress_blob && shard_column_->CheckCompressBlob()) {
     for (auto &blob : blob_data) {
       int64_t compression_bytes = 0;
       blob = shard_column_->CompressBlob(blob, &compression_bytes);
@@ -624,6 +636,19 @@ Status ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
 
 Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                  std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  if (!pipeline_queues_.empty()) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(!parallel_writer,
+                                    "Invalid parameter, parallel writer is not supported in pipeline mode.");
+    RETURN_IF_NOT_OK_MR(GetPipelineStatus());
+    // the rows are moved to the pipeline, the caller can prepare the next rows while they are being written
+    auto batch = std::make_unique<PipelineBatch>();
+    batch->raw_data = std::move(raw_data);
+    batch->blob_data = std::move(blob_data);
+    batch->sign = sign;
+    pipeline_queues_[0]->Push(std::move(batch));
+    return Status::OK();
+  }
+
   // Lock Writer if loading data parallel
   std::unique_ptr<int> fd_ptr;
   RETURN_IF_NOT_OK_MR(LockWriter(parallel_writer, &fd_ptr));
@@ -638,6 +663,8 @@ Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data
   if (row_count == kInt0) {
     return Status::OK();
   }
+  schema_count_ = schema_count;
+  row_count_ = row_count;
   std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
   // Serialize raw data
   RETURN_IF_NOT_OK_MR(SerializeRawData(raw_data, bin_raw_data, row_count));
@@ -690,6 +717,130 @@ Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &ra
   return WriteRawData(raw_data_json, bin_blob_data, sign, parallel_writer);
 }
 
+Status ShardWriter::EnablePipeline(uint32_t queue_capacity) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(queue_capacity > 0, "Invalid parameter, 'queue_capacity' should be positive.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(pipeline_queues_.empty(), "[Internal ERROR] the pipeline has been enabled.");
+  const std::vector<Status (ShardWriter::*)(PipelineBatch *)> stages = {
+    &ShardWriter::ValidateBatch, &ShardWriter::SerializeBatch, &ShardWriter::WriteBatch};
+  for (size_t i = 0; i < stages.size(); ++i) {
+    pipeline_queues_.push_back(std::make_unique<PipelineQueue>(queue_capacity));
+  }
+  for (size_t i = 0; i < stages.size(); ++i) {
+    auto output = i + 1 < stages.size() ? pipeline_queues_[i + 1].get() : nullptr;
+    pipeline_threads_.emplace_back(&ShardWriter::RunPipelineStage, this, pipeline_queues_[i].get(), output, stages[i]);
+  }
+  MS_LOG(INFO) << "Enable pipelined writing, queue capacity: " << queue_capacity;
+  return Status::OK();
+}
+
+void ShardWriter::PipelineQueue::Push(std::unique_ptr<PipelineBatch> batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock, [this] { return batches_.size() < capacity_; });
+  batches_.push_back(std::move(batch));
+  not_empty_.notify_one();
+}
+
+std::unique_ptr<ShardWriter::PipelineBatch> ShardWriter::PipelineQueue::Pop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_empty_.wait(lock, [this] { return !batches_.empty(); });
+  auto batch = std::move(batches_.front());
+  batches_.pop_front();
+  not_full_.notify_one();
+  return batch;
+}
+
+Status ShardWriter::ValidateBatch(PipelineBatch *batch) {
+  RETURN_UNEXPECTED_IF_NULL_MR(batch);
+  // the blobs are compressed by the serializing stage
+  RETURN_IF_NOT_OK_MR(WriteRawDataPreCheck(batch->raw_data, batch->blob_data, batch->sign, &batch->schema_count,
+                                           &batch->row_count, false));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(batch->row_count >= kInt0,
+                                  "[Internal ERROR] the size of raw data should be positive.");
+  return Status::OK();
+}
+
+Status ShardWriter::SerializeBatch(PipelineBatch *batch) {
+  RETURN_UNEXPECTED_IF_NULL_MR(batch);
+  if (batch->row_count == kInt0) {
+    return Status::OK();
+  }
+  if (shard_column_->CheckCompressBlob()) {
+    for (auto &blob : batch->blob_data) {
+      int64_t compression_bytes = 0;
+      blob = shard_column_->CompressBlob(blob, &compression_bytes);
+      compression_size_ += compression_bytes;
+    }
+  }
+  batch->bin_raw_data = std::vector<std::vector<uint8_t>>(batch->row_count * batch->schema_count);
+  RETURN_IF_NOT_OK_MR(SerializeRawData(batch->raw_data, batch->bin_raw_data, batch->row_count));
+  // the json rows are not used any more
+  batch->raw_data.clear();
+  return Status::OK();
+}
+
+Status ShardWriter::WriteBatch(PipelineBatch *batch) {
+  RETURN_UNEXPECTED_IF_NULL_MR(batch);
+  if (batch->row_count == kInt0) {
+    return Status::OK();
+  }
+  schema_count_ = batch->schema_count;
+  row_count_ = batch->row_count;
+  RETURN_IF_NOT_OK_MR(SetRawDataSize(batch->bin_raw_data));
+  RETURN_IF_NOT_OK_MR(SetBlobDataSize(batch->blob_data));
+  RETURN_IF_NOT_OK_MR(ParallelWriteData(batch->blob_data, batch->bin_raw_data));
+  MS_LOG(INFO) << "Succeed to write " << batch->bin_raw_data.size() << " records.";
+  return Status::OK();
+}
+
+void ShardWriter::RunPipelineStage(PipelineQueue *input, PipelineQueue *output,
+                                   Status (ShardWriter::*stage)(PipelineBatch *)) {
+  while (true) {
+    auto batch = input->Pop();
+    if (batch == nullptr) {
+      break;
+    }
+    // keep consuming after failure so that the previous stages are never blocked
+    if (pipeline_failed_) {
+      continue;
+    }
+    auto status = (this->*stage)(batch.get());
+    if (status.IsError()) {
+      std::lock_guard<std::mutex> lock(pipeline_mutex_);
+      if (!pipeline_failed_) {
+        pipeline_status_ = status;
+        pipeline_failed_ = true;
+      }
+      continue;
+    }
+    if (output != nullptr) {
+      output->Push(std::move(batch));
+    }
+  }
+  if (output != nullptr) {
+    output->Push(nullptr);
+  }
+}
+
+Status ShardWriter::StopPipeline() {
+  if (pipeline_queues_.empty()) {
+    return Status::OK();
+  }
+  pipeline_queues_[0]->Push(nullptr);
+  for (auto &thread : pipeline_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  pipeline_threads_.clear();
+  pipeline_queues_.clear();
+  return GetPipelineStatus();
+}
+
+Status ShardWriter::GetPipelineStatus() {
+  std::lock_guard<std::mutex> lock(pipeline_mutex_);
+  return pipeline_status_;
+}
+
 Status ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
                                       const std::vector<std::vector<uint8_t>> &bin_raw_data) {
   auto shards = BreakIntoShards();
@@ -989,8 +1140,8 @@ Status ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
     }
 
     // Write the data of blob
-    auto line = blob_data[j];
-    auto &io_handle_data = out->write(reinterpret_cast<char *>(&line[0]), line_len);
+    const auto &line = blob_data[j];
+    auto &io_handle_data = out->write(reinterpret_cast<const char *>(line.data()), line_len);
     if (!io_handle_data.good() || io_handle_data.fail() || io_handle_data.bad()) {
       out->close();
       RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to write file.");
@@ -1014,8 +1165,8 @@ Status ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
     }
     // Write the data of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
-      auto line = bin_raw_data[i * schema_count_ + j];
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line[0]), line.size());
+      const auto &line = bin_raw_data[i * schema_count_ + j];
+      auto &io_handle = out->write(reinterpret_cast<const char *>(line.data()), line.size());
       if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
         out->close();
         RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to write file.");
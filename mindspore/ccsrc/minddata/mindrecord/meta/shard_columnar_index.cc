@@ -0,0 +1,403 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <unordered_set>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// The layout of index file, every section is aligned to 8 bytes:
+// 1. header: magic, version, mindrecord file size and modification time, row count, field count and shard name.
+// 2. fields: name, dictionary size and the sorted distinct values of every index field.
+// 3. offset columns: kColumnarOffsetNum arrays of uint64, every array has row count elements sorted by row id.
+// 4. code columns: an array of uint32 for every index field, which is the dictionary code of every row.
+constexpr uint64_t kColumnarIndexMagic = 0x5844494344524D4DULL;  // "MMRDCIDX"
+constexpr uint64_t kColumnarIndexVersion = 2;
+constexpr uint64_t kColumnarIndexAlignment = 8;
+
+uint64_t AlignUp(uint64_t size) {
+  return (size + kColumnarIndexAlignment - 1) / kColumnarIndexAlignment * kColumnarIndexAlignment;
+}
+
+void AppendBytes(const void *data, uint64_t size, std::vector<uint8_t> *content) {
+  auto bytes = reinterpret_cast<const uint8_t *>(data);
+  content->insert(content->end(), bytes, bytes + size);
+  content->resize(AlignUp(content->size()), 0);
+}
+
+void AppendUint64(uint64_t value, std::vector<uint8_t> *content) { AppendBytes(&value, sizeof(value), content); }
+
+void AppendString(const std::string &value, std::vector<uint8_t> *content) {
+  AppendUint64(value.size(), content);
+  AppendBytes(value.data(), value.size(), content);
+}
+
+// Read the sections of index file in order, every read checks the bound of content.
+class ContentReader {
+ public:
+  ContentReader(const uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+  ~ContentReader() = default;
+
+  bool ReadBytes(uint64_t size, const uint8_t **bytes) {
+    if (size > size_ - pos_ || AlignUp(size) > size_ - pos_) {
+      return false;
+    }
+    *bytes = data_ + pos_;
+    pos_ += AlignUp(size);
+    return true;
+  }
+
+  bool ReadUint64(uint64_t *value) {
+    const uint8_t *bytes = nullptr;
+    if (!ReadBytes(sizeof(uint64_t), &bytes)) {
+      return false;
+    }
+    *value = *reinterpret_cast<const uint64_t *>(bytes);
+    return true;
+  }
+
+  bool ReadString(std::string *value) {
+    uint64_t length = 0;
+    const uint8_t *bytes = nullptr;
+    if (!ReadUint64(&length) || !ReadBytes(length, &bytes)) {
+      return false;
+    }
+    value->assign(reinterpret_cast<const char *>(bytes), length);
+    return true;
+  }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t pos_{0};
+};
+
+bool GetFileSize(const std::string &file_path, uint64_t *size, uint64_t *mtime = nullptr) {
+  struct stat file_stat;
+  if (stat(file_path.c_str(), &file_stat) != 0) {
+    return false;
+  }
+  *size = static_cast<uint64_t>(file_stat.st_size);
+  if (mtime != nullptr) {
+    // the modification time in nanoseconds, or in seconds if the platform has no finer one
+#if defined(__linux__)
+    const uint64_t kNanosecondsPerSecond = 1000000000;
+    *mtime = static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * kNanosecondsPerSecond +
+             static_cast<uint64_t>(file_stat.st_mtim.tv_nsec);
+#else
+    *mtime = static_cast<uint64_t>(file_stat.st_mtime);
+#endif
+  }
+  return true;
+}
+}  // namespace
+
+ShardColumnarIndex::ShardColumnarIndex(const std::string &shard_name, const std::vector<std::string> &field_names)
+    : shard_name_(shard_name), field_names_(field_names), building_values_(field_names.size()) {}
+
+ShardColumnarIndex::~ShardColumnarIndex() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_addr_ != nullptr) {
+    (void)munmap(mapped_addr_, mapped_size_);
+    mapped_addr_ = nullptr;
+  }
+#endif
+}
+
+void ShardColumnarIndex::AddRow(const std::array<uint64_t, kColumnarOffsetNum> &offsets,
+                                const std::vector<std::string> &values) {
+  building_offsets_.push_back(offsets);
+  for (size_t i = 0; i < building_values_.size(); ++i) {
+    building_values_[i].push_back(i < values.size() ? values[i] : "");
+  }
+  ++row_count_;
+}
+
+Status ShardColumnarIndex::Save(const std::string &file_path) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(GetFileSize(file_path, &data_file_size_, &data_file_mtime_),
+                                  "Invalid file, failed to get the size of mindrecord file: " + file_path);
+  // sort the rows by row id
+  std::vector<uint64_t> order(row_count_);
+  std::iota(order.begin(), order.end(), 0);
+  auto row_id_column = static_cast<size_t>(ColumnarOffset::kRowId);
+  std::stable_sort(order.begin(), order.end(), [this, row_id_column](uint64_t a, uint64_t b) {
+    return building_offsets_[a][row_id_column] < building_offsets_[b][row_id_column];
+  });
+
+  std::vector<uint8_t> content;
+  AppendUint64(kColumnarIndexMagic, &content);
+  AppendUint64(kColumnarIndexVersion, &content);
+  AppendUint64(data_file_size_, &content);
+  AppendUint64(data_file_mtime_, &content);
+  AppendUint64(row_count_, &content);
+  AppendUint64(field_names_.size(), &content);
+  AppendString(shard_name_, &content);
+
+  std::vector<std::vector<uint32_t>> codes(field_names_.size(), std::vector<uint32_t>(row_count_));
+  for (size_t i = 0; i < field_names_.size(); ++i) {
+    std::vector<std::string> dictionary(building_values_[i]);
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+    AppendString(field_names_[i], &content);
+    AppendUint64(dictionary.size(), &content);
+    for (const auto &value : dictionary) {
+      AppendString(value, &content);
+    }
+    for (uint64_t row = 0; row < row_count_; ++row) {
+      const auto &value = building_values_[i][order[row]];
+      codes[i][row] =
+        static_cast<uint32_t>(std::lower_bound(dictionary.begin(), dictionary.end(), value) - dictionary.begin());
+    }
+  }
+  for (size_t column = 0; column < kColumnarOffsetNum; ++column) {
+    std::vector<uint64_t> offsets(row_count_);
+    for (uint64_t row = 0; row < row_count_; ++row) {
+      offsets[row] = building_offsets_[order[row]][column];
+    }
+    AppendBytes(offsets.data(), offsets.size() * sizeof(uint64_t), &content);
+  }
+  for (const auto &field_codes : codes) {
+    AppendBytes(field_codes.data(), field_codes.size() * sizeof(uint32_t), &content);
+  }
+
+  auto index_path = file_path + kColumnarIndexSuffix;
+  std::ofstream fs(index_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fs.good(), "Invalid file, failed to open mindrecord columnar index file: " +
+                                               index_path + ". Please check file path and permission.");
+  (void)fs.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fs.good(), "[Internal ERROR] Failed to write mindrecord columnar index file: " +
+                                               index_path);
+  fs.close();
+  MS_LOG(INFO) << "Succeed to write columnar index of " << row_count_ << " rows, path: " << index_path;
+  return Status::OK();
+}
+
+bool ShardColumnarIndex::Exist(const std::string &file_path) {
+  uint64_t size = 0;
+  return GetFileSize(file_path + kColumnarIndexSuffix, &size);
+}
+
+Status ShardColumnarIndex::Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(index_ptr);
+  auto index = std::make_shared<ShardColumnarIndex>();
+  auto index_path = file_path + kColumnarIndexSuffix;
+  uint64_t index_size = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(GetFileSize(index_path, &index_size),
+                                  "Invalid file, failed to get the size of mindrecord columnar index file: " +
+                                    index_path);
+  const uint8_t *data = nullptr;
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(index_path.c_str(), O_RDONLY | O_CLOEXEC);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open mindrecord columnar index file: " +
+                                             index_path + ", errno: " + std::to_string(errno));
+  if (index_size > 0) {
+    void *addr = mmap(nullptr, index_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED,
+                                    "[Internal ERROR] Failed to map mindrecord columnar index file: " + index_path +
+                                      ", errno: " + std::to_string(errno));
+    index->mapped_addr_ = addr;
+    index->mapped_size_ = index_size;
+    data = reinterpret_cast<const uint8_t *>(addr);
+  } else {
+    (void)close(fd);
+  }
+#else
+  std::ifstream fs(index_path, std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fs.good(),
+                                  "Invalid file, failed to open mindrecord columnar index file: " + index_path);
+  index->buffer_.resize(index_size);
+  (void)fs.read(reinterpret_cast<char *>(index->buffer_.data()), static_cast<std::streamsize>(index_size));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fs.good(), "[Internal ERROR] Failed to read mindrecord columnar index file: " +
+                                               index_path);
+  data = index->buffer_.data();
+#endif
+  RETURN_IF_NOT_OK_MR(index->Parse(data, index_size));
+
+  // the index is stale if the mindrecord file is renamed or rewritten
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(file_path, &fn_ptr));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(index->shard_name_ == *fn_ptr,
+                                  "Invalid file, mindrecord columnar index file: " + index_path +
+                                    " and mindrecord file: " + file_path + " can not match.");
+  // a rewritten mindrecord file of the same size is caught by the modification time
+  uint64_t data_file_size = 0;
+  uint64_t data_file_mtime = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(GetFileSize(file_path, &data_file_size, &data_file_mtime) &&
+                                    data_file_size == index->data_file_size_ &&
+                                    data_file_mtime == index->data_file_mtime_,
+                                  "Invalid file, mindrecord columnar index file: " + index_path +
+                                    " is out of date, the mindrecord file has been modified.");
+  *index_ptr = index;
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::Parse(const uint8_t *data, uint64_t size) {
+  ContentReader reader(data, size);
+  uint64_t magic = 0;
+  uint64_t version = 0;
+  uint64_t field_count = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadUint64(&magic) && magic == kColumnarIndexMagic,
+                                  "Invalid file, the magic number of mindrecord columnar index file is wrong.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadUint64(&version) && version == kColumnarIndexVersion,
+                                  "Invalid file, the version of mindrecord columnar index file is not supported.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadUint64(&data_file_size_) && reader.ReadUint64(&data_file_mtime_) &&
+                                    reader.ReadUint64(&row_count_) && reader.ReadUint64(&field_count) &&
+                                    reader.ReadString(&shard_name_),
+                                  "Invalid file, the header of mindrecord columnar index file is broken.");
+  for (uint64_t i = 0; i < field_count; ++i) {
+    std::string field_name;
+    uint64_t dictionary_size = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadString(&field_name) && reader.ReadUint64(&dictionary_size) &&
+                                      dictionary_size <= row_count_,
+                                    "Invalid file, the fields of mindrecord columnar index file are broken.");
+    std::vector<std::string> dictionary(dictionary_size);
+    for (auto &value : dictionary) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadString(&value),
+                                      "Invalid file, the fields of mindrecord columnar index file are broken.");
+    }
+    field_names_.push_back(std::move(field_name));
+    dictionaries_.push_back(std::move(dictionary));
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(row_count_ <= size / sizeof(uint64_t),
+                                  "Invalid file, the row count of mindrecord columnar index file is broken.");
+  for (size_t column = 0; column < kColumnarOffsetNum; ++column) {
+    const uint8_t *bytes = nullptr;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadBytes(row_count_ * sizeof(uint64_t), &bytes),
+                                    "Invalid file, the offsets of mindrecord columnar index file are broken.");
+    offsets_[column] = reinterpret_cast<const uint64_t *>(bytes);
+  }
+  for (uint64_t i = 0; i < field_count; ++i) {
+    const uint8_t *bytes = nullptr;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(reader.ReadBytes(row_count_ * sizeof(uint32_t), &bytes),
+                                    "Invalid file, the codes of mindrecord columnar index file are broken.");
+    auto codes = reinterpret_cast<const uint32_t *>(bytes);
+    auto dictionary_size = dictionaries_[i].size();
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      std::all_of(codes, codes + row_count_, [dictionary_size](uint32_t code) { return code < dictionary_size; }),
+      "Invalid file, the codes of mindrecord columnar index file are broken.");
+    codes_.push_back(codes);
+  }
+
+  const auto *page_ids = offsets_[static_cast<size_t>(ColumnarOffset::kPageIdBlob)];
+  for (uint64_t row = 0; row < row_count_; ++row) {
+    page_rows_[page_ids[row]].push_back(row);
+  }
+  return Status::OK();
+}
+
+int ShardColumnarIndex::GetFieldId(const std::string &field_name) const {
+  auto iter = std::find(field_names_.begin(), field_names_.end(), field_name);
+  return iter == field_names_.end() ? -1 : static_cast<int>(iter - field_names_.begin());
+}
+
+bool ShardColumnarIndex::FindRow(uint64_t row_id, uint64_t *row) const {
+  const auto *row_ids = offsets_[static_cast<size_t>(ColumnarOffset::kRowId)];
+  auto iter = std::lower_bound(row_ids, row_ids + row_count_, row_id);
+  if (iter == row_ids + row_count_ || *iter != row_id) {
+    return false;
+  }
+  *row = static_cast<uint64_t>(iter - row_ids);
+  return true;
+}
+
+std::vector<bool> ShardColumnarIndex::MatchCodes(int field_id, const std::string &value, bool is_number) const {
+  const auto &dictionary = dictionaries_[field_id];
+  std::vector<bool> matched(dictionary.size(), false);
+  auto iter = std::lower_bound(dictionary.begin(), dictionary.end(), value);
+  if (iter != dictionary.end() && *iter == value) {
+    matched[iter - dictionary.begin()] = true;
+  }
+  if (!is_number) {
+    return matched;
+  }
+  // the number is compared by value like sqlite, e.g. 1 is equal to 1.0
+  try {
+    auto number = std::stold(value);
+    for (size_t i = 0; i < dictionary.size(); ++i) {
+      try {
+        matched[i] = matched[i] || std::stold(dictionary[i]) == number;
+      } catch (const std::exception &) {
+        continue;
+      }
+    }
+  } catch (const std::exception &) {
+    return matched;
+  }
+  return matched;
+}
+
+std::vector<uint64_t> ShardColumnarIndex::SelectRowsInPage(uint64_t page_id, int field_id, const std::string &value,
+                                                           bool is_number) const {
+  auto iter = page_rows_.find(page_id);
+  if (iter == page_rows_.end()) {
+    return {};
+  }
+  if (field_id < 0) {
+    return iter->second;
+  }
+  auto matched = MatchCodes(field_id, value, is_number);
+  std::vector<uint64_t> rows;
+  for (auto row : iter->second) {
+    if (matched[codes_[field_id][row]]) {
+      rows.push_back(row);
+    }
+  }
+  return rows;
+}
+
+std::vector<uint64_t> ShardColumnarIndex::SelectPages(int field_id, const std::string &value, bool is_number) const {
+  std::vector<bool> matched;
+  if (field_id >= 0) {
+    matched = MatchCodes(field_id, value, is_number);
+  }
+  const auto *page_ids = offsets_[static_cast<size_t>(ColumnarOffset::kPageIdBlob)];
+  std::vector<uint64_t> pages;
+  std::unordered_set<uint64_t> selected_pages;
+  for (uint64_t row = 0; row < row_count_; ++row) {
+    if (field_id >= 0 && !matched[codes_[field_id][row]]) {
+      continue;
+    }
+    if (selected_pages.insert(page_ids[row]).second) {
+      pages.push_back(page_ids[row]);
+    }
+  }
+  return pages;
+}
+
+void ShardColumnarIndex::FilterRows(int field_id, const std::string &value, bool is_number,
+                                    std::vector<uint64_t> *rows) const {
+  if (rows == nullptr || field_id < 0) {
+    return;
+  }
+  auto matched = MatchCodes(field_id, value, is_number);
+  const auto *codes = codes_[field_id];
+  (void)rows->erase(
+    std::remove_if(rows->begin(), rows->end(), [&matched, codes](uint64_t row) { return !matched[codes[row]]; }),
+    rows->end());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
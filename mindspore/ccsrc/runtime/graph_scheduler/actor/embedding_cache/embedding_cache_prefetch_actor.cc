@@ -15,6 +15,9 @@
  */
 
 #include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_actor.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
 #include <limits>
 #include "backend/common/optimizer/dynamic_shape/dynamic_shape_helper.h"
 #include "kernel/common_utils.h"
@@ -40,7 +43,36 @@ constexpr size_t kMaxThreadNum = 16;
 // Maximum number of feature ids processed per thread.
 constexpr size_t kMaxIdsPerThread = 10000;
 
+// The environment variable to set the max number of batches which are parsed but not updated, the cache prefetching is
+// pipelined if it is greater than 0.
+constexpr char kEnvEmbeddingCachePrefetchLookahead[] = "MS_DEV_EMBEDDING_CACHE_PREFETCH_LOOKAHEAD";
+// Maximum lookahead steps of pipelined cache prefetching, each step holds a set of swap buffers.
+constexpr size_t kMaxPrefetchLookahead = 8;
+// The interval of steps to print the accumulated statistics of embedding cache.
+constexpr size_t kCacheStatisticsDumpInterval = 1000;
+
 namespace {
+// Get the lookahead steps of pipelined cache prefetching, return 0 for the serial mode.
+size_t GetPrefetchLookahead() {
+  auto env = common::GetEnv(kEnvEmbeddingCachePrefetchLookahead);
+  if (env.empty()) {
+    return 0;
+  }
+  if (!std::all_of(env.begin(), env.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }) ||
+      env.size() > std::to_string(kMaxPrefetchLookahead).size()) {
+    MS_LOG(WARNING) << "The value of " << kEnvEmbeddingCachePrefetchLookahead << " should be an integer in range [0, "
+                    << kMaxPrefetchLookahead << "], but got: " << env << ", use the serial cache prefetching instead.";
+    return 0;
+  }
+  return std::min(static_cast<size_t>(std::stoul(env)), kMaxPrefetchLookahead);
+}
+
+// Get the cost time from the start time point in microseconds.
+size_t GetCostTime(const std::chrono::steady_clock::time_point &start) {
+  return LongToSize(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 ParameterPtr NewParameter(const KernelGraphPtr &graph, TypePtr type, const ShapeVector &shape) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(type);
@@ -244,6 +276,22 @@ void EmbeddingCachePrefetchActor::Initialize() {
   MS_EXCEPTION_IF_NULL(embedding_host_cache_);
   local_embedding_slice_bounds_ = embedding_cache_table_manager.local_embedding_slice_bounds_;
   local_device_cache_bounds_ = embedding_cache_table_manager.local_device_cache_bounds_;
+  eviction_policy_type_ = embedding_cache_table_manager.eviction_policy_type();
+  // All the embedding tables share the same swap indices, so a swapped row moves the embeddings of all tables.
+  embedding_row_bytes_ = 0;
+  for (const auto &item : hash_tables_) {
+    embedding_row_bytes_ += item.second.embedding_size * sizeof(float);
+  }
+
+  // Create the swap buffers, there are lookahead buffers in the pipelined mode.
+  prefetch_lookahead_ = GetPrefetchLookahead();
+  auto swap_info_num = prefetch_lookahead_ == 0 ? 1 : prefetch_lookahead_;
+  swap_infos_.clear();
+  auto batch_ids_num = embedding_cache_table_manager.batch_ids_num_;
+  for (size_t i = 0; i < swap_info_num; ++i) {
+    (void)swap_infos_.emplace_back(std::make_unique<EmbeddingCacheSwapInfo>(batch_ids_num));
+  }
+  MS_LOG(INFO) << "Embedding cache prefetch lookahead steps: " << prefetch_lookahead_;
 
   // Get the id range of each server's embedding table slice.
   GetRemoteEmbeddingSliceBound();
@@ -269,13 +317,21 @@ void EmbeddingCachePrefetchActor::Finalize() {
   if (!initialized_ || finalized_) {
     return;
   }
+  finalizing_ = true;
   SyncEmbeddingTable();
+  DumpCacheStatistics();
 
   running_ = false;
+  // Join the stage threads before finalizing remote, the prefetch thread stops the pipeline too when it exits.
+  StopPrefetchPipeline();
   (void)FinalizeRemote();
 
   PsDataPrefetch::GetInstance().NotifyFinalize();
   data_parser_.notify_all();
+  {
+    std::lock_guard<std::mutex> locker(update_mutex_);
+    update_finished_.notify_all();
+  }
 
   embedding_cache_lookup_node_ = nullptr;
   embedding_cache_update_node_ = nullptr;
@@ -470,6 +526,23 @@ void EmbeddingCachePrefetchActor::IncreaseGraphStep(const std::string &channel_n
     MS_LOG(EXCEPTION) << "TryWakeChannel failed, channel name: " << channel_name;
   }
   data_parser_.notify_one();
+
+  // In the pipelined mode, the batch ids are returned to the dataset before the caches are updated, so the graph step
+  // needs to wait for the cache updating of its batch.
+  if (prefetch_lookahead_ != 0) {
+    std::unique_lock<std::mutex> locker(update_mutex_);
+    update_finished_.wait(locker, [this] { return updated_data_step_ >= graph_step_ || !running_; });
+    if (!running_ && finalizing_) {
+      MS_LOG(INFO) << "Embedding cache prefetch actor is finalized before the cache updating of graph step "
+                   << graph_step_ << " finished.";
+      return;
+    }
+    if (!running_) {
+      std::string error_info =
+        !error_info_.empty() ? error_info_ : "Embedding cache prefetch actor is finalized abnormally.";
+      MS_LOG(EXCEPTION) << error_info;
+    }
+  }
 }
 
 void EmbeddingCachePrefetchActor::Run() {
@@ -494,6 +567,7 @@ void EmbeddingCachePrefetchActor::Run() {
   WaitDataChannelInit();
 
   MS_LOG(INFO) << "Begin prefetching cache.";
+  StartPrefetchPipeline();
   while (running_) {
     if (!PrefetchCache()) {
       running_ = false;
@@ -502,9 +576,65 @@ void EmbeddingCachePrefetchActor::Run() {
       PsDataPrefetch::GetInstance().NotifyFinalize();
     }
   }
+  StopPrefetchPipeline();
   MS_LOG(INFO) << "End prefetching cache.";
 }
 
+void EmbeddingCachePrefetchActor::StartPrefetchPipeline() {
+  if (prefetch_lookahead_ == 0) {
+    return;
+  }
+  std::vector<EmbeddingCacheSwapInfo *> buffers;
+  (void)std::transform(swap_infos_.begin(), swap_infos_.end(), std::back_inserter(buffers),
+                       [](const std::unique_ptr<EmbeddingCacheSwapInfo> &swap_info) { return swap_info.get(); });
+  auto remote_stage = [this](EmbeddingCacheSwapInfo *swap_info) {
+    if (!SwapRemoteCache(swap_info)) {
+      OnStageFailed("Swap embeddings between local host cache and remote failed.");
+      return false;
+    }
+    return true;
+  };
+  auto device_stage = [this](EmbeddingCacheSwapInfo *swap_info) {
+    if (!SwapDeviceCache(swap_info)) {
+      OnStageFailed("Swap embeddings between device cache and local host cache failed.");
+      return false;
+    }
+    RecordCacheStatistics(*swap_info);
+    FinishUpdateStep(swap_info->data_step_);
+    return true;
+  };
+  // The device context has been checked in Run.
+  auto device_stage_init = [this]() {
+    if (!device_context_->device_res_manager_->BindDeviceToCurrentThread()) {
+      OnStageFailed("Failed to bind device to the device stage thread of cache prefetching.");
+      return false;
+    }
+    return true;
+  };
+  prefetch_pipeline_.Start(buffers, remote_stage, device_stage, device_stage_init);
+}
+
+void EmbeddingCachePrefetchActor::StopPrefetchPipeline() { prefetch_pipeline_.Stop(); }
+
+void EmbeddingCachePrefetchActor::OnStageFailed(const std::string &error_info) {
+  SetErrorInfo(error_info);
+  MS_LOG(ERROR) << error_info;
+  running_ = false;
+  PsDataPrefetch::GetInstance().NotifyFinalize();
+  data_parser_.notify_all();
+  {
+    std::lock_guard<std::mutex> locker(update_mutex_);
+    update_finished_.notify_all();
+  }
+  prefetch_pipeline_.Close();
+}
+
+void EmbeddingCachePrefetchActor::FinishUpdateStep(size_t data_step) {
+  std::lock_guard<std::mutex> locker(update_mutex_);
+  updated_data_step_ = data_step;
+  update_finished_.notify_all();
+}
+
 bool EmbeddingCachePrefetchActor::PrefetchCache() {
   // 1. Acquire batch ids
   void *data = nullptr;
@@ -527,13 +657,30 @@ bool EmbeddingCachePrefetchActor::PrefetchCache() {
   auto batch_ids = reinterpret_cast<int *>(data);
   auto batch_ids_num = data_size / sizeof(int);
   std::unique_ptr<int[]> hash_index = std::make_unique<int[]>(batch_ids_num);
+
+  // In the pipelined mode, wait for a free swap buffer, which bounds the batches parsed but not updated.
+  auto start_time = std::chrono::steady_clock::now();
+  EmbeddingCacheSwapInfo *swap_info = nullptr;
+  if (prefetch_lookahead_ == 0) {
+    swap_info = swap_infos_.front().get();
+  } else {
+    swap_info = prefetch_pipeline_.AcquireFreeBuffer();
+    if (swap_info == nullptr) {
+      MS_LOG(INFO) << "The cache prefetching pipeline is stopped.";
+      return true;
+    }
+  }
+  auto wait_swap_buffer_cost = GetCostTime(start_time);
+
   auto ret = memset_s(&statistics_info_, sizeof(statistics_info_), 0, sizeof(statistics_info_));
   if (ret != EOK) {
     MS_LOG(ERROR) << "Memset for cache statistics info failed, errno[" << ret << "]";
     return false;
   }
+  statistics_info_.wait_swap_buffer_cost_ = wait_swap_buffer_cost;
 
   // 2. Count cache miss ids.
+  start_time = std::chrono::steady_clock::now();
   RETURN_IF_FALSE_WITH_LOG(CountCacheMissIds(batch_ids, batch_ids_num, hash_index.get()),
                            "Count cache miss ids failed.");
 
@@ -541,9 +688,21 @@ bool EmbeddingCachePrefetchActor::PrefetchCache() {
     MS_LOG(ERROR) << "Cache prefetching waits graph finish failed.";
     return false;
   }
+  statistics_info_.parse_ids_cost_ = GetCostTime(start_time);
+  ExchangeSwapInfo(swap_info);
 
-  // 3. If the device cache does not reach 100% hit rate, the cache needs to be updated.
-  RETURN_IF_FALSE_WITH_LOG(UpdateCache(), "Update local cache failed.");
+  // 3. If the device cache does not reach 100% hit rate, the cache needs to be updated. In the pipelined mode, the
+  // caches are updated by the stage threads, and the graph step waits for it in IncreaseGraphStep.
+  if (prefetch_lookahead_ == 0) {
+    RETURN_IF_FALSE_WITH_LOG(UpdateCache(swap_info), "Update local cache failed.");
+    RecordCacheStatistics(*swap_info);
+  } else {
+    {
+      std::lock_guard<std::mutex> locker(update_mutex_);
+      parsed_data_step_ = data_step_;
+    }
+    prefetch_pipeline_.Submit(swap_info);
+  }
 
   // 4. Replace the batch_ids by hash index for GetNext operator to get hash index as input.
   size_t dest_len = data_size;
@@ -556,6 +715,25 @@ bool EmbeddingCachePrefetchActor::PrefetchCache() {
   return true;
 }
 
+void EmbeddingCachePrefetchActor::ExchangeSwapInfo(EmbeddingCacheSwapInfo *swap_info) {
+  MS_EXCEPTION_IF_NULL(swap_info);
+  MS_EXCEPTION_IF_NULL(embedding_device_cache_);
+  MS_EXCEPTION_IF_NULL(embedding_host_cache_);
+  // Only the buffers are exchanged, the caches write the swap information of next batch ids into the free buffers.
+  std::swap(swap_info->device_cache_device_to_host_index_, embedding_device_cache_->device_to_host_index);
+  std::swap(swap_info->device_cache_device_to_host_ids_, embedding_device_cache_->device_to_host_ids);
+  std::swap(swap_info->device_cache_host_to_device_index_, embedding_device_cache_->host_to_device_index);
+  std::swap(swap_info->device_cache_host_to_device_ids_, embedding_device_cache_->host_to_device_ids);
+  std::swap(swap_info->host_cache_host_to_server_index_, embedding_host_cache_->host_to_server_index);
+  std::swap(swap_info->host_cache_host_to_server_ids_, embedding_host_cache_->host_to_server_ids);
+  std::swap(swap_info->host_cache_server_to_host_index_, embedding_host_cache_->server_to_host_index);
+  std::swap(swap_info->host_cache_server_to_host_ids_, embedding_host_cache_->server_to_host_ids);
+  std::swap(swap_info->host_cache_host_to_device_index_, embedding_host_cache_->host_to_device_index);
+  std::swap(swap_info->host_cache_device_to_host_index_, embedding_host_cache_->device_to_host_index);
+  swap_info->data_step_ = data_step_;
+  swap_info->statistics_info_ = statistics_info_;
+}
+
 bool EmbeddingCachePrefetchActor::IncreaseStep() {
   if (data_step_ >= UINT64_MAX) {
     MS_LOG(ERROR) << "The data step (" << data_step_ << ") will exceed the maximum value of uint64_t.";
@@ -639,6 +817,7 @@ bool EmbeddingCachePrefetchActor::ParseDeviceData(int id, bool *need_swap_device
     if (device_hash_map->hash_step(index) != data_step_) {
       statistics_info_.hash_hit_count_++;
       device_hash_map->set_hash_step(index, data_step_);
+      device_hash_map->AccessIndex(index);
     }
   } else {
     int *device_to_host_index = embedding_device_cache_->device_to_host_index.get();
@@ -683,6 +862,7 @@ bool EmbeddingCachePrefetchActor::ParseHostDataHostToDevice(int id) {
     auto index = iter->second;
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
+      host_hash_map->AccessIndex(index);
     }
     host_to_device_index[statistics_info_.host_to_device_size_ - 1] = index;
   } else {
@@ -728,6 +908,7 @@ bool EmbeddingCachePrefetchActor::ParseHostDataDeviceToHost() {
     auto index = iter->second;
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
+      host_hash_map->AccessIndex(index);
     }
     device_to_host_index[statistics_info_.device_to_host_size_ - 1] = index;
   } else {
@@ -752,12 +933,12 @@ bool EmbeddingCachePrefetchActor::ParseHostDataDeviceToHost() {
 
 bool EmbeddingCachePrefetchActor::CheckCacheHitOrOutRangeFunc(const int *batch_ids, const size_t batch_ids_num,
                                                               int *hash_index, bool *in_device, bool *out_range,
-                                                              size_t *hash_hit_count) {
+                                                              std::vector<int> *hit_indices) {
   MS_ERROR_IF_NULL(batch_ids);
   MS_ERROR_IF_NULL(hash_index);
   MS_ERROR_IF_NULL(in_device);
   MS_ERROR_IF_NULL(out_range);
-  MS_ERROR_IF_NULL(hash_hit_count);
+  MS_ERROR_IF_NULL(hit_indices);
   MS_ERROR_IF_NULL(embedding_device_cache_);
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
@@ -778,7 +959,7 @@ bool EmbeddingCachePrefetchActor::CheckCacheHitOrOutRangeFunc(const int *batch_i
     if (iter != hash_id_to_index.end()) {
       hash_index[i] = iter->second + local_device_cache_bounds_.first;
       if (device_hash_map->hash_step(iter->second) != data_step_) {
-        ++(*hash_hit_count);
+        (void)hit_indices->emplace_back(iter->second);
         device_hash_map->set_hash_step(iter->second, data_step_);
       }
       in_device[i] = true;
@@ -797,7 +978,8 @@ bool EmbeddingCachePrefetchActor::CheckCacheHitOrOutRange(const int *batch_ids,
   size_t thread_num = batch_ids_num / kMaxIdsPerThread + 1;
   thread_num = thread_num > kMaxThreadNum ? kMaxThreadNum : thread_num;
   std::thread threads[kMaxThreadNum];
-  size_t hash_hit_count[kMaxThreadNum] = {0};
+  // The indices hit by each thread, which are reported to the eviction policy after all threads finished.
+  std::vector<int> hit_indices[kMaxThreadNum];
   size_t i = 0;
   size_t offset = 0;
 
@@ -807,7 +989,7 @@ bool EmbeddingCachePrefetchActor::CheckCacheHitOrOutRange(const int *batch_ids,
     }
     size_t proc_len = batch_ids_num / thread_num + (i < (batch_ids_num % thread_num) ? 1 : 0);
     threads[i] = std::thread(&EmbeddingCachePrefetchActor::CheckCacheHitOrOutRangeFunc, this, batch_ids + offset,
-                             proc_len, hash_index + offset, in_device + offset, out_range + offset, hash_hit_count + i);
+                             proc_len, hash_index + offset, in_device + offset, out_range + offset, hit_indices + i);
     offset += proc_len;
   }
   if (offset != batch_ids_num) {
@@ -817,12 +999,72 @@ bool EmbeddingCachePrefetchActor::CheckCacheHitOrOutRange(const int *batch_ids,
   for (size_t j = 0; j < i; j++) {
     threads[j].join();
   }
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
+  MS_ERROR_IF_NULL(device_hash_map);
   for (size_t j = 0; j < i; j++) {
-    statistics_info_.hash_hit_count_ += hash_hit_count[j];
+    statistics_info_.hash_hit_count_ += hit_indices[j].size();
+    for (auto index : hit_indices[j]) {
+      device_hash_map->AccessIndex(index);
+    }
   }
   return true;
 }
 
+void EmbeddingCachePrefetchActor::RecordCacheStatistics(const EmbeddingCacheSwapInfo &swap_info) {
+  const auto &info = swap_info.statistics_info_;
+  auto &accumulated_info = accumulated_statistics_info_;
+  accumulated_info.step_count_++;
+  accumulated_info.device_hit_count_ += info.hash_hit_count_;
+  accumulated_info.device_miss_count_ += info.host_to_device_size_;
+  accumulated_info.host_to_device_size_ += info.host_to_device_size_;
+  accumulated_info.device_to_host_size_ += info.device_to_host_size_;
+  accumulated_info.server_to_host_size_ += info.server_to_host_size_;
+  accumulated_info.host_to_server_size_ += info.host_to_server_size_;
+  accumulated_info.wait_swap_buffer_cost_ += info.wait_swap_buffer_cost_;
+  accumulated_info.parse_ids_cost_ += info.parse_ids_cost_;
+  accumulated_info.wait_graph_cost_ += info.wait_graph_cost_;
+  accumulated_info.host_to_server_cost_ += info.host_to_server_cost_;
+  accumulated_info.device_to_host_cost_ += info.device_to_host_cost_;
+  accumulated_info.server_to_host_cost_ += info.server_to_host_cost_;
+  accumulated_info.host_to_device_cost_ += info.host_to_device_cost_;
+
+  // The hit rate is counted by the unique ids in the range of local embedding table slice.
+  size_t access_count = info.hash_hit_count_ + info.host_to_device_size_;
+  float hit_rate = access_count == 0 ? 1.0f : SizeToFloat(info.hash_hit_count_) / access_count;
+  MS_LOG(DEBUG) << "Embedding cache step:" << swap_info.data_step_
+                << ", eviction policy:" << distributed::GetCacheEvictionPolicyName(eviction_policy_type_)
+                << ", batch ids num:" << info.batch_id_count_ << ", device cache hit rate:" << hit_rate
+                << ", swap in(host to device) bytes:" << info.host_to_device_size_ * embedding_row_bytes_
+                << ", swap out(device to host) bytes:" << info.device_to_host_size_ * embedding_row_bytes_
+                << ", swap in(remote to host) bytes:" << info.server_to_host_size_ * embedding_row_bytes_
+                << ", swap out(host to remote) bytes:" << info.host_to_server_size_ * embedding_row_bytes_
+                << ", cost time(us) of wait swap buffer:" << info.wait_swap_buffer_cost_
+                << ", parse ids:" << info.parse_ids_cost_ << "(wait graph:" << info.wait_graph_cost_
+                << "), host to remote:" << info.host_to_server_cost_ << ", device to host:" << info.device_to_host_cost_
+                << ", remote to host:" << info.server_to_host_cost_ << ", host to device:" << info.host_to_device_cost_;
+  if (accumulated_info.step_count_ % kCacheStatisticsDumpInterval == 0) {
+    DumpCacheStatistics();
+  }
+}
+
+void EmbeddingCachePrefetchActor::DumpCacheStatistics() const {
+  const auto &info = accumulated_statistics_info_;
+  size_t access_count = info.device_hit_count_ + info.device_miss_count_;
+  float hit_rate = access_count == 0 ? 1.0f : SizeToFloat(info.device_hit_count_) / access_count;
+  MS_LOG(INFO) << "Embedding cache statistics of " << info.step_count_
+               << " steps, eviction policy:" << distributed::GetCacheEvictionPolicyName(eviction_policy_type_)
+               << ", prefetch lookahead steps:" << prefetch_lookahead_ << ", device cache hit rate:" << hit_rate
+               << ", total swap in(host to device) bytes:" << info.host_to_device_size_ * embedding_row_bytes_
+               << ", total swap out(device to host) bytes:" << info.device_to_host_size_ * embedding_row_bytes_
+               << ", total swap in(remote to host) bytes:" << info.server_to_host_size_ * embedding_row_bytes_
+               << ", total swap out(host to remote) bytes:" << info.host_to_server_size_ * embedding_row_bytes_
+               << ", total cost time(us) of wait swap buffer:" << info.wait_swap_buffer_cost_
+               << ", parse ids:" << info.parse_ids_cost_ << "(wait graph:" << info.wait_graph_cost_
+               << "), host to remote:" << info.host_to_server_cost_ << ", device to host:" << info.device_to_host_cost_
+               << ", remote to host:" << info.server_to_host_cost_ << ", host to device:" << info.host_to_device_cost_;
+}
+
 bool EmbeddingCachePrefetchActor::ResetEmbeddingHashMap() {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
@@ -839,6 +1081,7 @@ bool EmbeddingCachePrefetchActor::ResetEmbeddingHashMap() {
 
 bool EmbeddingCachePrefetchActor::WaitGraphRun() {
   MS_LOG(INFO) << "Hash table has no space to insert new data and retries within 2 minutes.";
+  auto start_time = std::chrono::steady_clock::now();
   std::unique_lock<std::mutex> locker(data_mutex_);
   const int64_t longest_time_to_wait = 120;
   if (!data_parser_.wait_for(locker, std::chrono::seconds(longest_time_to_wait),
@@ -851,30 +1094,84 @@ bool EmbeddingCachePrefetchActor::WaitGraphRun() {
     return false;
   }
   set_current_graph_step();
+  statistics_info_.wait_graph_cost_ += GetCostTime(start_time);
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::UpdateCache() {
+bool EmbeddingCachePrefetchActor::UpdateCache(EmbeddingCacheSwapInfo *swap_info) {
+  MS_ERROR_IF_NULL(swap_info);
+  auto &info = swap_info->statistics_info_;
   for (const auto &item : hash_tables_) {
     auto hash_info = item.second;
-    RETURN_IF_FALSE_WITH_LOG(PushCacheFromLocalHostToRemote(hash_info), "Push cache from local host to remote failed.");
-    RETURN_IF_FALSE_WITH_LOG(PushCacheFromDeviceToLocalHost(hash_info), "Push cache from device to local host failed.");
-    RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(hash_info), "Pull cache from remote to local host failed.");
-    RETURN_IF_FALSE_WITH_LOG(PullCacheFromLocalHostToDevice(hash_info), "Pull cache from local host to device failed.");
+    auto start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PushCacheFromLocalHostToRemote(hash_info, *swap_info),
+                             "Push cache from local host to remote failed.");
+    info.host_to_server_cost_ += GetCostTime(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PushCacheFromDeviceToLocalHost(hash_info, *swap_info),
+                             "Push cache from device to local host failed.");
+    info.device_to_host_cost_ += GetCostTime(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(hash_info, *swap_info),
+                             "Pull cache from remote to local host failed.");
+    info.server_to_host_cost_ += GetCostTime(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PullCacheFromLocalHostToDevice(hash_info, *swap_info),
+                             "Pull cache from local host to device failed.");
+    info.host_to_device_cost_ += GetCostTime(start_time);
   }
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::PushCacheFromLocalHostToRemote(const HashTableInfo &hash_info) {
-  auto swap_indices_size = statistics_info_.host_to_server_size_;
+bool EmbeddingCachePrefetchActor::SwapRemoteCache(EmbeddingCacheSwapInfo *swap_info) {
+  MS_ERROR_IF_NULL(swap_info);
+  auto &info = swap_info->statistics_info_;
+  // The host indices swapped out to remote only belong to the updated steps, so this stage does not conflict with the
+  // device stage of the previous batch.
+  for (const auto &item : hash_tables_) {
+    auto start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PushCacheFromLocalHostToRemote(item.second, *swap_info),
+                             "Push cache from local host to remote failed.");
+    info.host_to_server_cost_ += GetCostTime(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(item.second, *swap_info),
+                             "Pull cache from remote to local host failed.");
+    info.server_to_host_cost_ += GetCostTime(start_time);
+  }
+  return true;
+}
+
+bool EmbeddingCachePrefetchActor::SwapDeviceCache(EmbeddingCacheSwapInfo *swap_info) {
+  MS_ERROR_IF_NULL(swap_info);
+  auto &info = swap_info->statistics_info_;
+  for (const auto &item : hash_tables_) {
+    auto start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PushCacheFromDeviceToLocalHost(item.second, *swap_info),
+                             "Push cache from device to local host failed.");
+    info.device_to_host_cost_ += GetCostTime(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    RETURN_IF_FALSE_WITH_LOG(PullCacheFromLocalHostToDevice(item.second, *swap_info),
+                             "Pull cache from local host to device failed.");
+    info.host_to_device_cost_ += GetCostTime(start_time);
+  }
+  return true;
+}
+
+bool EmbeddingCachePrefetchActor::PushCacheFromLocalHostToRemote(const HashTableInfo &hash_info,
+                                                                 const EmbeddingCacheSwapInfo &swap_info) {
+  auto swap_indices_size = swap_info.statistics_info_.host_to_server_size_;
   if (swap_indices_size == 0) {
     return true;
   }
 
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
+  auto host_to_server_ids = swap_info.host_cache_host_to_server_ids_.get();
   MS_ERROR_IF_NULL(host_to_server_ids);
-  auto host_to_server_index = embedding_host_cache_->host_to_server_index.get();
+  auto host_to_server_index = swap_info.host_cache_host_to_server_index_.get();
   MS_ERROR_IF_NULL(host_to_server_index);
 
   std::vector<float> swap_out_data;
@@ -891,17 +1188,17 @@ bool EmbeddingCachePrefetchActor::PushCacheFromLocalHostToRemote(const HashTable
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info) {
-  auto swap_indices_size = statistics_info_.device_to_host_size_;
+bool EmbeddingCachePrefetchActor::PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info,
+                                                                 const EmbeddingCacheSwapInfo &swap_info) {
+  auto swap_indices_size = swap_info.statistics_info_.device_to_host_size_;
   if (swap_indices_size == 0) {
     return true;
   }
 
   MS_ERROR_IF_NULL(embedding_device_cache_);
-  MS_ERROR_IF_NULL(embedding_host_cache_);
 
-  auto device_cache_device_to_host_index = embedding_device_cache_->device_to_host_index.get();
-  auto host_cache_device_to_host_index = embedding_host_cache_->device_to_host_index.get();
+  auto device_cache_device_to_host_index = swap_info.device_cache_device_to_host_index_.get();
+  auto host_cache_device_to_host_index = swap_info.host_cache_device_to_host_index_.get();
   MS_ERROR_IF_NULL(device_cache_device_to_host_index);
   MS_ERROR_IF_NULL(host_cache_device_to_host_index);
   auto hash_table_addr = reinterpret_cast<float *>(hash_info.device_address.addr);
@@ -935,16 +1232,16 @@ bool EmbeddingCachePrefetchActor::PushCacheFromDeviceToLocalHost(const HashTable
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info) {
-  auto swap_indices_size = statistics_info_.server_to_host_size_;
+bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info,
+                                                                 const EmbeddingCacheSwapInfo &swap_info) {
+  auto swap_indices_size = swap_info.statistics_info_.server_to_host_size_;
   if (swap_indices_size == 0) {
     return true;
   }
 
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
+  auto server_to_host_ids = swap_info.host_cache_server_to_host_ids_.get();
   MS_ERROR_IF_NULL(server_to_host_ids);
-  auto server_to_host_index = embedding_host_cache_->server_to_host_index.get();
+  auto server_to_host_index = swap_info.host_cache_server_to_host_index_.get();
   MS_ERROR_IF_NULL(server_to_host_index);
 
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
@@ -961,17 +1258,17 @@ bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTable
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::PullCacheFromLocalHostToDevice(const HashTableInfo &hash_info) {
-  auto swap_indices_size = statistics_info_.host_to_device_size_;
+bool EmbeddingCachePrefetchActor::PullCacheFromLocalHostToDevice(const HashTableInfo &hash_info,
+                                                                 const EmbeddingCacheSwapInfo &swap_info) {
+  auto swap_indices_size = swap_info.statistics_info_.host_to_device_size_;
   if (swap_indices_size == 0) {
     return true;
   }
 
   MS_ERROR_IF_NULL(embedding_device_cache_);
-  MS_ERROR_IF_NULL(embedding_host_cache_);
 
-  auto host_cache_host_to_device_index = embedding_host_cache_->host_to_device_index.get();
-  auto device_cache_host_to_device_index = embedding_device_cache_->host_to_device_index.get();
+  auto host_cache_host_to_device_index = swap_info.host_cache_host_to_device_index_.get();
+  auto device_cache_host_to_device_index = swap_info.device_cache_host_to_device_index_.get();
   MS_ERROR_IF_NULL(host_cache_host_to_device_index);
   MS_ERROR_IF_NULL(device_cache_host_to_device_index);
 
@@ -1423,6 +1720,14 @@ void EmbeddingCachePrefetchActor::SyncEmbeddingTable() {
   if (!initialized_) {
     return;
   }
+  // Wait for the caches of all parsed batches to be updated in the pipelined mode.
+  if (prefetch_lookahead_ != 0) {
+    std::unique_lock<std::mutex> locker(update_mutex_);
+    update_finished_.wait(locker, [this] { return updated_data_step_ >= parsed_data_step_ || !running_; });
+    if (!running_) {
+      return;
+    }
+  }
   if (!SyncHostEmbeddingTable()) {
     MS_LOG(ERROR) << "SyncHostEmbeddingTable failed.";
   }
@@ -31,6 +31,7 @@
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "utils/hash_map.h"
 #include "distributed/embedding_cache/embedding_cache_utils.h"
+#include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_pipeline.h"
 
 // Note: After the code in ps/ps_cache are removed into runtime/addons/embedding_cache/,
 // the follow include file and using declaration of ps will be removed.
@@ -52,6 +53,8 @@ using ReceiverPtr = std::shared_ptr<Receiver>;
 using SendRecvPair = std::pair<SenderPtr, ReceiverPtr>;
 using SendRecvPairList = std::vector<SendRecvPair>;
 
+using distributed::CacheEvictionPolicyType;
+using distributed::EmbeddingCacheAccumulatedStatisticsInfo;
 using distributed::EmbeddingCacheStatisticsInfo;
 using distributed::EmbeddingDeviceCache;
 using distributed::EmbeddingHostCache;
@@ -64,11 +67,49 @@ using distributed::cluster::ActorRouteTableProxyPtr;
 using distributed::rpc::TCPClient;
 using distributed::rpc::TCPServer;
 
+// The swap information of a batch ids, which is produced by parsing the ids and consumed by updating the caches. The
+// arrays are exchanged with the ones of EmbeddingDeviceCache and EmbeddingHostCache after parsing, so that the ids of
+// next batch can be parsed before the caches are updated.
+struct EmbeddingCacheSwapInfo {
+  explicit EmbeddingCacheSwapInfo(size_t batch_ids_num)
+      : device_cache_device_to_host_index_(std::make_unique<int[]>(batch_ids_num)),
+        device_cache_device_to_host_ids_(std::make_unique<int[]>(batch_ids_num)),
+        device_cache_host_to_device_index_(std::make_unique<int[]>(batch_ids_num)),
+        device_cache_host_to_device_ids_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_host_to_server_index_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_host_to_server_ids_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_server_to_host_index_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_server_to_host_ids_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_host_to_device_index_(std::make_unique<int[]>(batch_ids_num)),
+        host_cache_device_to_host_index_(std::make_unique<int[]>(batch_ids_num)) {}
+
+  // The data step of the batch ids.
+  size_t data_step_{0};
+  // The swap sizes and the cost time of each stage.
+  EmbeddingCacheStatisticsInfo statistics_info_;
+
+  std::unique_ptr<int[]> device_cache_device_to_host_index_;
+  std::unique_ptr<int[]> device_cache_device_to_host_ids_;
+  std::unique_ptr<int[]> device_cache_host_to_device_index_;
+  std::unique_ptr<int[]> device_cache_host_to_device_ids_;
+  std::unique_ptr<int[]> host_cache_host_to_server_index_;
+  std::unique_ptr<int[]> host_cache_host_to_server_ids_;
+  std::unique_ptr<int[]> host_cache_server_to_host_index_;
+  std::unique_ptr<int[]> host_cache_server_to_host_ids_;
+  std::unique_ptr<int[]> host_cache_host_to_device_index_;
+  std::unique_ptr<int[]> host_cache_device_to_host_index_;
+};
+
 // The EmbeddingCachePrefetchActor is used to cache large embedding table scenarios. The cache level is: Device
 // Cache->Local Host Cache->Remote Cache. This Actor is used to perform Local and Device Cache hit analysis and cache
 // prefetching (the feature weights corresponding to the ids of subsequent batches are assigned in advance Prefetching
 // into the Device Cache, so that it is pipelined with the calculation on the Device side), cache prefetching may
 // involve RPC communication with the Server side.
+// In the pipelined mode, which is enabled by the environment variable 'MS_DEV_EMBEDDING_CACHE_PREFETCH_LOOKAHEAD', the
+// batch ids are returned to the dataset right after parsing, and the caches are updated by two stage threads: the
+// remote stage swaps embeddings between local host cache and remote, and the device stage swaps embeddings between
+// device cache and local host cache. At most 'lookahead' batches are parsed but not updated, and each graph step waits
+// for the cache updating of its batch before running.
 class EmbeddingCachePrefetchActor : public ActorBase {
  public:
   explicit EmbeddingCachePrefetchActor(device::DeviceContext *device_context)
@@ -121,11 +162,26 @@ class EmbeddingCachePrefetchActor : public ActorBase {
                                bool *out_range);
   // Thread execution function of method 'CheckCacheHitOrOutRange'.
   bool CheckCacheHitOrOutRangeFunc(const int *batch_ids, const size_t batch_ids_len, int *hash_index, bool *in_device,
-                                   bool *out_range, size_t *hash_hit_count);
+                                   bool *out_range, std::vector<int> *hit_indices);
 
   // Reset EmbeddingHashMap for device and local host cache.
   bool ResetEmbeddingHashMap();
 
+  // Exchange the swap arrays of the parsed batch ids with the device and local host cache, and record the swap sizes.
+  void ExchangeSwapInfo(EmbeddingCacheSwapInfo *swap_info);
+  // Start and stop the stage threads of pipelined cache prefetching.
+  void StartPrefetchPipeline();
+  void StopPrefetchPipeline();
+  // Stop prefetching when a stage of the pipeline failed.
+  void OnStageFailed(const std::string &error_info);
+  // Mark the cache updating of the data step finished and notify the graph step waiting for it.
+  void FinishUpdateStep(size_t data_step);
+
+  // Accumulate and print the hit rate, swap volume and cost time of a step.
+  void RecordCacheStatistics(const EmbeddingCacheSwapInfo &swap_info);
+  // Print the hit rate, swap volume and cost time of all steps.
+  void DumpCacheStatistics() const;
+
   // Update the current computed graph's step to real global step at the time when this actor starts to prefetch cache
   // for a batch ids.
   void set_current_graph_step() { graph_running_step_ = graph_step_; }
@@ -133,16 +189,20 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // When the device cache does not reach 100% hit, the cache needs to be updated, which involves cache insertion and
   // deletion. That is, push the non-hotspot embeddings on the local side to the remote, and pull the missing embeddings
   // on the local side from the remote.
-  bool UpdateCache();
+  bool UpdateCache(EmbeddingCacheSwapInfo *swap_info);
+  // Swap embeddings between local host cache and remote, which is the remote stage of pipelined prefetching.
+  bool SwapRemoteCache(EmbeddingCacheSwapInfo *swap_info);
+  // Swap embeddings between device cache and local host cache, which is the device stage of pipelined prefetching.
+  bool SwapDeviceCache(EmbeddingCacheSwapInfo *swap_info);
 
   // Push non-hotspot embeddings on local host cache to remote.
-  bool PushCacheFromLocalHostToRemote(const HashTableInfo &hash_info);
+  bool PushCacheFromLocalHostToRemote(const HashTableInfo &hash_info, const EmbeddingCacheSwapInfo &swap_info);
   // Push non-hotspot embeddings on device cache to local host cache.
-  bool PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info);
+  bool PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info, const EmbeddingCacheSwapInfo &swap_info);
   // Pull missing embeddings on local cache from remote.
-  bool PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info);
+  bool PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info, const EmbeddingCacheSwapInfo &swap_info);
   // Pull missing embeddings on device cache from local host.
-  bool PullCacheFromLocalHostToDevice(const HashTableInfo &hash_info);
+  bool PullCacheFromLocalHostToDevice(const HashTableInfo &hash_info, const EmbeddingCacheSwapInfo &swap_info);
 
   // Insert weights into the local host embedding cache.
   bool InsertLocalHostCache(size_t embedding_size, size_t insert_indices_size, const int *insert_indices,
@@ -278,6 +338,12 @@ class EmbeddingCachePrefetchActor : public ActorBase {
 
   // Statistics on the cache hit rate of the host and device and the information used to update cache.
   EmbeddingCacheStatisticsInfo statistics_info_;
+  // Statistics accumulated over all steps.
+  EmbeddingCacheAccumulatedStatisticsInfo accumulated_statistics_info_;
+  // The eviction policy of device cache and local host cache.
+  CacheEvictionPolicyType eviction_policy_type_{CacheEvictionPolicyType::kClock};
+  // The bytes of the embeddings of all tables on a cache index, which are swapped together.
+  size_t embedding_row_bytes_{0};
 
   // Model parallelism is used between multiple workers, and local_embedding_slice_bounds_ records the feature range
   // corresponding to the embedding table slice of the process.
@@ -337,6 +403,22 @@ class EmbeddingCachePrefetchActor : public ActorBase {
 
   // Record latest error information user related.
   std::string error_info_{""};
+
+  // The max number of batches which are parsed but not updated in the pipelined mode, 0 means the serial mode.
+  size_t prefetch_lookahead_{0};
+  // The swap information buffers, there is only one buffer in the serial mode.
+  std::vector<std::unique_ptr<EmbeddingCacheSwapInfo>> swap_infos_;
+  // The swap information is passed between the stages: parse ids -> remote stage -> device stage -> free.
+  EmbeddingCachePrefetchPipeline prefetch_pipeline_;
+  // The flag which indicates whether this actor is being finalized normally, the graph step waiting for the cache
+  // updating returns quietly then.
+  std::atomic_bool finalizing_{false};
+  // The latest data step which has been parsed and the latest data step whose caches have been updated.
+  size_t parsed_data_step_{0};
+  size_t updated_data_step_{0};
+  // The condition variable to notify the graph step waiting for the cache updating of its batch.
+  std::condition_variable update_finished_;
+  std::mutex update_mutex_;
 };
 
 // RpcOperator is used to do rpc with other processes in distributed execution.
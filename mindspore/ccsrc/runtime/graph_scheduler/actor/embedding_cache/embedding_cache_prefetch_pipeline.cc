@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_pipeline.h"
+
+namespace mindspore {
+namespace runtime {
+void EmbeddingCacheSwapInfoQueue::Push(EmbeddingCacheSwapInfo *swap_info) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  queue_.push(swap_info);
+  cond_var_.notify_one();
+}
+
+EmbeddingCacheSwapInfo *EmbeddingCacheSwapInfoQueue::Pop() {
+  std::unique_lock<std::mutex> locker(mutex_);
+  cond_var_.wait(locker, [this] { return !queue_.empty() || closed_; });
+  if (closed_) {
+    return nullptr;
+  }
+  auto swap_info = queue_.front();
+  queue_.pop();
+  return swap_info;
+}
+
+void EmbeddingCacheSwapInfoQueue::Close() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  closed_ = true;
+  cond_var_.notify_all();
+}
+
+void EmbeddingCacheSwapInfoQueue::Reset() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  std::queue<EmbeddingCacheSwapInfo *>().swap(queue_);
+  closed_ = false;
+}
+
+void EmbeddingCachePrefetchPipeline::Start(const std::vector<EmbeddingCacheSwapInfo *> &buffers,
+                                           const StageFunc &remote_stage, const StageFunc &device_stage,
+                                           const InitFunc &device_stage_init) {
+  std::lock_guard<std::mutex> locker(threads_mutex_);
+  if (remote_stage_thread_.joinable() || device_stage_thread_.joinable()) {
+    return;
+  }
+  free_queue_.Reset();
+  remote_stage_queue_.Reset();
+  device_stage_queue_.Reset();
+  for (auto swap_info : buffers) {
+    free_queue_.Push(swap_info);
+  }
+  remote_stage_thread_ = std::thread(&EmbeddingCachePrefetchPipeline::StageRun, this, &remote_stage_queue_,
+                                     &device_stage_queue_, remote_stage, nullptr);
+  device_stage_thread_ = std::thread(&EmbeddingCachePrefetchPipeline::StageRun, this, &device_stage_queue_,
+                                     &free_queue_, device_stage, device_stage_init);
+}
+
+void EmbeddingCachePrefetchPipeline::Close() {
+  free_queue_.Close();
+  remote_stage_queue_.Close();
+  device_stage_queue_.Close();
+}
+
+void EmbeddingCachePrefetchPipeline::Stop() {
+  Close();
+  std::lock_guard<std::mutex> locker(threads_mutex_);
+  if (remote_stage_thread_.joinable()) {
+    remote_stage_thread_.join();
+  }
+  if (device_stage_thread_.joinable()) {
+    device_stage_thread_.join();
+  }
+}
+
+void EmbeddingCachePrefetchPipeline::StageRun(EmbeddingCacheSwapInfoQueue *input, EmbeddingCacheSwapInfoQueue *output,
+                                              const StageFunc &stage, const InitFunc &init) {
+  if (init != nullptr && !init()) {
+    Close();
+    return;
+  }
+  while (true) {
+    auto swap_info = input->Pop();
+    if (swap_info == nullptr) {
+      return;
+    }
+    if (!stage(swap_info)) {
+      Close();
+      return;
+    }
+    output->Push(swap_info);
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
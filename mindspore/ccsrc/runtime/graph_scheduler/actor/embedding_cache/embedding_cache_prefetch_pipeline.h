@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_EMBEDDING_CACHE_EMBEDDING_CACHE_PREFETCH_PIPELINE_H_
+#define MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_EMBEDDING_CACHE_EMBEDDING_CACHE_PREFETCH_PIPELINE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace runtime {
+struct EmbeddingCacheSwapInfo;
+
+// The blocking queue which passes the swap information between the stages of pipelined cache prefetching.
+class EmbeddingCacheSwapInfoQueue {
+ public:
+  EmbeddingCacheSwapInfoQueue() = default;
+  ~EmbeddingCacheSwapInfoQueue() = default;
+
+  void Push(EmbeddingCacheSwapInfo *swap_info);
+  // Block until there is swap information in the queue, return nullptr if the queue is closed.
+  EmbeddingCacheSwapInfo *Pop();
+  // Close the queue and wake up all the waiting threads.
+  void Close();
+  // Drop the swap information left in the queue and open it again.
+  void Reset();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  std::queue<EmbeddingCacheSwapInfo *> queue_;
+  bool closed_{false};
+};
+
+// The stage threads of pipelined cache prefetching. The swap information of a parsed batch is submitted to the remote
+// stage, which swaps the embeddings between the local host cache and remote, then passes it to the device stage, which
+// swaps the embeddings between the device cache and the local host cache, then returns it to the free buffers.
+class EmbeddingCachePrefetchPipeline {
+ public:
+  // The stage function returns false if the stage failed, the stage thread exits after closing the pipeline then.
+  using StageFunc = std::function<bool(EmbeddingCacheSwapInfo *)>;
+  // The init function runs at the beginning of the device stage thread, e.g. to bind the device to the thread.
+  using InitFunc = std::function<bool()>;
+
+  EmbeddingCachePrefetchPipeline() = default;
+  ~EmbeddingCachePrefetchPipeline() { Stop(); }
+
+  // Fill the free buffers and start the stage threads.
+  void Start(const std::vector<EmbeddingCacheSwapInfo *> &buffers, const StageFunc &remote_stage,
+             const StageFunc &device_stage, const InitFunc &device_stage_init = nullptr);
+  // Block until there is a free buffer, return nullptr if the pipeline is closed.
+  EmbeddingCacheSwapInfo *AcquireFreeBuffer() { return free_queue_.Pop(); }
+  // Submit the swap information of a parsed batch to the remote stage.
+  void Submit(EmbeddingCacheSwapInfo *swap_info) { remote_stage_queue_.Push(swap_info); }
+  // Close all the queues and wake up the waiting threads without joining the stage threads, so it is safe to call from
+  // a stage thread. The batches which are not finished by the stages are dropped.
+  void Close();
+  // Close the pipeline and join the stage threads. It is idempotent and may be called from several threads.
+  void Stop();
+
+ private:
+  void StageRun(EmbeddingCacheSwapInfoQueue *input, EmbeddingCacheSwapInfoQueue *output, const StageFunc &stage,
+                const InitFunc &init);
+
+  EmbeddingCacheSwapInfoQueue free_queue_;
+  EmbeddingCacheSwapInfoQueue remote_stage_queue_;
+  EmbeddingCacheSwapInfoQueue device_stage_queue_;
+  std::thread remote_stage_thread_;
+  std::thread device_stage_thread_;
+  // Serialize the starting and stopping, which may be called by the prefetch thread and the finalizing thread.
+  std::mutex threads_mutex_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_EMBEDDING_CACHE_EMBEDDING_CACHE_PREFETCH_PIPELINE_H_
@@ -39,12 +39,14 @@ void ActorWorker::RunWithSpin() {
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
+      OnTaskFound();
       spin_count_ = 0;
     } else {
       YieldAndDeactive();
     }
-    if (spin_count_ > max_spin_count_) {
+    if (spin_count_ > max_spin_count_ || SpinBudgetExhausted()) {
       WaitUntilActive();
+      OnParkEnd();
       spin_count_ = 1;
     }
   }
@@ -72,7 +74,7 @@ bool ActorWorker::ActorActive() {
     active_num_++;
     status_ = kThreadBusy;
   }
-  cond_var_.notify_one();
+  Wake();
   return true;
 }
 
@@ -241,6 +241,26 @@ float CoreAffinity::GetServerFrequency() {
   return max_freq;  // MHz
 }
 
+int CoreAffinity::GetCorePackageId(int core_id) {
+  int package_id = -1;
+#if !defined(_WIN32) && !defined(__APPLE__)
+  if (core_id < 0) {
+    return package_id;
+  }
+  std::string file = "/sys/devices/system/cpu/cpu" + std::to_string(core_id) + "/topology/physical_package_id";
+  FILE *fp = fopen(file.c_str(), "rb");
+  if (fp == nullptr) {
+    THREAD_INFO("open %s failed", file.c_str());
+    return package_id;
+  }
+  if (fscanf(fp, "%d", &package_id) != 1) {
+    package_id = -1;
+  }
+  (void)fclose(fp);
+#endif
+  return package_id;
+}
+
 #ifdef _WIN32
 void SetWindowsAffinity(HANDLE thread, DWORD_PTR mask) {
   THREAD_INFO("Bind thread[%ld] to core[%lld].", GetThreadId(thread), mask);
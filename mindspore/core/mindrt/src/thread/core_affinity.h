@@ -59,6 +59,8 @@ class CoreAffinity {
   std::vector<int> GetCoreId(size_t thread_num, BindMode bind_mode) const;
   void SetCoreId(const std::vector<int> &core_list);
   static float GetServerFrequency();
+  // get the physical package id of the core, return -1 if unknown
+  static int GetCorePackageId(int core_id);
 
  private:
 #ifdef _WIN32
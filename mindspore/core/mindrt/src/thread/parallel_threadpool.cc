@@ -51,8 +51,8 @@ void ParallelWorker::Run() {
 }
 
 void ParallelWorker::WaitUntilActive() {
-  std::unique_lock<std::mutex> _l(mutex_);
-  cond_var_.wait(_l, [&] { return active_num_ > 0 || !alive_; });
+  ParkUntil([this] { return active_num_ > 0 || !alive_; });
+  std::lock_guard<std::mutex> _l(mutex_);
   if (active_num_ > 0) {
     active_num_--;
   }
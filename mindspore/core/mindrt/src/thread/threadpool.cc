@@ -17,18 +17,41 @@
 #include <sched.h>
 #include <unistd.h>
 #endif
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <climits>
+#define THREAD_USE_FUTEX
+#endif
 #include "thread/threadpool.h"
 #include "thread/core_affinity.h"
 
 namespace mindspore {
 std::mutex ThreadPool::create_thread_pool_muntex_;
 
+namespace {
+#ifdef THREAD_USE_FUTEX
+void FutexWait(std::atomic<uint32_t> *addr, uint32_t expected) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t> *addr, int count) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#endif
+
+uint64_t ElapsedUs(const std::chrono::steady_clock::time_point &start) {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+}  // namespace
+
 Worker::~Worker() {
   {
     std::lock_guard<std::mutex> _l(mutex_);
     alive_ = false;
   }
-  cond_var_.notify_one();
+  Wake();
 
   bool terminate = false;
   int count = 0;
@@ -43,8 +66,17 @@ Worker::~Worker() {
   if (thread_.joinable()) {
     thread_.join();
   }
+  // the remaining tasks in the steal queue can only be run after the owner thread exits
+  if (steal_task_queue_ != nullptr) {
+    auto task_split = steal_task_queue_->Pop();
+    while (task_split != nullptr) {
+      (void)TryRunTask(task_split);
+      task_split = steal_task_queue_->Pop();
+    }
+  }
   pool_ = nullptr;
   local_task_queue_ = nullptr;
+  steal_task_queue_ = nullptr;
 }
 
 void Worker::CreateThread() { thread_ = std::thread(&Worker::Run, this); }
@@ -101,14 +133,16 @@ void Worker::Run() {
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
   while (alive_) {
-    if (RunLocalKernelTask()) {
+    if (RunLocalKernelTask() || StealKernelTask()) {
+      OnTaskFound();
       spin_count_ = 0;
     } else {
       RunOtherKernelTask();
       YieldAndDeactive();
     }
-    if (spin_count_ > max_spin_count_) {
+    if (spin_count_ > max_spin_count_ || SpinBudgetExhausted()) {
       WaitUntilActive();
+      OnParkEnd();
       spin_count_ = 1;
     }
   }
@@ -126,6 +160,9 @@ bool Worker::TryRunTask(TaskSplit *task_split) {
 }
 
 bool Worker::RunLocalKernelTask() {
+  if (steal_task_queue_ != nullptr) {
+    return RunStealableKernelTask();
+  }
   bool res = false;
   Task *task = task_.load(std::memory_order_consume);
   if (task != nullptr) {
@@ -143,6 +180,49 @@ bool Worker::RunLocalKernelTask() {
   return res;
 }
 
+bool Worker::RunStealableKernelTask() {
+  bool res = false;
+  while (true) {
+    // move the assigned tasks into the steal queue so that the idle workers can share them
+    while (!local_task_queue_->Empty()) {
+      auto task_split = local_task_queue_->Dequeue();
+      if (task_split == nullptr) {
+        break;
+      }
+      if (!steal_task_queue_->Push(task_split)) {
+        res |= TryRunTask(task_split);
+      }
+    }
+    auto task_split = steal_task_queue_->Pop();
+    if (task_split == nullptr) {
+      break;
+    }
+    res |= TryRunTask(task_split);
+  }
+  return res;
+}
+
+bool Worker::StealKernelTask() {
+  if (steal_task_queue_ == nullptr || victim_queues_.empty()) {
+    return false;
+  }
+  // start from the last successful victim to reduce the contention of the thieves
+  size_t victim_num = victim_queues_.size();
+  for (size_t i = 0; i < victim_num; ++i) {
+    size_t index = (steal_index_ + i) % victim_num;
+    auto task_split = victim_queues_[index]->Steal();
+    if (task_split != nullptr) {
+      steal_index_ = index;
+      auto start = std::chrono::steady_clock::now();
+      bool res = TryRunTask(task_split);
+      (void)steal_count_.fetch_add(1, std::memory_order_relaxed);
+      (void)steal_time_us_.fetch_add(ElapsedUs(start), std::memory_order_relaxed);
+      return res;
+    }
+  }
+  return false;
+}
+
 void Worker::RunOtherKernelTask() {
   if (pool_ == nullptr || pool_->actor_thread_num() <= kMinActorRunOther) {
     return;
@@ -163,30 +243,127 @@ void Worker::YieldAndDeactive() {
   // deactivate this worker only on the first entry
   if (spin_count_ == 0) {
     std::lock_guard<std::mutex> _l(mutex_);
-    if (local_task_queue_->Empty()) {
+    if (local_task_queue_->Empty() && (steal_task_queue_ == nullptr || steal_task_queue_->Empty())) {
       status_.store(kThreadIdle);
     } else {
       return;
     }
+    idle_start_ = std::chrono::steady_clock::now();
   }
   spin_count_++;
+  (void)spin_total_.fetch_add(1, std::memory_order_relaxed);
   std::this_thread::yield();
 }
 
 void Worker::WaitUntilActive() {
-  std::unique_lock<std::mutex> _l(mutex_);
-  cond_var_.wait(_l, [&] { return status_ == kThreadBusy || active_num_ > 0 || !alive_; });
+  ParkUntil([this] { return status_ == kThreadBusy || active_num_ > 0 || !alive_; });
+  std::lock_guard<std::mutex> _l(mutex_);
   if (active_num_ > 0) {
     active_num_--;
   }
 }
 
+void Worker::ParkUntil(const std::function<bool()> &pred) {
+  (void)park_count_.fetch_add(1, std::memory_order_relaxed);
+#ifdef THREAD_USE_FUTEX
+  parked_.store(true);
+  while (true) {
+    uint32_t seq = wake_seq_.load();
+    if (pred()) {
+      break;
+    }
+    FutexWait(&wake_seq_, seq);
+  }
+  parked_.store(false);
+#else
+  std::unique_lock<std::mutex> _l(mutex_);
+  cond_var_.wait(_l, pred);
+#endif
+}
+
+void Worker::Wake() {
+#ifdef THREAD_USE_FUTEX
+  // the waker must change the state before bumping the sequence, so that the parked thread either observes
+  // the new state or fails to wait on the stale sequence
+  (void)wake_seq_.fetch_add(1);
+  if (parked_.load()) {
+    (void)wakeup_count_.fetch_add(1, std::memory_order_relaxed);
+    FutexWake(&wake_seq_, 1);
+  }
+#else
+  (void)wakeup_count_.fetch_add(1, std::memory_order_relaxed);
+  cond_var_.notify_one();
+#endif
+}
+
+void Worker::OnTaskFound() {
+  if (spin_count_ == 0) {
+    return;
+  }
+  // the worker has been idle since the first YieldAndDeactive
+  int64_t idle_us = parked_idle_us_ + static_cast<int64_t>(ElapsedUs(idle_start_));
+  parked_idle_us_ = 0;
+  (void)idle_time_us_.fetch_add(static_cast<uint64_t>(idle_us), std::memory_order_relaxed);
+  int64_t idle_ewma_us = idle_ewma_us_.load(std::memory_order_relaxed);
+  idle_ewma_us += (idle_us - idle_ewma_us) / kIdleEwmaWeight;
+  idle_ewma_us_.store(idle_ewma_us, std::memory_order_relaxed);
+  int64_t budget = kMinAdaptiveSpinTimeUs;
+  if (idle_ewma_us <= kMaxAdaptiveSpinTimeUs) {
+    // the next task is likely to come soon, spin a little longer than the expected idle duration
+    budget = idle_ewma_us * kAdaptiveSpinTimeScale;
+    budget = budget < kMinAdaptiveSpinTimeUs ? kMinAdaptiveSpinTimeUs : budget;
+    budget = budget > kMaxAdaptiveSpinTimeUs ? kMaxAdaptiveSpinTimeUs : budget;
+  }
+  spin_budget_us_.store(budget, std::memory_order_relaxed);
+}
+
+void Worker::OnParkEnd() {
+  // keep the idle duration before the park, and restart the spin clock so that the worker spins for its full budget
+  // again instead of parking at once if it is woken up without a task
+  parked_idle_us_ += static_cast<int64_t>(ElapsedUs(idle_start_));
+  idle_start_ = std::chrono::steady_clock::now();
+}
+
+bool Worker::SpinBudgetExhausted() {
+  // only check the clock every kSpinClockInterval spins after the worker becomes idle
+  if (!adaptive_spin_.load(std::memory_order_relaxed) || spin_count_ == 0 || spin_count_ % kSpinClockInterval != 0) {
+    return false;
+  }
+  return static_cast<int64_t>(ElapsedUs(idle_start_)) > spin_budget_us_.load(std::memory_order_relaxed);
+}
+
+WorkerStats Worker::stats() const {
+  WorkerStats stats;
+  stats.spin_count = spin_total_.load(std::memory_order_relaxed);
+  stats.park_count = park_count_.load(std::memory_order_relaxed);
+  stats.wakeup_count = wakeup_count_.load(std::memory_order_relaxed);
+  stats.steal_count = steal_count_.load(std::memory_order_relaxed);
+  stats.idle_time_us = idle_time_us_.load(std::memory_order_relaxed);
+  stats.steal_time_us = steal_time_us_.load(std::memory_order_relaxed);
+  stats.idle_ewma_us = idle_ewma_us_.load(std::memory_order_relaxed);
+  stats.spin_budget_us = spin_budget_us_.load(std::memory_order_relaxed);
+  return stats;
+}
+
 void Worker::set_scale(float lhs_scale, float rhs_scale) {
   lhs_scale_ = lhs_scale;
   rhs_scale_ = rhs_scale;
 }
 
 void Worker::Active(std::vector<TaskSplit> *task_list, int task_id_start, int task_id_end) {
+  if (steal_task_queue_ != nullptr) {
+    // all tasks go through the queue, and the worker will make them stealable after waking up
+    {
+      std::lock_guard<std::mutex> _l(mutex_);
+      status_ = kThreadBusy;
+      for (int i = task_id_start; i < task_id_end; ++i) {
+        while (!local_task_queue_->Enqueue(&(*task_list)[i])) {
+        }
+      }
+    }
+    Wake();
+    return;
+  }
   {
     std::lock_guard<std::mutex> _l(mutex_);
     // add the first to task_, and others to queue.
@@ -200,7 +377,7 @@ void Worker::Active(std::vector<TaskSplit> *task_list, int task_id_start, int ta
     }
     status_ = kThreadBusy;
   }
-  cond_var_.notify_one();
+  Wake();
 }
 
 void Worker::Active() {
@@ -212,13 +389,13 @@ void Worker::Active() {
     active_num_++;
     status_ = kThreadBusy;
   }
-  cond_var_.notify_one();
+  Wake();
 }
 
 void Worker::FastActive() {
   if (active_num_ == 0) {
     active_num_++;
-    cond_var_.notify_one();
+    Wake();
   }
 }
 
@@ -243,6 +420,10 @@ ThreadPool::~ThreadPool() {
     task_queue->Clean();
   }
   task_queues_.clear();
+  for (auto &steal_queue : steal_task_queues_) {
+    steal_queue->Clean();
+  }
+  steal_task_queues_.clear();
   THREAD_INFO("destruct success");
 }
 
@@ -256,6 +437,16 @@ int ThreadPool::TaskQueuesInit(size_t thread_num) {
       return THREAD_ERROR;
     }
   }
+  if (work_stealing_) {
+    for (size_t i = 0; i < thread_num; ++i) {
+      auto steal_queue = std::make_unique<WorkStealQueue<TaskSplit>>();
+      if (steal_queue->Init(kMaxHqueueSize) != true) {
+        THREAD_ERROR("init steal task queue failed.");
+        return THREAD_ERROR;
+      }
+      (void)steal_task_queues_.emplace_back(std::move(steal_queue));
+    }
+  }
   THREAD_ERROR("init task queues success.");
   return THREAD_OK;
 }
@@ -280,7 +471,11 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
   // wait until the finished is equal to task_num
   while (task.finished != task_num) {
     if (curr != nullptr) {
-      (void)curr->RunLocalKernelTask();
+      if (curr->RunLocalKernelTask() || curr->StealKernelTask()) {
+        continue;
+      }
+    } else if (work_stealing_ && StealTask()) {
+      continue;
     }
     std::this_thread::yield();
   }
@@ -409,6 +604,44 @@ Worker *ThreadPool::CurrentWorker(size_t *index) const {
   return nullptr;
 }
 
+std::vector<WorkStealQueue<TaskSplit> *> ThreadPool::GetVictimQueues(size_t index,
+                                                                     const std::vector<int> &core_list) const {
+  std::vector<WorkStealQueue<TaskSplit> *> near_victims;
+  std::vector<WorkStealQueue<TaskSplit> *> far_victims;
+  size_t queue_num = steal_task_queues_.size();
+  if (index >= queue_num) {
+    return near_victims;
+  }
+  // the worker with index i is bound to core_list[i % core_list.size()]
+  auto package_id = [&core_list](size_t i) {
+    return core_list.empty() ? -1 : CoreAffinity::GetCorePackageId(core_list[i % core_list.size()]);
+  };
+  int self_package = package_id(index);
+  for (size_t i = 1; i < queue_num; ++i) {
+    size_t victim = (index + i) % queue_num;
+    if (self_package == package_id(victim)) {
+      near_victims.push_back(steal_task_queues_[victim].get());
+    } else {
+      far_victims.push_back(steal_task_queues_[victim].get());
+    }
+  }
+  (void)near_victims.insert(near_victims.end(), far_victims.begin(), far_victims.end());
+  return near_victims;
+}
+
+bool ThreadPool::StealTask() const {
+  for (const auto &steal_queue : steal_task_queues_) {
+    auto task_split = steal_queue->Steal();
+    if (task_split != nullptr) {
+      auto task = task_split->task_;
+      task->status |= task->func(task->content, task_split->task_id_, 0, kMaxScale);
+      (void)++task->finished;
+      return true;
+    }
+  }
+  return false;
+}
+
 Worker *ThreadPool::CurrentWorker() const {
   for (const auto &worker : workers_) {
     if (worker->thread_id() == std::this_thread::get_id()) {
@@ -502,12 +735,30 @@ void ThreadPool::SetMinSpinCount(int spin_count) {
   min_spin_count_ = spin_count;
 }
 
-ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, const std::vector<int> &core_list) {
+void ThreadPool::SetAdaptiveSpin(bool adaptive_spin) {
+  for (auto worker : workers_) {
+    THREAD_RETURN_IF_NULL(worker);
+    worker->SetAdaptiveSpin(adaptive_spin);
+  }
+}
+
+std::vector<WorkerStats> ThreadPool::GetWorkerStats() const {
+  std::vector<WorkerStats> stats;
+  for (auto worker : workers_) {
+    if (worker != nullptr) {
+      stats.push_back(worker->stats());
+    }
+  }
+  return stats;
+}
+
+ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, const std::vector<int> &core_list, bool work_stealing) {
   std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
   ThreadPool *pool = new (std::nothrow) ThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->work_stealing_ = work_stealing;
   if (pool->TaskQueuesInit(thread_num) != THREAD_OK) {
     delete pool;
     return nullptr;
@@ -27,6 +27,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <functional>
+#include <chrono>
 #include "thread/threadlog.h"
 #include "thread/core_affinity.h"
 #ifndef _WIN32
@@ -37,6 +38,7 @@
 #endif
 #include "utils/macros.h"
 #include "thread/hqueue.h"
+#include "thread/work_steal_queue.h"
 
 #define USE_HQUEUE
 namespace mindspore {
@@ -48,6 +50,12 @@ constexpr int kDefaultFrequency = 1;
 constexpr float kMaxScale = 1.;
 constexpr size_t kMaxHqueueSize = 8192;
 constexpr size_t kMinActorRunOther = 2;
+// the adaptive spin budget is learned from the ewma of the idle duration between two tasks
+constexpr int64_t kMinAdaptiveSpinTimeUs = 20;
+constexpr int64_t kMaxAdaptiveSpinTimeUs = 2000;
+constexpr int64_t kAdaptiveSpinTimeScale = 2;
+constexpr int64_t kIdleEwmaWeight = 8;  // the weight of a new sample is 1/8
+constexpr int kSpinClockInterval = 64;
 /* Thread status */
 constexpr int kThreadBusy = 0;  // busy, the thread is running task
 constexpr int kThreadHeld = 1;  // held, the thread has been marked as occupied
@@ -74,6 +82,17 @@ typedef struct TaskSplit {
   int task_id_;
 } TaskSplit;
 
+typedef struct WorkerStats {
+  uint64_t spin_count = 0;     // times of yielding while waiting for tasks
+  uint64_t park_count = 0;     // times of parking the thread
+  uint64_t wakeup_count = 0;   // times of waking up the parked thread by the futex or the condition variable
+  uint64_t steal_count = 0;    // number of tasks stolen from the other workers
+  uint64_t idle_time_us = 0;   // time between running out of tasks and receiving the next one
+  uint64_t steal_time_us = 0;  // time spent on running the stolen tasks
+  int64_t idle_ewma_us = 0;    // ewma of the idle duration
+  int64_t spin_budget_us = 0;  // current adaptive spin budget
+} WorkerStats;
+
 class ThreadPool;
 class Worker {
  public:
@@ -92,12 +111,22 @@ class Worker {
   // assigns task first before running
   virtual bool RunLocalKernelTask();
   virtual void RunOtherKernelTask();
+  // try to steal a single task from the other workers, only used in work stealing mode
+  bool StealKernelTask();
   // try to run a single task
   bool TryRunTask(TaskSplit *task_split);
   // set max spin count before running
   void SetMaxSpinCount(int max_spin_count) { max_spin_count_ = max_spin_count; }
+  // learn the spin budget from the idle duration, bounded by the max spin count
+  void SetAdaptiveSpin(bool adaptive_spin) { adaptive_spin_ = adaptive_spin; }
+  WorkerStats stats() const;
   void InitWorkerMask(const std::vector<int> &core_list, const size_t workers_size);
   void InitLocalTaskQueue(HQueue<TaskSplit> *task_queue) { local_task_queue_ = task_queue; }
+  void InitStealTaskQueue(WorkStealQueue<TaskSplit> *steal_queue,
+                          const std::vector<WorkStealQueue<TaskSplit> *> &victim_queues) {
+    steal_task_queue_ = steal_queue;
+    victim_queues_ = victim_queues;
+  }
 
   void set_frequency(int frequency) { frequency_ = frequency; }
   int frequency() const { return frequency_; }
@@ -106,6 +135,7 @@ class Worker {
   float lhs_scale() const { return lhs_scale_; }
   float rhs_scale() const { return rhs_scale_; }
   HQueue<TaskSplit> *local_task_queue() { return local_task_queue_; }
+  WorkStealQueue<TaskSplit> *steal_task_queue() { return steal_task_queue_; }
 
   std::thread::id thread_id() const { return thread_.get_id(); }
 
@@ -123,6 +153,16 @@ class Worker {
   void Run();
   void YieldAndDeactive();
   virtual void WaitUntilActive();
+  bool RunStealableKernelTask();
+  // park the thread until the predicate is true, using futex on linux and condition variable otherwise
+  void ParkUntil(const std::function<bool()> &pred);
+  // wake up the parked thread after the state checked by the predicate is changed
+  void Wake();
+  // update the idle statistics and the adaptive spin budget when a task is found after idling
+  void OnTaskFound();
+  // restart the spin clock after a park
+  void OnParkEnd();
+  bool SpinBudgetExhausted();
 
   bool alive_{true};
   std::thread thread_;
@@ -136,6 +176,8 @@ class Worker {
 
   std::mutex mutex_;
   std::condition_variable cond_var_;
+  std::atomic<uint32_t> wake_seq_{0};
+  std::atomic_bool parked_{false};
 
   std::atomic<Task *> task_{nullptr};
   std::atomic_int task_id_{0};
@@ -144,18 +186,38 @@ class Worker {
   int frequency_{kDefaultFrequency};
   int spin_count_{0};
   int max_spin_count_{kMinSpinCount};
+  std::atomic_bool adaptive_spin_{false};
+  std::chrono::steady_clock::time_point idle_start_;
+  // the idle duration before the latest parks, which is folded into the next idle duration
+  int64_t parked_idle_us_{0};
+  std::atomic<int64_t> idle_ewma_us_{0};
+  std::atomic<int64_t> spin_budget_us_{kMaxAdaptiveSpinTimeUs};
+  // statistics, only wakeup_count_ is updated by the other threads
+  std::atomic<uint64_t> spin_total_{0};
+  std::atomic<uint64_t> park_count_{0};
+  std::atomic<uint64_t> wakeup_count_{0};
+  std::atomic<uint64_t> steal_count_{0};
+  std::atomic<uint64_t> idle_time_us_{0};
+  std::atomic<uint64_t> steal_time_us_{0};
   ThreadPool *pool_{nullptr};
   HQueue<TaskSplit> *local_task_queue_;
+  // in work stealing mode, the tasks received by local_task_queue_ are moved into steal_task_queue_,
+  // and the idle workers steal tasks from the steal_task_queue_ of others in the order of victim_queues_
+  WorkStealQueue<TaskSplit> *steal_task_queue_{nullptr};
+  std::vector<WorkStealQueue<TaskSplit> *> victim_queues_;
+  size_t steal_index_{0};
   size_t worker_id_{0};
 };
 
 class MS_CORE_API ThreadPool {
  public:
-  static ThreadPool *CreateThreadPool(size_t thread_num, const std::vector<int> &core_list = {});
+  static ThreadPool *CreateThreadPool(size_t thread_num, const std::vector<int> &core_list = {},
+                                      bool work_stealing = false);
   virtual ~ThreadPool();
 
   size_t thread_num() const { return workers_.size(); }
   const std::vector<std::unique_ptr<HQueue<TaskSplit>>> &task_queues() { return task_queues_; }
+  bool work_stealing() const { return work_stealing_; }
 
   int SetCpuAffinity(const std::vector<int> &core_list);
   int SetCpuAffinity(BindMode bind_mode);
@@ -174,6 +236,10 @@ class MS_CORE_API ThreadPool {
   void SetSpinCountMinValue();
   void SetMaxSpinCount(int spin_count);
   void SetMinSpinCount(int spin_count);
+  // enable the adaptive spin policy of all workers
+  void SetAdaptiveSpin(bool adaptive_spin);
+  // query the contention telemetry of each worker
+  std::vector<WorkerStats> GetWorkerStats() const;
   void ActiveWorkers();
   void SetWorkerIdMap();
   // init task queues
@@ -202,6 +268,9 @@ class MS_CORE_API ThreadPool {
         return THREAD_ERROR;
       }
       worker->InitLocalTaskQueue(task_queues_[queues_idx].get());
+      if (work_stealing_) {
+        worker->InitStealTaskQueue(steal_task_queues_[queues_idx].get(), GetVictimQueues(queues_idx, core_list));
+      }
       workers_.push_back(worker);
     }
     for (size_t i = 0; i < thread_num; ++i) {
@@ -224,14 +293,20 @@ class MS_CORE_API ThreadPool {
   Worker *CurrentWorker(size_t *index) const;
   Worker *CurrentWorker() const;
 
+  // the victims on the same cpu package (NUMA node) as the thief are visited first
+  std::vector<WorkStealQueue<TaskSplit> *> GetVictimQueues(size_t index, const std::vector<int> &core_list) const;
+  bool StealTask() const;
+
   std::mutex pool_mutex_;
   std::vector<Worker *> workers_;
   std::vector<std::unique_ptr<HQueue<TaskSplit>>> task_queues_;
+  std::vector<std::unique_ptr<WorkStealQueue<TaskSplit>>> steal_task_queues_;
   std::unordered_map<std::thread::id, size_t> worker_ids_;
   CoreAffinity *affinity_{nullptr};
   size_t actor_thread_num_{0};
   size_t kernel_thread_num_{0};
   bool occupied_actor_thread_{true};
+  bool work_stealing_{false};
   int max_spin_count_{kDefaultSpinCount};
   int min_spin_count_{kMinSpinCount};
   float server_cpu_frequence = -1.0f;  // Unit : GHz
@@ -45,6 +45,11 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_autotune_interval', 'get_autotune_interval',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
+           'set_enable_tfrecord_crc_check', 'get_enable_tfrecord_crc_check',
+           'set_text_file_split_size', 'get_text_file_split_size',
+           'set_batch_buffer_ring_size', 'get_batch_buffer_ring_size',
+           'set_pin_batch_buffer', 'get_pin_batch_buffer',
+           'set_jpeg_dct_scaling', 'get_jpeg_dct_scaling',
            'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
 
 INT32_MAX = 2147483647
@@ -728,6 +733,187 @@ def get_enable_watchdog():
     return _config.get_enable_watchdog()
 
 
+def set_enable_tfrecord_crc_check(enable):
+    """
+    Set whether to verify the CRC of every record read by TFRecordDataset. The check is disabled by default,
+    in which case only the first record of each file is verified when the dataset is created.
+
+    Args:
+        enable (bool): Whether to verify the CRC of the length and the data of every record. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Verify the CRC of every record read from the TFRecord files.
+        >>> ds.config.set_enable_tfrecord_crc_check(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_tfrecord_crc_check(enable)
+
+
+def get_enable_tfrecord_crc_check():
+    """
+    Get whether the CRC of every record read by TFRecordDataset is verified.
+
+    Returns:
+        bool, whether the CRC of every TFRecord record is verified.
+
+    Examples:
+        >>> # Get the global configuration of the TFRecord CRC check.
+        >>> crc_check = ds.config.get_enable_tfrecord_crc_check()
+    """
+    return _config.get_enable_tfrecord_crc_check()
+
+
+def set_text_file_split_size(size):
+    """
+    Set the size (in bytes) of the pieces that the files of TextFileDataset and CSVDataset are split into.
+    Each piece of a file is read by its own worker, so that a single large file is read in parallel. The pieces
+    are cut at row boundaries found when the rows of the files are counted, and the rows of the pieces are
+    interleaved in the output, so the order of the rows differs from the order in the file. System default: 0,
+    which means files are not split.
+
+    Args:
+        size (int): The size of the pieces in bytes, 0 to read every file with a single worker.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0.
+
+    Examples:
+        >>> # Read large text files in pieces of 256MB.
+        >>> ds.config.set_text_file_split_size(256 * 1024 * 1024)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0:
+        raise ValueError("size should be greater than or equal to 0, but got: {}.".format(size))
+    _config.set_text_file_split_size(size)
+
+
+def get_text_file_split_size():
+    """
+    Get the size (in bytes) of the pieces that the files of TextFileDataset and CSVDataset are split into.
+
+    Returns:
+        int, the size of the pieces in bytes, 0 if files are not split.
+
+    Examples:
+        >>> split_size = ds.config.get_text_file_split_size()
+    """
+    return _config.get_text_file_split_size()
+
+
+def set_batch_buffer_ring_size(size):
+    """
+    Set the number of batch buffers each worker of a batch operation keeps for reuse. The batched numeric
+    columns are assembled in buffers owned by the worker, which get them back once the batches are consumed,
+    e.g., after they are sent to the device, and hand them out again to the next batches of the same size
+    instead of allocating new memory. System default: 0, which means batches are allocated from the global
+    memory pool.
+
+    Args:
+        size (int): The number of free buffers kept for each buffer size, 0 to disable the reuse.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0 or `size` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Keep up to 4 free buffers of each size in every batch worker.
+        >>> ds.config.set_batch_buffer_ring_size(4)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("size given is not within the required range [0, INT32_MAX(2147483647)].")
+    _config.set_batch_buffer_ring_size(size)
+
+
+def get_batch_buffer_ring_size():
+    """
+    Get the number of batch buffers each worker of a batch operation keeps for reuse.
+
+    Returns:
+        int, the number of free buffers kept for each buffer size, 0 if the reuse is disabled.
+
+    Examples:
+        >>> ring_size = ds.config.get_batch_buffer_ring_size()
+    """
+    return _config.get_batch_buffer_ring_size()
+
+
+def set_pin_batch_buffer(enable):
+    """
+    Set whether the batch buffers kept for reuse by the workers of a batch operation are page locked (pinned),
+    so that they stay in physical memory. It only takes effect when the ring size set by
+    :func:`mindspore.dataset.config.set_batch_buffer_ring_size` is greater than 0. If the memory can not be
+    locked, e.g., because of the limit of locked memory of the process, the buffers are used unpinned.
+
+    Args:
+        enable (bool): Whether to pin the batch buffers. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_pin_batch_buffer(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_pin_batch_buffer(enable)
+
+
+def get_pin_batch_buffer():
+    """
+    Get whether the batch buffers kept for reuse by the workers of a batch operation are page locked.
+
+    Returns:
+        bool, whether the batch buffers are pinned.
+
+    Examples:
+        >>> pin_batch_buffer = ds.config.get_pin_batch_buffer()
+    """
+    return _config.get_pin_batch_buffer()
+
+
+def set_jpeg_dct_scaling(enable):
+    """
+    Set whether :class:`mindspore.dataset.vision.RandomCropDecodeResize` decodes JPEG images at a reduced scale.
+    When enabled, the crop of a JPEG image is decoded at the smallest of the 1/8, 1/4, 1/2 and full scales of
+    libjpeg that is still at least as large as the output size, before it is resized. Decoding a high resolution
+    image this way costs several times less CPU, but the output is slightly different from the one of a full
+    resolution decode.
+
+    Args:
+        enable (bool): Whether to decode JPEG images at a reduced scale. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_jpeg_dct_scaling(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_jpeg_dct_scaling(enable)
+
+
+def get_jpeg_dct_scaling():
+    """
+    Get whether :class:`mindspore.dataset.vision.RandomCropDecodeResize` decodes JPEG images at a reduced scale.
+
+    Returns:
+        bool, whether JPEG images are decoded at a reduced scale.
+
+    Examples:
+        >>> jpeg_dct_scaling = ds.config.get_jpeg_dct_scaling()
+    """
+    return _config.get_jpeg_dct_scaling()
+
+
 def set_multiprocessing_timeout_interval(interval):
     """
     Set the default interval (in seconds) for multiprocessing/multithreading timeout when main process/thread gets
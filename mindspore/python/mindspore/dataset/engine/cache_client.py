@@ -39,6 +39,9 @@ class DatasetCache:
         num_connections (int, optional): Number of tcp/ip connections (default=None, use default value 12).
         prefetch_size (int, optional): The size of the cache queue between operations
             (default=None, use default value 20).
+        zero_copy_fetch (bool, optional): Whether or not the fetched rows refer to the shared memory of a cache server
+            on the same machine directly instead of a copy. The memory is given back to the server once the rows are
+            consumed (default=False).
 
     Examples:
             >>> import mindspore.dataset as ds
@@ -52,7 +55,7 @@ class DatasetCache:
     """
 
     def __init__(self, session_id, size=0, spilling=False, hostname=None, port=None, num_connections=None,
-                 prefetch_size=None):
+                 prefetch_size=None, zero_copy_fetch=False):
         check_pos_uint32(session_id, "session_id")
         type_check(size, (int,), "size")
         if size != 0:
@@ -68,6 +71,7 @@ class DatasetCache:
             check_pos_int32(num_connections, "num_connections")
         if prefetch_size is not None:
             check_pos_int32(prefetch_size, "prefetch_size")
+        type_check(zero_copy_fetch, (bool,), "zero_copy_fetch")
 
         self.session_id = session_id
         self.size = size
@@ -76,7 +80,9 @@ class DatasetCache:
         self.port = port
         self.prefetch_size = prefetch_size
         self.num_connections = num_connections
-        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size)
+        self.zero_copy_fetch = zero_copy_fetch
+        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size,
+                                        zero_copy_fetch)
 
     def get_stat(self):
         """Get the statistics from a cache."""
@@ -95,5 +101,6 @@ class DatasetCache:
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
         new_cache.num_connections = copy.deepcopy(self.num_connections, memodict)
+        new_cache.zero_copy_fetch = copy.deepcopy(self.zero_copy_fetch, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
@@ -920,12 +920,18 @@ class Dataset:
         Filter dataset by prediction.
 
         Args:
-            predicate (callable): Python callable which returns a boolean value. If False then filter the element.
+            predicate (Union[callable, transforms.Mask]): Python callable which returns a boolean value, or a
+                Mask on a single input column. If False then filter the element.
             input_columns (Union[str, list[str]], optional): List of names of the input columns. If not provided
                 or provided with None, the predicate will be applied on all columns in the dataset (default=None).
             num_parallel_workers (int, optional): Number of workers to process the dataset
                 in parallel (default=None).
 
+        Note:
+            A Python callable is opaque to the dataset pipeline. When the predicate is
+            `transforms.Mask(Relational.EQ, value)` on a single index field of a MindDataset, the MindDataset only
+            reads the rows whose field equals to `value`.
+
         Returns:
             Dataset, dataset filtered.
 
@@ -933,6 +939,10 @@ class Dataset:
             >>> # generator data(0 ~ 63)
             >>> # filter the data that greater than or equal to 11
             >>> dataset = dataset.filter(predicate=lambda data: data < 11, input_columns = ["data"])
+            >>>
+            >>> # keep the rows whose label is 3
+            >>> from mindspore.dataset.transforms import Relational
+            >>> dataset = dataset.filter(predicate=transforms.Mask(Relational.EQ, 3), input_columns=["label"])
         """
         return FilterDataset(self, predicate, input_columns, num_parallel_workers)
 
@@ -3433,7 +3443,8 @@ class FilterDataset(UnionBaseDataset):
 
     Args:
         input_dataset (Dataset): Input Dataset to be mapped.
-        predicate (callable): Python callable which returns a boolean value. If False then filter the element.
+        predicate (Union[callable, transforms.Mask]): Python callable which returns a boolean value, or a Mask on a
+            single input column. If False then filter the element.
         input_columns (Union[str, list[str]], optional): List of names of the input columns
         (default=None, the predicate will be applied to all columns in the dataset).
         num_parallel_workers (int, optional): Number of workers to process the dataset
@@ -3442,11 +3453,16 @@ class FilterDataset(UnionBaseDataset):
 
     def __init__(self, input_dataset, predicate, input_columns=None, num_parallel_workers=None):
         super().__init__(children=input_dataset, num_parallel_workers=num_parallel_workers)
-        self.predicate = lambda *args: bool(predicate(*args))
+        if isinstance(predicate, transforms.Mask):
+            # parsed into a C++ predicate, which can be pushed down into the reader
+            self.predicate = predicate
+        else:
+            self.predicate = lambda *args: bool(predicate(*args))
         self.input_columns = to_list(input_columns)
 
     def parse(self, children=None):
-        return cde.FilterNode(children[0], self.predicate, self.input_columns)
+        predicate = self.predicate.parse() if isinstance(self.predicate, transforms.Mask) else self.predicate
+        return cde.FilterNode(children[0], predicate, self.input_columns)
 
 
 class RepeatDataset(UnionBaseDataset):
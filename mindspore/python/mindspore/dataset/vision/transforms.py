@@ -1145,12 +1145,13 @@ class HWC2CHW(ImageTensorOperation):
     """
     Transpose the input image from shape (H, W, C) to (C, H, W).
     If the input image is of shape <H, W>, it will remain unchanged.
+    A batch of images of shape <..., H, W, C> is transposed to <..., C, H, W> in one pass.
 
     Note:
         This operation supports running on Ascend or GPU platforms by Offload.
 
     Raises:
-        RuntimeError: If shape of the input image is not <H, W> or <H, W, C>.
+        RuntimeError: If shape of the input image is not <H, W> or <..., H, W, C>.
 
     Supported Platforms:
         ``CPU``
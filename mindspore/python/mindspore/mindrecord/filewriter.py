@@ -102,6 +102,7 @@ class FileWriter:
         self._header = ShardHeader()
         self._writer = ShardWriter()
         self._generator = None
+        self._pipeline_capacity = None
 
     @classmethod
     def open_for_append(cls, file_name):
@@ -320,8 +321,39 @@ class FileWriter:
             if not isinstance(each_raw, dict):
                 raise ParamTypeError('raw_data item', 'dict')
         self._verify_based_on_schema(raw_data)
+        if self._pipeline_capacity is not None and not self._writer.is_pipeline_enabled:
+            self._writer.enable_pipeline(self._pipeline_capacity)
         return self._writer.write_raw_data(raw_data, True, parallel_writer)
 
+    def enable_pipeline(self, queue_capacity=4):
+        """
+        Write the raw data in a pipeline. `write_raw_data` returns once the raw data is queued, while it is \
+        validated, serialized and written to disk by background threads, so the next raw data can be prepared \
+        at the same time. An error of the background threads is raised by the following `write_raw_data` or `commit`.
+
+        Note:
+            It should be called before `write_raw_data`, and it can't be used with `parallel_writer`.
+
+        Args:
+            queue_capacity (int, optional): The max number of calls of `write_raw_data` queued before every stage
+                of the pipeline. Default: 4.
+
+        Raises:
+            ParamValueError: If `queue_capacity` is not a positive int.
+            RuntimeError: If the pipeline has been enabled or the MindRecord files have been committed.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.enable_pipeline()
+        """
+        if not isinstance(queue_capacity, int) or isinstance(queue_capacity, bool) or queue_capacity <= 0:
+            raise ParamValueError("Parameter queue_capacity: {} should be a positive int.".format(queue_capacity))
+        if self._writer.is_pipeline_enabled or self._flush:
+            raise RuntimeError("Unexpected error. The pipeline has been enabled or the MindRecord files have been "
+                               "committed.")
+        self._pipeline_capacity = queue_capacity
+
     def set_header_size(self, header_size):
         """
         Set the size of header which contains shard information, schema information, \
@@ -412,10 +444,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -35,6 +35,7 @@ class ShardWriter:
         self._writer = ms.ShardWriter()
         self._header = None
         self._is_open = False
+        self._is_pipeline_enabled = False
 
     def open(self, paths, override):
         """
@@ -137,6 +138,26 @@ class ShardWriter:
     def get_shard_header(self):
         return self._header
 
+    def enable_pipeline(self, queue_capacity):
+        """
+        Enable pipelined writing, the raw data is validated, serialized and written to disk by background threads.
+
+        Args:
+           queue_capacity (int): The max number of batches of raw data queued before every stage.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMWriteDatasetError: If failed to enable pipelined writing.
+        """
+        ret = self._writer.enable_pipeline(queue_capacity)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.critical("Failed to enable pipelined writing.")
+            raise MRMWriteDatasetError
+        self._is_pipeline_enabled = True
+        return ret
+
     @staticmethod
     def convert_np_types(val):
         """convert numpy type to python primitive type"""
@@ -228,3 +249,8 @@ class ShardWriter:
     def is_open(self):
         """getter function"""
         return self._is_open
+
+    @property
+    def is_pipeline_enabled(self):
+        """getter function"""
+        return self._is_pipeline_enabled
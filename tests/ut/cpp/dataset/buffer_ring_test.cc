@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/util/buffer_ring.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBufferRing : public UT::Common {
+ public:
+  MindDataTestBufferRing() {}
+
+  /// \brief Make a table of image like rows, the pixels of each row are derived from its index
+  static std::unique_ptr<TensorQTable> MakeImageTable(int32_t num_rows) {
+    auto table = std::make_unique<TensorQTable>();
+    for (int32_t i = 0; i < num_rows; ++i) {
+      std::shared_ptr<Tensor> image;
+      std::shared_ptr<Tensor> label;
+      EXPECT_OK(Tensor::CreateEmpty(TensorShape({224, 224, 3}), DataType(DataType::DE_UINT8), &image));
+      EXPECT_OK(image->Fill<uint8_t>(static_cast<uint8_t>(i)));
+      EXPECT_OK(Tensor::CreateScalar<int32_t>(i, &label));
+      table->emplace_back(TensorRow({image, label}));
+    }
+    return table;
+  }
+};
+
+/// Feature: BufferRing
+/// Description: Allocate and free buffers of a few sizes from a buffer ring with a capacity of 2
+/// Expectation: A freed buffer is handed out again for the same size, at most 2 buffers of a size are kept
+TEST_F(MindDataTestBufferRing, TestRecycle) {
+  auto ring = std::make_shared<BufferRing>(2, false);
+  void *p1 = nullptr;
+  void *p2 = nullptr;
+  void *p3 = nullptr;
+  ASSERT_OK(ring->Allocate(1024, &p1));
+  ASSERT_OK(ring->Allocate(1024, &p2));
+  ASSERT_OK(ring->Allocate(1024, &p3));
+  EXPECT_EQ(ring->NumSystemAllocations(), 3);
+  ring->Deallocate(p1);
+  ring->Deallocate(p2);
+  ring->Deallocate(p3);  // the ring is full, p3 goes back to the system
+
+  // A buffer of another size is not served from the ring
+  void *q = nullptr;
+  ASSERT_OK(ring->Allocate(512, &q));
+  EXPECT_EQ(ring->NumSystemAllocations(), 4);
+  EXPECT_EQ(ring->NumReusedAllocations(), 0);
+  ring->Deallocate(q);
+
+  void *r1 = nullptr;
+  void *r2 = nullptr;
+  void *r3 = nullptr;
+  ASSERT_OK(ring->Allocate(1024, &r1));
+  ASSERT_OK(ring->Allocate(1024, &r2));
+  ASSERT_OK(ring->Allocate(1024, &r3));
+  EXPECT_TRUE((r1 == p1 && r2 == p2) || (r1 == p2 && r2 == p1));
+  EXPECT_EQ(ring->NumReusedAllocations(), 2);
+  EXPECT_EQ(ring->NumSystemAllocations(), 5);
+  ring->Deallocate(r1);
+  ring->Deallocate(r2);
+  ring->Deallocate(r3);
+}
+
+/// Feature: BufferRing
+/// Description: Allocate pinned buffers of sizes below, at and above a page, write them whole and recycle them
+/// Expectation: Every pinned buffer starts at a page boundary, so no two buffers share a locked page
+TEST_F(MindDataTestBufferRing, TestPinnedPageAligned) {
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto ring = std::make_shared<BufferRing>(2, true);
+  std::vector<void *> buffers;
+  for (size_t n : {static_cast<size_t>(1), page_size / 2, page_size, page_size + 1, 3 * page_size}) {
+    for (int32_t i = 0; i < 2; ++i) {
+      void *p = nullptr;
+      ASSERT_OK(ring->Allocate(n, &p));
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % page_size, 0);
+      (void)std::memset(p, 0xff, n);
+      buffers.push_back(p);
+    }
+  }
+  for (auto p : buffers) {
+    ring->Deallocate(p);
+  }
+  void *p = nullptr;
+  ASSERT_OK(ring->Allocate(page_size + 1, &p));
+  EXPECT_EQ(ring->NumReusedAllocations(), 1);
+  ring->Deallocate(p);
+}
+
+/// Feature: BufferRing
+/// Description: Batch image rows with and without a buffer ring, freeing every batch before the next one
+/// Expectation: The batches are the same, and the ring allocates the buffers of the first batch only
+TEST_F(MindDataTestBufferRing, TestBatchRows) {
+  const int32_t batch_size = 32;
+  const int32_t num_batches = 50;
+  auto ring = std::make_shared<BufferRing>(2, true);
+  std::chrono::nanoseconds ring_time(0);
+  std::chrono::nanoseconds global_time(0);
+  for (int32_t i = 0; i < num_batches; ++i) {
+    auto table = MakeImageTable(batch_size);
+    auto expected_table = MakeImageTable(batch_size);
+    TensorRow batch;
+    TensorRow expected;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_OK(BatchOp::BatchRows(&table, &batch, batch_size, false, ring));
+    auto mid = std::chrono::steady_clock::now();
+    ASSERT_OK(BatchOp::BatchRows(&expected_table, &expected, batch_size));
+    auto end = std::chrono::steady_clock::now();
+    ring_time += mid - start;
+    global_time += end - mid;
+    ASSERT_EQ(batch.size(), expected.size());
+    for (size_t col = 0; col < batch.size(); ++col) {
+      EXPECT_EQ(*batch[col], *expected[col]);
+    }
+  }
+  // One image buffer and one label buffer for the first batch, every later batch reuses them
+  EXPECT_EQ(ring->NumSystemAllocations(), 2);
+  EXPECT_EQ(ring->NumReusedAllocations(), 2 * (num_batches - 1));
+  MS_LOG(INFO) << "Average batch latency with buffer ring: " << ring_time.count() / num_batches
+               << "ns, with global memory pool: " << global_time.count() / num_batches << "ns.";
+}
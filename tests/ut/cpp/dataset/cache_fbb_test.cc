@@ -0,0 +1,156 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/cache/cache_fbb.h"
+#include "minddata/dataset/engine/cache/cache_request.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheFbb : public UT::Common {
+ protected:
+  /// \brief Serialize the rows the way the cache server replies to a batch fetch. The buffer is made of int64 to keep
+  ///     it aligned like the shared memory.
+  static Status SerializeRows(const TensorTable &rows, std::vector<int64_t> *buf) {
+    const int64_t row_alignment = sizeof(int64_t);
+    std::vector<int64_t> offsets = {static_cast<int64_t>((rows.size() + 1) * sizeof(int64_t))};
+    std::vector<std::shared_ptr<flatbuffers::FlatBufferBuilder>> headers;
+    for (const auto &row : rows) {
+      std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb;
+      RETURN_IF_NOT_OK(SerializeTensorRowHeader(row, &fbb));
+      int64_t sz = fbb->GetSize();
+      for (const auto &ts : row) {
+        sz += ts->SizeInBytes();
+      }
+      offsets.push_back(offsets.back() + (sz + row_alignment - 1) / row_alignment * row_alignment);
+      headers.push_back(fbb);
+    }
+    buf->assign(offsets.back() / sizeof(int64_t), 0);
+    auto *p = reinterpret_cast<char *>(buf->data());
+    (void)std::memcpy(p, offsets.data(), offsets.size() * sizeof(int64_t));
+    for (size_t i = 0; i < rows.size(); ++i) {
+      auto *dest = p + offsets[i];
+      (void)std::memcpy(dest, headers[i]->GetBufferPointer(), headers[i]->GetSize());
+      dest += headers[i]->GetSize();
+      for (const auto &ts : rows[i]) {
+        (void)std::memcpy(dest, ts->GetBuffer(), ts->SizeInBytes());
+        dest += ts->SizeInBytes();
+      }
+    }
+    return Status::OK();
+  }
+
+  /// \brief Make rows of a uint8 column followed by a float32 column. The float data is unaligned in the buffer unless
+  ///     the number of elements of the uint8 column is a multiple of 4.
+  static Status MakeRows(int32_t num_rows, int32_t num_bytes, TensorTable *rows) {
+    for (int32_t i = 0; i < num_rows; ++i) {
+      std::shared_ptr<Tensor> bytes;
+      std::shared_ptr<Tensor> floats;
+      RETURN_IF_NOT_OK(Tensor::CreateFromVector(std::vector<uint8_t>(num_bytes, static_cast<uint8_t>(i)), &bytes));
+      RETURN_IF_NOT_OK(Tensor::CreateFromVector(std::vector<float>({i * 1.5f, -i * 0.5f, 3.0f}), &floats));
+      rows->push_back(TensorRow(i, {bytes, floats}));
+    }
+    return Status::OK();
+  }
+
+  static void CheckRows(const TensorTable &expected, const TensorTable &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].getId(), actual[i].getId());
+      ASSERT_EQ(expected[i].size(), actual[i].size());
+      for (size_t k = 0; k < expected[i].size(); ++k) {
+        EXPECT_EQ(*expected[i][k], *actual[i][k]);
+      }
+    }
+  }
+
+  static bool InBuffer(const std::vector<int64_t> &buf, const std::shared_ptr<Tensor> &ts) {
+    auto *begin = reinterpret_cast<const unsigned char *>(buf.data());
+    return ts->GetBuffer() >= begin && ts->GetBuffer() < begin + buf.size() * sizeof(int64_t);
+  }
+};
+
+/// Feature: Cache zero copy fetch
+/// Description: Restore the fetched rows with and without a lease on the buffer, with aligned and unaligned columns
+/// Expectation: The rows are intact. With the lease, the aligned tensors refer to the buffer in place and the
+///     unaligned ones are copied. Without it, all the tensors are copied.
+TEST_F(MindDataTestCacheFbb, TestRestoreRowsZeroCopy) {
+  for (int32_t num_bytes : {4, 5}) {
+    TensorTable rows;
+    ASSERT_OK(MakeRows(3, num_bytes, &rows));
+    std::vector<int64_t> buf;
+    ASSERT_OK(SerializeRows(rows, &buf));
+    std::vector<row_id_type> row_ids = {0, 1, 2};
+
+    TensorTable copied;
+    ASSERT_OK(RestoreTensorRows(buf.data(), row_ids, &copied));
+    CheckRows(rows, copied);
+    for (const auto &row : copied) {
+      for (const auto &ts : row) {
+        EXPECT_FALSE(InBuffer(buf, ts));
+      }
+    }
+
+    auto lease = std::make_shared<SharedBlockLease>(0, nullptr);
+    TensorTable leased;
+    ASSERT_OK(RestoreTensorRows(buf.data(), row_ids, &leased, lease));
+    CheckRows(rows, leased);
+    for (const auto &row : leased) {
+      EXPECT_TRUE(InBuffer(buf, row[0]));
+      bool float_aligned = reinterpret_cast<uintptr_t>(row[1]->GetBuffer()) % sizeof(float) == 0;
+      EXPECT_EQ(InBuffer(buf, row[1]), float_aligned);
+      EXPECT_EQ(float_aligned, num_bytes % sizeof(float) == 0);
+    }
+  }
+}
+
+/// Feature: Cache zero copy fetch
+/// Description: Drop the lease and the restored tensors one by one
+/// Expectation: The block is released exactly once, after the lease and the last tensor referring to it are gone
+TEST_F(MindDataTestCacheFbb, TestSharedBlockLeaseLifetime) {
+  TensorTable rows;
+  ASSERT_OK(MakeRows(2, 8, &rows));
+  std::vector<int64_t> buf;
+  ASSERT_OK(SerializeRows(rows, &buf));
+
+  const int64_t block_addr = 4096;
+  std::vector<int64_t> released;
+  auto lease = std::make_shared<SharedBlockLease>(block_addr, [&released](int64_t addr) { released.push_back(addr); });
+  TensorTable leased;
+  ASSERT_OK(RestoreTensorRows(buf.data(), {0, 1}, &leased, lease));
+  lease.reset();
+  EXPECT_TRUE(released.empty());
+
+  std::shared_ptr<Tensor> last = leased[1][1];
+  ASSERT_TRUE(InBuffer(buf, last));
+  leased.clear();
+  EXPECT_TRUE(released.empty());
+  float value = 0;
+  ASSERT_OK(last->GetItemAt(&value, {1}));
+  EXPECT_EQ(value, -0.5f);
+
+  last.reset();
+  EXPECT_EQ(released, std::vector<int64_t>({block_addr}));
+
+  // A lease no tensor ever refers to is released when it is dropped.
+  lease = std::make_shared<SharedBlockLease>(block_addr, [&released](int64_t addr) { released.push_back(addr); });
+  lease.reset();
+  EXPECT_EQ(released, std::vector<int64_t>({block_addr, block_addr}));
+}
@@ -0,0 +1,231 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCachePool : public UT::Common {
+ protected:
+  static constexpr size_t kRowSize = 4096;
+
+  void SetUp() override {
+    ASSERT_OK(Services::CreateInstance());
+    // Keep the lower bound of the available memory well below the free memory. The tests bound the rows in memory
+    // with SetMemoryCap instead.
+    auto total_mem = CacheServerHW::GetTotalSystemMemory();
+    auto memory_cap_ratio = 1.0 - static_cast<double>(CacheServerHW::GetAvailableMemory()) / total_mem / 2;
+    mp_ = std::make_shared<NumaMemoryPool>(std::make_shared<CacheServerHW>(), memory_cap_ratio);
+    pool_ = std::make_shared<CachePool>(mp_, "/tmp", 2);
+    ASSERT_OK(pool_->ServiceStart());
+  }
+
+  void TearDown() override {
+    if (pool_ != nullptr) {
+      EXPECT_OK(pool_->ServiceStop());
+    }
+  }
+
+  static std::vector<uint8_t> MakeRow(CachePool::key_type key) {
+    std::vector<uint8_t> row(kRowSize);
+    for (size_t i = 0; i < row.size(); ++i) {
+      row[i] = static_cast<uint8_t>(key * 31 + i);
+    }
+    return row;
+  }
+
+  static Status InsertRow(CachePool *pool, CachePool::key_type key) {
+    auto row = MakeRow(key);
+    return pool->Insert(key, {ReadableSlice(row.data(), row.size())});
+  }
+
+  static Status CheckRow(const CachePool &pool, CachePool::key_type key) {
+    std::vector<uint8_t> row(kRowSize);
+    WritableSlice dest(row.data(), row.size());
+    size_t bytes_read = 0;
+    RETURN_IF_NOT_OK(pool.Read(key, &dest, &bytes_read));
+    CHECK_FAIL_RETURN_UNEXPECTED(bytes_read == kRowSize, "Wrong size of row " + std::to_string(key));
+    CHECK_FAIL_RETURN_UNEXPECTED(row == MakeRow(key), "Wrong content of row " + std::to_string(key));
+    return Status::OK();
+  }
+
+  /// \brief Wait for the tiering task until the statistics meet the condition
+  /// \return Whether the condition is met within a few seconds
+  bool WaitForStat(const std::function<bool(const CachePool::CacheStat &)> &cond) const {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (cond(pool_->GetStat())) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return cond(pool_->GetStat());
+  }
+
+  std::shared_ptr<NumaMemoryPool> mp_;
+  std::shared_ptr<CachePool> pool_;
+};
+
+/// Feature: CachePool
+/// Description: Spill rows beyond the memory cap, lift the cap and read one of the spilled rows repeatedly
+/// Expectation: The row read repeatedly is promoted into memory, the others stay on disk, all rows read back intact
+TEST_F(MindDataTestCachePool, TestPromoteAfterRepeatedReads) {
+  const int64_t num_rows = 8;
+  pool_->SetMemoryCap(kRowSize * 4);
+  for (int64_t key = 0; key < num_rows; ++key) {
+    ASSERT_OK(InsertRow(pool_.get(), key));
+  }
+  auto stat = pool_->GetStat();
+  ASSERT_EQ(stat.num_mem_cached, 4);
+  ASSERT_EQ(stat.num_disk_cached, 4);
+
+  pool_->SetMemoryCap(0);
+  const CachePool &reader = *pool_;
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_OK(CheckRow(reader, 6));
+  }
+  ASSERT_TRUE(WaitForStat([](const CachePool::CacheStat &s) { return s.num_promoted == 1; }));
+  stat = pool_->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 5);
+  EXPECT_EQ(stat.num_disk_cached, 3);
+  EXPECT_EQ(stat.num_demoted, 0);
+  for (int64_t key = 0; key < num_rows; ++key) {
+    ASSERT_OK(CheckRow(reader, key));
+  }
+}
+
+/// Feature: CachePool
+/// Description: Fill the memory cap with rows which are never read, then read the spilled rows repeatedly
+/// Expectation: The cold rows in memory are demoted to make room for the hot ones, the cap is never exceeded
+TEST_F(MindDataTestCachePool, TestDemoteUnderMemoryPressure) {
+  const int64_t num_rows = 8;
+  const int64_t rows_in_memory = 4;
+  pool_->SetMemoryCap(kRowSize * rows_in_memory);
+  for (int64_t key = 0; key < num_rows; ++key) {
+    ASSERT_OK(InsertRow(pool_.get(), key));
+  }
+
+  for (int32_t i = 0; i < 4; ++i) {
+    for (int64_t key = rows_in_memory; key < num_rows; ++key) {
+      ASSERT_OK(CheckRow(*pool_, key));
+    }
+  }
+  ASSERT_TRUE(WaitForStat([](const CachePool::CacheStat &s) { return s.num_promoted == rows_in_memory; }));
+  auto stat = pool_->GetStat();
+  EXPECT_EQ(stat.num_demoted, rows_in_memory);
+  EXPECT_EQ(stat.num_mem_cached, rows_in_memory);
+  EXPECT_EQ(stat.num_disk_cached, num_rows - rows_in_memory);
+  for (int64_t key = 0; key < num_rows; ++key) {
+    ASSERT_OK(CheckRow(*pool_, key));
+  }
+  // The demoted rows are spilled already, the last reads don't promote them back at the expense of the hot rows.
+  EXPECT_EQ(pool_->GetStat().num_mem_cached, rows_in_memory);
+}
+
+/// Feature: CachePool
+/// Description: Read ahead all the spilled rows, fetch some of them and reset the read ahead
+/// Expectation: The staged bytes grow with the rows read ahead and drop with every row fetched and on reset
+TEST_F(MindDataTestCachePool, TestReadAheadBudget) {
+  const int64_t num_rows = 16;
+  // Spill all the rows.
+  pool_->SetMemoryCap(1);
+  std::vector<CachePool::key_type> keys;
+  for (int64_t key = 0; key < num_rows; ++key) {
+    ASSERT_OK(InsertRow(pool_.get(), key));
+    keys.push_back(key);
+  }
+  ASSERT_EQ(pool_->GetStat().num_disk_cached, num_rows);
+  EXPECT_EQ(pool_->GetStat().read_ahead_bytes, 0);
+
+  ASSERT_OK(pool_->ReadAhead(keys, true));
+  ASSERT_TRUE(WaitForStat([](const CachePool::CacheStat &s) { return s.read_ahead_bytes == num_rows * kRowSize; }));
+  for (int64_t key = 0; key < num_rows / 2; ++key) {
+    ASSERT_OK(CheckRow(*pool_, key));
+  }
+  auto stat = pool_->GetStat();
+  EXPECT_EQ(stat.num_read_ahead_hit, num_rows / 2);
+  EXPECT_EQ(stat.read_ahead_bytes, num_rows / 2 * kRowSize);
+
+  ASSERT_OK(pool_->ReadAhead({}, true));
+  EXPECT_EQ(pool_->GetStat().read_ahead_bytes, 0);
+  for (int64_t key = num_rows / 2; key < num_rows; ++key) {
+    ASSERT_OK(CheckRow(*pool_, key));
+  }
+  stat = pool_->GetStat();
+  EXPECT_EQ(stat.num_read_ahead_hit, num_rows / 2);
+  EXPECT_EQ(stat.read_ahead_bytes, 0);
+}
+
+/// Feature: CachePool
+/// Description: Insert rows from several threads while the hot rows are promoted and the cold ones demoted
+/// Expectation: All the rows read back intact and the rows in memory never exceed the memory cap
+TEST_F(MindDataTestCachePool, TestConcurrentInsertAndTiering) {
+  const int32_t num_threads = 4;
+  const int64_t rows_per_thread = 256;
+  const int64_t rows_in_memory = 64;
+  pool_->SetMemoryCap(kRowSize * rows_in_memory);
+
+  std::atomic<bool> done(false);
+  Status read_rc;
+  // Read the low keys over and over so they keep getting promoted and demoted during the inserts.
+  std::thread reader([this, &done, &read_rc]() {
+    while (!done && read_rc.IsOk()) {
+      for (CachePool::key_type key = 0; key < rows_in_memory && read_rc.IsOk(); ++key) {
+        std::vector<uint8_t> row(kRowSize);
+        WritableSlice dest(row.data(), row.size());
+        // A row not inserted yet is fine.
+        if (pool_->Read(key, &dest).IsOk() && row != MakeRow(key)) {
+          read_rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, "Wrong content of row " + std::to_string(key));
+        }
+      }
+    }
+  });
+  TaskGroup vg;
+  for (int32_t t = 0; t < num_threads; ++t) {
+    ASSERT_OK(vg.CreateAsyncTask("Insert", [this, t]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t i = 0; i < rows_per_thread; ++i) {
+        RETURN_IF_NOT_OK(InsertRow(pool_.get(), i * num_threads + t));
+      }
+      return Status::OK();
+    }));
+  }
+  ASSERT_OK(vg.join_all(Task::WaitFlag::kNonBlocking));
+  EXPECT_OK(vg.GetTaskErrorIfAny());
+  done = true;
+  reader.join();
+  EXPECT_OK(read_rc);
+
+  auto stat = pool_->GetStat();
+  EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, num_threads * rows_per_thread);
+  EXPECT_LE(stat.num_mem_cached, rows_in_memory);
+  for (int64_t key = 0; key < num_threads * rows_per_thread; ++key) {
+    ASSERT_OK(CheckRow(*pool_, key));
+  }
+  EXPECT_LE(pool_->GetStat().num_mem_cached, rows_in_memory);
+}
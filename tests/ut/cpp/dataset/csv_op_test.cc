@@ -15,6 +15,9 @@
  */
 #include <iostream>
 #include <memory>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -58,3 +61,50 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+/// Feature: CountRows in CsvParser
+/// Description: Count the rows of random CSV text with quoted fields, new lines in quotes and CRLF, once character by
+///     character and once block by block with random block sizes
+/// Expectation: Both count the same rows, and every row start found in a block follows a new line with the rows
+///     counted before it
+TEST_F(MindDataTestCSVOp, TestCountRowsByBlock) {
+  const char alphabet[] = {'a', 'b', ',', '"', '\r', '\n'};
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<size_t> char_dist(0, sizeof(alphabet) - 1);
+  std::uniform_int_distribution<size_t> len_dist(0, 64);
+  for (int32_t t = 0; t < 20000; ++t) {
+    std::string text;
+    auto len = len_dist(gen);
+    for (size_t k = 0; k < len; ++k) {
+      text += alphabet[char_dist(gen)];
+    }
+
+    CsvOp::CsvParser by_char(0, nullptr, ',', {}, "random.csv");
+    ASSERT_OK(by_char.InitCsvParser());
+    // The rows counted before every character.
+    std::vector<int64_t> rows_before;
+    for (char c : text) {
+      rows_before.push_back(by_char.GetTotalRows());
+      (void)by_char.CountRows(c);
+    }
+    (void)by_char.CountRows(std::char_traits<char>::eof());
+
+    CsvOp::CsvParser by_block(0, nullptr, ',', {}, "random.csv");
+    ASSERT_OK(by_block.InitCsvParser());
+    size_t offset = 0;
+    while (offset < text.size()) {
+      auto block_size = std::uniform_int_distribution<size_t>(1, text.size() - offset)(gen);
+      std::pair<int64_t, int64_t> row_start;
+      by_block.CountRows(text.data() + offset, block_size, &row_start);
+      if (row_start.second >= 0) {
+        auto pos = offset + static_cast<size_t>(row_start.second);
+        ASSERT_LT(pos, text.size());
+        EXPECT_EQ(row_start.first, rows_before[pos]) << text;
+        EXPECT_TRUE(pos == 0 || text[pos - 1] == '\r' || text[pos - 1] == '\n') << text;
+      }
+      offset += block_size;
+    }
+    (void)by_block.CountRows(std::char_traits<char>::eof());
+    ASSERT_EQ(by_char.GetTotalRows(), by_block.GetTotalRows()) << text;
+  }
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestFusedNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedNormalizeOp() : CVOpCommon() {}
+
+  /// \brief Run HorizontalFlip, Normalize and HWC2CHW one after another
+  static void RunChain(const std::shared_ptr<Tensor> &input, bool flip, const std::vector<float> &mean,
+                       const std::vector<float> &std, bool to_chw, std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> image = input;
+    if (flip) {
+      ASSERT_OK(HorizontalFlipOp().Compute(input, &image));
+    }
+    ASSERT_OK(NormalizeOp(mean, std, true).Compute(image, output));
+    if (to_chw) {
+      image = *output;
+      ASSERT_OK(HwcToChwOp().Compute(image, output));
+    }
+  }
+};
+
+/// Feature: FusedNormalize op
+/// Description: Fuse flip, Normalize and HWC2CHW on uint8 and float32 images, with per channel and single mean/std
+/// Expectation: The output is the same as the one of the ops run one after another
+TEST_F(MindDataTestFusedNormalizeOp, TestSameAsChain) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp-TestSameAsChain.";
+  std::shared_ptr<Tensor> float_input;
+  ASSERT_OK(TypeCastOp(DataType(DataType::DE_FLOAT32)).Compute(input_tensor_, &float_input));
+  const std::vector<std::vector<float>> means = {{121.0, 115.0, 100.0}, {127.5}};
+  const std::vector<std::vector<float>> stds = {{70.0, 68.0, 71.0}, {63.7}};
+  for (const auto &input : {input_tensor_, float_input}) {
+    for (size_t i = 0; i < means.size(); ++i) {
+      for (bool flip : {false, true}) {
+        for (bool to_chw : {false, true}) {
+          FusedNormalizeOp op(flip ? 1.0 : 0.0, means[i], stds[i], to_chw);
+          std::shared_ptr<Tensor> output;
+          std::shared_ptr<Tensor> expected;
+          ASSERT_OK(op.Compute(input, &output));
+          RunChain(input, flip, means[i], stds[i], to_chw, &expected);
+          EXPECT_EQ(output->shape(), expected->shape());
+          EXPECT_EQ(output->type(), expected->type());
+          EXPECT_EQ(*output, *expected);
+        }
+      }
+    }
+  }
+}
+
+/// Feature: FusedNormalize op
+/// Description: Run FusedNormalize on a 4 dimension uint8 tensor, which does not take the fused path
+/// Expectation: The output is the same as the one of the ops run one after another
+TEST_F(MindDataTestFusedNormalizeOp, TestUnfused) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp-TestUnfused.";
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromTensor(input_tensor_, &input));
+  TensorShape shape = input->shape();
+  ASSERT_OK(input->ExpandDim(0));
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  FusedNormalizeOp op(0.0, mean, std, false);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(input, &output));
+  std::shared_ptr<Tensor> expected;
+  RunChain(input_tensor_, false, mean, std, false, &expected);
+  ASSERT_OK(output->Reshape(shape));
+  EXPECT_EQ(*output, *expected);
+}
+
+/// Feature: FusedNormalize op
+/// Description: Measure the throughput of FusedNormalize and of the chain of ops it replaces on 224x224 images
+/// Expectation: The outputs are the same, the throughputs are logged
+TEST_F(MindDataTestFusedNormalizeOp, TestPerformance) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp-TestPerformance.";
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({224, 224, 3}), DataType(DataType::DE_UINT8), &input));
+  uint8_t value = 0;
+  for (auto itr = input->begin<uint8_t>(); itr != input->end<uint8_t>(); ++itr) {
+    *itr = value;
+    value += 7;
+  }
+  std::vector<float> mean = {0.485 * 255, 0.456 * 255, 0.406 * 255};
+  std::vector<float> std = {0.229 * 255, 0.224 * 255, 0.225 * 255};
+  FusedNormalizeOp op(1.0, mean, std, true);
+  const int32_t num_images = 200;
+  std::chrono::nanoseconds fused_time(0);
+  std::chrono::nanoseconds chain_time(0);
+  for (int32_t i = 0; i < num_images; ++i) {
+    std::shared_ptr<Tensor> output;
+    std::shared_ptr<Tensor> expected;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_OK(op.Compute(input, &output));
+    auto mid = std::chrono::steady_clock::now();
+    RunChain(input, true, mean, std, true, &expected);
+    auto end = std::chrono::steady_clock::now();
+    fused_time += mid - start;
+    chain_time += end - mid;
+    ASSERT_EQ(*output, *expected);
+  }
+  auto images_per_second = [num_images](std::chrono::nanoseconds t) {
+    return num_images / std::chrono::duration<double>(t).count();
+  };
+  MS_LOG(INFO) << "Images per second on one core with FusedNormalize: " << images_per_second(fused_time)
+               << ", with HorizontalFlip, Normalize and HWC2CHW: " << images_per_second(chain_time) << ".";
+}
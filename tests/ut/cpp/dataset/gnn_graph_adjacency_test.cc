@@ -0,0 +1,226 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/gnn/graph_adjacency.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using namespace mindspore::dataset::gnn;
+
+class MindDataTestGNNGraphAdjacency : public UT::Common {
+ protected:
+  MindDataTestGNNGraphAdjacency() = default;
+
+  /// \brief Build the adjacency of a small graph of nodes 1 to 6 of type 0 and nodes 10 and 20 of type 1,
+  /// the ids of its edges are 100 to 107 in the order they are added
+  static void BuildSmallGraph(GraphAdjacency *adjacency) {
+    ASSERT_OK(adjacency->AddEdge(100, 1, 3, 0, 1.0));
+    ASSERT_OK(adjacency->AddEdge(101, 1, 10, 1, 1.0));
+    ASSERT_OK(adjacency->AddEdge(102, 1, 2, 0, 2.0));
+    ASSERT_OK(adjacency->AddEdge(103, 1, 5, 0, 4.0));
+    ASSERT_OK(adjacency->AddEdge(104, 2, 20, 1, 1.0));
+    ASSERT_OK(adjacency->AddEdge(105, 2, 10, 1, 1.0));
+    ASSERT_OK(adjacency->AddEdge(106, 2, 1, 0, 1.0));
+    ASSERT_OK(adjacency->AddEdge(107, 10, 1, 0, 3.0));
+    ASSERT_OK(adjacency->Build({10, 1, 2, 3, 4, 5, 6, 20}));
+  }
+};
+
+/// Feature: GraphAdjacency
+/// Description: Get all neighbors of nodes with and without neighbors, and of a node which is not in the graph
+/// Expectation: The neighbors are in the order of their edges, led by the node itself unless excluded
+TEST_F(MindDataTestGNNGraphAdjacency, TestGetAllNeighbors) {
+  GraphAdjacency adjacency;
+  BuildSmallGraph(&adjacency);
+
+  std::vector<NodeIdType> neighbors;
+  ASSERT_OK(adjacency.GetAllNeighbors(1, 0, &neighbors));
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({1, 3, 2, 5}));
+  ASSERT_OK(adjacency.GetAllNeighbors(1, 0, &neighbors, true));
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({3, 2, 5}));
+  ASSERT_OK(adjacency.GetAllNeighbors(2, 1, &neighbors, true));
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({20, 10}));
+  ASSERT_OK(adjacency.GetAllNeighbors(10, 0, &neighbors, true));
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({1}));
+  ASSERT_OK(adjacency.GetAllNeighbors(4, 0, &neighbors));
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({4}));
+  ASSERT_OK(adjacency.GetAllNeighbors(20, 1, &neighbors, true));
+  EXPECT_TRUE(neighbors.empty());
+
+  Status s = adjacency.GetAllNeighbors(7, 0, &neighbors);
+  EXPECT_TRUE(s.ToString().find("Invalid node id:7") != std::string::npos);
+  s = adjacency.AddEdge(200, 3, 4, 0, 1.0);
+  EXPECT_FALSE(s.IsOk());
+}
+
+/// Feature: GraphAdjacency
+/// Description: Get the edges between adjacent nodes, duplicate edges, nodes which are not adjacent and a missing node
+/// Expectation: The first added edge between two nodes is returned, -1 if they are not adjacent
+TEST_F(MindDataTestGNNGraphAdjacency, TestGetEdge) {
+  GraphAdjacency adjacency;
+  BuildSmallGraph(&adjacency);
+
+  std::map<std::pair<NodeIdType, NodeIdType>, EdgeIdType> expected = {
+    {{1, 3}, 100},  {{1, 10}, 101}, {{1, 2}, 102}, {{1, 5}, 103},  {{1, 4}, -1},  {{1, 1}, -1},  {{2, 20}, 104},
+    {{2, 10}, 105}, {{2, 1}, 106},  {{2, 3}, -1},  {{10, 1}, 107}, {{10, 2}, -1}, {{20, 2}, -1}};
+  for (const auto &item : expected) {
+    EdgeIdType edge_id = 0;
+    ASSERT_OK(adjacency.GetEdge(item.first.first, item.first.second, &edge_id));
+    EXPECT_EQ(edge_id, item.second) << item.first.first << " " << item.first.second;
+  }
+  EdgeIdType edge_id = 0;
+  EXPECT_FALSE(adjacency.GetEdge(7, 1, &edge_id).IsOk());
+
+  GraphAdjacency duplicate_adjacency;
+  ASSERT_OK(duplicate_adjacency.AddEdge(7, 0, 1, 0, 1.0));
+  ASSERT_OK(duplicate_adjacency.AddEdge(3, 0, 2, 0, 1.0));
+  ASSERT_OK(duplicate_adjacency.AddEdge(5, 0, 1, 0, 2.0));
+  ASSERT_OK(duplicate_adjacency.Build({0, 1, 2}));
+  ASSERT_OK(duplicate_adjacency.GetEdge(0, 1, &edge_id));
+  EXPECT_EQ(edge_id, 7);
+  ASSERT_OK(duplicate_adjacency.GetEdge(0, 2, &edge_id));
+  EXPECT_EQ(edge_id, 3);
+}
+
+/// Feature: GraphAdjacency
+/// Description: Randomly sample fewer, as many and more neighbors than a node has, and neighbors of a lone node
+/// Expectation: Every round of samples picks distinct neighbors, a lone node gets kDefaultNodeId
+TEST_F(MindDataTestGNNGraphAdjacency, TestRandomSampledNeighbors) {
+  GraphAdjacency adjacency;
+  ASSERT_OK(adjacency.Build({0, 1, 2, 3}));
+  EXPECT_FALSE(adjacency.GetSampledNeighbors(0, 0, 2, SamplingStrategy::kRandom, nullptr, nullptr).IsOk());
+
+  const int32_t degree = 100;
+  GraphAdjacency hub_adjacency;
+  std::vector<NodeIdType> node_ids = {-1000};
+  for (int32_t i = 0; i < degree; ++i) {
+    ASSERT_OK(hub_adjacency.AddEdge(i, -1000, i, 0, 1.0));
+    node_ids.push_back(i);
+  }
+  node_ids.push_back(5000);
+  ASSERT_OK(hub_adjacency.Build(node_ids));
+
+  std::mt19937 rnd(0);
+  for (int32_t samples_num : {1, 10, 32, 33, 99, 100, 250}) {
+    std::vector<NodeIdType> samples = {-2};
+    ASSERT_OK(hub_adjacency.GetSampledNeighbors(-1000, 0, samples_num, SamplingStrategy::kRandom, &samples, &rnd));
+    ASSERT_EQ(samples.size(), samples_num + 1);
+    EXPECT_EQ(samples[0], -2);
+    for (int32_t begin = 1; begin < samples.size(); begin += degree) {
+      auto end = std::min(samples.begin() + begin + degree, samples.end());
+      std::set<NodeIdType> round(samples.begin() + begin, end);
+      EXPECT_EQ(round.size(), end - samples.begin() - begin) << samples_num;
+      EXPECT_TRUE(*round.begin() >= 0 && *round.rbegin() < degree);
+    }
+  }
+
+  std::vector<NodeIdType> samples;
+  ASSERT_OK(hub_adjacency.GetSampledNeighbors(5000, 0, 3, SamplingStrategy::kRandom, &samples, &rnd));
+  EXPECT_EQ(samples, std::vector<NodeIdType>(3, kDefaultNodeId));
+  samples.clear();
+  ASSERT_OK(hub_adjacency.GetSampledNeighbors(-1000, 1, 2, SamplingStrategy::kEdgeWeight, &samples, &rnd));
+  EXPECT_EQ(samples, std::vector<NodeIdType>(2, kDefaultNodeId));
+}
+
+/// Feature: GraphAdjacency
+/// Description: Sample neighbors by edge weight many times, from a row with uniform and one with different weights
+/// Expectation: The frequency of every neighbor is proportional to the weight of its edge
+TEST_F(MindDataTestGNNGraphAdjacency, TestWeightSampledNeighbors) {
+  GraphAdjacency adjacency;
+  BuildSmallGraph(&adjacency);
+
+  const int32_t samples_num = 70000;
+  std::mt19937 rnd(1);
+  std::vector<NodeIdType> samples;
+  ASSERT_OK(adjacency.GetSampledNeighbors(1, 0, samples_num, SamplingStrategy::kEdgeWeight, &samples, &rnd));
+  ASSERT_EQ(samples.size(), samples_num);
+  std::map<NodeIdType, int32_t> counts;
+  for (auto id : samples) {
+    ++counts[id];
+  }
+  std::map<NodeIdType, float> weights = {{3, 1.0}, {2, 2.0}, {5, 4.0}};
+  ASSERT_EQ(counts.size(), weights.size());
+  for (const auto &item : weights) {
+    float expected = samples_num * item.second / 7.0;
+    EXPECT_LT(std::fabs(counts[item.first] - expected), expected * 0.05) << item.first;
+  }
+
+  samples.clear();
+  counts.clear();
+  ASSERT_OK(adjacency.GetSampledNeighbors(2, 1, samples_num, SamplingStrategy::kEdgeWeight, &samples, &rnd));
+  for (auto id : samples) {
+    ++counts[id];
+  }
+  ASSERT_EQ(counts.size(), 2);
+  EXPECT_LT(std::abs(counts[10] - counts[20]), samples_num * 0.05);
+}
+
+/// Feature: GraphAdjacency
+/// Description: Build the adjacency of a synthetic power law graph, then sample neighbors of all its nodes.
+///     It is a benchmark of 2M edges, run it with --gtest_also_run_disabled_tests
+/// Expectation: Runs successfully, the memory footprint and the sampled neighbors per second are logged
+TEST_F(MindDataTestGNNGraphAdjacency, DISABLED_TestPerformance) {
+  const int32_t num_nodes = 100000;
+  const int32_t num_edges = 2000000;
+  const int32_t samples_num = 10;
+  std::mt19937 rnd(2);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::uniform_int_distribution<NodeIdType> dst_dist(0, num_nodes - 1);
+  std::uniform_real_distribution<WeightType> weight_dist(0.1, 10.0);
+
+  auto start = std::chrono::steady_clock::now();
+  GraphAdjacency adjacency;
+  adjacency.Reserve(num_edges);
+  for (int32_t i = 0; i < num_edges; ++i) {
+    // The degree of the node of rank k falls like k^(-2/3), so a few hubs have most of the edges
+    auto src = static_cast<NodeIdType>(num_nodes * std::pow(uniform(rnd), 3.0));
+    NodeIdType dst = dst_dist(rnd);
+    ASSERT_OK(adjacency.AddEdge(i, src, dst, static_cast<NodeType>(dst % 2), dst % 2 == 0 ? 1.0 : weight_dist(rnd)));
+  }
+  std::vector<NodeIdType> node_ids(num_nodes);
+  std::iota(node_ids.begin(), node_ids.end(), 0);
+  ASSERT_OK(adjacency.Build(std::move(node_ids)));
+  auto build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Built the adjacency of " << num_nodes << " nodes and " << num_edges << " edges in " << build_time
+               << "s, " << adjacency.MemorySize() << " bytes, "
+               << static_cast<double>(adjacency.MemorySize()) / num_edges << " bytes per edge.";
+
+  for (auto strategy : {SamplingStrategy::kRandom, SamplingStrategy::kEdgeWeight}) {
+    for (NodeType type : {0, 1}) {
+      std::vector<NodeIdType> samples;
+      samples.reserve(static_cast<size_t>(num_nodes) * samples_num);
+      start = std::chrono::steady_clock::now();
+      for (NodeIdType id = 0; id < num_nodes; ++id) {
+        ASSERT_OK(adjacency.GetSampledNeighbors(id, type, samples_num, strategy, &samples, &rnd));
+      }
+      auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ASSERT_EQ(samples.size(), static_cast<size_t>(num_nodes) * samples_num);
+      MS_LOG(INFO) << "Strategy " << static_cast<int>(strategy) << ", neighbor type " << static_cast<int>(type) << ": "
+                   << samples.size() / time << " sampled neighbors/s.";
+    }
+  }
+}
@@ -0,0 +1,243 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "lite_cv/image_process.h"
+#include "lite_cv/lite_mat.h"
+#include "lite_cv/simd_x86.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestLiteCvSimd : public UT::Common {
+ public:
+  MindDataTestLiteCvSimd() {}
+
+  void TearDown() override { (void)SetX86IsaLimit(X86Isa::kAvx512); }
+
+  /// \brief Make an image of random pixels
+  static LiteMat MakeImage(int width, int height, int channel, LDataType data_type, uint32_t seed) {
+    LiteMat image(width, height, channel, data_type);
+    std::mt19937 rnd(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    size_t size = static_cast<size_t>(width) * height * channel;
+    if (data_type == LDataType::UINT8) {
+      uint8_t *ptr = image;
+      for (size_t i = 0; i < size; i++) {
+        ptr[i] = static_cast<uint8_t>(dist(rnd));
+      }
+    } else {
+      float *ptr = image;
+      for (size_t i = 0; i < size; i++) {
+        ptr[i] = static_cast<float>(dist(rnd)) / 3.0f;
+      }
+    }
+    return image;
+  }
+
+  /// \brief Run an op with the scalar kernels and with the best kernels of the cpu, and compare the outputs bitwise
+  static void CheckSameAsScalar(const std::string &name, const std::function<bool(LiteMat *)> &op) {
+    LiteMat expected;
+    (void)SetX86IsaLimit(X86Isa::kScalar);
+    ASSERT_TRUE(op(&expected)) << name;
+    LiteMat output;
+    (void)SetX86IsaLimit(X86Isa::kAvx512);
+    ASSERT_TRUE(op(&output)) << name;
+    ASSERT_EQ(output.width_, expected.width_) << name;
+    ASSERT_EQ(output.height_, expected.height_) << name;
+    ASSERT_EQ(output.channel_, expected.channel_) << name;
+    ASSERT_EQ(output.data_type_, expected.data_type_) << name;
+    size_t size = static_cast<size_t>(output.width_) * output.height_ * output.channel_ * output.elem_size_;
+    EXPECT_EQ(memcmp(output.data_ptr_, expected.data_ptr_, size), 0) << name;
+  }
+
+  /// \brief The average time of an op in microseconds
+  static double TimeOp(const std::function<bool(LiteMat *)> &op, int repeat) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+      LiteMat output;
+      EXPECT_TRUE(op(&output));
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / repeat;
+  }
+};
+
+/// Feature: ConvertTo
+/// Description: Convert images of a few sizes and channels with the scalar and with the vectorized kernels
+/// Expectation: The outputs are bitwise the same
+TEST_F(MindDataTestLiteCvSimd, TestConvertTo) {
+  for (int channel : {1, 3}) {
+    for (int width : {1, 15, 224, 333}) {
+      LiteMat src = MakeImage(width, 7, channel, LDataType::UINT8, width + channel);
+      CheckSameAsScalar("ConvertTo " + std::to_string(width), [&](LiteMat *dst) {
+        return ConvertTo(src, *dst, 1.0 / 255);
+      });
+    }
+  }
+}
+
+/// Feature: SubStractMeanNormalize
+/// Description: Normalize uint8 and float images with mean and std, mean only and std only
+/// Expectation: The outputs are bitwise the same with the scalar and with the vectorized kernels
+TEST_F(MindDataTestLiteCvSimd, TestSubStractMeanNormalize) {
+  for (int channel : {1, 3, 4}) {
+    std::vector<float> mean(channel);
+    std::vector<float> std(channel);
+    for (int c = 0; c < channel; c++) {
+      mean[c] = 120.5f + 3.3f * c;
+      std[c] = 58.4f + 1.7f * c;
+    }
+    for (auto data_type : {LDataType::UINT8, LDataType::FLOAT32}) {
+      LiteMat src = MakeImage(101, 13, channel, data_type, channel);
+      std::string name = "SubStractMeanNormalize " + std::to_string(channel);
+      CheckSameAsScalar(name, [&](LiteMat *dst) { return SubStractMeanNormalize(src, *dst, mean, std); });
+      CheckSameAsScalar(name, [&](LiteMat *dst) { return SubStractMeanNormalize(src, *dst, mean, {}); });
+      CheckSameAsScalar(name, [&](LiteMat *dst) { return SubStractMeanNormalize(src, *dst, {}, std); });
+    }
+  }
+}
+
+/// Feature: ResizeBilinear
+/// Description: Resize 1 and 3 channel images up and down
+/// Expectation: The outputs are bitwise the same with the scalar and with the vectorized kernels
+TEST_F(MindDataTestLiteCvSimd, TestResizeBilinear) {
+  std::vector<std::vector<int>> sizes = {{640, 480, 224, 224}, {100, 61, 333, 171}, {57, 43, 7, 5}};
+  for (int channel : {1, 3}) {
+    for (auto &size : sizes) {
+      LiteMat src = MakeImage(size[0], size[1], channel, LDataType::UINT8, size[2]);
+      CheckSameAsScalar("ResizeBilinear " + std::to_string(size[2]), [&](LiteMat *dst) {
+        return ResizeBilinear(src, *dst, size[2], size[3]);
+      });
+    }
+  }
+}
+
+/// Feature: WarpAffineBilinear
+/// Description: Rotate and scale 1, 2 and 3 channel images, so that parts of the output are outside of the image
+/// Expectation: The outputs are bitwise the same with the scalar and with the vectorized kernels
+TEST_F(MindDataTestLiteCvSimd, TestWarpAffineBilinear) {
+  for (int channel : {1, 2, 3}) {
+    LiteMat src = MakeImage(211, 157, channel, LDataType::UINT8, channel);
+    for (double angle : {0.0, 30.0, 90.0, 215.0}) {
+      LiteMat matrix;
+      ASSERT_TRUE(GetRotationMatrix2D(105.0f, 78.0f, angle, 0.8, matrix));
+      std::vector<uint8_t> border(channel, 17);
+      CheckSameAsScalar("WarpAffineBilinear " + std::to_string(angle), [&](LiteMat *dst) {
+        return WarpAffineBilinear(src, *dst, matrix, 190, 170, PADD_BORDER_CONSTANT, border);
+      });
+    }
+  }
+}
+
+/// Feature: Pad
+/// Description: Pad 1 and 3 channel float and uint8 images with every border type, with borders of different sizes
+/// Expectation: The outputs are the same as the reference computed pixel by pixel
+TEST_F(MindDataTestLiteCvSimd, TestPad) {
+  const int width = 23;
+  const int height = 17;
+  const int top = 3;
+  const int bottom = 5;
+  const int left = 7;
+  const int right = 2;
+  const std::vector<uint8_t> fill = {11, 22, 33};
+  const std::vector<PaddBorderType> pad_types = {PADD_BORDER_CONSTANT, PADD_BORDER_REPLICATE, PADD_BORDER_REFLECT_101,
+                                                 PADD_BORDER_DEFAULT};
+  // The source position of a border pixel, with a reflect 101 border like edcb|abcdef|edcb
+  auto src_pos = [](int p, int len, PaddBorderType pad_type) {
+    if (p >= 0 && p < len) {
+      return p;
+    }
+    if (pad_type == PADD_BORDER_REPLICATE) {
+      return p < 0 ? 0 : len - 1;
+    }
+    return p < 0 ? -p : 2 * len - p - 2;
+  };
+  for (auto data_type : {LDataType::FLOAT32, LDataType::UINT8}) {
+    for (int channel : {1, 3}) {
+      LiteMat src = MakeImage(width, height, channel, data_type, channel);
+      for (auto pad_type : pad_types) {
+        std::string name = "Pad " + std::to_string(static_cast<int>(data_type)) + " " + std::to_string(channel) + " " +
+                           std::to_string(pad_type);
+        LiteMat dst;
+        ASSERT_TRUE(Pad(src, dst, top, bottom, left, right, pad_type, fill[0], fill[1], fill[2])) << name;
+        ASSERT_EQ(dst.width_, width + left + right) << name;
+        ASSERT_EQ(dst.height_, height + top + bottom) << name;
+        ASSERT_EQ(dst.channel_, channel) << name;
+        // Compare every pixel of the output with the reference
+        auto check = [&](const auto *dst_ptr, const auto *src_ptr) {
+          for (int y = 0; y < dst.height_; y++) {
+            for (int x = 0; x < dst.width_; x++) {
+              bool inside = y >= top && y < top + height && x >= left && x < left + width;
+              int sy = src_pos(y - top, height, pad_type);
+              int sx = src_pos(x - left, width, pad_type);
+              for (int c = 0; c < channel; c++) {
+                auto expected = src_ptr[(static_cast<size_t>(sy) * width + sx) * channel + c];
+                if (pad_type == PADD_BORDER_CONSTANT && !inside) {
+                  expected = fill[c];
+                }
+                ASSERT_EQ(dst_ptr[(static_cast<size_t>(y) * dst.width_ + x) * channel + c], expected)
+                  << name << " x: " << x << " y: " << y;
+              }
+            }
+          }
+        };
+        if (data_type == LDataType::FLOAT32) {
+          check(static_cast<float *>(dst), static_cast<float *>(src));
+        } else {
+          check(static_cast<uint8_t *>(dst), static_cast<uint8_t *>(src));
+        }
+      }
+    }
+  }
+}
+
+/// Feature: lite_cv x86 kernels
+/// Description: Time ResizeBilinear, ConvertTo, SubStractMeanNormalize, Pad and WarpAffineBilinear on images of
+///     common sizes, with the scalar kernels and with the best kernels of the cpu
+/// Expectation: Runs successfully, the timings are logged
+TEST_F(MindDataTestLiteCvSimd, TestPerformance) {
+  const int repeat = 10;
+  std::vector<float> mean = {123.675f, 116.28f, 103.53f};
+  std::vector<float> std = {58.395f, 57.12f, 57.375f};
+  std::vector<uint8_t> border = {0, 0, 0};
+  LiteMat matrix;
+  for (auto &size : std::vector<std::pair<int, int>>{{224, 224}, {640, 480}, {1920, 1080}}) {
+    LiteMat src = MakeImage(size.first, size.second, 3, LDataType::UINT8, size.first);
+    ASSERT_TRUE(GetRotationMatrix2D(size.first / 2.0f, size.second / 2.0f, 10.0, 1.0, matrix));
+    std::vector<std::pair<std::string, std::function<bool(LiteMat *)>>> ops = {
+      {"ResizeBilinear", [&](LiteMat *dst) { return ResizeBilinear(src, *dst, 224, 224); }},
+      {"ConvertTo", [&](LiteMat *dst) { return ConvertTo(src, *dst, 1.0 / 255); }},
+      {"SubStractMeanNormalize", [&](LiteMat *dst) { return SubStractMeanNormalize(src, *dst, mean, std); }},
+      {"Pad", [&](LiteMat *dst) { return Pad(src, *dst, 16, 16, 16, 16, PADD_BORDER_REFLECT_101); }},
+      {"WarpAffineBilinear", [&](LiteMat *dst) {
+         return WarpAffineBilinear(src, *dst, matrix, size.first, size.second, PADD_BORDER_CONSTANT, border);
+       }}};
+    for (auto &op : ops) {
+      (void)SetX86IsaLimit(X86Isa::kScalar);
+      double scalar_time = TimeOp(op.second, repeat);
+      (void)SetX86IsaLimit(X86Isa::kAvx512);
+      double simd_time = TimeOp(op.second, repeat);
+      MS_LOG(INFO) << op.first << " " << size.first << "x" << size.second << ": " << scalar_time << "us scalar, "
+                   << simd_time << "us with isa " << static_cast<int>(GetX86Isa()) << ".";
+    }
+  }
+}
@@ -120,3 +120,54 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass by fusing RandomHorizontalFlip, Normalize and HWC2CHW after the fusion of
+///     Decode and RandomResizedCrop
+/// Expectation: The map has a RandomCropDecodeResize op followed by a FusedNormalize op
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalize) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalize.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto random_resized_crop_op = vision::RandomResizedCrop({100});
+  auto flip_op = vision::RandomHorizontalFlip(0.5);
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)
+                                    ->Map({decode_op, random_resized_crop_op, flip_op, normalize_op, hwc2chw_op},
+                                          {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 2);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kRandomCropDecodeResizeOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), kFusedNormalizeOp);
+}
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass on a lone Normalize and on a Normalize of a CHW image followed by HWC2CHW
+/// Expectation: Nothing is fused
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeNotFused) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeNotFused.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto normalize_chw_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}, false);
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)->Map({decode_op, normalize_op, normalize_chw_op, hwc2chw_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(map_node, nullptr);
+  EXPECT_EQ(map_node->operations().size(), 4);
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <fstream>
 #include "common/common.h"
 #include "common/cvop_common.h"
@@ -20,6 +21,7 @@
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/util/path.h"
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -161,3 +163,89 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+/// Feature: RandomCropDecodeResize op
+/// Description: Test RandomCropDecodeResizeOp with the JPEG images decoded at a reduced DCT scale
+/// Expectation: Output is of the target size and close to the output of a full resolution decode
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestDctScaling) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeOp-TestDctScaling.";
+  constexpr int target_height = 224;
+  constexpr int target_width = 224;
+  constexpr double kScaledMseThreshold = 30.0;
+  auto cfg = GlobalContext::config_manager();
+  bool saved_dct_scaling = cfg->jpeg_dct_scaling();
+  uint32_t saved_seed = cfg->seed();
+  cfg->set_seed(42);
+  auto full_op = RandomCropDecodeResizeOp(target_height, target_width);
+  cfg->set_jpeg_dct_scaling(true);
+  auto scaled_op = RandomCropDecodeResizeOp(target_height, target_width);
+  TensorRow input_row({raw_input_tensor_});
+  for (int k = 0; k < 10; k++) {
+    TensorRow full_row;
+    TensorRow scaled_row;
+    // both ops draw the same crop windows
+    ASSERT_OK(full_op.Compute(input_row, &full_row));
+    ASSERT_OK(scaled_op.Compute(input_row, &scaled_row));
+    ASSERT_EQ(scaled_row[0]->shape(), TensorShape({target_height, target_width, 3}));
+    cv::Mat full = CVTensor::AsCVTensor(full_row[0])->mat();
+    cv::Mat scaled = CVTensor::AsCVTensor(scaled_row[0])->mat();
+    double mse = 0;
+    for (int i = 0; i < target_height; i++) {
+      for (int j = 0; j < target_width; j++) {
+        int diff = static_cast<int>(full.at<cv::Vec3b>(i, j)[1]) - static_cast<int>(scaled.at<cv::Vec3b>(i, j)[1]);
+        mse += diff * diff;
+      }
+    }
+    mse /= target_height * target_width;
+    MS_LOG(INFO) << "mse: " << mse;
+    EXPECT_LT(mse, kScaledMseThreshold);
+  }
+  cfg->set_jpeg_dct_scaling(saved_dct_scaling);
+  cfg->set_seed(saved_seed);
+}
+
+/// Feature: JpegCropAndDecode
+/// Description: Decode random crops of the large JPEG images of a folder at full resolution and at a reduced DCT scale
+/// Expectation: The scaled crops are at least the minimum size, the decode latencies are logged
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestDctScalingPerformance) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeOp-TestDctScalingPerformance.";
+  constexpr int min_size = 224;
+  Path folder("data/dataset/testPK/data/class1");
+  auto dir_it = Path::DirIterator::OpenDirectory(&folder);
+  ASSERT_NE(dir_it, nullptr);
+  std::mt19937 rd(0);
+  std::chrono::nanoseconds full_time(0);
+  std::chrono::nanoseconds scaled_time(0);
+  int32_t num_images = 0;
+  while (dir_it->HasNext()) {
+    std::shared_ptr<Tensor> encoded;
+    ASSERT_OK(Tensor::CreateFromFile(dir_it->Next().ToString(), &encoded));
+    int width = 0;
+    int height = 0;
+    ASSERT_OK(GetJpegImageInfo(encoded, &width, &height));
+    std::uniform_int_distribution<int> rd_w(width / 2, width);
+    std::uniform_int_distribution<int> rd_h(height / 2, height);
+    int crop_w = rd_w(rd);
+    int crop_h = rd_h(rd);
+    int x = std::uniform_int_distribution<int>(0, width - crop_w)(rd);
+    int y = std::uniform_int_distribution<int>(0, height - crop_h)(rd);
+    std::shared_ptr<Tensor> full;
+    std::shared_ptr<Tensor> scaled;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_OK(JpegCropAndDecode(encoded, &full, x, y, crop_w, crop_h));
+    auto mid = std::chrono::steady_clock::now();
+    ASSERT_OK(JpegCropAndDecode(encoded, &scaled, x, y, crop_w, crop_h, min_size, min_size));
+    auto end = std::chrono::steady_clock::now();
+    full_time += mid - start;
+    scaled_time += end - mid;
+    EXPECT_EQ(full->shape(), TensorShape({crop_h, crop_w, 3}));
+    EXPECT_GE(scaled->shape()[0], min_size);
+    EXPECT_GE(scaled->shape()[1], min_size);
+    EXPECT_LT(scaled->shape()[0], crop_h);
+    num_images++;
+  }
+  ASSERT_GT(num_images, 0);
+  MS_LOG(INFO) << "Average crop decode latency of " << num_images << " images at full resolution: "
+               << full_time.count() / num_images << "ns, at reduced DCT scale: " << scaled_time.count() / num_images
+               << "ns.";
+}
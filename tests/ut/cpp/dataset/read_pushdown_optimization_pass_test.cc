@@ -0,0 +1,218 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/de_tensor.h"
+#include "minddata/dataset/engine/ir/datasetops/filter_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/rename_node.h"
+#include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/random_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/sequential_sampler_ir.h"
+#include "minddata/dataset/engine/opt/pre/read_pushdown_pass.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/transforms.h"
+#include "minddata/dataset/kernels/data/mask_op.h"
+
+using namespace mindspore::dataset;
+
+class MindDataReadPushdownTestOptimizationPass : public UT::DatasetOpTesting {
+ protected:
+  MindDataReadPushdownTestOptimizationPass() {}
+
+  /// \brief Create a MindDataNode of the ImageNet mindrecord files
+  /// \param[in] sampler The sampler of the node
+  /// \return The MindDataNode
+  std::shared_ptr<MindDataNode> CreateMindDataNode(const std::shared_ptr<SamplerObj> &sampler) {
+    std::string file_path =
+      datasets_root_path_ + "/../mindrecord/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+    return std::make_shared<MindDataNode>(file_path, std::vector<std::string>{}, sampler, nullptr, 0);
+  }
+
+  /// \brief Create a FilterNode whose predicate is Mask(RelationalOp::kEqual, label) on column "label"
+  /// \param[in] child The child of the node
+  /// \param[in] label The label to be kept
+  /// \return The FilterNode
+  std::shared_ptr<FilterNode> CreateLabelFilterNode(const std::shared_ptr<DatasetNode> &child, int32_t label) {
+    std::shared_ptr<Tensor> value;
+    EXPECT_OK(Tensor::CreateScalar<int32_t>(label, &value));
+    auto predicate = std::make_shared<MaskOp>(RelationalOp::kEqual, value);
+    return std::make_shared<FilterNode>(child, predicate, std::vector<std::string>{"label"});
+  }
+
+  /// \brief Create a transforms::Mask which keeps the rows whose label is equal to the given label
+  /// \param[in] label The label to be kept
+  /// \return The Mask transform
+  std::shared_ptr<transforms::Mask> CreateLabelMask(int32_t label) {
+    std::shared_ptr<Tensor> constant;
+    EXPECT_OK(Tensor::CreateScalar<int32_t>(label, &constant));
+    return std::make_shared<transforms::Mask>(RelationalOp::kEqual,
+                                              mindspore::MSTensor(std::make_shared<DETensor>(constant)));
+  }
+
+  /// \brief Create a predicate function equal to the Mask of CreateLabelMask, which is never pushed down
+  /// \param[in] label The label to be kept
+  /// \return The predicate function
+  std::function<MSTensorVec(MSTensorVec)> CreateLabelPredicate(int32_t label) {
+    return [label](MSTensorVec in) -> MSTensorVec {
+      int64_t value = 0;
+      TensorRow input = VecToRow(in);
+      (void)input.at(0)->GetItemAt(&value, {});
+      TensorRow output;
+      std::shared_ptr<Tensor> out;
+      (void)Tensor::CreateScalar(value == label, &out);
+      output.push_back(out);
+      return RowToVec(output);
+    };
+  }
+
+  /// \brief Get the file names of all the rows of a dataset
+  /// \param[in] ds The dataset
+  /// \param[out] file_names The file names in the order of the rows
+  void GetFileNames(const std::shared_ptr<Dataset> &ds, std::vector<std::string> *file_names) {
+    std::shared_ptr<Iterator> iter = ds->Project({"file_name"})->CreateIterator();
+    ASSERT_NE(iter, nullptr);
+    std::unordered_map<std::string, mindspore::MSTensor> row;
+    ASSERT_OK(iter->GetNextRow(&row));
+    while (!row.empty()) {
+      std::shared_ptr<Tensor> file_name;
+      ASSERT_OK(Tensor::CreateFromMSTensor(row["file_name"], &file_name));
+      std::string_view name;
+      ASSERT_OK(file_name->GetItemAt(&name, {}));
+      file_names->emplace_back(name);
+      ASSERT_OK(iter->GetNextRow(&row));
+    }
+    iter->Stop();
+  }
+};
+
+/// Feature: MindData Read Pushdown Optimization Pass Test
+/// Description: Test Read Pushdown Optimization Pass with MindDataset -> Filter -> Project
+/// Expectation: The projected columns and the predicate are pushed down into MindDataNode, and the filter is kept
+TEST_F(MindDataReadPushdownTestOptimizationPass, ReadPushdownFilterProject) {
+  MS_LOG(INFO) << "Doing MindDataReadPushdownTestOptimizationPass-ReadPushdownFilterProject.";
+  auto mind_data = CreateMindDataNode(std::make_shared<SequentialSamplerObj>(0, 0));
+  auto filter = CreateLabelFilterNode(mind_data, 1);
+  auto project = std::make_shared<ProjectNode>(filter, std::vector<std::string>{"file_name"});
+
+  bool modified = false;
+  EXPECT_OK(ReadPushdownPass().Run(project, &modified));
+  EXPECT_TRUE(modified);
+  EXPECT_EQ(mind_data->ColumnsList(), (std::vector<std::string>{"file_name", "label"}));
+  EXPECT_EQ(mind_data->RowCriteria(), (std::vector<std::pair<std::string, std::string>>{{"label", "1"}}));
+  EXPECT_EQ(project->Children()[0], filter);
+}
+
+/// Feature: MindData Read Pushdown Optimization Pass Test
+/// Description: Test Read Pushdown Optimization Pass with a sampler which does not read all the rows
+/// Expectation: Only the projected columns are pushed down into MindDataNode
+TEST_F(MindDataReadPushdownTestOptimizationPass, ReadPushdownPartialSampler) {
+  MS_LOG(INFO) << "Doing MindDataReadPushdownTestOptimizationPass-ReadPushdownPartialSampler.";
+  auto mind_data = CreateMindDataNode(std::make_shared<RandomSamplerObj>(false, 10));
+  auto filter = CreateLabelFilterNode(mind_data, 1);
+  auto project = std::make_shared<ProjectNode>(filter, std::vector<std::string>{"label"});
+
+  bool modified = false;
+  EXPECT_OK(ReadPushdownPass().Run(project, &modified));
+  EXPECT_TRUE(modified);
+  EXPECT_EQ(mind_data->ColumnsList(), (std::vector<std::string>{"label"}));
+  EXPECT_TRUE(mind_data->RowCriteria().empty());
+}
+
+/// Feature: MindData Read Pushdown Optimization Pass Test
+/// Description: Test Read Pushdown Optimization Pass with a Rename node between Filter and MindDataset
+/// Expectation: Nothing is pushed down into MindDataNode
+TEST_F(MindDataReadPushdownTestOptimizationPass, ReadPushdownRename) {
+  MS_LOG(INFO) << "Doing MindDataReadPushdownTestOptimizationPass-ReadPushdownRename.";
+  auto mind_data = CreateMindDataNode(std::make_shared<SequentialSamplerObj>(0, 0));
+  auto rename = std::make_shared<RenameNode>(mind_data, std::vector<std::string>{"label"},
+                                             std::vector<std::string>{"class"});
+  auto filter = CreateLabelFilterNode(rename, 1);
+  auto project = std::make_shared<ProjectNode>(filter, std::vector<std::string>{"label"});
+
+  bool modified = false;
+  EXPECT_OK(ReadPushdownPass().Run(project, &modified));
+  EXPECT_FALSE(modified);
+  EXPECT_TRUE(mind_data->ColumnsList().empty());
+  EXPECT_TRUE(mind_data->RowCriteria().empty());
+}
+
+/// Feature: MindData Read Pushdown Optimization Pass Test
+/// Description: Test Read Pushdown Optimization Pass with MindData -> Filter -> Project created by the public API,
+///     where the predicate of Filter is a transforms::Mask
+/// Expectation: The predicate is pushed down into MindDataNode, and the pipeline outputs the same rows as the one with
+///     an equal predicate function
+TEST_F(MindDataReadPushdownTestOptimizationPass, ReadPushdownMaskFilterPipeline) {
+  MS_LOG(INFO) << "Doing MindDataReadPushdownTestOptimizationPass-ReadPushdownMaskFilterPipeline.";
+  std::string file_path = datasets_root_path_ + "/../mindrecord/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  auto mask = CreateLabelMask(2);
+  auto ds = MindData(file_path)->Filter(mask, {"label"})->Project({"file_name"});
+  ASSERT_NE(ds, nullptr);
+  bool modified = false;
+  EXPECT_OK(ReadPushdownPass().Run(ds->IRNode(), &modified));
+  EXPECT_TRUE(modified);
+  auto mind_data = std::dynamic_pointer_cast<MindDataNode>(ds->IRNode()->Children()[0]->Children()[0]);
+  ASSERT_NE(mind_data, nullptr);
+  EXPECT_EQ(mind_data->RowCriteria(), (std::vector<std::pair<std::string, std::string>>{{"label", "2"}}));
+
+  std::vector<std::string> expected;
+  GetFileNames(MindData(file_path)->Filter(CreateLabelPredicate(2), {"label"}), &expected);
+  EXPECT_EQ(expected.size(), 5);
+  std::vector<std::string> file_names;
+  GetFileNames(MindData(file_path)->Filter(mask, {"label"}), &file_names);
+  EXPECT_EQ(file_names, expected);
+}
+
+/// Feature: MindData Read Pushdown Optimization Pass Test
+/// Description: Test Read Pushdown Optimization Pass with MindData -> Filter where MindData is read by a
+///     DistributedSampler of one shard and of two shards
+/// Expectation: The predicate is only pushed down for one shard, and every shard outputs the same rows as the pipeline
+///     with an equal predicate function, which is never pushed down
+TEST_F(MindDataReadPushdownTestOptimizationPass, ReadPushdownDistributedSampler) {
+  MS_LOG(INFO) << "Doing MindDataReadPushdownTestOptimizationPass-ReadPushdownDistributedSampler.";
+  std::string file_path = datasets_root_path_ + "/../mindrecord/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  auto mask = CreateLabelMask(2);
+  for (int64_t num_shards : {1, 2}) {
+    auto ds = MindData(file_path, {}, std::make_shared<DistributedSampler>(num_shards, 0, false))
+                ->Filter(mask, {"label"})
+                ->Project({"file_name"});
+    ASSERT_NE(ds, nullptr);
+    bool modified = false;
+    EXPECT_OK(ReadPushdownPass().Run(ds->IRNode(), &modified));
+    auto mind_data = std::dynamic_pointer_cast<MindDataNode>(ds->IRNode()->Children()[0]->Children()[0]);
+    ASSERT_NE(mind_data, nullptr);
+    if (num_shards == 1) {
+      EXPECT_EQ(mind_data->RowCriteria(), (std::vector<std::pair<std::string, std::string>>{{"label", "2"}}));
+    } else {
+      EXPECT_TRUE(mind_data->RowCriteria().empty());
+    }
+
+    for (int64_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+      auto sampler = std::make_shared<DistributedSampler>(num_shards, shard_id, false);
+      std::vector<std::string> expected;
+      GetFileNames(MindData(file_path, {}, sampler)->Filter(CreateLabelPredicate(2), {"label"}), &expected);
+      std::vector<std::string> file_names;
+      GetFileNames(MindData(file_path, {}, sampler)->Filter(mask, {"label"}), &file_names);
+      EXPECT_EQ(file_names, expected) << "num_shards: " << num_shards << ", shard_id: " << shard_id;
+    }
+  }
+}
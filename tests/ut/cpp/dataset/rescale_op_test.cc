@@ -46,3 +46,22 @@ TEST_F(MindDataTestRescaleOp, TestOp) {
   CheckImageShapeAndData(output_tensor, kRescale);
   MS_LOG(INFO) << "testRescale end.";
 }
+
+/// Feature: Rescale op
+/// Description: Test RescaleOp on batches of images with a type OpenCV supports and with types it does not
+/// Expectation: The supported batch is rescaled image by image, the others fail with an error
+TEST_F(MindDataTestRescaleOp, TestBatchType) {
+  auto op = std::make_unique<RescaleOp>(0.5, 1.0);
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int16_t>(2 * 2 * 3 * 3, 4), TensorShape({2, 2, 3, 3}), &input));
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op->Compute(input, &output));
+  std::shared_ptr<Tensor> expected;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<float>(2 * 2 * 3 * 3, 3.0), TensorShape({2, 2, 3, 3}), &expected));
+  EXPECT_EQ(*output, *expected);
+
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int64_t>(2 * 2 * 3 * 3, 4), TensorShape({2, 2, 3, 3}), &input));
+  EXPECT_ERROR(op->Compute(input, &output));
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<std::string>(2 * 2 * 3 * 3, "4"), TensorShape({2, 2, 3, 3}), &input));
+  EXPECT_ERROR(op->Compute(input, &output));
+}
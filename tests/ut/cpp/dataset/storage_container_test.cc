@@ -0,0 +1,118 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/engine/cache/storage_container.h"
+#include "minddata/dataset/engine/cache/storage_manager.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/random.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestStorageContainer : public UT::Common {
+ public:
+  MindDataTestStorageContainer() {}
+
+  /// \brief Generate a row of the given size filled with a pattern derived from its index
+  static std::string MakeRow(int32_t i, size_t sz) {
+    std::string row(sz, '\0');
+    for (size_t j = 0; j < sz; ++j) {
+      row[j] = static_cast<char>((i * 31 + j) % 127);
+    }
+    return row;
+  }
+};
+
+/// Feature: StorageContainer
+/// Description: Insert rows into a container and read them back with one vectored read in a random order
+/// Expectation: Every row read back is the same as the one inserted
+TEST_F(MindDataTestStorageContainer, TestReadV) {
+  Path dir("/tmp/storage_container_test");
+  ASSERT_TRUE(dir.CreateDirectories().IsOk());
+  Path file = dir / "TestReadV.LB";
+  std::shared_ptr<StorageContainer> sc;
+  ASSERT_OK(StorageContainer::CreateStorageContainer(&sc, file.ToString()));
+  const int32_t num_rows = 64;
+  std::vector<std::string> rows;
+  std::vector<off64_t> offsets;
+  for (int32_t i = 0; i < num_rows; ++i) {
+    // Mix the rows of exact block size, which are adjacent on disk, and the rows of odd size.
+    auto row = MakeRow(i, (i % 2 == 0) ? 4096 : 1000 + i);
+    off64_t offset;
+    ASSERT_OK(sc->Insert({ReadableSlice(row.data(), row.size())}, &offset));
+    rows.push_back(std::move(row));
+    offsets.push_back(offset);
+  }
+  std::vector<std::string> out(num_rows);
+  std::vector<StorageContainer::Extent> extents;
+  for (int32_t i = 0; i < num_rows; ++i) {
+    out[i].resize(rows[i].size());
+    extents.emplace_back(offsets[i], WritableSlice(out[i].data(), out[i].size()));
+  }
+  std::shuffle(extents.begin(), extents.end(), GetRandomDevice());
+  ASSERT_OK(sc->ReadV(&extents));
+  for (int32_t i = 0; i < num_rows; ++i) {
+    EXPECT_EQ(out[i], rows[i]);
+  }
+  sc.reset();
+  ASSERT_OK(file.Remove());
+}
+
+/// Feature: StorageManager
+/// Description: Write rows through a storage manager with several containers and read them back in one batch
+/// Expectation: Every row read back is the same as the one written, and the sizes are returned
+TEST_F(MindDataTestStorageContainer, TestBatchRead) {
+  Path dir("/tmp/storage_container_test/batch_read");
+  ASSERT_TRUE(dir.CreateDirectories().IsOk());
+  auto sm = std::make_shared<StorageManager>(dir, 4);
+  ASSERT_OK(sm->ServiceStart());
+  const int32_t num_rows = 200;
+  std::vector<std::string> rows;
+  std::vector<StorageManager::key_type> keys;
+  for (int32_t i = 0; i < num_rows; ++i) {
+    auto row = MakeRow(i, 500 + i * 7);
+    StorageManager::key_type key;
+    ASSERT_OK(sm->Write(&key, {ReadableSlice(row.data(), row.size())}));
+    rows.push_back(std::move(row));
+    keys.push_back(key);
+  }
+  std::vector<std::string> out(num_rows);
+  std::vector<WritableSlice> dest;
+  for (int32_t i = 0; i < num_rows; ++i) {
+    out[i].resize(rows[i].size());
+    dest.emplace_back(out[i].data(), out[i].size());
+  }
+  std::vector<size_t> bytes_read;
+  ASSERT_OK(sm->Read(keys, &dest, &bytes_read));
+  ASSERT_EQ(bytes_read.size(), num_rows);
+  for (int32_t i = 0; i < num_rows; ++i) {
+    EXPECT_EQ(bytes_read[i], rows[i].size());
+    EXPECT_EQ(out[i], rows[i]);
+  }
+  // A destination buffer smaller than the row is an error.
+  std::string small(10, '\0');
+  std::vector<WritableSlice> small_dest{WritableSlice(small.data(), small.size())};
+  EXPECT_ERROR(sm->Read({keys[0]}, &small_dest, &bytes_read));
+  ASSERT_OK(sm->ServiceStop());
+  sm.reset();
+  auto it = Path::DirIterator::OpenDirectory(&dir);
+  while (it->HasNext()) {
+    ASSERT_OK(it->Next().Remove());
+  }
+}
@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/util/memory_pool.h"
 
 using namespace mindspore::dataset;
 
@@ -587,3 +588,52 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+/// Feature: Tensor
+/// Description: Test Tensor::CreateFromExternalMemory which refers to the buffer of a memory pool in place
+/// Expectation: The tensor shares the buffer, and the memory pool is released after the tensor is destroyed
+TEST_F(MindDataTestTensorDE, TensorFromExternalMemory) {
+  // A memory pool which only counts the deallocation of its buffer
+  class CountingPool : public MemoryPool {
+   public:
+    explicit CountingPool(int32_t *num_deallocated) : num_deallocated_(num_deallocated) {}
+    ~CountingPool() override = default;
+    Status Allocate(size_t, void **) override { RETURN_STATUS_UNEXPECTED("Not supported"); }
+    Status Reallocate(void **, size_t, size_t) override { RETURN_STATUS_UNEXPECTED("Not supported"); }
+    void Deallocate(void *) override { ++(*num_deallocated_); }
+    uint64_t get_max_size() const override { return 0; }
+    int PercentFree() const override { return 0; }
+
+   private:
+    int32_t *num_deallocated_;
+  };
+
+  int32_t num_deallocated = 0;
+  std::vector<int32_t> buffer = {1, 2, 3, 4, 5, 6};
+  auto pool = std::make_shared<CountingPool>(&num_deallocated);
+  std::weak_ptr<MemoryPool> pool_ref = pool;
+  std::shared_ptr<Tensor> t;
+  Status rc = Tensor::CreateFromExternalMemory(TensorShape({2, 3}), DataType(DataType::DE_INT32),
+                                               reinterpret_cast<uchar *>(buffer.data()),
+                                               buffer.size() * sizeof(int32_t), pool, &t);
+  ASSERT_TRUE(rc.IsOk());
+  pool.reset();
+  ASSERT_EQ(t->GetBuffer(), reinterpret_cast<uchar *>(buffer.data()));
+  int32_t o;
+  t->GetItemAt<int32_t>(&o, {1, 2});
+  ASSERT_EQ(o, 6);
+  buffer[5] = 7;
+  t->GetItemAt<int32_t>(&o, {1, 2});
+  ASSERT_EQ(o, 7);
+  ASSERT_FALSE(pool_ref.expired());
+
+  t.reset();
+  ASSERT_EQ(num_deallocated, 1);
+  ASSERT_TRUE(pool_ref.expired());
+
+  // The length must match the shape
+  rc = Tensor::CreateFromExternalMemory(TensorShape({2, 2}), DataType(DataType::DE_INT32),
+                                        reinterpret_cast<uchar *>(buffer.data()), buffer.size() * sizeof(int32_t),
+                                        std::make_shared<CountingPool>(&num_deallocated), &t);
+  ASSERT_TRUE(rc.IsError());
+}
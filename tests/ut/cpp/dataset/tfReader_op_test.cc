@@ -13,12 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -28,7 +32,55 @@ namespace common = mindspore::common;
 
 using namespace mindspore::dataset;
 
-class MindDataTestTFReaderOp : public UT::DatasetOpTesting {};
+class MindDataTestTFReaderOp : public UT::DatasetOpTesting {
+ protected:
+  /// \brief Build the schema and a serialized Example with an image, a label and a list of weights
+  static std::unique_ptr<DataSchema> MakeExample(std::string *serialized, int32_t image_size, int32_t num_weights) {
+    auto schema = std::make_unique<DataSchema>();
+    TensorShape scalar = TensorShape::CreateScalar();
+    (void)schema->AddColumn(ColDescriptor("image", DataType(DataType::DE_UINT8), TensorImpl::kFlexible, 1));
+    (void)schema->AddColumn(ColDescriptor("label", DataType(DataType::DE_INT32), TensorImpl::kFlexible, 0, &scalar));
+    (void)schema->AddColumn(ColDescriptor("weights", DataType(DataType::DE_FLOAT32), TensorImpl::kFlexible, 1));
+    dataengine::Example example;
+    auto *features = example.mutable_features()->mutable_feature();
+    (*features)["image"].mutable_bytes_list()->add_value(std::string(image_size, 'x'));
+    (*features)["label"].mutable_int64_list()->add_value(-7);
+    for (int32_t i = 0; i < num_weights; ++i) {
+      (*features)["weights"].mutable_float_list()->add_value(static_cast<float>(i) / 4);
+    }
+    (*features)["unused"].mutable_int64_list()->add_value(1);
+    *serialized = example.SerializeAsString();
+    return schema;
+  }
+
+  /// \brief Build the schema and a serialized Example of many small numeric features, like the rows of a
+  ///     recommendation model: scalar int64 ids, short float32 lists, and features which are not in the schema
+  static std::unique_ptr<DataSchema> MakeSmallFeaturesExample(std::string *serialized, int32_t num_ids,
+                                                              int32_t num_floats, int32_t num_unused) {
+    const int32_t float_list_size = 4;
+    auto schema = std::make_unique<DataSchema>();
+    TensorShape scalar = TensorShape::CreateScalar();
+    dataengine::Example example;
+    auto *features = example.mutable_features()->mutable_feature();
+    for (int32_t i = 0; i < num_ids; ++i) {
+      std::string name = "id_" + std::to_string(i);
+      (void)schema->AddColumn(ColDescriptor(name, DataType(DataType::DE_INT64), TensorImpl::kFlexible, 0, &scalar));
+      (*features)[name].mutable_int64_list()->add_value(static_cast<int64_t>(i) * 1000003);
+    }
+    for (int32_t i = 0; i < num_floats; ++i) {
+      std::string name = "float_" + std::to_string(i);
+      (void)schema->AddColumn(ColDescriptor(name, DataType(DataType::DE_FLOAT32), TensorImpl::kFlexible, 1));
+      for (int32_t j = 0; j < float_list_size; ++j) {
+        (*features)[name].mutable_float_list()->add_value(static_cast<float>(i + j) / 8);
+      }
+    }
+    for (int32_t i = 0; i < num_unused; ++i) {
+      (*features)["unused_" + std::to_string(i)].mutable_int64_list()->add_value(i);
+    }
+    *serialized = example.SerializeAsString();
+    return schema;
+  }
+};
 
 /// Feature: TFReader op
 /// Description: Test TFReaderOp with large rows per buffer
@@ -270,6 +322,50 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderOneThread) {
   ASSERT_EQ(row_count, 12);
 }
 
+/// Feature: TFReader op
+/// Description: Test TFReaderOp with the crc check enabled on a file whose data of the first record is corrupted
+/// Expectation: The iteration fails with the crc mismatch of the data of the row
+TEST_F(MindDataTestTFReaderOp, TestTFReaderCorruptRecord) {
+  std::string dataset_path = "./corrupt_test.data";
+  {
+    std::ifstream src(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    ASSERT_TRUE(src.is_open());
+    std::string content((std::istreambuf_iterator<char>(src)), std::istreambuf_iterator<char>());
+    // Skip the length and the crc of the length, flip a byte of the serialized Example
+    const size_t data_offset = sizeof(int64_t) + sizeof(uint32_t);
+    ASSERT_GT(content.size(), data_offset + 1);
+    content[data_offset + 1] = static_cast<char>(~content[data_offset + 1]);
+    std::ofstream dst(dataset_path, std::ios::binary | std::ios::trunc);
+    dst.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  bool enable_crc_check = config_manager->enable_tfrecord_crc_check();
+  config_manager->set_enable_tfrecord_crc_check(true);
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  ASSERT_OK(schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {}));
+  std::shared_ptr<TFReaderOp> my_tfreader_op = std::make_shared<TFReaderOp>(
+    1, config_manager->worker_connector_size(), 0, std::vector<std::string>{dataset_path}, std::move(schema),
+    config_manager->op_connector_size(), std::vector<std::string>{}, false, 1, 0, false);
+  config_manager->set_enable_tfrecord_crc_check(enable_crc_check);
+  ASSERT_OK(my_tfreader_op->Init());
+  ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+  ASSERT_OK(my_tree->AssignRoot(my_tfreader_op));
+  ASSERT_OK(my_tree->Prepare());
+  ASSERT_OK(my_tree->Launch());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  Status rc = di.FetchNextTensorRow(&tensor_list);
+  while (rc.IsOk() && !tensor_list.empty()) {
+    rc = di.FetchNextTensorRow(&tensor_list);
+  }
+  EXPECT_ERROR(rc);
+  EXPECT_NE(rc.ToString().find("the crc of the data of row 0 does not match"), std::string::npos) << rc.ToString();
+  (void)std::remove(dataset_path.c_str());
+}
+
 /// Feature: TFReader op
 /// Description: Test TFReaderOp that takes 1 buffer
 /// Expectation: Runs successfully and equal row count
@@ -378,3 +474,120 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+/// Feature: TFExampleParser
+/// Description: Decode serialized Examples with the wire format parser
+/// Expectation: The columns are the same as the protobuf path produces, and the records the parser does not
+///     handle are reported back instead of failing
+TEST_F(MindDataTestTFReaderOp, TestTFExampleParser) {
+  dataengine::Example example;
+  auto *features = example.mutable_features()->mutable_feature();
+  (*features)["image"].mutable_bytes_list()->add_value("abc");
+  (*features)["image"].mutable_bytes_list()->add_value("de");
+  (*features)["label"].mutable_int64_list()->add_value(-7);
+  (*features)["weights"].mutable_float_list()->add_value(1.5);
+  (*features)["weights"].mutable_float_list()->add_value(-2.25);
+  (*features)["unused"].mutable_float_list()->add_value(0);
+
+  std::string serialized;
+  auto schema = MakeExample(&serialized, 0, 0);
+  ASSERT_TRUE(TFExampleParser::IsSupported(*schema));
+  TFExampleParser parser(*schema);
+  TensorRow row(schema->NumColumns(), nullptr);
+  bool parsed = false;
+  ASSERT_OK(parser.Parse(example.SerializeAsString(), &row, &parsed));
+  ASSERT_TRUE(parsed);
+
+  std::shared_ptr<Tensor> expected;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{'a', 'b', 'c', 'd', 'e', ' '}, &expected));
+  EXPECT_EQ(*row[0], *expected);
+  ASSERT_OK(Tensor::CreateScalar<int32_t>(-7, &expected));
+  EXPECT_EQ(*row[1], *expected);
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<float>{1.5, -2.25}, &expected));
+  EXPECT_EQ(*row[2], *expected);
+
+  // A column of the wrong type is left to protobuf, which reports the error
+  (*features)["weights"].mutable_int64_list()->add_value(1);
+  ASSERT_OK(parser.Parse(example.SerializeAsString(), &row, &parsed));
+  EXPECT_FALSE(parsed);
+
+  // So is a missing column
+  features->erase("weights");
+  ASSERT_OK(parser.Parse(example.SerializeAsString(), &row, &parsed));
+  EXPECT_FALSE(parsed);
+
+  // And a truncated record
+  ASSERT_OK(parser.Parse(serialized.substr(0, serialized.size() - 1), &row, &parsed));
+  EXPECT_FALSE(parsed);
+
+  // String columns are not decoded by the parser
+  DataSchema string_schema;
+  ASSERT_OK(string_schema.AddColumn(ColDescriptor("text", DataType(DataType::DE_STRING), TensorImpl::kFlexible, 1)));
+  EXPECT_FALSE(TFExampleParser::IsSupported(string_schema));
+}
+
+/// Feature: TFExampleParser
+/// Description: Compare the records per second of the wire format parser and of the protobuf path of TFReaderOp on
+///     the same records of many small numeric features. It is a benchmark whose timing depends on the machine, so it
+///     is disabled by default and run with --gtest_also_run_disabled_tests
+/// Expectation: Both decode every record to the same row, and the wire format parser is faster
+TEST_F(MindDataTestTFReaderOp, DISABLED_TestTFExampleParserPerf) {
+  const int32_t num_records = 5000;
+  std::string serialized;
+  auto schema = MakeSmallFeaturesExample(&serialized, 128, 128, 64);
+  TFExampleParser parser(*schema);
+
+  TensorRow fast_row;
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_records; ++i) {
+    TensorRow row(schema->NumColumns(), nullptr);
+    bool parsed = false;
+    ASSERT_OK(parser.Parse(serialized, &row, &parsed));
+    ASSERT_TRUE(parsed);
+    fast_row = std::move(row);
+  }
+  std::chrono::duration<double> fast_time = std::chrono::steady_clock::now() - start;
+
+  // The same steps as TFReaderOp::LoadExample for the int64 and float32 columns
+  TensorRow protobuf_row;
+  start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_records; ++i) {
+    TensorRow row(schema->NumColumns(), nullptr);
+    dataengine::Example example;
+    ASSERT_TRUE(example.ParseFromString(serialized));
+    const auto &features = example.features().feature();
+    for (int32_t col = 0; col < schema->NumColumns(); ++col) {
+      const ColDescriptor &current_col = schema->Column(col);
+      const auto &feature = features.at(current_col.Name());
+      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+      if (current_col.Type() == DataType::DE_INT64) {
+        const auto &int64_list = feature.int64_list();
+        ASSERT_OK(current_col.MaterializeTensorShape(int64_list.value_size(), &current_shape));
+        ASSERT_OK(Tensor::CreateEmpty(current_shape, current_col.Type(), &row[col]));
+        int64_t index = 0;
+        for (auto it = row[col]->begin<int64_t>(); it != row[col]->end<int64_t>(); ++it) {
+          *it = int64_list.value(index++);
+        }
+      } else {
+        const auto &float_list = feature.float_list();
+        auto float_array = std::make_unique<float[]>(float_list.value_size());
+        for (int32_t index = 0; index < float_list.value_size(); ++index) {
+          float_array[index] = float_list.value(index);
+        }
+        ASSERT_OK(current_col.MaterializeTensorShape(float_list.value_size(), &current_shape));
+        ASSERT_OK(Tensor::CreateFromMemory(current_shape, current_col.Type(),
+                                           reinterpret_cast<const uchar *>(float_array.get()), &row[col]));
+      }
+    }
+    protobuf_row = std::move(row);
+  }
+  std::chrono::duration<double> protobuf_time = std::chrono::steady_clock::now() - start;
+
+  MS_LOG(INFO) << "TFExampleParser: " << num_records / fast_time.count() << " records/sec, protobuf: "
+               << num_records / protobuf_time.count() << " records/sec.";
+  ASSERT_EQ(fast_row.size(), protobuf_row.size());
+  for (size_t i = 0; i < fast_row.size(); ++i) {
+    EXPECT_EQ(*fast_row[i], *protobuf_row[i]);
+  }
+  EXPECT_LT(fast_time.count(), protobuf_time.count());
+}
@@ -0,0 +1,188 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kDeviceMemSize = 256 << 20;
+constexpr size_t kUnitSize = 32 << 20;
+}  // namespace
+
+// The memory pool whose device memory is the host memory.
+class HostMemoryPool : public DynamicMemPoolBestFit {
+ public:
+  HostMemoryPool() { SetMemAllocUintSize(kUnitSize, kUnitSize); }
+  ~HostMemoryPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    if (used_size_ + size > kDeviceMemSize) {
+      return 0;
+    }
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    used_size_ += size;
+    sizes_[*addr] = size;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    used_size_ -= sizes_[addr];
+    (void)sizes_.erase(addr);
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return kDeviceMemSize - used_size_; }
+
+ private:
+  size_t used_size_{0};
+  std::map<DeviceMemPtr, size_t> sizes_;
+};
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() {}
+};
+
+/// Feature: size class cache of dynamic memory pool.
+/// Description: alloc and free small and large tensors with the size class cache enabled.
+/// Expectation: the small tensors come from the cache without overlap, and the large tensors from the best-fit pool.
+TEST_F(TestDynamicMemPool, TestSizeClassCacheAllocFree) {
+  HostMemoryPool pool;
+  pool.EnableSizeClassCache(true);
+  ASSERT_TRUE(pool.IsSizeClassCacheEnabled());
+  std::vector<size_t> sizes = {1, 512, 513, 3000, 4097, 100000, 1 << 20, (1 << 20) + 1, 8 << 20};
+  std::vector<std::pair<uint8_t *, size_t>> addrs;
+  for (size_t round = 0; round < 10; ++round) {
+    for (auto size : sizes) {
+      auto addr = static_cast<uint8_t *>(pool.AllocTensorMem(size));
+      ASSERT_NE(addr, nullptr);
+      addrs.emplace_back(addr, size);
+    }
+  }
+  // The allocated memory must not overlap.
+  std::map<uint8_t *, size_t> ranges(addrs.begin(), addrs.end());
+  ASSERT_EQ(ranges.size(), addrs.size());
+  uint8_t *prev_end = nullptr;
+  for (const auto &range : ranges) {
+    ASSERT_GE(range.first, prev_end);
+    prev_end = range.first + range.second;
+  }
+  for (const auto &addr : addrs) {
+    pool.FreeTensorMem(addr.first);
+  }
+  pool.DumpDynamicMemPoolStateInfo();
+  const auto &stats = pool.size_class_cache()->statistics();
+  ASSERT_GT(stats.thread_cache_hit_count_.load(), 0);
+  ASSERT_EQ(stats.in_used_size_.load(), 0);
+  // Only the slabs are still in use after all tensors are freed.
+  ASSERT_EQ(pool.TotalUsedMemStatistics(), stats.slab_total_size_.load());
+}
+
+/// Feature: size class cache of dynamic memory pool.
+/// Description: alloc and free tensors from multiple threads, then alloc a tensor which needs the idle slabs.
+/// Expectation: the idle slabs are given back to the best-fit pool when the device memory is exhausted.
+TEST_F(TestDynamicMemPool, TestSizeClassCacheReleaseIdleSlabs) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kAllocNum = 500;
+  constexpr size_t kTensorSize = 64 << 10;
+  HostMemoryPool pool;
+  pool.EnableSizeClassCache(true);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool]() {
+      std::vector<DeviceMemPtr> addrs;
+      for (size_t j = 0; j < kAllocNum; ++j) {
+        auto addr = pool.AllocTensorMem(kTensorSize);
+        ASSERT_NE(addr, nullptr);
+        addrs.push_back(addr);
+      }
+      for (auto addr : addrs) {
+        pool.FreeTensorMem(addr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_GT(pool.size_class_cache()->statistics().slab_total_size_.load(), 0);
+  // The whole device memory is only available after the slabs are released.
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kDeviceMemSize / kUnitSize; ++i) {
+    auto addr = pool.AllocTensorMem(kUnitSize);
+    ASSERT_NE(addr, nullptr);
+    addrs.push_back(addr);
+  }
+  ASSERT_EQ(pool.size_class_cache()->statistics().slab_total_size_.load(), 0);
+  for (auto addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+}
+
+/// Feature: trace record and replay of dynamic memory pool.
+/// Description: record the alloc and free of a memory pool, then replay the trace on another memory pool.
+/// Expectation: all the operations are replayed, and the replay reaches the same peak memory as the recording.
+TEST_F(TestDynamicMemPool, TestMemTraceRecordAndReplay) {
+  const std::string trace_path = "./dynamic_mem_pool_test.trace";
+  HostMemoryPool record_pool;
+  ASSERT_TRUE(record_pool.StartMemTrace(trace_path));
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 100; ++i) {
+    DynamicMemAllocatorDebugInfo::SetDebugInfo("Test", AllocatorType::kKernelOutput);
+    addrs.push_back(record_pool.AllocTensorMem((i + 1) * 4096, i % 10 == 0));
+    if (i % 3 == 0) {
+      record_pool.FreeTensorMem(addrs[i / 2]);
+      addrs[i / 2] = nullptr;
+    }
+  }
+  auto continuous_addrs = record_pool.AllocContinuousTensorMem({1024, 2048, 4096});
+  ASSERT_EQ(continuous_addrs.size(), 3);
+  for (auto addr : continuous_addrs) {
+    record_pool.FreeTensorMem(addr);
+  }
+  for (auto addr : addrs) {
+    if (addr != nullptr) {
+      record_pool.FreeTensorMem(addr);
+    }
+  }
+  record_pool.StopMemTrace();
+
+  std::vector<MemTraceRecord> records;
+  ASSERT_TRUE(LoadMemTrace(trace_path, &records));
+  // The continuous alloc is recorded as one record for each tensor.
+  ASSERT_EQ(records.size(), 100 + 34 + 3 + 3 + 100 - 34);
+  HostMemoryPool replay_pool;
+  MemTraceReplayer replayer(&replay_pool);
+  auto result = replayer.Replay(records);
+  std::cout << MemTraceReplayer::ResultInfo(result) << std::endl;
+  ASSERT_EQ(result.alloc_count_, 101);
+  ASSERT_EQ(result.free_count_, 100 + 3);
+  ASSERT_EQ(result.alloc_fail_count_, 0);
+  ASSERT_EQ(result.unmatched_free_count_, 0);
+  ASSERT_GT(result.peak_used_mem_size_, 0);
+  ASSERT_LE(result.peak_used_mem_size_, record_pool.UsedMemPeakStatistics());
+  ASSERT_EQ(replay_pool.TotalUsedMemStatistics(), 0);
+  (void)remove(trace_path.c_str());
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "distributed/embedding_cache/cache_eviction_policy.h"
+#include "distributed/embedding_cache/embedding_hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+// Evict any index.
+bool CanEvictAll(int) { return true; }
+}  // namespace
+
+class TestCacheEvictionPolicy : public UT::Common {
+ public:
+  TestCacheEvictionPolicy() = default;
+  virtual ~TestCacheEvictionPolicy() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: embedding cache eviction policy.
+/// Description: parse the policy name and create the policy.
+/// Expectation: the unknown name falls back to clock policy, which has no policy object.
+TEST_F(TestCacheEvictionPolicy, test_create_policy) {
+  EXPECT_EQ(GetCacheEvictionPolicyType(""), CacheEvictionPolicyType::kClock);
+  EXPECT_EQ(GetCacheEvictionPolicyType("LRU"), CacheEvictionPolicyType::kLRU);
+  EXPECT_EQ(GetCacheEvictionPolicyType("lfu"), CacheEvictionPolicyType::kLFU);
+  EXPECT_EQ(GetCacheEvictionPolicyType("arc"), CacheEvictionPolicyType::kARC);
+  EXPECT_EQ(GetCacheEvictionPolicyType("fifo"), CacheEvictionPolicyType::kClock);
+  EXPECT_EQ(GetCacheEvictionPolicyName(CacheEvictionPolicyType::kARC), "arc");
+  EXPECT_EQ(CreateCacheEvictionPolicy(CacheEvictionPolicyType::kClock, 8), nullptr);
+  EXPECT_NE(CreateCacheEvictionPolicy(CacheEvictionPolicyType::kLRU, 8), nullptr);
+}
+
+/// Feature: embedding cache eviction policy.
+/// Description: access the indices of LRU and LFU policy and select the victim.
+/// Expectation: LRU selects the least recently used index, LFU selects the least frequently used index, and the index
+/// which can not be evicted is skipped.
+TEST_F(TestCacheEvictionPolicy, test_lru_lfu_policy) {
+  LRUCacheEvictionPolicy lru(4);
+  LFUCacheEvictionPolicy lfu(4);
+  for (int i = 0; i < 4; ++i) {
+    lru.Insert(i, i);
+    lfu.Insert(i, i);
+  }
+  lru.Access(0);
+  lfu.Access(0);
+  lfu.Access(1);
+  lfu.Access(1);
+  EXPECT_EQ(lru.SelectVictim(10, CanEvictAll), 1);
+  EXPECT_EQ(lru.SelectVictim(10, [](int index) { return index != 1; }), 2);
+  EXPECT_EQ(lfu.SelectVictim(10, CanEvictAll), 2);
+
+  lru.Evict(1, 1);
+  lru.Insert(10, 1);
+  EXPECT_EQ(lru.SelectVictim(11, CanEvictAll), 2);
+  lfu.Evict(2, 2);
+  lfu.Insert(10, 2);
+  EXPECT_EQ(lfu.SelectVictim(11, CanEvictAll), 3);
+  EXPECT_EQ(lfu.SelectVictim(11, [](int index) { return index == 1; }), 1);
+  EXPECT_EQ(lfu.SelectVictim(11, [](int) { return false; }), INVALID_INDEX_VALUE);
+}
+
+/// Feature: embedding cache eviction policy.
+/// Description: scan a large number of ids once in an ARC cache of frequently used ids.
+/// Expectation: the frequently used ids are kept, and the hit on the ghost list enlarges the recent list.
+TEST_F(TestCacheEvictionPolicy, test_arc_policy) {
+  constexpr int kCapacity = 4;
+  ARCCacheEvictionPolicy arc(kCapacity);
+  std::vector<int> index_to_id(kCapacity);
+  for (int i = 0; i < kCapacity; ++i) {
+    arc.Insert(i, i);
+    arc.Access(i);
+    index_to_id[i] = i;
+  }
+  // The scanned ids are inserted and evicted in the recent list.
+  arc.Evict(index_to_id[0], 0);
+  arc.Insert(100, 0);
+  index_to_id[0] = 100;
+  for (int id = 101; id < 110; ++id) {
+    auto index = arc.SelectVictim(id, CanEvictAll);
+    EXPECT_EQ(index, 0);
+    arc.Evict(index_to_id[index], index);
+    arc.Insert(id, index);
+    index_to_id[index] = id;
+  }
+  EXPECT_EQ(arc.recent_target_size(), 0);
+
+  // The id 108 is in the ghost list of the recent list.
+  auto index = arc.SelectVictim(108, CanEvictAll);
+  arc.Evict(index_to_id[index], index);
+  arc.Insert(108, index);
+  EXPECT_EQ(arc.recent_target_size(), 1);
+}
+
+/// Feature: embedding cache eviction policy.
+/// Description: fill the embedding hash map with the ids of a data step, then parse a new id while the graph runs the
+/// steps before, at and after that step.
+/// Expectation: no index is evicted before the step runs, the index is evicted after waiting for the graph while the
+/// step runs, and the expired index is evicted without waiting after the step.
+TEST_F(TestCacheEvictionPolicy, test_hash_map_pending_steps) {
+  // The first and last indices are reserved.
+  constexpr size_t kCapacity = 10;
+  for (auto type : {CacheEvictionPolicyType::kLRU, CacheEvictionPolicyType::kLFU, CacheEvictionPolicyType::kARC}) {
+    EmbeddingHashMap hash_map(0, kCapacity, type);
+    std::vector<int> swap_out_index(kCapacity);
+    std::vector<int> swap_out_ids(kCapacity);
+    size_t swap_out_size = 0;
+    bool need_wait_graph = false;
+    for (int id = 0; id < static_cast<int>(kCapacity - 2); ++id) {
+      ASSERT_NE(hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 0, &swap_out_size,
+                                   &need_wait_graph),
+                INVALID_INDEX_VALUE);
+    }
+    EXPECT_EQ(swap_out_size, 0);
+
+    int new_id = kCapacity;
+    EXPECT_EQ(hash_map.ParseData(new_id, swap_out_index.data(), swap_out_ids.data(), 2, 0, &swap_out_size,
+                                 &need_wait_graph),
+              INVALID_INDEX_VALUE);
+    EXPECT_EQ(swap_out_size, 0);
+
+    auto index = hash_map.ParseData(new_id, swap_out_index.data(), swap_out_ids.data(), 2, 1, &swap_out_size,
+                                    &need_wait_graph);
+    ASSERT_NE(index, INVALID_INDEX_VALUE);
+    EXPECT_TRUE(need_wait_graph);
+    ASSERT_EQ(swap_out_size, 1);
+    EXPECT_EQ(swap_out_index[0], index);
+
+    need_wait_graph = false;
+    index = hash_map.ParseData(new_id + 1, swap_out_index.data(), swap_out_ids.data(), 3, 2, &swap_out_size,
+                               &need_wait_graph);
+    ASSERT_NE(index, INVALID_INDEX_VALUE);
+    EXPECT_FALSE(need_wait_graph);
+    ASSERT_EQ(swap_out_size, 2);
+    EXPECT_EQ(hash_map.hash_step(index), 3);
+    EXPECT_NE(swap_out_ids[1], new_id);
+  }
+}
+
+/// Feature: embedding cache eviction policy.
+/// Description: parse the skewed batches by the embedding hash map with all policies like EmbeddingCachePrefetchActor.
+/// Expectation: every id of a batch has a unique cache index, and the hit rate and swap size of policies are printed.
+TEST_F(TestCacheEvictionPolicy, test_hash_map_with_policies) {
+  constexpr size_t kCapacity = 2000;
+  constexpr size_t kBatchSize = 500;
+  constexpr size_t kStepNum = 200;
+  constexpr int kVocabSize = 100000;
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(0, 1);
+  std::vector<std::vector<int>> batches(kStepNum, std::vector<int>(kBatchSize));
+  for (auto &batch : batches) {
+    for (auto &id : batch) {
+      auto ratio = dist(gen);
+      id = static_cast<int>(ratio * ratio * ratio * kVocabSize);
+    }
+  }
+
+  for (auto type : {CacheEvictionPolicyType::kClock, CacheEvictionPolicyType::kLRU, CacheEvictionPolicyType::kLFU,
+                    CacheEvictionPolicyType::kARC}) {
+    EmbeddingHashMap hash_map(0, kCapacity, type);
+    std::vector<int> swap_out_index(kBatchSize);
+    std::vector<int> swap_out_ids(kBatchSize);
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t total_swap_out_size = 0;
+    for (size_t data_step = 1; data_step <= kStepNum; ++data_step) {
+      hash_map.Reset();
+      size_t swap_out_size = 0;
+      bool need_wait_graph = false;
+      for (auto id : batches[data_step - 1]) {
+        const auto &iter = hash_map.hash_id_to_index().find(id);
+        if (iter != hash_map.hash_id_to_index().end()) {
+          if (hash_map.hash_step(iter->second) != data_step) {
+            ++hit_count;
+            hash_map.set_hash_step(iter->second, data_step);
+            hash_map.AccessIndex(iter->second);
+          }
+          continue;
+        }
+        auto index = hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), data_step, data_step - 1,
+                                        &swap_out_size, &need_wait_graph);
+        ASSERT_NE(index, INVALID_INDEX_VALUE);
+        ++miss_count;
+      }
+      total_swap_out_size += swap_out_size;
+      EXPECT_LE(hash_map.hash_id_to_index().size(), kCapacity - 2);
+      for (auto id : batches[data_step - 1]) {
+        const auto &iter = hash_map.hash_id_to_index().find(id);
+        ASSERT_TRUE(iter != hash_map.hash_id_to_index().end());
+        EXPECT_EQ(hash_map.hash_step(iter->second), data_step);
+      }
+    }
+    MS_LOG(INFO) << "Eviction policy " << GetCacheEvictionPolicyName(type)
+                 << ", hit rate: " << static_cast<double>(hit_count) / (hit_count + miss_count)
+                 << ", swap in size: " << miss_count << ", swap out size: " << total_swap_out_size;
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
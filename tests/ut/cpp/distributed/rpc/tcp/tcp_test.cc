@@ -18,6 +18,8 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <thread>
 #include <csignal>
@@ -328,6 +330,82 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test sending messages of different sizes with and without zero copy.
+/// Description: start a socket server and send the messages from 1KB to 4MB whose body is the real data pointer, and
+/// enable zero copy sending by the environment variable for the second round. Close the client without flushing it.
+/// Expectation: the server received all the messages intact, and the free callback is called once for every message
+/// by the time the client is closed.
+TEST_F(TCPTest, SendMessagesThroughput) {
+  constexpr size_t kMaxMsgSize = 4 << 20;
+  constexpr size_t kTotalSizePerRound = 16 << 20;
+  constexpr size_t kMaxMsgCnt = 256;
+  constexpr size_t kMinMsgCnt = 2;
+  auto send_buffer = std::make_unique<char[]>(kMaxMsgSize);
+  auto recv_buffer = std::make_unique<char[]>(kMaxMsgSize);
+  for (size_t i = 0; i < kMaxMsgSize; ++i) {
+    send_buffer[i] = static_cast<char>(i % 251);
+  }
+
+  for (bool zero_copy : {false, true}) {
+    Init();
+    if (zero_copy) {
+      (void)setenv(kEnvRpcZeroCopyThreshold, "65536", 1);
+    }
+
+    // Start the tcp server which receives all the messages to the same buffer and checks their body.
+    std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+    bool ret = server->Initialize([&recv_buffer](size_t size) -> void * { return recv_buffer.get(); });
+    ASSERT_TRUE(ret);
+    std::atomic<size_t> corrupted_num(0);
+    server->SetMessageHandler([&send_buffer, &corrupted_num](MessageBase *const message) -> MessageBase *const {
+      if (message->data == nullptr || memcmp(message->data, send_buffer.get(), message->size) != 0) {
+        ++corrupted_num;
+      }
+      IncrDataMsgNum(1);
+      delete message;
+      return NULL_MSG;
+    });
+
+    // Start the tcp client whose free callback only counts the released messages.
+    auto client_url = "127.0.0.1:1234";
+    std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+    ret = client->Initialize();
+    ASSERT_TRUE(ret);
+    auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+    std::atomic<size_t> free_num(0);
+    client->Connect(server_url, 60, [&free_num](void *data) {
+      ++free_num;
+      return true;
+    });
+
+    size_t total_msg_cnt = 0;
+    for (size_t msg_size = 1024; msg_size <= kMaxMsgSize; msg_size *= 4) {
+      size_t msg_cnt = std::max(kMinMsgCnt, std::min(kMaxMsgCnt, kTotalSizePerRound / msg_size));
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < msg_cnt; ++i) {
+        auto message = CreateMessage(server_url, client_url, 0);
+        message->data = send_buffer.get();
+        message->size = msg_size;
+        EXPECT_EQ(static_cast<int>(msg_size), client->SendSync(std::move(message)));
+      }
+      total_msg_cnt += msg_cnt;
+      WaitForDataMsg(total_msg_cnt, 60);
+      ASSERT_EQ(total_msg_cnt, GetDataMsgNum());
+      std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+      MS_LOG(INFO) << "Message size: " << msg_size << "B, zero copy: " << zero_copy
+                   << ", throughput: " << msg_size * msg_cnt / cost.count() / (1 << 30) << "GB/s";
+    }
+    EXPECT_EQ(0U, corrupted_num.load());
+
+    // The messages sent with zero copy which are not released yet are released when the connection is closed.
+    client->Disconnect(server_url);
+    client->Finalize();
+    EXPECT_EQ(total_msg_cnt, free_num.load());
+    server->Finalize();
+    (void)unsetenv(kEnvRpcZeroCopyThreshold);
+  }
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
@@ -312,6 +312,7 @@ void ShardWriterImageNetOpenForAppend(string filename) {
     string db_name = std::string("./OpenForAppendSample.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
   }
 
   // load binary data
@@ -14,9 +14,15 @@
  * limitations under the License.
  */
 
+#include <utime.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,6 +47,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     }
   }
 };
@@ -239,5 +246,342 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+/// Feature: read mindrecord files by positional read.
+/// Description: write a 16MB mindrecord dataset, read it with 1 to 16 consumers by file streams and pread.
+/// Expectation: both read modes return the same rows, and the rows/s of every mode and consumer number is logged.
+TEST_F(TestShardReader, TestShardReaderReadModeThroughput) {
+  constexpr uint64_t kTotalSize = 16 << 20;
+  constexpr uint64_t kRowSize = 64 << 10;
+  constexpr uint64_t kRowNum = kTotalSize / kRowSize;
+  constexpr uint64_t kRowNumPerWrite = 64;
+  std::vector<std::string> file_names;
+  for (int i = 1; i <= 4; i++) {
+    file_names.emplace_back(std::string("./read_mode.shard0") + std::to_string(i));
+  }
+
+  ShardHeader header_data;
+  json schema_json = R"({"label": {"type": "int64"}, "data": {"type": "bytes"}})"_json;
+  auto schema = Schema::Build("read_mode", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  auto schema_id = header_data.AddSchema(schema);
+  ASSERT_TRUE(header_data.AddIndexFields({{schema_id, "label"}}).IsOk());
+  ShardWriter writer;
+  ASSERT_TRUE(writer.Open(file_names).IsOk());
+  ASSERT_TRUE(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+  std::vector<std::vector<uint8_t>> blobs(kRowNumPerWrite, std::vector<uint8_t>(kRowSize));
+  for (uint64_t start = 0; start < kRowNum; start += kRowNumPerWrite) {
+    std::map<uint64_t, std::vector<json>> raw_data;
+    for (uint64_t i = 0; i < kRowNumPerWrite; ++i) {
+      raw_data[schema_id].push_back(json{{"label", start + i}});
+      std::fill(blobs[i].begin(), blobs[i].end(), static_cast<uint8_t>(start + i));
+    }
+    ASSERT_TRUE(writer.WriteRawData(raw_data, blobs).IsOk());
+  }
+  ASSERT_TRUE(writer.Commit().IsOk());
+  ASSERT_TRUE(ShardIndexGenerator::Finalize(file_names).IsOk());
+
+  for (const std::string read_mode : {"stream", "pread"}) {
+    (void)setenv(kEnvReadMode, read_mode.c_str(), 1);
+    for (int n_consumer : {1, 4, 16}) {
+      ShardReader dataset;
+      ASSERT_TRUE(dataset.Open({file_names[0]}, true, n_consumer, {"label", "data"}).IsOk());
+      ASSERT_EQ(dataset.GetReadMode(), read_mode == "pread" ? ShardReadMode::kPositional : ShardReadMode::kStream);
+      auto start_time = std::chrono::steady_clock::now();
+      ASSERT_TRUE(dataset.Launch().IsOk());
+      uint64_t row_num = 0;
+      uint64_t label_sum = 0;
+      while (true) {
+        auto rows = dataset.GetNext();
+        if (rows.empty()) {
+          break;
+        }
+        for (auto &row : rows) {
+          auto label = std::get<1>(row)["label"].get<uint64_t>();
+          const auto &blob = std::get<0>(row);
+          ASSERT_GE(blob.size(), kRowSize);
+          ASSERT_EQ(blob.back(), static_cast<uint8_t>(label));
+          label_sum += label;
+          ++row_num;
+        }
+      }
+      auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+      dataset.Close();
+      EXPECT_EQ(row_num, kRowNum);
+      EXPECT_EQ(label_sum, kRowNum * (kRowNum - 1) / 2);
+      MS_LOG(INFO) << "Read mode " << read_mode << ", consumer number " << n_consumer << ", rows/s: " << row_num / cost
+                   << ", GB/s: " << row_num * kRowSize / cost / (1 << 30);
+    }
+  }
+  (void)unsetenv(kEnvReadMode);
+
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name));
+    remove(common::SafeCStr(file_name + ".db"));
+    remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+  }
+}
+
+/// Feature: columnar index of mindrecord files.
+/// Description: write a 250-shard dataset, open it and filter it by category with the columnar index and with sqlite.
+/// Expectation: both indexes return the same rows, the columnar index of every shard is loaded if it exists, and the
+///     latency of both indexes is logged.
+TEST_F(TestShardReader, TestShardReaderColumnarIndexLatency) {
+  constexpr int kShardNum = 250;
+  constexpr uint64_t kRowNum = 20000;
+  constexpr uint64_t kClassNum = 10;
+  std::vector<std::string> file_names;
+  for (int i = 0; i < kShardNum; i++) {
+    file_names.emplace_back(std::string("./columnar.shard") + std::to_string(i));
+  }
+
+  ShardHeader header_data;
+  json schema_json = R"({"label": {"type": "int64"}, "name": {"type": "string"}, "data": {"type": "bytes"}})"_json;
+  auto schema = Schema::Build("columnar", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  auto schema_id = header_data.AddSchema(schema);
+  ASSERT_TRUE(header_data.AddIndexFields({{schema_id, "label"}, {schema_id, "name"}}).IsOk());
+  ShardWriter writer;
+  ASSERT_TRUE(writer.Open(file_names).IsOk());
+  ASSERT_TRUE(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+  std::map<uint64_t, std::vector<json>> raw_data;
+  std::vector<std::vector<uint8_t>> blobs;
+  for (uint64_t i = 0; i < kRowNum; ++i) {
+    raw_data[schema_id].push_back(json{{"label", i % kClassNum}, {"name", "class_" + std::to_string(i % kClassNum)}});
+    blobs.emplace_back(std::vector<uint8_t>(16, static_cast<uint8_t>(i)));
+  }
+  ASSERT_TRUE(writer.WriteRawData(raw_data, blobs).IsOk());
+  ASSERT_TRUE(writer.Commit().IsOk());
+  ASSERT_TRUE(ShardIndexGenerator::Finalize(file_names).IsOk());
+  for (const auto &file_name : file_names) {
+    ASSERT_TRUE(ShardColumnarIndex::Exist(file_name));
+  }
+
+  // return the row number, the latency of open and the latency of launch which creates the tasks by index
+  auto read_all = [&file_names](const std::vector<std::shared_ptr<ShardOperator>> &ops, int columnar_index_num,
+                                uint64_t *label_sum) {
+    ShardReader dataset;
+    auto start_time = std::chrono::steady_clock::now();
+    EXPECT_TRUE(dataset.Open({file_names[0]}, true, 4, {"label", "name"}, ops).IsOk());
+    EXPECT_EQ(dataset.GetColumnarIndexNum(), columnar_index_num);
+    auto open_time = std::chrono::steady_clock::now();
+    EXPECT_TRUE(dataset.Launch().IsOk());
+    auto launch_time = std::chrono::steady_clock::now();
+    uint64_t row_num = 0;
+    while (true) {
+      auto rows = dataset.GetNext();
+      if (rows.empty()) {
+        break;
+      }
+      for (auto &row : rows) {
+        auto label = std::get<1>(row)["label"].get<uint64_t>();
+        EXPECT_EQ(std::get<1>(row)["name"].get<std::string>(), "class_" + std::to_string(label));
+        *label_sum += label;
+        ++row_num;
+      }
+    }
+    dataset.Close();
+    return std::make_tuple(row_num, std::chrono::duration<double, std::milli>(open_time - start_time).count(),
+                           std::chrono::duration<double, std::milli>(launch_time - open_time).count());
+  };
+
+  // the best latency of creating the tasks of all rows and of the category filter, out of a few runs
+  constexpr int kRuns = 2;
+  std::vector<std::pair<std::string, std::string>> categories{{"label", "3"}, {"name", "class_5"}};
+  for (const std::string index_type : {"columnar", "sqlite"}) {
+    if (index_type == "sqlite") {
+      for (const auto &file_name : file_names) {
+        remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+      }
+    }
+    int columnar_index_num = index_type == "columnar" ? kShardNum : 0;
+    std::pair<double, double> latency = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    for (int run = 0; run < kRuns; ++run) {
+      uint64_t label_sum = 0;
+      auto result = read_all({}, columnar_index_num, &label_sum);
+      EXPECT_EQ(std::get<0>(result), kRowNum);
+      EXPECT_EQ(label_sum, kRowNum / kClassNum * kClassNum * (kClassNum - 1) / 2);
+      latency.first = std::min(latency.first, std::get<2>(result));
+
+      label_sum = 0;
+      auto category = std::make_shared<ShardCategory>(categories);
+      result = read_all({category}, columnar_index_num, &label_sum);
+      EXPECT_EQ(std::get<0>(result), kRowNum / kClassNum * categories.size());
+      EXPECT_EQ(label_sum, kRowNum / kClassNum * (3 + 5));
+      latency.second = std::min(latency.second, std::get<2>(result));
+    }
+    MS_LOG(INFO) << "Index " << index_type << ", read all rows index latency(ms): " << latency.first
+                 << ", category filter latency(ms): " << latency.second;
+  }
+
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name));
+    remove(common::SafeCStr(file_name + ".db"));
+    remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+  }
+}
+
+/// Feature: columnar index of mindrecord files.
+/// Description: rewrite a mindrecord file after its columnar index is built, keeping its size and content.
+/// Expectation: the stale index is not loaded, and the reader falls back to sqlite and reads all rows.
+TEST_F(TestShardReader, TestShardReaderStaleColumnarIndex) {
+  constexpr uint64_t kRowNum = 100;
+  std::string file_name = "./stale_columnar.shard";
+  ShardHeader header_data;
+  json schema_json = R"({"label": {"type": "int64"}, "data": {"type": "bytes"}})"_json;
+  auto schema = Schema::Build("stale", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  auto schema_id = header_data.AddSchema(schema);
+  ASSERT_TRUE(header_data.AddIndexFields({{schema_id, "label"}}).IsOk());
+  ShardWriter writer;
+  ASSERT_TRUE(writer.Open({file_name}).IsOk());
+  ASSERT_TRUE(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+  std::map<uint64_t, std::vector<json>> raw_data;
+  std::vector<std::vector<uint8_t>> blobs;
+  for (uint64_t i = 0; i < kRowNum; ++i) {
+    raw_data[schema_id].push_back(json{{"label", i}});
+    blobs.emplace_back(std::vector<uint8_t>(16, static_cast<uint8_t>(i)));
+  }
+  ASSERT_TRUE(writer.WriteRawData(raw_data, blobs).IsOk());
+  ASSERT_TRUE(writer.Commit().IsOk());
+  ASSERT_TRUE(ShardIndexGenerator::Finalize({file_name}).IsOk());
+  std::shared_ptr<ShardColumnarIndex> index;
+  ASSERT_TRUE(ShardColumnarIndex::Load(file_name, &index).IsOk());
+
+  // the file size is the same, only the modification time tells the file is rewritten
+  struct utimbuf times = {0, 0};
+  ASSERT_EQ(utime(file_name.c_str(), &times), 0);
+  auto status = ShardColumnarIndex::Load(file_name, &index);
+  EXPECT_FALSE(status.IsOk());
+  EXPECT_NE(status.ToString().find("out of date"), std::string::npos);
+
+  ShardReader dataset;
+  ASSERT_TRUE(dataset.Open({file_name}, true, 4, {"label"}).IsOk());
+  EXPECT_EQ(dataset.GetColumnarIndexNum(), 0);
+  ASSERT_TRUE(dataset.Launch().IsOk());
+  uint64_t label_sum = 0;
+  uint64_t row_num = 0;
+  while (true) {
+    auto rows = dataset.GetNext();
+    if (rows.empty()) {
+      break;
+    }
+    for (auto &row : rows) {
+      label_sum += std::get<1>(row)["label"].get<uint64_t>();
+      ++row_num;
+    }
+  }
+  dataset.Close();
+  EXPECT_EQ(row_num, kRowNum);
+  EXPECT_EQ(label_sum, kRowNum * (kRowNum - 1) / 2);
+
+  remove(common::SafeCStr(file_name));
+  remove(common::SafeCStr(file_name + ".db"));
+  remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+}
+
+/// Feature: row criteria and column projection pushed down to ShardReader.
+/// Description: filter a dataset with large blobs by label after reading full rows, and by row criteria in the reader
+///     with and without the blob field selected, with the columnar index and with sqlite.
+/// Expectation: all the ways return the same rows, and the criteria pushdown reads less blob bytes than filtering after
+///     reading, and the projection pushdown reads even less.
+TEST_F(TestShardReader, TestShardReaderRowCriteriaPushdown) {
+  constexpr int kShardNum = 4;
+  constexpr uint64_t kRowNum = 4000;
+  constexpr uint64_t kClassNum = 10;
+  constexpr uint64_t kBlobSize = 64 << 10;
+  constexpr uint64_t kLabel = 3;
+  std::vector<std::string> file_names;
+  for (int i = 0; i < kShardNum; i++) {
+    file_names.emplace_back(std::string("./pushdown.shard") + std::to_string(i));
+  }
+
+  ShardHeader header_data;
+  json schema_json = R"({"label": {"type": "int64"}, "name": {"type": "string"}, "data": {"type": "bytes"}})"_json;
+  auto schema = Schema::Build("pushdown", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  auto schema_id = header_data.AddSchema(schema);
+  ASSERT_TRUE(header_data.AddIndexFields({{schema_id, "label"}, {schema_id, "name"}}).IsOk());
+  ShardWriter writer;
+  ASSERT_TRUE(writer.Open(file_names).IsOk());
+  ASSERT_TRUE(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+  std::map<uint64_t, std::vector<json>> raw_data;
+  std::vector<std::vector<uint8_t>> blobs;
+  for (uint64_t i = 0; i < kRowNum; ++i) {
+    raw_data[schema_id].push_back(json{{"label", i % kClassNum}, {"name", "class_" + std::to_string(i % kClassNum)}});
+    blobs.emplace_back(std::vector<uint8_t>(kBlobSize, static_cast<uint8_t>(i)));
+  }
+  ASSERT_TRUE(writer.WriteRawData(raw_data, blobs).IsOk());
+  ASSERT_TRUE(writer.Commit().IsOk());
+  ASSERT_TRUE(ShardIndexGenerator::Finalize(file_names).IsOk());
+
+  // return the row number and the blob bytes read, the rows are filtered after reading if criteria is not pushed down
+  auto read_filtered = [&file_names](const std::vector<std::string> &columns, bool pushdown, uint64_t *label_sum) {
+    ShardReader dataset;
+    if (pushdown) {
+      dataset.SetRowCriteria({{"label", std::to_string(kLabel)}});
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    EXPECT_TRUE(dataset.Open({file_names[0]}, true, 4, columns).IsOk());
+    EXPECT_TRUE(dataset.Launch().IsOk());
+    uint64_t row_num = 0;
+    while (true) {
+      auto rows = dataset.GetNext();
+      if (rows.empty()) {
+        break;
+      }
+      for (auto &row : rows) {
+        auto label = std::get<1>(row)["label"].get<uint64_t>();
+        if (label != kLabel) {
+          continue;
+        }
+        auto &blob = std::get<0>(row);
+        if (!blob.empty()) {
+          std::shared_ptr<std::vector<std::vector<uint8_t>>> blob_data_ptr =
+            std::make_shared<std::vector<std::vector<uint8_t>>>();
+          EXPECT_TRUE(dataset.UnCompressBlob(blob, &blob_data_ptr).IsOk());
+          EXPECT_EQ((*blob_data_ptr)[0].size(), static_cast<size_t>(kBlobSize));
+        }
+        *label_sum += std::get<1>(row)["name"].get<std::string>() == "class_" + std::to_string(kLabel) ? label : 0;
+        ++row_num;
+      }
+    }
+    auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    auto read_bytes = dataset.GetBlobReadBytes();
+    dataset.Close();
+    return std::make_tuple(row_num, read_bytes, cost);
+  };
+
+  for (const std::string index_type : {"columnar", "sqlite"}) {
+    if (index_type == "sqlite") {
+      for (const auto &file_name : file_names) {
+        remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+      }
+    }
+    std::vector<uint64_t> read_bytes;
+    for (const auto &mode : std::vector<std::pair<std::string, std::pair<std::vector<std::string>, bool>>>{
+           {"filter after read", {{"label", "name", "data"}, false}},
+           {"criteria pushdown", {{"label", "name", "data"}, true}},
+           {"criteria and projection pushdown", {{"label", "name"}, true}}}) {
+      uint64_t label_sum = 0;
+      auto result = read_filtered(mode.second.first, mode.second.second, &label_sum);
+      EXPECT_EQ(std::get<0>(result), kRowNum / kClassNum);
+      EXPECT_EQ(label_sum, kRowNum / kClassNum * kLabel);
+      read_bytes.push_back(std::get<1>(result));
+      MS_LOG(INFO) << "Index " << index_type << ", " << mode.first << ", blob bytes read: " << std::get<1>(result)
+                   << ", matched rows/s: " << std::get<0>(result) / std::get<2>(result);
+    }
+    // the criteria skip the blobs of the unmatched rows, and the projection skips the blobs of the matched rows
+    EXPECT_LT(read_bytes[1], read_bytes[0]) << "Index " << index_type;
+    EXPECT_LE(read_bytes[1] * 2, read_bytes[0]) << "Index " << index_type;
+    EXPECT_LT(read_bytes[2], read_bytes[1]) << "Index " << index_type;
+  }
+
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name));
+    remove(common::SafeCStr(file_name + ".db"));
+    remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
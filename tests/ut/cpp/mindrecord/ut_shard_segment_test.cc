@@ -46,6 +46,7 @@ class TestShardSegment : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     }
   }
 };
@@ -15,10 +15,13 @@
  */
 
 #include <chrono>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "utils/ms_utils.h"
@@ -35,6 +38,84 @@ namespace mindrecord {
 class TestShardWriter : public UT::Common {
  public:
   TestShardWriter() {}
+
+ protected:
+  /// \brief Get the names of the 4 shard files written with or without pipeline
+  std::vector<std::string> GetPipelineFileNames(bool pipeline) {
+    std::vector<std::string> file_names;
+    for (int i = 1; i <= 4; i++) {
+      file_names.emplace_back(std::string(pipeline ? "./pipeline.shard0" : "./no_pipeline.shard0") +
+                              std::to_string(i));
+    }
+    return file_names;
+  }
+
+  /// \brief Create the blob of a row, whose bytes depend on both the label and the position
+  std::vector<uint8_t> CreatePipelineBlob(uint64_t label, uint64_t row_size) {
+    std::vector<uint8_t> blob(row_size);
+    for (uint64_t i = 0; i < row_size; ++i) {
+      blob[i] = static_cast<uint8_t>(label * 31 + i);
+    }
+    return blob;
+  }
+
+  /// \brief Write rows of file name, label and blob, the rows are prepared by the caller while the previous rows are
+  ///     being written in pipeline mode
+  void WritePipelineDataset(const std::vector<std::string> &file_names, bool pipeline, uint64_t row_num,
+                            uint64_t row_size, uint64_t row_num_per_write) {
+    ShardHeader header_data;
+    json schema_json =
+      R"({"file_name": {"type": "string"}, "label": {"type": "int64"}, "data": {"type": "bytes"}})"_json;
+    auto schema = Schema::Build("pipeline", schema_json);
+    ASSERT_TRUE(schema != nullptr);
+    auto schema_id = header_data.AddSchema(schema);
+    ASSERT_TRUE(header_data.AddIndexFields({{schema_id, "label"}}).IsOk());
+    ShardWriter writer;
+    ASSERT_TRUE(writer.Open(file_names, false, true).IsOk());
+    ASSERT_TRUE(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+    if (pipeline) {
+      ASSERT_TRUE(writer.EnablePipeline().IsOk());
+    }
+    for (uint64_t start = 0; start < row_num; start += row_num_per_write) {
+      std::map<uint64_t, std::vector<json>> raw_data;
+      std::vector<std::vector<uint8_t>> blobs;
+      for (uint64_t label = start; label < std::min(start + row_num_per_write, row_num); ++label) {
+        raw_data[schema_id].push_back(json{{"file_name", "image_" + std::to_string(label) + ".jpg"}, {"label", label}});
+        blobs.emplace_back(CreatePipelineBlob(label, row_size));
+      }
+      ASSERT_TRUE(writer.WriteRawData(raw_data, blobs).IsOk());
+    }
+    ASSERT_TRUE(writer.Commit().IsOk());
+    ASSERT_TRUE(ShardIndexGenerator::Finalize(file_names).IsOk());
+  }
+
+  /// \brief Read the label, file name and blob of all rows in order
+  void ReadPipelineDataset(const std::string &file_name,
+                           std::vector<std::tuple<uint64_t, std::string, std::vector<uint8_t>>> *rows) {
+    ShardReader dataset;
+    ASSERT_TRUE(dataset.Open({file_name}, true, 4, {"file_name", "label", "data"}).IsOk());
+    ASSERT_TRUE(dataset.Launch().IsOk());
+    while (true) {
+      auto task_rows = dataset.GetNext();
+      if (task_rows.empty()) {
+        break;
+      }
+      for (auto &row : task_rows) {
+        rows->emplace_back(std::get<1>(row)["label"].get<uint64_t>(), std::get<1>(row)["file_name"].get<std::string>(),
+                           std::get<0>(row));
+      }
+    }
+    dataset.Close();
+  }
+
+  /// \brief Remove the shard files and their indexes
+  void RemovePipelineDataset(const std::vector<std::string> &file_names) {
+    for (const auto &file_name : file_names) {
+      remove(common::SafeCStr(file_name));
+      remove(common::SafeCStr(file_name + ".db"));
+      remove(common::SafeCStr(file_name + kColumnarIndexSuffix));
+    }
+  }
 };
 
 TEST_F(TestShardWriter, TestShardWriterBench) {
@@ -46,6 +127,7 @@ TEST_F(TestShardWriter, TestShardWriterBench) {
     string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
   }
 }
 
@@ -75,6 +157,7 @@ TEST_F(TestShardWriter, TestShardWriterOneSample) {
     string db_name = std::string("./OneSample.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
   }
 }
 
@@ -345,6 +428,7 @@ TEST_F(TestShardWriter, TestShardWriterTrial) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -481,6 +565,7 @@ TEST_F(TestShardWriter, TestShardWriterTrialNoFields) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -582,6 +667,7 @@ TEST_F(TestShardWriter, DataCheck) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -675,6 +761,7 @@ TEST_F(TestShardWriter, AllRawDataWrong) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -782,6 +869,7 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberColumnInIndex) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -870,6 +958,7 @@ TEST_F(TestShardWriter, TestShardNoBlob) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -971,6 +1060,7 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberNotColumnInIndex) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1079,6 +1169,7 @@ TEST_F(TestShardWriter, TestShardWriter10Sample40Shard) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1148,6 +1239,7 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
     string db_name = std::string("./OpenForAppendSample.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + kColumnarIndexSuffix));
   }
 }
 
@@ -1236,5 +1328,52 @@ TEST_F(TestShardWriter, TestOverWrite) {
 
 }
 
+/// Feature: pipelined writing of mindrecord files.
+/// Description: write a small image-blob dataset with and without pipeline, then read the datasets back.
+/// Expectation: both datasets contain the same rows in the same order, with the written file names, labels and blobs.
+TEST_F(TestShardWriter, TestShardWriterPipeline) {
+  constexpr uint64_t kRowNum = 1000;
+  constexpr uint64_t kRowSize = 4 << 10;
+  constexpr uint64_t kRowNumPerWrite = 64;
+  std::map<bool, std::vector<std::tuple<uint64_t, std::string, std::vector<uint8_t>>>> rows;
+  for (const bool pipeline : {false, true}) {
+    auto file_names = GetPipelineFileNames(pipeline);
+    WritePipelineDataset(file_names, pipeline, kRowNum, kRowSize, kRowNumPerWrite);
+    ReadPipelineDataset(file_names[0], &rows[pipeline]);
+    RemovePipelineDataset(file_names);
+    ASSERT_EQ(rows[pipeline].size(), kRowNum);
+    uint64_t label_sum = 0;
+    for (const auto &row : rows[pipeline]) {
+      auto label = std::get<0>(row);
+      ASSERT_EQ(std::get<1>(row), "image_" + std::to_string(label) + ".jpg");
+      ASSERT_EQ(std::get<2>(row), CreatePipelineBlob(label, kRowSize));
+      label_sum += label;
+    }
+    EXPECT_EQ(label_sum, kRowNum * (kRowNum - 1) / 2);
+  }
+  EXPECT_EQ(rows[true], rows[false]);
+}
+
+/// Feature: pipelined writing of mindrecord files.
+/// Description: write a 1GB image-blob dataset with and without pipeline, then read the datasets back.
+/// Expectation: both datasets contain all the rows, and the GB/s of every mode is logged.
+TEST_F(TestShardWriter, DISABLED_TestShardWriterPipelineThroughput) {
+  constexpr uint64_t kTotalSize = 1ULL << 30;
+  constexpr uint64_t kRowSize = 128 << 10;
+  constexpr uint64_t kRowNum = kTotalSize / kRowSize;
+  constexpr uint64_t kRowNumPerWrite = 256;
+  for (const bool pipeline : {false, true}) {
+    auto file_names = GetPipelineFileNames(pipeline);
+    auto start_time = std::chrono::steady_clock::now();
+    WritePipelineDataset(file_names, pipeline, kRowNum, kRowSize, kRowNumPerWrite);
+    auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    MS_LOG(INFO) << "Pipeline " << pipeline << ", GB/s: " << kTotalSize / cost / (1 << 30);
+    std::vector<std::tuple<uint64_t, std::string, std::vector<uint8_t>>> rows;
+    ReadPipelineDataset(file_names[0], &rows);
+    RemovePipelineDataset(file_names);
+    EXPECT_EQ(rows.size(), kRowNum);
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
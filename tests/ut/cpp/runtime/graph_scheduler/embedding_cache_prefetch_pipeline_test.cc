@@ -0,0 +1,169 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_actor.h"
+#include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_pipeline.h"
+
+namespace mindspore {
+namespace runtime {
+class EmbeddingCachePrefetchPipelineTest : public UT::Common {
+ public:
+  EmbeddingCachePrefetchPipelineTest() {}
+
+  void SetUp() override {
+    const size_t batch_ids_num = 16;
+    for (size_t i = 0; i < kLookahead; ++i) {
+      (void)swap_infos_.emplace_back(std::make_unique<EmbeddingCacheSwapInfo>(batch_ids_num));
+      (void)buffers_.emplace_back(swap_infos_.back().get());
+    }
+  }
+
+  // Parse the batches like the prefetch thread: wait for a free buffer and submit it to the remote stage, stop when
+  // the pipeline is closed.
+  void ParseBatches(EmbeddingCachePrefetchPipeline *pipeline, size_t num_batches) {
+    for (size_t step = 1; step <= num_batches; ++step) {
+      auto swap_info = pipeline->AcquireFreeBuffer();
+      if (swap_info == nullptr) {
+        return;
+      }
+      swap_info->data_step_ = step;
+      parsed_step_ = step;
+      pipeline->Submit(swap_info);
+    }
+  }
+
+  static constexpr size_t kLookahead = 2;
+  std::vector<std::unique_ptr<EmbeddingCacheSwapInfo>> swap_infos_;
+  std::vector<EmbeddingCacheSwapInfo *> buffers_;
+  std::atomic<size_t> parsed_step_{0};
+  std::atomic<size_t> remote_step_{0};
+  std::atomic<size_t> device_step_{0};
+  std::atomic<bool> in_order_{true};
+};
+
+/// Feature: Pipelined embedding cache prefetching.
+/// Description: Pass all the batches through the remote and device stages, then stop the pipeline.
+/// Expectation: Every batch goes through both stages in order and the free buffers bound the batches in flight.
+TEST_F(EmbeddingCachePrefetchPipelineTest, RunAllBatches) {
+  const size_t num_batches = 100;
+  EmbeddingCachePrefetchPipeline pipeline;
+  pipeline.Start(
+    buffers_,
+    [this](EmbeddingCacheSwapInfo *swap_info) {
+      in_order_ = in_order_ && swap_info->data_step_ == remote_step_ + 1;
+      remote_step_ = swap_info->data_step_;
+      return true;
+    },
+    [this](EmbeddingCacheSwapInfo *swap_info) {
+      in_order_ = in_order_ && swap_info->data_step_ == device_step_ + 1;
+      in_order_ = in_order_ && parsed_step_ <= swap_info->data_step_ + kLookahead;
+      device_step_ = swap_info->data_step_;
+      return true;
+    });
+  ParseBatches(&pipeline, num_batches);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (device_step_ < num_batches && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  pipeline.Stop();
+  EXPECT_EQ(parsed_step_, num_batches);
+  EXPECT_EQ(remote_step_, num_batches);
+  EXPECT_EQ(device_step_, num_batches);
+  EXPECT_TRUE(in_order_);
+}
+
+/// Feature: Pipelined embedding cache prefetching.
+/// Description: Stop the pipeline from the finalizing thread and the prefetch thread while the slow stages are busy.
+/// Expectation: The stage threads are joined, the prefetch thread waiting for a free buffer wakes up, the batches
+/// finished by the device stage are a prefix of the ones finished by the remote stage.
+TEST_F(EmbeddingCachePrefetchPipelineTest, StopMidFlight) {
+  const size_t num_batches = 1000;
+  EmbeddingCachePrefetchPipeline pipeline;
+  pipeline.Start(
+    buffers_,
+    [this](EmbeddingCacheSwapInfo *swap_info) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      in_order_ = in_order_ && swap_info->data_step_ == remote_step_ + 1;
+      remote_step_ = swap_info->data_step_;
+      return true;
+    },
+    [this](EmbeddingCacheSwapInfo *swap_info) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(3));
+      in_order_ = in_order_ && swap_info->data_step_ == device_step_ + 1;
+      device_step_ = swap_info->data_step_;
+      return true;
+    });
+  std::thread prefetch_thread([this, &pipeline]() {
+    ParseBatches(&pipeline, num_batches);
+    pipeline.Stop();
+  });
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (device_step_ < kLookahead && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  pipeline.Stop();
+  prefetch_thread.join();
+
+  EXPECT_GE(device_step_, kLookahead);
+  EXPECT_LT(parsed_step_, num_batches);
+  EXPECT_LE(remote_step_, parsed_step_);
+  EXPECT_LE(device_step_, remote_step_);
+  EXPECT_TRUE(in_order_);
+  // The pipeline stays closed after stopping.
+  EXPECT_EQ(pipeline.AcquireFreeBuffer(), nullptr);
+  const size_t device_step = device_step_;
+  pipeline.Stop();
+  EXPECT_EQ(device_step_, device_step);
+}
+
+/// Feature: Pipelined embedding cache prefetching.
+/// Description: Fail the remote stage at a batch while the prefetch thread keeps submitting batches.
+/// Expectation: The pipeline closes itself, the device stage never sees the failed batch and the prefetch thread
+/// waiting for a free buffer wakes up.
+TEST_F(EmbeddingCachePrefetchPipelineTest, StageFailed) {
+  const size_t num_batches = 1000;
+  const size_t failed_step = 10;
+  EmbeddingCachePrefetchPipeline pipeline;
+  pipeline.Start(
+    buffers_, [](EmbeddingCacheSwapInfo *swap_info) { return swap_info->data_step_ != failed_step; },
+    [this](EmbeddingCacheSwapInfo *swap_info) {
+      device_step_ = swap_info->data_step_;
+      return true;
+    });
+  ParseBatches(&pipeline, num_batches);
+  EXPECT_LE(parsed_step_, failed_step + kLookahead);
+  EXPECT_LT(device_step_, failed_step);
+  pipeline.Stop();
+
+  // A failed init of the device stage closes the pipeline too.
+  EmbeddingCachePrefetchPipeline init_failed_pipeline;
+  init_failed_pipeline.Start(
+    buffers_, [](EmbeddingCacheSwapInfo *) { return true; }, [](EmbeddingCacheSwapInfo *) { return true; },
+    []() { return false; });
+  parsed_step_ = 0;
+  ParseBatches(&init_failed_pipeline, num_batches);
+  EXPECT_LE(parsed_step_, kLookahead);
+  init_failed_pipeline.Stop();
+}
+}  // namespace runtime
+}  // namespace mindspore
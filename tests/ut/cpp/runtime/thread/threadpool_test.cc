@@ -0,0 +1,211 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "thread/threadpool.h"
+#include "thread/work_steal_queue.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace {
+constexpr int kTaskNum = 64;
+constexpr int kLaunchNum = 200;
+constexpr int kSkewFactor = 50;
+
+struct SkewedContent {
+  std::vector<std::atomic_int> counts;
+  int base_work;
+  explicit SkewedContent(int task_num, int work) : counts(task_num), base_work(work) {}
+};
+
+// the first split is kSkewFactor times heavier than the others, like a ragged batch
+int SkewedFunc(void *content, int task_id, float, float) {
+  auto skewed = reinterpret_cast<SkewedContent *>(content);
+  int loop = task_id == 0 ? skewed->base_work * kSkewFactor : skewed->base_work;
+  volatile float sum = 0;
+  for (int i = 0; i < loop; ++i) {
+    sum = sum + static_cast<float>(i) * 0.5f;
+  }
+  (void)++skewed->counts[task_id];
+  return THREAD_OK;
+}
+
+std::vector<double> LaunchSkewedTasks(ThreadPool *pool, int base_work) {
+  std::vector<double> costs;
+  for (int i = 0; i < kLaunchNum; ++i) {
+    SkewedContent content(kTaskNum, base_work);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pool->ParallelLaunch(SkewedFunc, &content, kTaskNum), THREAD_OK);
+    auto end = std::chrono::steady_clock::now();
+    costs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    for (int j = 0; j < kTaskNum; ++j) {
+      EXPECT_EQ(content.counts[j].load(), 1);
+    }
+  }
+  std::sort(costs.begin(), costs.end());
+  return costs;
+}
+
+// the cost of running all the splits of a launch one by one on the calling thread
+std::vector<double> RunSkewedTasksSerially(int base_work) {
+  std::vector<double> costs;
+  for (int i = 0; i < kLaunchNum; ++i) {
+    SkewedContent content(kTaskNum, base_work);
+    auto start = std::chrono::steady_clock::now();
+    for (int j = 0; j < kTaskNum; ++j) {
+      (void)SkewedFunc(&content, j, 0, 1);
+    }
+    auto end = std::chrono::steady_clock::now();
+    costs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  std::sort(costs.begin(), costs.end());
+  return costs;
+}
+}  // namespace
+
+class TestThreadPool : public UT::Common {
+ public:
+  TestThreadPool() {}
+};
+
+/// Feature: work stealing deque.
+/// Description: the owner pushes and pops at the bottom while the thieves steal at the top.
+/// Expectation: every element is taken exactly once.
+TEST_F(TestThreadPool, TestWorkStealQueue) {
+  constexpr int kElementNum = 100000;
+  constexpr int kThiefNum = 3;
+  WorkStealQueue<int> queue;
+  ASSERT_TRUE(queue.Init(1000));
+  ASSERT_FALSE(queue.Init(1000));
+  std::vector<int> elements(kElementNum);
+  std::vector<std::atomic_int> taken(kElementNum);
+  for (int i = 0; i < kElementNum; ++i) {
+    elements[i] = i;
+  }
+  std::atomic_bool done{false};
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThiefNum; ++t) {
+    thieves.emplace_back([&]() {
+      while (!done || !queue.Empty()) {
+        auto element = queue.Steal();
+        if (element != nullptr) {
+          (void)++taken[*element];
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kElementNum; ++i) {
+    while (!queue.Push(&elements[i])) {
+      auto element = queue.Pop();
+      if (element != nullptr) {
+        (void)++taken[*element];
+      }
+    }
+  }
+  auto element = queue.Pop();
+  while (element != nullptr) {
+    (void)++taken[*element];
+    element = queue.Pop();
+  }
+  done = true;
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+  for (int i = 0; i < kElementNum; ++i) {
+    ASSERT_EQ(taken[i].load(), 1);
+  }
+  ASSERT_TRUE(queue.Empty());
+  queue.Clean();
+}
+
+/// Feature: work stealing thread pool.
+/// Description: launch skewed tasks on the thread pools with and without work stealing.
+/// Expectation: every split runs exactly once, the median latency of both modes is bounded by the serial cost of the
+/// splits, and it is below the serial cost when every thread can get a core. Stealing does not make the median and
+/// the tail latency worse than pushing only.
+TEST_F(TestThreadPool, TestSkewedParallelLaunch) {
+  constexpr size_t kThreadNum = 4;
+  constexpr int kBaseWork = 2000;
+  std::unique_ptr<ThreadPool> push_pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(push_pool, nullptr);
+  ASSERT_FALSE(push_pool->work_stealing());
+  push_pool->SetSpinCountMaxValue();
+  std::unique_ptr<ThreadPool> steal_pool(ThreadPool::CreateThreadPool(kThreadNum, {}, true));
+  ASSERT_NE(steal_pool, nullptr);
+  ASSERT_TRUE(steal_pool->work_stealing());
+  steal_pool->SetSpinCountMaxValue();
+
+  auto serial_costs = RunSkewedTasksSerially(kBaseWork);
+  auto push_costs = LaunchSkewedTasks(push_pool.get(), kBaseWork);
+  auto steal_costs = LaunchSkewedTasks(steal_pool.get(), kBaseWork);
+  auto percentile = [](const std::vector<double> &costs, size_t p) { return costs[(costs.size() - 1) * p / 100]; };
+  MS_LOG(INFO) << "skewed ParallelLaunch(us) serial p50: " << percentile(serial_costs, 50);
+  MS_LOG(INFO) << "skewed ParallelLaunch(us) push   p50: " << percentile(push_costs, 50)
+               << " p90: " << percentile(push_costs, 90) << " p99: " << percentile(push_costs, 99);
+  MS_LOG(INFO) << "skewed ParallelLaunch(us) steal  p50: " << percentile(steal_costs, 50)
+               << " p90: " << percentile(steal_costs, 90) << " p99: " << percentile(steal_costs, 99);
+
+  // the scheduling overhead must not outweigh the splits even if the workers share a single core
+  constexpr double kMaxOverheadRatio = 2.0;
+  EXPECT_LT(percentile(push_costs, 50), percentile(serial_costs, 50) * kMaxOverheadRatio);
+  EXPECT_LT(percentile(steal_costs, 50), percentile(serial_costs, 50) * kMaxOverheadRatio);
+  // stealing must not hurt the skewed launches, the tolerance absorbs the noise of a loaded machine
+  constexpr double kMaxStealRatio = 1.5;
+  EXPECT_LT(percentile(steal_costs, 50), percentile(push_costs, 50) * kMaxStealRatio);
+  EXPECT_LT(percentile(steal_costs, 90), percentile(push_costs, 90) * kMaxStealRatio);
+  if (std::thread::hardware_concurrency() > kThreadNum) {
+    // the heavy split alone takes less than half of the serial cost, so the launch must be faster than serial
+    EXPECT_LT(percentile(push_costs, 50), percentile(serial_costs, 50));
+    EXPECT_LT(percentile(steal_costs, 50), percentile(serial_costs, 50));
+  }
+}
+
+/// Feature: adaptive spin policy of thread pool.
+/// Description: launch tasks with long gaps in between on the thread pool with adaptive spin enabled.
+/// Expectation: the workers park quickly, and the telemetry reflects the idle duration.
+TEST_F(TestThreadPool, TestAdaptiveSpinStats) {
+  constexpr size_t kThreadNum = 2;
+  constexpr int kGapMs = 20;
+  constexpr int kRound = 10;
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  pool->SetSpinCountMaxValue();
+  pool->SetAdaptiveSpin(true);
+  for (int i = 0; i < kRound; ++i) {
+    SkewedContent content(kTaskNum, 1);
+    ASSERT_EQ(pool->ParallelLaunch(SkewedFunc, &content, kTaskNum), THREAD_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(kGapMs));
+  }
+  auto stats = pool->GetWorkerStats();
+  ASSERT_EQ(stats.size(), pool->thread_num());
+  for (const auto &stat : stats) {
+    MS_LOG(INFO) << "spins: " << stat.spin_count << " parks: " << stat.park_count << " wakeups: " << stat.wakeup_count
+                 << " idle(us): " << stat.idle_time_us << " idle ewma(us): " << stat.idle_ewma_us
+                 << " spin budget(us): " << stat.spin_budget_us;
+    ASSERT_GE(stat.spin_budget_us, kMinAdaptiveSpinTimeUs);
+    ASSERT_LE(stat.spin_budget_us, kMaxAdaptiveSpinTimeUs);
+    if (stat.idle_time_us > 0) {
+      // the idle duration is far beyond the max spin budget, so the worker must have parked
+      ASSERT_GT(stat.park_count, 0);
+    }
+  }
+}
+}  // namespace mindspore
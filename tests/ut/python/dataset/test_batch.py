@@ -283,6 +283,35 @@ def test_batch_13():
     save_and_check_dict(data1, filename, generate_golden=GENERATE_GOLDEN)
 
 
+def test_batch_buffer_ring():
+    """
+    Feature: Batch op
+    Description: Test Batch op with the batches assembled in the pinned buffer rings of the workers
+    Expectation: The batches are the same as the batches allocated from the global memory pool
+    """
+    logger.info("test_batch_buffer_ring")
+
+    def get_batches():
+        data1 = ds.TFRecordDataset(DATA_DIR, shuffle=False)
+        data1 = data1.batch(5, drop_remainder=False, num_parallel_workers=2)
+        # Keep every batch, so that the rings have to hand out new buffers while earlier batches are alive
+        return [row for _ in range(2) for row in data1.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    expected = get_batches()
+    original_ring_size = ds.config.get_batch_buffer_ring_size()
+    original_pin = ds.config.get_pin_batch_buffer()
+    ds.config.set_batch_buffer_ring_size(2)
+    ds.config.set_pin_batch_buffer(True)
+    batches = get_batches()
+    ds.config.set_batch_buffer_ring_size(original_ring_size)
+    ds.config.set_pin_batch_buffer(original_pin)
+
+    assert len(batches) == len(expected) == 6
+    for batch, expected_batch in zip(batches, expected):
+        for col in expected_batch:
+            np.testing.assert_array_equal(batch[col], expected_batch[col])
+
+
 def test_batch_exception_01():
     """
     Feature: Batch op
@@ -626,6 +655,7 @@ if __name__ == '__main__':
     test_batch_11()
     test_batch_12()
     test_batch_13()
+    test_batch_buffer_ring()
     test_batch_exception_01()
     test_batch_exception_02()
     test_batch_exception_03()
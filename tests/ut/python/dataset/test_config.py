@@ -19,6 +19,7 @@ import os
 import filecmp
 import glob
 import numpy as np
+import pytest
 
 import mindspore.dataset as ds
 import mindspore.dataset.engine.iterators as it
@@ -442,6 +443,87 @@ def test_enable_watchdog():
     assert saved_config == ds.config.get_enable_watchdog()
 
 
+def test_enable_tfrecord_crc_check():
+    """
+    Feature: Test the function of get_enable_tfrecord_crc_check and set_enable_tfrecord_crc_check.
+    Description: Flip the state of the TFRecord CRC check and read a TFRecord file with it enabled
+    Expectation: The default state is False, the state is updated by set_enable_tfrecord_crc_check,
+        and a valid file is read completely with the check enabled.
+    """
+    saved_config = ds.config.get_enable_tfrecord_crc_check()
+    assert isinstance(saved_config, bool)
+    assert saved_config is False
+    ds.config.set_enable_tfrecord_crc_check(True)
+    assert ds.config.get_enable_tfrecord_crc_check() is True
+    data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, shuffle=False)
+    assert sum(1 for _ in data.create_dict_iterator(num_epochs=1)) == 3
+    ds.config.set_enable_tfrecord_crc_check(saved_config)
+    assert saved_config == ds.config.get_enable_tfrecord_crc_check()
+
+
+def test_text_file_split_size():
+    """
+    Feature: Test the function of get_text_file_split_size and set_text_file_split_size.
+    Description: Set the size of the pieces the text files are split into, with valid and invalid values
+    Expectation: The default size is 0, the size is updated by set_text_file_split_size,
+        and invalid values are rejected.
+    """
+    saved_config = ds.config.get_text_file_split_size()
+    assert saved_config == 0
+    ds.config.set_text_file_split_size(64 * 1024 * 1024)
+    assert ds.config.get_text_file_split_size() == 64 * 1024 * 1024
+    with pytest.raises(TypeError):
+        ds.config.set_text_file_split_size(True)
+    with pytest.raises(ValueError):
+        ds.config.set_text_file_split_size(-1)
+    ds.config.set_text_file_split_size(saved_config)
+    assert saved_config == ds.config.get_text_file_split_size()
+
+
+def test_batch_buffer_ring_size():
+    """
+    Feature: Test the function of get_batch_buffer_ring_size, set_batch_buffer_ring_size, get_pin_batch_buffer
+        and set_pin_batch_buffer.
+    Description: Set the size of the batch buffer rings and whether they are pinned, with valid and invalid values
+    Expectation: The default size is 0 and the buffers are not pinned by default, the values are updated by the
+        setters, and invalid values are rejected.
+    """
+    saved_size = ds.config.get_batch_buffer_ring_size()
+    saved_pin = ds.config.get_pin_batch_buffer()
+    assert saved_size == 0
+    assert saved_pin is False
+    ds.config.set_batch_buffer_ring_size(4)
+    assert ds.config.get_batch_buffer_ring_size() == 4
+    ds.config.set_pin_batch_buffer(True)
+    assert ds.config.get_pin_batch_buffer() is True
+    with pytest.raises(TypeError):
+        ds.config.set_batch_buffer_ring_size(1.5)
+    with pytest.raises(ValueError):
+        ds.config.set_batch_buffer_ring_size(-1)
+    with pytest.raises(TypeError):
+        ds.config.set_pin_batch_buffer(1)
+    ds.config.set_batch_buffer_ring_size(saved_size)
+    ds.config.set_pin_batch_buffer(saved_pin)
+    assert saved_size == ds.config.get_batch_buffer_ring_size()
+    assert saved_pin == ds.config.get_pin_batch_buffer()
+
+
+def test_jpeg_dct_scaling():
+    """
+    Feature: Test the function of get_jpeg_dct_scaling and set_jpeg_dct_scaling.
+    Description: Enable and disable the reduced scale decode of JPEG images, and set an invalid value
+    Expectation: The default state is False, the state is updated by the setter, and an invalid value is rejected.
+    """
+    saved_config = ds.config.get_jpeg_dct_scaling()
+    assert saved_config is False
+    ds.config.set_jpeg_dct_scaling(True)
+    assert ds.config.get_jpeg_dct_scaling() is True
+    with pytest.raises(TypeError):
+        ds.config.set_jpeg_dct_scaling(1)
+    ds.config.set_jpeg_dct_scaling(saved_config)
+    assert saved_config == ds.config.get_jpeg_dct_scaling()
+
+
 def test_multiprocessing_timeout_interval():
     """
     Feature: Test the function of get_multiprocessing_timeout_interval and set_multiprocessing_timeout_interval.
@@ -503,5 +585,9 @@ if __name__ == '__main__':
     test_auto_num_workers_error()
     test_auto_num_workers()
     test_enable_watchdog()
+    test_enable_tfrecord_crc_check()
+    test_text_file_split_size()
+    test_batch_buffer_ring_size()
+    test_jpeg_dct_scaling()
     test_multiprocessing_timeout_interval()
     test_config_bool_type_error()
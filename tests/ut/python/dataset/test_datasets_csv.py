@@ -12,6 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import tempfile
+from pathlib import Path
+
 import numpy as np
 import pytest
 import mindspore.dataset as ds
@@ -384,6 +387,29 @@ def test_csv_dataset_duplicate_columns():
     assert "column_names" in str(info.value)
 
 
+def test_csv_dataset_file_split(tmp_path):
+    """
+    Feature: CSVDataset
+    Description: Test CSVDataset with a file which has new lines in quoted fields split into pieces
+    Expectation: The rows are the same as the rows read without splitting, in any order
+    """
+    test_file = str(tmp_path / "split.csv")
+    expected = []
+    with open(test_file, "w") as f:
+        f.write("col1,col2\n")
+        for i in range(50000):
+            f.write("{},\"line\n{},\"\"quoted\"\"\"\n".format(i, i))
+            expected.append((str(i), "line\n{},\"quoted\"".format(i)))
+    original_split_size = ds.config.get_text_file_split_size()
+    ds.config.set_text_file_split_size(1)
+    data = ds.CSVDataset(test_file, column_defaults=["", ""], num_parallel_workers=4, shuffle=False)
+    buffer = []
+    for d in data.create_dict_iterator(num_epochs=1, output_numpy=True):
+        buffer.append((d['col1'].item().decode("utf8"), d['col2'].item().decode("utf8")))
+    ds.config.set_text_file_split_size(original_split_size)
+    assert sorted(buffer) == sorted(expected)
+
+
 if __name__ == "__main__":
     test_csv_dataset_basic()
     test_csv_dataset_one_file()
@@ -401,3 +427,5 @@ if __name__ == "__main__":
     test_csv_dataset_type_error()
     test_csv_dataset_exception()
     test_csv_dataset_duplicate_columns()
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        test_csv_dataset_file_split(Path(tmp_dir))
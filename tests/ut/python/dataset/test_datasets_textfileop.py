@@ -330,6 +330,25 @@ def test_textline_dataset_exceptions():
     assert "map operation: [PyFunc] failed. The corresponding data files" in str(error_info.value)
 
 
+def test_textline_dataset_file_split():
+    """
+    Feature: TextFileDataset
+    Description: Test TextFileDataset with the files split into pieces which are read by several workers
+    Expectation: The rows are the same as the rows read without splitting, in any order
+    """
+    original_num_parallel_workers = config_get_set_num_parallel_workers(4)
+    original_split_size = ds.config.get_text_file_split_size()
+    ds.config.set_text_file_split_size(1)
+    data = ds.TextFileDataset(DATA_ALL_FILE, shuffle=False)
+    line = [i["text"].item().decode("utf8") for i in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert sorted(line) == sorted(["This is a text file.", "Another file.", "Be happy every day.", "End of file.",
+                                   "Good luck to everyone."])
+    data = ds.TextFileDataset(DATA_FILE, shuffle=False, num_shards=2, shard_id=1)
+    assert sum(1 for _ in data.create_dict_iterator(num_epochs=1)) == 2
+    ds.config.set_text_file_split_size(original_split_size)
+    ds.config.set_num_parallel_workers(original_num_parallel_workers)
+
+
 if __name__ == "__main__":
     test_textline_dataset_one_file()
     test_textline_dataset_all_file()
@@ -347,3 +366,4 @@ if __name__ == "__main__":
     test_textline_dataset_get_datasetsize()
     test_textline_dataset_to_device()
     test_textline_dataset_exceptions()
+    test_textline_dataset_file_split()
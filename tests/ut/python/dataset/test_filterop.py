@@ -16,10 +16,13 @@
 import numpy as np
 
 import mindspore.dataset as ds
+import mindspore.dataset.transforms as transforms
 import mindspore.dataset.vision as cde
+from mindspore.dataset.transforms import Relational
 
 DATA_DIR = ["../data/dataset/test_tf_file_3_images/train-0000-of-0001.data"]
 SCHEMA_DIR = "../data/dataset/test_tf_file_3_images/datasetSchema.json"
+MIND_FILE = "../data/mindrecord/testMindDataSet/testImageNetData/imagenet.mindrecord0"
 
 
 def test_diff_predicate_func():
@@ -582,6 +585,41 @@ def test_filter_by_generator_get_dataset_size():
     assert data_sie == num_iter
 
 
+def test_filter_by_mask_generator():
+    """
+    Feature: Filter op
+    Description: Test Filter op using Mask as the predicate on GeneratorDataset
+    Expectation: Output is equal to the expected output
+    """
+    dataset = ds.GeneratorDataset(generator_1d, ["data"])
+    dataset = dataset.filter(predicate=transforms.Mask(Relational.GT, 10), input_columns=["data"])
+    result = [item["data"].item() for item in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert result == list(range(11, 64))
+
+
+def test_filter_by_mask_minddataset():
+    """
+    Feature: Filter op
+    Description: Test Filter op using Mask(Relational.EQ) on an index field of MindDataset followed by a Project,
+        which pushes the projection and the predicate down into the reader
+    Expectation: Output is equal to the output of the same predicate as a Python function
+    """
+
+    def get_file_names(predicate, num_samples=None):
+        dataset = ds.MindDataset(MIND_FILE, shuffle=False, num_samples=num_samples)
+        dataset = dataset.filter(predicate=predicate, input_columns=["label"])
+        dataset = dataset.project(["file_name"])
+        return [item["file_name"].item() for item in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    expected = get_file_names(lambda label: label == 2)
+    assert len(expected) == 5
+    assert get_file_names(transforms.Mask(Relational.EQ, 2)) == expected
+    assert not get_file_names(transforms.Mask(Relational.EQ, 7))
+
+    # The sampler does not read all the rows, so only the projection is pushed down.
+    expected = get_file_names(lambda label: label == 2, num_samples=12)
+    assert get_file_names(transforms.Mask(Relational.EQ, 2), num_samples=12) == expected
+
 if __name__ == '__main__':
     test_diff_predicate_func()
     test_filte_case_dataset_cifar10()
@@ -604,3 +642,5 @@ if __name__ == '__main__':
     test_filter_by_generator_with_zip_after()
     test_filter_by_generator_Partial()
     test_filter_by_generator_get_dataset_size()
+    test_filter_by_mask_generator()
+    test_filter_by_mask_minddataset()
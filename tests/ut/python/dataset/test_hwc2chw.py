@@ -297,6 +297,35 @@ def test_hwc2chw_mix_compose(plot=False):
         visualize_list(image, image_transposed)
 
 
+def test_hwc2chw_batch():
+    """
+    Feature: HWC2CHW op
+    Description: Test HWC2CHW, Rescale and Normalize on batches of images, after the batch op
+    Expectation: Output is the same as the one of the ops applied to each image before the batch op
+    """
+    logger.info("Test HWC2CHW on batches of images")
+
+    raw_data = np.random.randint(0, 256, size=(10, 6, 8, 3)).astype(np.uint8)
+    transforms = [vision.Rescale(1.0 / 255, 0.0), vision.Normalize([0.5, 0.4, 0.3], [0.2, 0.25, 0.3]),
+                  vision.HWC2CHW()]
+
+    per_image = ds.NumpySlicesDataset(raw_data, column_names=["image"], shuffle=False)
+    per_image = per_image.map(transforms, input_columns=["image"]).batch(5)
+    per_batch = ds.NumpySlicesDataset(raw_data, column_names=["image"], shuffle=False).batch(5)
+    per_batch = per_batch.map(transforms, input_columns=["image"])
+    num_batches = 0
+    for expected, output in zip(per_image.create_tuple_iterator(output_numpy=True),
+                                per_batch.create_tuple_iterator(output_numpy=True)):
+        assert output[0].shape == (5, 3, 6, 8)
+        np.testing.assert_array_equal(output[0], expected[0])
+        num_batches += 1
+    assert num_batches == 2
+
+    # eager mode on a batch of shape <N, H, W, C>
+    output = vision.HWC2CHW()(raw_data)
+    np.testing.assert_array_equal(output, np.transpose(raw_data, (0, 3, 1, 2)))
+
+
 if __name__ == '__main__':
     test_hwc2chw_callable()
     test_hwc2chw_multi_channels()
@@ -306,3 +335,4 @@ if __name__ == '__main__':
     test_hwc2chw_comparison2(True)
     test_hwc2chw_mix(True)
     test_hwc2chw_mix_compose(True)
+    test_hwc2chw_batch()
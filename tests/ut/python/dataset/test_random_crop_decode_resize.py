@@ -101,7 +101,42 @@ def test_random_crop_decode_resize_invalid():
     assert "not of type (<class 'int'>,)" in str(error_info.value)
 
 
+def test_random_crop_decode_resize_dct_scaling():
+    """
+    Feature: RandomCropDecodeResize op
+    Description: Test RandomCropDecodeResize op with the JPEG images decoded at a reduced DCT scale
+    Expectation: Output is of the target size and close to the output of a full resolution decode
+    """
+    logger.info("test_random_crop_decode_resize_dct_scaling")
+    original_seed = config_get_set_seed(10)
+    original_dct_scaling = ds.config.get_jpeg_dct_scaling()
+    image_folder = "../data/dataset/testPK/data"
+
+    # the op reads the config when the pipeline is built, i.e. when its iterator is created
+    def create_iterator(dct_scaling):
+        ds.config.set_jpeg_dct_scaling(dct_scaling)
+        data = ds.ImageFolderDataset(image_folder, num_samples=8, shuffle=False)
+        data = data.map(operations=vision.RandomCropDecodeResize((224, 224)), input_columns=["image"],
+                        num_parallel_workers=1)
+        return data.create_dict_iterator(num_epochs=1, output_numpy=True)
+
+    iter1 = create_iterator(False)
+    iter2 = create_iterator(True)
+    num_iter = 0
+    for item1, item2 in zip(iter1, iter2):
+        assert item2["image"].shape == (224, 224, 3)
+        mse = diff_mse(item1["image"], item2["image"])
+        logger.info("random_crop_decode_resize_dct_scaling_{}, mse: {}".format(num_iter + 1, mse))
+        assert mse < 0.05
+        num_iter += 1
+    assert num_iter == 8
+
+    ds.config.set_seed(original_seed)
+    ds.config.set_jpeg_dct_scaling(original_dct_scaling)
+
+
 if __name__ == "__main__":
     test_random_crop_decode_resize_op(plot=True)
     test_random_crop_decode_resize_md5()
     test_random_crop_decode_resize_invalid()
+    test_random_crop_decode_resize_dct_scaling()
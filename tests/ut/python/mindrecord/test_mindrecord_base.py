@@ -245,6 +245,43 @@ def test_cv_file_writer_loop_and_read():
     remove_multi_files(mindrecord_file_name, FILES_NUM)
 
 
+def test_cv_file_writer_pipeline_and_read():
+    """
+    Feature: FileWriter
+    Description: write the rows one by one in a pipeline, and enable the pipeline with invalid parameters
+    Expectation: all the rows are read back intact, the invalid parameters raise errors
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    remove_multi_files(mindrecord_file_name, FILES_NUM)
+    writer = FileWriter(mindrecord_file_name, FILES_NUM)
+    with pytest.raises(Exception, match="queue_capacity"):
+        writer.enable_pipeline(0)
+    writer.enable_pipeline(2)
+    with pytest.raises(RuntimeError, match="pipeline has been enabled"):
+        writer.enable_pipeline(2)
+    data = get_data("../data/mindrecord/testImageNetData/")
+    cv_schema_json = {"file_name": {"type": "string"},
+                      "label": {"type": "int64"}, "data": {"type": "bytes"}}
+    writer.add_schema(cv_schema_json, "img_schema")
+    writer.add_index(["file_name", "label"])
+    for row in data:
+        writer.write_raw_data([row])
+    writer.commit()
+
+    reader = FileReader(mindrecord_file_name + "0")
+    expected = {row["file_name"]: row for row in data}
+    count = 0
+    for x in reader.get_next():
+        row = expected[x["file_name"]]
+        assert x["label"] == row["label"]
+        assert bytes(x["data"]) == row["data"]
+        count = count + 1
+    assert count == 10
+    reader.close()
+
+    remove_multi_files(mindrecord_file_name, FILES_NUM)
+
+
 def test_cv_file_reader_tutorial():
     """tutorial for cv file reader."""
     mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]